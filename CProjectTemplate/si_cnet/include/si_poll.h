@@ -99,9 +99,14 @@ size_t si_poll_find(const si_poll_t* const p_poll,
  * @param p_socket Pointer to the si_socket_t value to be appended.
  * @param events short si_poll_info events mask value.
  * @param p_settings Pointer to si_realloc_settings to specify grow options.
+ * @param p_stats Pointer to si_realloc_stats_t recording grows. (NULL ok)
  * 
  * @return Returns stdbool true on success. Returns false otherwise.
  */
+bool si_poll_append_5(si_poll_t* const p_poll,
+	const si_socket_t* const p_socket, const short events,
+	const si_realloc_settings_t* const p_settings,
+	si_realloc_stats_t* const p_stats);
 bool si_poll_append_4(si_poll_t* const p_poll,
 	const si_socket_t* const p_socket, const short events,
 	const si_realloc_settings_t* const p_settings);
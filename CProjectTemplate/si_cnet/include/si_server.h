@@ -65,6 +65,8 @@ typedef struct si_server_t
 	si_accesslist_t* p_access_list;
 	si_mutex_t sockets_lock;
 	si_poll_t sockets;
+	// Resize history of the sockets poll array.
+	si_realloc_stats_t sockets_stats;
 	si_realloc_settings_t* p_settings;
 	event_handler_t p_on_connect;
 	event_handler_t p_on_read;
@@ -36,7 +36,7 @@ si_poll_t* si_poll_new_2(const size_t capacity, const short events)
 	{
 		goto END;
 	}
-	p_result = calloc(capacity, sizeof(si_poll_info));
+	p_result = calloc(1u, sizeof(si_poll_t));
 	if (NULL == p_result)
 	{
 		goto END;
@@ -134,9 +134,10 @@ END:
 	return result;
 }
 
-bool si_poll_append_4(si_poll_t* const p_poll,
+bool si_poll_append_5(si_poll_t* const p_poll,
 	const si_socket_t* const p_socket, const short events,
-	const si_realloc_settings_t* const p_settings)
+	const si_realloc_settings_t* const p_settings,
+	si_realloc_stats_t* const p_stats)
 {
 	bool result = false;
 	if ((NULL == p_poll) || (NULL == p_socket))
@@ -148,22 +149,33 @@ bool si_poll_append_4(si_poll_t* const p_poll,
 	if (SIZE_MAX == open_index)
 	{
 		// No available index. Attempt to grow capacity.
+		const size_t old_capacity = p_poll->capacity;
 		bool did_grow = false;
 		if (NULL == p_settings)
 		{
 			// Linear grow 1 capacity
-			did_grow = si_array_resize((si_array_t*)p_poll, p_poll->capacity + 1u);
+			did_grow = si_realloc_stats_resize(
+				p_stats, (si_array_t*)p_poll, p_poll->capacity + 1u
+			);
 		}
 		else
 		{
 			// Use provided si_realloc_settings to grow
-			did_grow = si_realloc_settings_grow(p_settings, (si_array_t*)p_poll);
+			did_grow = si_realloc_settings_grow_3(
+				p_settings, (si_array_t*)p_poll, p_stats
+			);
 		}
 		if (true != did_grow)
 		{
 			// Failed to grow.
 			goto END;
 		}
+		// Grown slots are zeroed, 0 is a valid fd so mark them open.
+		for (size_t iii = old_capacity; iii < p_poll->capacity; iii++)
+		{
+			si_poll_info* const p_open = si_array_at((si_array_t*)p_poll, iii);
+			p_open->fd = si_socket_invalid;
+		}
 		open_index = si_poll_find(p_poll, &invalid_socket);
 		if (SIZE_MAX == open_index)
 		{
@@ -184,6 +196,13 @@ bool si_poll_append_4(si_poll_t* const p_poll,
 END:
 	return result;
 }
+inline bool si_poll_append_4(si_poll_t* const p_poll,
+	const si_socket_t* const p_socket, const short events,
+	const si_realloc_settings_t* const p_settings)
+{
+	// Default value of p_stats is NULL
+	return si_poll_append_5(p_poll, p_socket, events, p_settings, NULL);
+}
 inline bool si_poll_append(si_poll_t* const p_poll,
 	const si_socket_t* const p_socket, const short events)
 {
@@ -361,6 +361,7 @@ void si_server_init_7(si_server_t* const p_server,
 		goto END;
 	}
 	si_poll_init(&(p_server->sockets), mut_max_queue);
+	si_realloc_stats_init(&(p_server->sockets_stats));
 
 	// Create and configure server socket
 	int server_fd = socket(
@@ -792,10 +793,10 @@ bool si_server_add_socket(si_server_t* const p_server, const si_socket_t socket_
 	}
 	// Attempt assign to open slot
 	si_mutex_lock(&(p_server->sockets_lock));
-	result = si_poll_append_4(
+	result = si_poll_append_5(
 		&(p_server->sockets),
 		&socket_fd, (POLLIN | POLLOUT | POLLHUP),
-		p_server->p_settings
+		p_server->p_settings, &(p_server->sockets_stats)
 	);
 	if (true != result)
 	{
@@ -29,6 +29,29 @@ void si_poll_test_main(void)
 	TEST_ASSERT_NULL(p_poll);
 }
 
+void si_poll_test_append(void)
+{
+	si_poll_t* p_poll = si_poll_new_2(1u, 0);
+	TEST_ASSERT_NOT_NULL(p_poll);
+	si_realloc_stats_t stats = {0};
+	si_realloc_stats_init(&stats);
+	// Real sockets, destroying the poll closes every one appended.
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		const si_socket_t socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+		TEST_ASSERT_TRUE(si_socket_is_valid(&socket_fd));
+		TEST_ASSERT_TRUE(
+			si_poll_append_5(p_poll, &socket_fd, POLLIN, NULL, &stats)
+		);
+	}
+	TEST_ASSERT_EQUAL_size_t(3u, si_poll_count(p_poll));
+	TEST_ASSERT_EQUAL_size_t(3u, p_poll->capacity);
+	// Linear growth, one slot per append that found no open slot.
+	TEST_ASSERT_EQUAL_size_t(2u, stats.grow_count);
+	TEST_ASSERT_EQUAL_size_t(3u, stats.peak_capacity);
+	si_poll_destroy(&p_poll);
+}
+
 /** Doxygen
  * @brief Runs all locally defined unit tests.
  */
@@ -36,6 +59,7 @@ static void si_poll_test_all(void)
 {
 	UNITY_BEGIN();
 	RUN_TEST(si_poll_test_main);
+	RUN_TEST(si_poll_test_append);
 	UNITY_END();
 }
 
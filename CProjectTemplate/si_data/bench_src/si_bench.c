@@ -0,0 +1,553 @@
+//si_bench.c
+
+#include "si_bench.h"
+
+#include <stdlib.h> // calloc(), free(), qsort(), strtoul()
+#include <string.h> // strcmp(), strchr()
+#include <time.h> // clock_gettime(), CLOCK_MONOTONIC
+
+#ifdef __linux__
+#include <sched.h> // cpu_set_t, sched_setaffinity()
+#include <sys/ioctl.h> // ioctl()
+#include <sys/syscall.h> // SYS_perf_event_open
+#include <unistd.h> // syscall(), read(), close()
+#if defined(__has_include)
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h> // perf_event_attr
+#define SI_BENCH_PERF (1)
+#endif// has perf_event.h
+#endif// __has_include
+#endif// __linux__
+
+#ifndef SI_BENCH_PERF
+#define SI_BENCH_PERF (0)
+#endif//SI_BENCH_PERF
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+/** Doxygen
+ * @brief Parses a comma separated list of sizes into the options.
+ *
+ * @param p_options Pointer to the options to be updated.
+ * @param p_list String of sizes such as "1000,10000".
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_bench_parse_sizes(si_bench_options_t* const p_options,
+	const char* p_list)
+{
+	bool result = false;
+	if ((NULL == p_options) || (NULL == p_list))
+	{
+		goto END;
+	}
+	p_options->size_count = 0u;
+	while ('\0' != *p_list)
+	{
+		if (SI_BENCH_MAX_SIZES <= p_options->size_count)
+		{
+			goto END;
+		}
+		char* p_end = NULL;
+		const unsigned long value = strtoul(p_list, &p_end, 10);
+		if ((p_end == p_list) || (0u >= value))
+		{
+			goto END;
+		}
+		p_options->sizes[p_options->size_count++] = (size_t)value;
+		p_list = p_end;
+		if (',' == *p_list)
+		{
+			p_list++;
+		}
+	}
+	result = (0u < p_options->size_count);
+END:
+	return result;
+}
+
+bool si_bench_options_parse(si_bench_options_t* const p_options,
+	const int argc, char** const pp_argv)
+{
+	bool result = false;
+	if ((NULL == p_options) || (NULL == pp_argv))
+	{
+		goto END;
+	}
+	for (int iii = 1; iii < argc; iii++)
+	{
+		const char* const p_arg = pp_argv[iii];
+		const bool has_value = ((iii + 1) < argc);
+		if (0 == strcmp(p_arg, "--csv"))
+		{
+			p_options->format = SI_BENCH_CSV;
+		}
+		else if (0 == strcmp(p_arg, "--json"))
+		{
+			p_options->format = SI_BENCH_JSON;
+		}
+		else if (0 == strcmp(p_arg, "--perf"))
+		{
+			p_options->use_perf = true;
+		}
+		else if ((0 == strcmp(p_arg, "--cpu")) && (true == has_value))
+		{
+			p_options->cpu = (int)strtol(pp_argv[++iii], NULL, 10);
+		}
+		else if ((0 == strcmp(p_arg, "--reps")) && (true == has_value))
+		{
+			p_options->repetitions = (size_t)strtoul(pp_argv[++iii], NULL, 10);
+			if (0u >= p_options->repetitions)
+			{
+				goto END;
+			}
+		}
+		else if ((0 == strcmp(p_arg, "--sizes")) && (true == has_value))
+		{
+			if (true != si_bench_parse_sizes(p_options, pp_argv[++iii]))
+			{
+				goto END;
+			}
+		}
+		else if ((0 == strcmp(p_arg, "--filter")) && (true == has_value))
+		{
+			p_options->p_filter = pp_argv[++iii];
+		}
+		else
+		{
+			goto END;
+		}
+	}
+	result = true;
+END:
+	return result;
+}
+
+void si_bench_options_usage(FILE* const p_file, const char* const p_name)
+{
+	if (NULL == p_file)
+	{
+		goto END;
+	}
+	fprintf(p_file, "Usage: %s [--csv|--json] [--cpu N] [--perf] [--reps N]"
+		" [--sizes N[,N...]] [--filter TEXT]\n",
+		(NULL == p_name) ? "bench" : p_name
+	);
+END:
+	return;
+}
+
+uint64_t si_bench_now_ns(void)
+{
+	struct timespec now = {0};
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ull) + (uint64_t)now.tv_nsec;
+}
+
+bool si_bench_pin_cpu(const int cpu)
+{
+	bool result = false;
+	if (0 > cpu)
+	{
+		goto END;
+	}
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET((size_t)cpu, &set);
+	result = (0 == sched_setaffinity(0, sizeof(set), &set));
+#endif// __linux__
+END:
+	return result;
+}
+
+#if SI_BENCH_PERF
+/** Doxygen
+ * @brief Opens a disabled user space hardware counter for this thread.
+ * @details Counters are inherited so threads started afterwards, such as the
+ *          workers of a pool made in a case setup, are counted too.
+ *
+ * @param config PERF_COUNT_HW_* counter to be opened.
+ *
+ * @return Returns file descriptor on success. Returns -1 otherwise.
+ */
+static int si_bench_perf_open(const uint64_t config)
+{
+	struct perf_event_attr attr = {0};
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.inherit = 1;
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif// SI_BENCH_PERF
+
+void si_bench_init(si_bench_t* const p_bench, FILE* const p_file,
+	const si_bench_options_t* const p_options)
+{
+	if ((NULL == p_bench) || (NULL == p_options))
+	{
+		goto END;
+	}
+	p_bench->p_file = (NULL == p_file) ? stdout : p_file;
+	p_bench->format = p_options->format;
+	p_bench->rows = 0u;
+	p_bench->sink = 0u;
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		p_bench->perf_fds[iii] = -1;
+	}
+	if (true != p_options->use_perf)
+	{
+		goto END;
+	}
+#if SI_BENCH_PERF
+	p_bench->perf_fds[0] = si_bench_perf_open(PERF_COUNT_HW_CPU_CYCLES);
+	p_bench->perf_fds[1] = si_bench_perf_open(PERF_COUNT_HW_INSTRUCTIONS);
+	p_bench->perf_fds[2] = si_bench_perf_open(PERF_COUNT_HW_CACHE_MISSES);
+	if (0 > p_bench->perf_fds[0])
+	{
+		fprintf(stderr, "perf_event_open() failed, counters disabled.\n");
+	}
+#else
+	fprintf(stderr, "Hardware counters are not supported on this platform.\n");
+#endif// SI_BENCH_PERF
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Resets and enables (or disables) the open perf counters.
+ *
+ * @param p_bench Pointer to the initialized benchmark struct.
+ * @param enable Should the counters be reset & started or stopped?
+ */
+static void si_bench_counters_toggle(si_bench_t* const p_bench,
+	const bool enable)
+{
+	if (NULL == p_bench)
+	{
+		goto END;
+	}
+#if SI_BENCH_PERF
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		if (0 > p_bench->perf_fds[iii])
+		{
+			continue;
+		}
+		if (true == enable)
+		{
+			(void)ioctl(p_bench->perf_fds[iii], PERF_EVENT_IOC_RESET, 0);
+			(void)ioctl(p_bench->perf_fds[iii], PERF_EVENT_IOC_ENABLE, 0);
+		}
+		else
+		{
+			(void)ioctl(p_bench->perf_fds[iii], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+#else
+	(void)enable;
+#endif// SI_BENCH_PERF
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Adds the stopped perf counter values to a running total.
+ *
+ * @param p_bench Pointer to the initialized benchmark struct.
+ * @param p_total Pointer to the counters to be added to.
+ */
+static void si_bench_counters_add(si_bench_t* const p_bench,
+	si_bench_counters_t* const p_total)
+{
+	if ((NULL == p_bench) || (NULL == p_total))
+	{
+		goto END;
+	}
+#if SI_BENCH_PERF
+	uint64_t* const pp_totals[3] = {
+		&(p_total->cycles), &(p_total->instructions), &(p_total->cache_misses)
+	};
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		uint64_t value = 0u;
+		if (0 > p_bench->perf_fds[iii])
+		{
+			continue;
+		}
+		if (sizeof(value) == read(p_bench->perf_fds[iii], &value, sizeof(value)))
+		{
+			*(pp_totals[iii]) += value;
+			p_total->is_valid = true;
+		}
+	}
+#endif// SI_BENCH_PERF
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief qsort() compare function for doubles in ascending order.
+ */
+static int si_bench_cmp_double(const void* const p_left,
+	const void* const p_right)
+{
+	const double left = *((const double*)p_left);
+	const double right = *((const double*)p_right);
+	return (left > right) - (left < right);
+}
+
+/** Doxygen
+ * @brief Nearest rank percentile of sorted samples.
+ *
+ * @param p_sorted Array of sorted samples.
+ * @param count Number of samples. Must be greater than 0.
+ * @param percent Percentile from 0 to 100.
+ *
+ * @return Returns the sample value at the percentile.
+ */
+static double si_bench_percentile(const double* const p_sorted,
+	const size_t count, const size_t percent)
+{
+	size_t rank = ((percent * count) + 99u) / 100u;
+	if (0u < rank)
+	{
+		rank--;
+	}
+	if (count <= rank)
+	{
+		rank = count - 1u;
+	}
+	return p_sorted[rank];
+}
+
+void si_bench_summarize(si_bench_result_t* const p_result,
+	double* const p_samples, const size_t count)
+{
+	if ((NULL == p_result) || (NULL == p_samples) || (0u >= count))
+	{
+		goto END;
+	}
+	qsort(p_samples, count, sizeof(double), si_bench_cmp_double);
+	p_result->samples = count;
+	p_result->min = p_samples[0];
+	p_result->p50 = si_bench_percentile(p_samples, count, 50u);
+	p_result->p90 = si_bench_percentile(p_samples, count, 90u);
+	p_result->p99 = si_bench_percentile(p_samples, count, 99u);
+	p_result->max = p_samples[count - 1u];
+END:
+	return;
+}
+
+bool si_bench_run(si_bench_t* const p_bench,
+	const si_bench_case_t* const p_case, const size_t size,
+	const size_t repetitions)
+{
+	bool result = false;
+	if ((NULL == p_bench) || (NULL == p_case) || (NULL == p_case->p_run_f))
+	{
+		goto END;
+	}
+	if ((0u >= size) || (0u >= repetitions))
+	{
+		goto END;
+	}
+	double* p_samples = calloc(repetitions, sizeof(double));
+	if (NULL == p_samples)
+	{
+		goto END;
+	}
+	si_bench_counters_t totals = {0};
+	for (size_t iii = 0u; iii < repetitions; iii++)
+	{
+		void* p_state = NULL;
+		if (NULL != p_case->p_setup_f)
+		{
+			p_state = p_case->p_setup_f(p_case->p_context, size);
+			if (NULL == p_state)
+			{
+				goto CLEAN;
+			}
+		}
+		si_bench_counters_toggle(p_bench, true);
+		const uint64_t start = si_bench_now_ns();
+		p_bench->sink += p_case->p_run_f(p_state, size);
+		const uint64_t stop = si_bench_now_ns();
+		si_bench_counters_toggle(p_bench, false);
+		si_bench_counters_add(p_bench, &totals);
+		if (NULL != p_case->p_teardown_f)
+		{
+			p_case->p_teardown_f(p_state);
+		}
+		p_samples[iii] = (double)(stop - start) / (double)size;
+	}
+	si_bench_result_t bench_result = {0};
+	bench_result.p_group = p_case->p_group;
+	bench_result.p_name = p_case->p_name;
+	bench_result.size = size;
+	si_bench_summarize(&bench_result, p_samples, repetitions);
+	if (true == totals.is_valid)
+	{
+		const uint64_t operations = (uint64_t)size * (uint64_t)repetitions;
+		bench_result.counters.is_valid = true;
+		bench_result.counters.cycles = totals.cycles / operations;
+		bench_result.counters.instructions = totals.instructions / operations;
+		bench_result.counters.cache_misses = totals.cache_misses / operations;
+	}
+	si_bench_report(p_bench, &bench_result);
+	result = true;
+CLEAN:
+	free(p_samples);
+	p_samples = NULL;
+END:
+	return result;
+}
+
+void si_bench_report(si_bench_t* const p_bench,
+	const si_bench_result_t* const p_result)
+{
+	if ((NULL == p_bench) || (NULL == p_bench->p_file) || (NULL == p_result))
+	{
+		goto END;
+	}
+	FILE* const p_file = p_bench->p_file;
+	const si_bench_counters_t* const p_counters = &(p_result->counters);
+	// Rows without samples mark cases the group doesn't support.
+	const bool is_supported = (0u < p_result->samples);
+	switch (p_bench->format)
+	{
+	case SI_BENCH_CSV:
+		if (0u == p_bench->rows)
+		{
+			fprintf(p_file, "group,name,size,samples,min_ns,p50_ns,p90_ns,"
+				"p99_ns,max_ns,cycles,instructions,cache_misses\n"
+			);
+		}
+		if (true != is_supported)
+		{
+			fprintf(p_file, "%s,%s,%zu,0,,,,,,,,\n",
+				p_result->p_group, p_result->p_name, p_result->size
+			);
+			break;
+		}
+		fprintf(p_file, "%s,%s,%zu,%zu,%.2f,%.2f,%.2f,%.2f,%.2f,",
+			p_result->p_group, p_result->p_name, p_result->size,
+			p_result->samples, p_result->min, p_result->p50, p_result->p90,
+			p_result->p99, p_result->max
+		);
+		if (true == p_counters->is_valid)
+		{
+			fprintf(p_file, "%llu,%llu,%llu\n",
+				(unsigned long long)p_counters->cycles,
+				(unsigned long long)p_counters->instructions,
+				(unsigned long long)p_counters->cache_misses
+			);
+		}
+		else
+		{
+			fprintf(p_file, ",,\n");
+		}
+		break;
+	case SI_BENCH_JSON:
+		fprintf(p_file, "%s\n  {\"group\": \"%s\", \"name\": \"%s\", ",
+			(0u == p_bench->rows) ? "[" : ",",
+			p_result->p_group, p_result->p_name
+		);
+		if (true != is_supported)
+		{
+			fprintf(p_file, "\"size\": %zu, \"samples\": 0, "
+				"\"unsupported\": true}", p_result->size
+			);
+			break;
+		}
+		fprintf(p_file, "\"size\": %zu, \"samples\": %zu, \"min_ns\": %.2f, "
+			"\"p50_ns\": %.2f, \"p90_ns\": %.2f, \"p99_ns\": %.2f, "
+			"\"max_ns\": %.2f",
+			p_result->size, p_result->samples, p_result->min, p_result->p50,
+			p_result->p90, p_result->p99, p_result->max
+		);
+		if (true == p_counters->is_valid)
+		{
+			fprintf(p_file, ", \"cycles\": %llu, \"instructions\": %llu, "
+				"\"cache_misses\": %llu",
+				(unsigned long long)p_counters->cycles,
+				(unsigned long long)p_counters->instructions,
+				(unsigned long long)p_counters->cache_misses
+			);
+		}
+		fprintf(p_file, "}");
+		break;
+	case SI_BENCH_TEXT:
+	default:
+		if (0u == p_bench->rows)
+		{
+			fprintf(p_file, "%-18s %-8s %9s %10s %10s %10s %10s %10s"
+				" (ns/op)\n",
+				"group", "name", "size", "min", "p50", "p90", "p99", "max"
+			);
+		}
+		if (true != is_supported)
+		{
+			fprintf(p_file, "%-18s %-8s %9zu %10s\n",
+				p_result->p_group, p_result->p_name, p_result->size,
+				"unsupported"
+			);
+			break;
+		}
+		fprintf(p_file, "%-18s %-8s %9zu %10.2f %10.2f %10.2f %10.2f %10.2f",
+			p_result->p_group, p_result->p_name, p_result->size,
+			p_result->min, p_result->p50, p_result->p90, p_result->p99,
+			p_result->max
+		);
+		if (true == p_counters->is_valid)
+		{
+			fprintf(p_file, " cyc:%llu ins:%llu miss:%llu",
+				(unsigned long long)p_counters->cycles,
+				(unsigned long long)p_counters->instructions,
+				(unsigned long long)p_counters->cache_misses
+			);
+		}
+		fprintf(p_file, "\n");
+		break;
+	}
+	p_bench->rows++;
+	fflush(p_file);
+END:
+	return;
+}
+
+void si_bench_free(si_bench_t* const p_bench)
+{
+	if (NULL == p_bench)
+	{
+		goto END;
+	}
+	if ((SI_BENCH_JSON == p_bench->format) && (NULL != p_bench->p_file))
+	{
+		fprintf(p_bench->p_file, "%s]\n", (0u == p_bench->rows) ? "[" : "\n");
+	}
+#if SI_BENCH_PERF
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		if (0 <= p_bench->perf_fds[iii])
+		{
+			(void)close(p_bench->perf_fds[iii]);
+		}
+		p_bench->perf_fds[iii] = -1;
+	}
+#endif// SI_BENCH_PERF
+	p_bench->rows = 0u;
+END:
+	return;
+}
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
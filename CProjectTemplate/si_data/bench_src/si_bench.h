@@ -0,0 +1,184 @@
+/* si_bench.h
+ * Language: C
+ * Authors: ScorpionInc
+ * Purpose: Shared timing, percentile & hardware counter helpers used by the
+ *          micro-benchmark executables. Not part of any library.
+ * Created: 20261019
+ * Updated: 20261019
+//*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif//_GNU_SOURCE
+
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t
+#include <stdio.h> // FILE, fprintf()
+
+#ifndef SI_BENCH_H
+#define SI_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+#define SI_BENCH_MAX_SIZES (16u)
+#define SI_BENCH_DEFAULT_REPETITIONS (11u)
+
+typedef enum si_bench_format_t
+{
+	SI_BENCH_TEXT = 0,
+	SI_BENCH_CSV  = 1,
+	SI_BENCH_JSON = 2,
+} si_bench_format_t;
+
+typedef struct si_bench_options_t
+{
+	si_bench_format_t format;
+	int cpu;
+	bool use_perf;
+	size_t repetitions;
+	size_t size_count;
+	size_t sizes[SI_BENCH_MAX_SIZES];
+	const char* p_filter;
+} si_bench_options_t;
+
+/** Doxygen
+ * @brief Parses the common benchmark command line options.
+ * @details --csv | --json, --cpu N, --perf, --reps N, --sizes N[,N...],
+ *          --filter TEXT. Sizes are kept when none are given.
+ *
+ * @param p_options Pointer to options struct holding defaults to update.
+ * @param argc Count of arguments.
+ * @param pp_argv Array of argument strings.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_bench_options_parse(si_bench_options_t* const p_options,
+	const int argc, char** const pp_argv);
+
+/** Doxygen
+ * @brief Writes the usage of the common options to a FILE stream.
+ *
+ * @param p_file Pointer to the FILE to be written to.
+ * @param p_name Name of the executable.
+ */
+void si_bench_options_usage(FILE* const p_file, const char* const p_name);
+
+typedef struct si_bench_counters_t
+{
+	bool is_valid;
+	uint64_t cycles;
+	uint64_t instructions;
+	uint64_t cache_misses;
+} si_bench_counters_t;
+
+typedef struct si_bench_result_t
+{
+	const char* p_group;
+	const char* p_name;
+	size_t size;
+	size_t samples;
+	// Nanoseconds per operation.
+	double min;
+	double p50;
+	double p90;
+	double p99;
+	double max;
+	// Averaged per operation when counters are available.
+	si_bench_counters_t counters;
+} si_bench_result_t;
+
+typedef struct si_bench_t
+{
+	FILE* p_file;
+	si_bench_format_t format;
+	size_t rows;
+	int perf_fds[3];
+	uint64_t sink;
+} si_bench_t;
+
+// Runs one measured repetition. Returns a value kept to defeat optimization.
+typedef struct si_bench_case_t
+{
+	const char* p_group;
+	const char* p_name;
+	const void* p_context;
+	void*  (*p_setup_f)(const void* const, const size_t);
+	size_t (*p_run_f)(void* const, const size_t);
+	void   (*p_teardown_f)(void* const);
+} si_bench_case_t;
+
+/** Doxygen
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ *
+ * @return Returns nanoseconds from an unspecified starting point.
+ */
+uint64_t si_bench_now_ns(void);
+
+/** Doxygen
+ * @brief Pins the calling thread to a single CPU to reduce timing noise.
+ *
+ * @param cpu Index of the CPU to run on.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_bench_pin_cpu(const int cpu);
+
+/** Doxygen
+ * @brief Initializes a benchmark reporter and optionally opens perf counters.
+ *
+ * @param p_bench Pointer to the benchmark struct to be initialized.
+ * @param p_file Pointer to the FILE results are written to.
+ * @param p_options Pointer to the parsed options.
+ */
+void si_bench_init(si_bench_t* const p_bench, FILE* const p_file,
+	const si_bench_options_t* const p_options);
+
+/** Doxygen
+ * @brief Sorts samples and stores their min, percentiles and max in result.
+ *
+ * @param p_result Pointer to the result to be filled out.
+ * @param p_samples Array of nanosecond per operation samples. Gets sorted.
+ * @param count Number of samples in the array.
+ */
+void si_bench_summarize(si_bench_result_t* const p_result,
+	double* const p_samples, const size_t count);
+
+/** Doxygen
+ * @brief Times a benchmark case at a given size & writes its result row.
+ *
+ * @param p_bench Pointer to the initialized benchmark struct.
+ * @param p_case Pointer to the case to be measured.
+ * @param size Number of operations done by each repetition.
+ * @param repetitions Number of samples to be taken.
+ *
+ * @return Returns stdbool true when the case ran. Returns false otherwise.
+ */
+bool si_bench_run(si_bench_t* const p_bench,
+	const si_bench_case_t* const p_case, const size_t size,
+	const size_t repetitions);
+
+/** Doxygen
+ * @brief Writes a result row in the configured format.
+ * @details Results of 0u samples are written as unsupported cases.
+ *
+ * @param p_bench Pointer to the initialized benchmark struct.
+ * @param p_result Pointer to the result to be written.
+ */
+void si_bench_report(si_bench_t* const p_bench,
+	const si_bench_result_t* const p_result);
+
+/** Doxygen
+ * @brief Writes any closing output and releases perf counters.
+ *
+ * @param p_bench Pointer to the benchmark struct to be freed.
+ */
+void si_bench_free(si_bench_t* const p_bench);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_BENCH_H
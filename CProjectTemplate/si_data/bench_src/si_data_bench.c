@@ -0,0 +1,810 @@
+//si_data_bench.c
+// Times insert, lookup, iterate, remove & sort of the si_data containers.
+
+#include <stdio.h> // printf(), fprintf()
+#include <stdlib.h> // calloc(), free()
+#include <string.h> // strstr()
+
+#include "si_bench.h"
+
+#include "si_array.h"
+#include "si_double_list.h"
+#include "si_hashmap.h"
+#include "si_map.h"
+#include "si_parray.h"
+#include "si_queue.h"
+#include "si_realloc_settings.h"
+#include "si_singular_blist.h"
+#include "si_stack.h"
+
+// Containers with O(n) inserts or lookups are capped to keep runs short.
+#define SI_DATA_BENCH_QUADRATIC_MAX (10000u)
+
+// Unique pseudo-random keys shared by every container.
+static size_t* gp_keys = NULL;
+static size_t g_key_count = 0u;
+static si_realloc_settings_t g_settings = {0};
+
+typedef struct si_data_bench_container_t
+{
+	const char* p_name;
+	size_t max_size;
+	void*  (*p_new_f)(const size_t);
+	size_t (*p_insert_f)(void* const, const size_t);
+	size_t (*p_lookup_f)(void* const, const size_t);
+	size_t (*p_iterate_f)(void* const, const size_t);
+	size_t (*p_remove_f)(void* const, const size_t);
+	size_t (*p_sort_f)(void* const, const size_t);
+	void   (*p_free_f)(void* const);
+} si_data_bench_container_t;
+
+typedef struct si_data_bench_state_t
+{
+	const si_data_bench_container_t* p_container;
+	void* p_data;
+} si_data_bench_state_t;
+
+/** Doxygen
+ * @brief splitmix64 finalizer. A bijection so distinct inputs stay distinct.
+ */
+static size_t si_data_bench_mix(uint64_t value)
+{
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+	return (size_t)(value ^ (value >> 31u));
+}
+
+static int si_data_bench_cmp_key(const void* const p_left,
+	const void* const p_right)
+{
+	const size_t left = *((const size_t*)p_left);
+	const size_t right = *((const size_t*)p_right);
+	return (left > right) - (left < right);
+}
+
+static int si_data_bench_cmp_pointer(const void* const p_left,
+	const void* const p_right)
+{
+	return si_data_bench_cmp_key(
+		*((const void* const*)p_left), *((const void* const*)p_right)
+	);
+}
+
+// si_array_t
+
+static void* si_data_bench_array_new(const size_t size)
+{
+	return si_array_new_2(sizeof(size_t), size);
+}
+static size_t si_data_bench_array_insert(void* const p_data, const size_t size)
+{
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		si_array_set(p_data, iii, &(gp_keys[iii]));
+	}
+	return size;
+}
+static size_t si_data_bench_array_lookup(void* const p_data, const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		sum += *((size_t*)si_array_at(p_data, gp_keys[iii] % size));
+	}
+	return sum;
+}
+static size_t si_data_bench_array_iterate(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		sum += *((size_t*)si_array_at(p_data, iii));
+	}
+	return sum;
+}
+static size_t si_data_bench_array_sort(void* const p_data, const size_t size)
+{
+	si_array_t* const p_array = p_data;
+	// Integer keys take the radix path, no comparator calls.
+	si_array_t view = { p_array->p_data, sizeof(size_t), size };
+	si_array_sort_radix(&view);
+	return *((size_t*)si_array_first(p_array));
+}
+static size_t si_data_bench_array_remove(void* const p_data, const size_t size)
+{
+	size_t removed = 0u;
+	for (size_t iii = size; iii > 0u; iii--)
+	{
+		removed += (size_t)si_array_erase_range(p_data, iii - 1u, 1u);
+	}
+	return removed;
+}
+static void si_data_bench_array_free(void* const p_data)
+{
+	si_array_t* p_array = p_data;
+	si_array_destroy(&p_array);
+}
+
+// si_parray_t
+
+static void* si_data_bench_parray_new(const size_t size)
+{
+	return si_parray_new_1(size);
+}
+static size_t si_data_bench_parray_insert(void* const p_data,
+	const size_t size)
+{
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		(void)si_parray_append(p_data, &(gp_keys[iii]));
+	}
+	return si_parray_count(p_data);
+}
+static size_t si_data_bench_parray_lookup(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		sum += *((size_t*)si_parray_at(p_data, gp_keys[iii] % size));
+	}
+	return sum;
+}
+static size_t si_data_bench_parray_iterate(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		sum += *((size_t*)si_parray_at(p_data, iii));
+	}
+	return sum;
+}
+static size_t si_data_bench_parray_remove(void* const p_data,
+	const size_t size)
+{
+	size_t removed = 0u;
+	for (size_t iii = size; iii > 0u; iii--)
+	{
+		removed += (size_t)si_parray_remove_at(p_data, iii - 1u);
+	}
+	return removed;
+}
+static size_t si_data_bench_parray_sort(void* const p_data, const size_t size)
+{
+	si_parray_t* const p_parray = p_data;
+	si_array_t view = { p_parray->array.p_data, sizeof(void*), size };
+	si_array_sort(&view, si_data_bench_cmp_pointer);
+	return *((size_t*)si_parray_at(p_parray, 0u));
+}
+static void si_data_bench_parray_free(void* const p_data)
+{
+	si_parray_t* p_parray = p_data;
+	si_parray_destroy(&p_parray);
+}
+
+// si_double_list_t
+
+static void* si_data_bench_double_list_new(const size_t size)
+{
+	(void)size;
+	return si_double_list_new_3(true, 0u, si_data_bench_cmp_key);
+}
+static size_t si_data_bench_double_list_insert(void* const p_data,
+	const size_t size)
+{
+	size_t inserted = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		inserted += (size_t)si_double_list_append(p_data, &(gp_keys[iii]));
+	}
+	return inserted;
+}
+static size_t si_data_bench_double_list_lookup(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		const size_t* const p_key = si_double_list_at(
+			p_data, gp_keys[iii] % size
+		);
+		sum += (NULL == p_key) ? 0u : *p_key;
+	}
+	return sum;
+}
+static size_t si_data_bench_double_list_iterate(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	const si_double_list_t* const p_list = p_data;
+	const si_double_node_t* p_node = p_list->p_head;
+	for (size_t iii = 0u; (iii < size) && (NULL != p_node); iii++)
+	{
+		sum += *((const size_t*)p_node->p_data);
+		p_node = p_node->p_next;
+	}
+	return sum;
+}
+static size_t si_data_bench_double_list_remove(void* const p_data,
+	const size_t size)
+{
+	size_t removed = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		removed += (size_t)si_double_list_remove_at(p_data, 0u);
+	}
+	return removed;
+}
+static size_t si_data_bench_double_list_sort(void* const p_data,
+	const size_t size)
+{
+	(void)size;
+	return (size_t)si_double_list_sort(p_data);
+}
+static void si_data_bench_double_list_free(void* const p_data)
+{
+	si_double_list_t* p_list = p_data;
+	si_double_list_free_at(&p_list);
+}
+
+// si_singular_blist_t (Owns & frees its values.)
+
+/** Doxygen
+ * @brief Key compare function sorting the list's empty (NULL) nodes first.
+ */
+static int si_data_bench_cmp_blist_key(const void* const p_left,
+	const void* const p_right)
+{
+	if ((NULL == p_left) || (NULL == p_right))
+	{
+		return (NULL != p_left) - (NULL != p_right);
+	}
+	return si_data_bench_cmp_key(p_left, p_right);
+}
+
+static void* si_data_bench_blist_new(const size_t size)
+{
+	(void)size;
+	return si_singular_blist_new_3(false, 1u, si_data_bench_cmp_blist_key);
+}
+static size_t si_data_bench_blist_insert(void* const p_data,
+	const size_t size)
+{
+	si_singular_blist_t* const p_list = p_data;
+	size_t inserted = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		size_t* p_key = calloc(1u, sizeof(size_t));
+		if (NULL == p_key)
+		{
+			break;
+		}
+		*p_key = gp_keys[iii];
+		if (true != si_singular_blist_append(p_list, p_key))
+		{
+			free(p_key);
+			break;
+		}
+		inserted++;
+	}
+	return inserted;
+}
+static size_t si_data_bench_blist_lookup(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		// Index 0 is the empty node the list was created with.
+		const size_t* const p_key = si_singular_blist_at(
+			p_data, (gp_keys[iii] % size) + 1u
+		);
+		sum += (NULL == p_key) ? 0u : *p_key;
+	}
+	return sum;
+}
+static size_t si_data_bench_blist_iterate(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	const si_singular_blist_t* const p_list = p_data;
+	const si_singular_list_t* p_node = p_list->p_head->p_next;
+	for (size_t iii = 0u; (iii < size) && (NULL != p_node); iii++)
+	{
+		sum += *((const size_t*)p_node->p_data);
+		p_node = p_node->p_next;
+	}
+	return sum;
+}
+static size_t si_data_bench_blist_remove(void* const p_data,
+	const size_t size)
+{
+	si_singular_blist_t* const p_list = p_data;
+	size_t removed = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		// Removes after the empty head node so each removal is O(1).
+		void* const p_key = si_singular_blist_at(p_list, 1u);
+		if (true != si_singular_blist_remove_at(p_list, 1u))
+		{
+			break;
+		}
+		free(p_key);
+		removed++;
+	}
+	return removed;
+}
+static size_t si_data_bench_blist_sort(void* const p_data, const size_t size)
+{
+	(void)size;
+	return (size_t)si_singular_blist_sort(p_data);
+}
+static void si_data_bench_blist_free(void* const p_data)
+{
+	si_singular_blist_free(p_data);
+}
+
+// si_queue_t
+
+static void* si_data_bench_queue_new(const size_t size)
+{
+	(void)size;
+	return si_queue_new_3(sizeof(size_t), 0u, &g_settings);
+}
+static size_t si_data_bench_queue_insert(void* const p_data,
+	const size_t size)
+{
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		(void)si_queue_enqueue(p_data, &(gp_keys[iii]));
+	}
+	return si_queue_count(p_data);
+}
+static size_t si_data_bench_queue_remove(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		size_t key = 0u;
+		(void)si_queue_dequeue(p_data, &key);
+		sum += key;
+	}
+	return sum;
+}
+static void si_data_bench_queue_free(void* const p_data)
+{
+	si_queue_t* p_queue = p_data;
+	si_queue_destroy(&p_queue);
+}
+
+// si_stack_t
+
+static void* si_data_bench_stack_new(const size_t size)
+{
+	(void)size;
+	si_stack_t* p_stack = calloc(1u, sizeof(si_stack_t));
+	if (NULL != p_stack)
+	{
+		si_stack_new_4(p_stack, sizeof(size_t), 0u, &g_settings);
+	}
+	return p_stack;
+}
+static size_t si_data_bench_stack_insert(void* const p_data,
+	const size_t size)
+{
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		si_stack_push(p_data, &(gp_keys[iii]));
+	}
+	return ((si_stack_t*)p_data)->count;
+}
+static size_t si_data_bench_stack_remove(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		size_t key = 0u;
+		si_stack_pop(p_data, &key);
+		sum += key;
+	}
+	return sum;
+}
+static void si_data_bench_stack_free(void* const p_data)
+{
+	si_stack_free(p_data);
+	free(p_data);
+}
+
+// si_map_t
+
+static void* si_data_bench_map_new(const size_t size)
+{
+	si_map_t* p_map = si_map_new();
+	if (NULL != p_map)
+	{
+		p_map->p_cmp_key_f = si_data_bench_cmp_key;
+		(void)si_array_resize(&(p_map->entries.array), size);
+	}
+	return p_map;
+}
+static size_t si_data_bench_map_insert(void* const p_data, const size_t size)
+{
+	size_t inserted = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		inserted += (size_t)si_map_insert(
+			p_data, &(gp_keys[iii]), &(gp_keys[iii])
+		);
+	}
+	return inserted;
+}
+static size_t si_data_bench_map_lookup(void* const p_data, const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		const size_t* const p_value = si_map_at(
+			p_data, &(gp_keys[gp_keys[iii] % size])
+		);
+		sum += (NULL == p_value) ? 0u : *p_value;
+	}
+	return sum;
+}
+static size_t si_data_bench_map_iterate(void* const p_data, const size_t size)
+{
+	size_t sum = 0u;
+	const si_map_t* const p_map = p_data;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		const si_map_pair_t* const p_pair = si_parray_at(
+			&(p_map->entries), iii
+		);
+		sum += *((const size_t*)p_pair->p_value);
+	}
+	return sum;
+}
+static size_t si_data_bench_map_remove(void* const p_data, const size_t size)
+{
+	size_t removed = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		removed += (size_t)si_map_remove(p_data, &(gp_keys[iii]));
+	}
+	return removed;
+}
+static void si_data_bench_map_free(void* const p_data)
+{
+	si_map_t* p_map = p_data;
+	si_map_destroy(&p_map);
+}
+
+// si_hashmap_t
+
+static void* si_data_bench_hashmap_new(const size_t size)
+{
+	// Load factor of 1 to match the usual open hashing configuration.
+	return si_hashmap_new(size);
+}
+static size_t si_data_bench_hashmap_insert(void* const p_data,
+	const size_t size)
+{
+	size_t inserted = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		inserted += (size_t)si_hashmap_insert_hash(
+			p_data, gp_keys[iii], &(gp_keys[iii])
+		);
+	}
+	return inserted;
+}
+static size_t si_data_bench_hashmap_lookup(void* const p_data,
+	const size_t size)
+{
+	size_t sum = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		const size_t* const p_value = si_hashmap_at_hash(
+			p_data, gp_keys[gp_keys[iii] % size]
+		);
+		sum += (NULL == p_value) ? 0u : *p_value;
+	}
+	return sum;
+}
+static size_t si_data_bench_hashmap_iterate(void* const p_data,
+	const size_t size)
+{
+	(void)size;
+	size_t sum = 0u;
+	const si_hashmap_t* const p_hashmap = p_data;
+	for (size_t iii = 0u; iii < p_hashmap->maps.capacity; iii++)
+	{
+		si_map_t** const pp_map = si_array_at(&(p_hashmap->maps), iii);
+		if (NULL == *pp_map)
+		{
+			continue;
+		}
+		const size_t count = si_map_count(*pp_map);
+		for (size_t jjj = 0u; jjj < count; jjj++)
+		{
+			const si_map_pair_t* const p_pair = si_parray_at(
+				&((*pp_map)->entries), jjj
+			);
+			sum += *((const size_t*)p_pair->p_value);
+		}
+	}
+	return sum;
+}
+static size_t si_data_bench_hashmap_remove(void* const p_data,
+	const size_t size)
+{
+	size_t removed = 0u;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		removed += (size_t)si_hashmap_remove_hash(p_data, gp_keys[iii]);
+	}
+	return removed;
+}
+static void si_data_bench_hashmap_free(void* const p_data)
+{
+	si_hashmap_t* p_hashmap = p_data;
+	si_hashmap_destroy(&p_hashmap);
+}
+
+static const si_data_bench_container_t g_containers[] = {
+	{
+		"si_array", SIZE_MAX, si_data_bench_array_new,
+		si_data_bench_array_insert, si_data_bench_array_lookup,
+		si_data_bench_array_iterate, si_data_bench_array_remove,
+		si_data_bench_array_sort, si_data_bench_array_free
+	},
+	{
+		"si_parray", SI_DATA_BENCH_QUADRATIC_MAX, si_data_bench_parray_new,
+		si_data_bench_parray_insert, si_data_bench_parray_lookup,
+		si_data_bench_parray_iterate, si_data_bench_parray_remove,
+		si_data_bench_parray_sort, si_data_bench_parray_free
+	},
+	{
+		"si_double_list", SI_DATA_BENCH_QUADRATIC_MAX,
+		si_data_bench_double_list_new, si_data_bench_double_list_insert,
+		si_data_bench_double_list_lookup, si_data_bench_double_list_iterate,
+		si_data_bench_double_list_remove, si_data_bench_double_list_sort,
+		si_data_bench_double_list_free
+	},
+	{
+		"si_singular_blist", SI_DATA_BENCH_QUADRATIC_MAX,
+		si_data_bench_blist_new, si_data_bench_blist_insert,
+		si_data_bench_blist_lookup, si_data_bench_blist_iterate,
+		si_data_bench_blist_remove, si_data_bench_blist_sort,
+		si_data_bench_blist_free
+	},
+	{
+		"si_queue", SIZE_MAX, si_data_bench_queue_new,
+		si_data_bench_queue_insert, NULL, NULL, si_data_bench_queue_remove,
+		NULL, si_data_bench_queue_free
+	},
+	{
+		"si_stack", SIZE_MAX, si_data_bench_stack_new,
+		si_data_bench_stack_insert, NULL, NULL, si_data_bench_stack_remove,
+		NULL, si_data_bench_stack_free
+	},
+	{
+		"si_map", SI_DATA_BENCH_QUADRATIC_MAX, si_data_bench_map_new,
+		si_data_bench_map_insert, si_data_bench_map_lookup,
+		si_data_bench_map_iterate, si_data_bench_map_remove, NULL,
+		si_data_bench_map_free
+	},
+	{
+		"si_hashmap", SIZE_MAX, si_data_bench_hashmap_new,
+		si_data_bench_hashmap_insert, si_data_bench_hashmap_lookup,
+		si_data_bench_hashmap_iterate, si_data_bench_hashmap_remove, NULL,
+		si_data_bench_hashmap_free
+	},
+};
+
+/** Doxygen
+ * @brief Case setup creating an empty container. (Used to time inserts.)
+ */
+static void* si_data_bench_setup_empty(const void* const p_context,
+	const size_t size)
+{
+	const si_data_bench_container_t* const p_container = p_context;
+	si_data_bench_state_t* p_state = calloc(1u, sizeof(si_data_bench_state_t));
+	if (NULL == p_state)
+	{
+		goto END;
+	}
+	p_state->p_container = p_container;
+	p_state->p_data = p_container->p_new_f(size);
+	if (NULL == p_state->p_data)
+	{
+		free(p_state);
+		p_state = NULL;
+	}
+END:
+	return p_state;
+}
+
+/** Doxygen
+ * @brief Case setup creating a container filled with size keys.
+ */
+static void* si_data_bench_setup_filled(const void* const p_context,
+	const size_t size)
+{
+	si_data_bench_state_t* p_state = si_data_bench_setup_empty(
+		p_context, size
+	);
+	if (NULL == p_state)
+	{
+		goto END;
+	}
+	const size_t inserted = p_state->p_container->p_insert_f(
+		p_state->p_data, size
+	);
+	if (inserted != size)
+	{
+		p_state->p_container->p_free_f(p_state->p_data);
+		free(p_state);
+		p_state = NULL;
+	}
+END:
+	return p_state;
+}
+
+static void si_data_bench_teardown(void* const p_state_v)
+{
+	si_data_bench_state_t* const p_state = p_state_v;
+	p_state->p_container->p_free_f(p_state->p_data);
+	free(p_state);
+}
+
+static size_t si_data_bench_run_insert(void* const p_state, const size_t size)
+{
+	const si_data_bench_state_t* const p_s = p_state;
+	return p_s->p_container->p_insert_f(p_s->p_data, size);
+}
+static size_t si_data_bench_run_lookup(void* const p_state, const size_t size)
+{
+	const si_data_bench_state_t* const p_s = p_state;
+	return p_s->p_container->p_lookup_f(p_s->p_data, size);
+}
+static size_t si_data_bench_run_iterate(void* const p_state,
+	const size_t size)
+{
+	const si_data_bench_state_t* const p_s = p_state;
+	return p_s->p_container->p_iterate_f(p_s->p_data, size);
+}
+static size_t si_data_bench_run_remove(void* const p_state, const size_t size)
+{
+	const si_data_bench_state_t* const p_s = p_state;
+	return p_s->p_container->p_remove_f(p_s->p_data, size);
+}
+static size_t si_data_bench_run_sort(void* const p_state, const size_t size)
+{
+	const si_data_bench_state_t* const p_s = p_state;
+	return p_s->p_container->p_sort_f(p_s->p_data, size);
+}
+
+/** Doxygen
+ * @brief Runs every supported operation of a container at every size.
+ */
+static void si_data_bench_container(si_bench_t* const p_bench,
+	const si_bench_options_t* const p_options,
+	const si_data_bench_container_t* const p_container)
+{
+	const struct
+	{
+		const char* p_name;
+		bool is_supported;
+		bool needs_fill;
+		size_t (*p_run_f)(void* const, const size_t);
+	} operations[] = {
+		{"insert", true, false, si_data_bench_run_insert},
+		{"lookup", NULL != p_container->p_lookup_f, true,
+			si_data_bench_run_lookup},
+		{"iterate", NULL != p_container->p_iterate_f, true,
+			si_data_bench_run_iterate},
+		{"remove", NULL != p_container->p_remove_f, true,
+			si_data_bench_run_remove},
+		{"sort", NULL != p_container->p_sort_f, true,
+			si_data_bench_run_sort},
+	};
+	const size_t operation_count = sizeof(operations) / sizeof(operations[0]);
+	for (size_t iii = 0u; iii < p_options->size_count; iii++)
+	{
+		const size_t size = p_options->sizes[iii];
+		if ((p_container->max_size < size) || (g_key_count < size))
+		{
+			continue;
+		}
+		for (size_t jjj = 0u; jjj < operation_count; jjj++)
+		{
+			if (true != operations[jjj].is_supported)
+			{
+				// Listed so every container reports every operation.
+				si_bench_result_t unsupported = {0};
+				unsupported.p_group = p_container->p_name;
+				unsupported.p_name = operations[jjj].p_name;
+				unsupported.size = size;
+				si_bench_report(p_bench, &unsupported);
+				continue;
+			}
+			const si_bench_case_t bench_case = {
+				p_container->p_name, operations[jjj].p_name, p_container,
+				operations[jjj].needs_fill ?
+					si_data_bench_setup_filled : si_data_bench_setup_empty,
+				operations[jjj].p_run_f, si_data_bench_teardown
+			};
+			if (true != si_bench_run(
+				p_bench, &bench_case, size, p_options->repetitions))
+			{
+				fprintf(stderr, "%s %s %zu failed to run.\n",
+					p_container->p_name, operations[jjj].p_name, size
+				);
+			}
+		}
+	}
+}
+
+int main(int argc, char** pp_argv)
+{
+	int result = 1;
+	si_bench_options_t options = {0};
+	options.cpu = -1;
+	options.repetitions = SI_BENCH_DEFAULT_REPETITIONS;
+	options.size_count = 3u;
+	options.sizes[0] = 1000u;
+	options.sizes[1] = 10000u;
+	options.sizes[2] = 100000u;
+	if (true != si_bench_options_parse(&options, argc, pp_argv))
+	{
+		si_bench_options_usage(stderr, pp_argv[0]);
+		goto END;
+	}
+	if ((0 <= options.cpu) && (true != si_bench_pin_cpu(options.cpu)))
+	{
+		fprintf(stderr, "Failed to pin to CPU %d.\n", options.cpu);
+	}
+	si_realloc_settings_new(&g_settings);
+
+	for (size_t iii = 0u; iii < options.size_count; iii++)
+	{
+		if (g_key_count < options.sizes[iii])
+		{
+			g_key_count = options.sizes[iii];
+		}
+	}
+	gp_keys = calloc(g_key_count, sizeof(size_t));
+	if (NULL == gp_keys)
+	{
+		goto END;
+	}
+	for (size_t iii = 0u; iii < g_key_count; iii++)
+	{
+		gp_keys[iii] = si_data_bench_mix(iii);
+	}
+
+	si_bench_t bench = {0};
+	si_bench_init(&bench, stdout, &options);
+	const size_t container_count = sizeof(g_containers) / sizeof(g_containers[0]);
+	for (size_t iii = 0u; iii < container_count; iii++)
+	{
+		if ((NULL != options.p_filter) &&
+		    (NULL == strstr(g_containers[iii].p_name, options.p_filter)))
+		{
+			continue;
+		}
+		si_data_bench_container(&bench, &options, &(g_containers[iii]));
+	}
+	si_bench_free(&bench);
+	fprintf(stderr, "sink: %llu\n", (unsigned long long)bench.sink);
+	result = 0;
+END:
+	free(gp_keys);
+	gp_keys = NULL;
+	return result;
+}
@@ -3,7 +3,7 @@
  * Authors: ScorpionInc
  * Purpose: Defines struct functions for managing an allocated memory buffer.
  * Created: 20150501
- * Updated: 20250813
+ * Updated: 20261019
 //*/
 
 #include <stdbool.h> // bool, false, true
@@ -162,6 +162,144 @@ void si_array_set(si_array_t* const p_array,
 void si_array_get(const si_array_t* const p_array,
 	const size_t index, void* p_item);
 
+/** Doxygen
+ * @brief Copies count elements from p_items into the buffer starting @ index.
+ *
+ * @param p_array Pointer to si_array_t struct whose buffer is to be changed.
+ * @param index Index of the first element to be set.
+ * @param p_items Pointer to count contiguous elements. May overlap buffer.
+ * @param count Number of elements to be copied.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_set_range(si_array_t* const p_array, const size_t index,
+	const void* const p_items, const size_t count);
+
+/** Doxygen
+ * @brief Copies count elements starting @ index from the buffer into p_items.
+ *
+ * @param p_array Pointer to si_array_t struct to be read from.
+ * @param index Index of the first element to be read.
+ * @param p_items Pointer to space for count contiguous elements.
+ * @param count Number of elements to be copied.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_get_range(const si_array_t* const p_array, const size_t index,
+	void* const p_items, const size_t count);
+
+/** Doxygen
+ * @brief Sets count elements starting @ index to copies of p_item.
+ *
+ * @param p_array Pointer to si_array_t struct whose buffer is to be changed.
+ * @param index Index of the first element to be set.
+ * @param p_item Pointer to the element value to be repeated.
+ * @param count Number of elements to be set.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_fill(si_array_t* const p_array, const size_t index,
+	const void* const p_item, const size_t count);
+
+/** Doxygen
+ * @brief Grows the array by count, shifting elements at and after index up
+ *        and copying p_items into the opening.
+ *
+ * @param p_array Pointer to si_array_t struct to be inserted into.
+ * @param index Index the first new element will have. (<= capacity)
+ * @param p_items Pointer to count contiguous elements. May overlap buffer.
+ * @param count Number of elements to be inserted.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_insert_range(si_array_t* const p_array, const size_t index,
+	const void* const p_items, const size_t count);
+
+/** Doxygen
+ * @brief Removes count elements starting @ index, shifting later elements
+ *        down and shrinking the array by count.
+ *
+ * @param p_array Pointer to si_array_t struct to be erased from.
+ * @param index Index of the first element to be removed.
+ * @param count Number of elements to be removed.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_erase_range(si_array_t* const p_array, const size_t index,
+	const size_t count);
+
+/** Doxygen
+ * @brief Finds the first element, at or after start, whose bytes equal p_item
+ * @details 1, 2, 4 & 8 byte elements are compared 16 bytes at a time when SSE2
+ *          is available.
+ *
+ * @param p_array Pointer to si_array_t struct to be searched.
+ * @param p_item Pointer to the element value to search for.
+ * @param start Index to begin searching from.
+ *
+ * @return Returns index of the element on success. Returns SIZE_MAX otherwise.
+ */
+size_t si_array_find_3(const si_array_t* const p_array,
+	const void* const p_item, const size_t start);
+size_t si_array_find(const si_array_t* const p_array,
+	const void* const p_item);
+
+/** Doxygen
+ * @brief Sorts the array in place using an introsort. (Not stable)
+ * @details Quicksort with median-of-three pivots, falling back to heapsort
+ *          past 2*log2(n) levels and insertion sort for small ranges.
+ *
+ * @param p_array Pointer to si_array_t struct to be sorted.
+ * @param p_cmp_f Function pointer used to order two elements like qsort().
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_sort(si_array_t* const p_array,
+	int (*p_cmp_f)(const void* const, const void* const));
+
+/** Doxygen
+ * @brief Sorts the array in place by an integer key using LSD radix sort.
+ * @details Keys are read in host byte order. Bytes all keys share are skipped.
+ *          Stable. Needs a scratch buffer the size of the array.
+ *
+ * @param p_array Pointer to si_array_t struct to be sorted.
+ * @param key_offset Byte offset of the key within each element.
+ * @param key_size Size of the key in bytes. (1, 2, 4 or 8)
+ * @param is_signed Orders keys as two's complement signed integers when true.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_array_sort_radix_4(si_array_t* const p_array, const size_t key_offset,
+	const size_t key_size, const bool is_signed);
+bool si_array_sort_radix_2(si_array_t* const p_array, const bool is_signed);
+bool si_array_sort_radix(si_array_t* const p_array);
+
+/** Doxygen
+ * @brief Finds the first element of a sorted array not ordered before p_key.
+ *
+ * @param p_array Pointer to sorted si_array_t struct to be searched.
+ * @param p_key Pointer to the key to search for.
+ * @param p_cmp_f Function pointer the array was sorted with.
+ *
+ * @return Returns index on success (capacity if none). SIZE_MAX on failure.
+ */
+size_t si_array_lower_bound(const si_array_t* const p_array,
+	const void* const p_key,
+	int (*p_cmp_f)(const void* const, const void* const));
+
+/** Doxygen
+ * @brief Binary searches a sorted array for the first element equal to p_key.
+ *
+ * @param p_array Pointer to sorted si_array_t struct to be searched.
+ * @param p_key Pointer to the key to search for.
+ * @param p_cmp_f Function pointer the array was sorted with.
+ *
+ * @return Returns index of the element on success. Returns SIZE_MAX otherwise.
+ */
+size_t si_array_bsearch(const si_array_t* const p_array,
+	const void* const p_key,
+	int (*p_cmp_f)(const void* const, const void* const));
+
 /**Doxygen
  * @brief Swaps the values of two indexs inside the array.
  * 
@@ -25,6 +25,8 @@ typedef struct si_parray_t
 	void (*p_free_value)(void*);
 	si_realloc_settings_t* p_settings;
 	si_array_t array;
+	// Resize history, drives adaptive p_settings.
+	si_realloc_stats_t stats;
 } si_parray_t;
 
 /** Doxygen
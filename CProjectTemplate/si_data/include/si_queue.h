@@ -3,7 +3,7 @@
  * Authors: ScorpionInc
  * Purpose: Defines struct with functions for managing a FIFO dynamic queue.
  * Created: 20150601
- * Updated: 20250707
+ * Updated: 20261019
 //*/
 
 #include <stdbool.h>
@@ -25,6 +25,10 @@ typedef struct si_queue_t
 	size_t back;
 	const si_realloc_settings_t* p_settings;
 	si_array_t array;
+	// Resize history, drives adaptive p_settings.
+	si_realloc_stats_t stats;
+	// Caller owned storage used before spilling to the heap. (Optional)
+	void* p_inline;
 } si_queue_t;
 
 /** Doxygen
@@ -41,6 +45,26 @@ void si_queue_init_3(si_queue_t* const p_queue, const size_t element_size,
 	const size_t initial_capacity);
 void si_queue_init(si_queue_t* const p_queue, const size_t element_size);
 
+/** Doxygen
+ * @brief Initializes a queue struct that stores items in p_buffer until it is
+ *        full, only then spilling onto the heap.
+ * @details Like the heap array one slot marks the back of the queue, so
+ *          p_buffer holds up to (buffer_capacity - 1) queued items.
+ *
+ * @param p_queue Pointer to struct to be initialized.
+ * @param element_size Size in bytes of the items to be stored.
+ * @param p_buffer Caller owned storage for buffer_capacity items. Must outlive
+ *                 the queue.
+ * @param buffer_capacity Number of elements p_buffer can hold. (>= 2)
+ * @param p_settings Pointer to si_realloc_settings to read from.
+ */
+void si_queue_init_inline_5(si_queue_t* const p_queue,
+	const size_t element_size, void* const p_buffer,
+	const size_t buffer_capacity, const si_realloc_settings_t* p_settings);
+void si_queue_init_inline(si_queue_t* const p_queue,
+	const size_t element_size, void* const p_buffer,
+	const size_t buffer_capacity);
+
 /** Doxygen
  * @brief Allocates and Initializes a new queue struct
  *
@@ -73,6 +97,15 @@ size_t si_queue_count(const si_queue_t* const p_queue);
  */
 size_t si_queue_capacity(const si_queue_t* const p_queue);
 
+/** Doxygen
+ * @brief Determines if the items are currently stored in the inline buffer.
+ *
+ * @param p_queue Pointer to the queue to check.
+ *
+ * @return Returns stdbool true if no heap memory is in use.
+ */
+bool si_queue_is_inline(const si_queue_t* const p_queue);
+
 /** Doxygen
  * @brief Determines if the queue is empty
  *
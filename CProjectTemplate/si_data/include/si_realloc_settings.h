@@ -4,10 +4,11 @@
  * Purpose: Defines struct si_realloc_settings along with several functions.
  *          These allow configuring dynamic memory grow/shrink methods/amounts.
  * Created: 20150611
- * Updated: 20250813
+ * Updated: 20261019
 //*/
 
 #include <math.h> //pow
+#include <stdbool.h> // bool
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -33,6 +34,17 @@ typedef enum si_resize_mode_t
 #define SI_DEFAULT_RESIZE_MODE LINEAR
 #define SI_DEFAULT_RESIZE_VALUE 32.0f
 
+#ifndef SI_REALLOC_ADAPTIVE_MAX_SHIFT
+// Adaptive grow steps double per grow since the last shrink, up to 2^this.
+#define SI_REALLOC_ADAPTIVE_MAX_SHIFT (3u)
+#endif//SI_REALLOC_ADAPTIVE_MAX_SHIFT
+
+#ifndef SI_REALLOC_ADAPTIVE_SHRINK_SLACK
+// Adaptive shrinks wait until the count fits the smaller capacity this many
+// times over, so a count bouncing on a boundary doesn't resize every time.
+#define SI_REALLOC_ADAPTIVE_SHRINK_SLACK (2u)
+#endif//SI_REALLOC_ADAPTIVE_SHRINK_SLACK
+
 /** Doxygen
  * @brief Prints the string value of the si_resize_mode enum to file.
  *
@@ -50,51 +62,124 @@ typedef struct si_realloc_settings_t
 	si_resize_mode_t shrink_mode;
 	size_t max_capacity;
 	size_t max_size;
+	// Scales grows & delays shrinks from each container's si_realloc_stats_t.
+	bool is_adaptive;
 } si_realloc_settings_t;
 
+// Resize history of a single container. Zeroed is a valid initial state.
+typedef struct si_realloc_stats_t
+{
+	size_t grow_count;
+	size_t shrink_count;
+	// Bytes moved into a new buffer by resizes.
+	size_t bytes_copied;
+	size_t peak_capacity;
+	// Grows since the last shrink.
+	size_t grow_streak;
+} si_realloc_stats_t;
+
 /** Doxygen
  * @brief Initializes si_realloc_settings struct pointed at by p_settings.
  * @param p_settings Pointer to si_realloc_settings struct to be initialized
  */
 void si_realloc_settings_new(si_realloc_settings_t* p_settings);
 
+/** Doxygen
+ * @brief Initializes si_realloc_stats struct pointed at by p_stats.
+ * @param p_stats Pointer to si_realloc_stats struct to be zeroed.
+ */
+void si_realloc_stats_init(si_realloc_stats_t* p_stats);
+
+/** Doxygen
+ * @brief Records a resize that went from old_capacity to new_capacity.
+ *
+ * @param p_stats Pointer to si_realloc_stats struct to update. (NULL ok)
+ * @param old_capacity Capacity before the resize.
+ * @param new_capacity Capacity after the resize.
+ * @param bytes_copied Bytes moved into a new buffer by the resize.
+ */
+void si_realloc_stats_record(si_realloc_stats_t* p_stats,
+	const size_t old_capacity, const size_t new_capacity,
+	const size_t bytes_copied);
+
+/** Doxygen
+ * @brief Resizes p_array like si_array_resize() & records it into p_stats.
+ *
+ * @param p_stats Pointer to si_realloc_stats struct to update. (NULL ok)
+ * @param p_array Pointer to struct of allocated dynamic memory to resize.
+ * @param new_capacity Number of elements p_array is resized to hold.
+ *
+ * @return Returns true on success. False otherwise.
+ */
+bool si_realloc_stats_resize(si_realloc_stats_t* p_stats,
+	si_array_t* p_array, const size_t new_capacity);
+
+/** Doxygen
+ * @brief Writes the formatted data from si_realloc_stats struct to file.
+ *
+ * @param p_file Pointer to file to be written to.
+ * @param p_stats Pointer to si_realloc_stats struct to be printed.
+ */
+void si_realloc_stats_fprint(FILE* p_file, const si_realloc_stats_t* p_stats);
+
 /** Doxygen
  * @brief Finds the capacity of next grow with settings from current_capacity.
+ * @details Adaptive settings double the step for every grow in p_stats since
+ *          its last shrink, up to 2^SI_REALLOC_ADAPTIVE_MAX_SHIFT times.
  *
  * @param p_settings Pointer to si_realloc_settings struct on how to grow.
  * @param current_capacity What capacity the buffer is already at.
+ * @param p_stats Pointer to the container's resize history. (NULL ok)
  */
+size_t si_realloc_settings_next_grow_capacity_3(
+	const si_realloc_settings_t* p_settings, const size_t current_capacity,
+	const si_realloc_stats_t* p_stats);
 size_t si_realloc_settings_next_grow_capacity(
 	const si_realloc_settings_t* p_settings, const size_t current_capacity);
 
 /** Doxygen
  * @brief Find the capacity of next shrink with settings from current_capacity.
+ * @details Adaptive settings keep current_capacity until count fits
+ *          SI_REALLOC_ADAPTIVE_SHRINK_SLACK times into the smaller capacity.
  *
  * @param p_settings Pointer to si_realloc_settings struct on how to shrink.
  * @param current_capacity What capacity the buffer is already at.
+ * @param count Number of elements in use.
  */
+size_t si_realloc_settings_next_shrink_capacity_3(
+	const si_realloc_settings_t* p_settings, const size_t current_capacity,
+	const size_t count);
 size_t si_realloc_settings_next_shrink_capacity(
 	const si_realloc_settings_t* p_settings, const size_t current_capacity);
 
 /** Doxygen
  * @brief Increases the capacity of p_array by grow_value using grow_method.
  *
+ * @param p_settings Pointer to si_realloc_settings struct holding grow
+ *                   settings.
  * @param p_array Pointer to struct of allocated dynamic memory to be grown.
- * @param dynamics Pointer to si_realloc_settings struct holding grow settings.
+ * @param p_stats Pointer to the container's resize history. (NULL ok)
  *
  * @return Returns true on success. False otherwise.
  */
+bool si_realloc_settings_grow_3(const si_realloc_settings_t* p_settings,
+	si_array_t* p_array, si_realloc_stats_t* p_stats);
 bool si_realloc_settings_grow(
 	const si_realloc_settings_t* p_settings, si_array_t* p_array);
 
 /** Doxygen
  * @brief Lowers the capacity of p_array by shrink_value using shrink_method.
  *
+ * @param p_settings Pointer to si_realloc_settings struct holding shrink
+ *                   settings.
  * @param p_array Pointer to struct of allocated dynamic memory to be shrunk.
- * @param dynamics Pointer to si_dynamics struct holding shrink settings.
+ * @param count Number of elements in use. (0u skips adaptive hysteresis)
+ * @param p_stats Pointer to the container's resize history. (NULL ok)
  *
  * @return Returns true on success. False otherwise.
  */
+bool si_realloc_settings_shrink_4(const si_realloc_settings_t* p_settings,
+	si_array_t* p_array, const size_t count, si_realloc_stats_t* p_stats);
 bool si_realloc_settings_shrink(
 	const si_realloc_settings_t* p_settings, si_array_t* p_array);
 
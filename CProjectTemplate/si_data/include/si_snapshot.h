@@ -0,0 +1,316 @@
+/* si_snapshot.h
+ * Language: C
+ * Authors: ScorpionInc
+ * Purpose: Defines a versioned & checksummed binary snapshot format used to
+ *          save and reload si_array_t, si_parray_t, si_map_t & si_hashmap_t.
+ * Created: 20261019
+ * Updated: 20261019
+//*/
+
+/* File layout (all integers are written in host byte order):
+ * [si_snapshot_header_t]
+ * [si_snapshot_section_t][payload][zero padding to SI_SNAPSHOT_ALIGNMENT]
+ * ... repeated section_count times.
+ *
+ * Array payloads are the raw element bytes so they can be used directly from
+ * a memory mapped file. Pointer containers store a table of offsets (relative
+ * to the start of their payload) followed by the referenced value bytes.
+//*/
+
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t, uint32_t, uint64_t
+#include <stdio.h> // FILE, fwrite()
+#include <stdlib.h> // calloc(), free()
+#include <string.h> // memcpy()
+
+#include "si_array.h" // si_array_t
+#include "si_hashmap.h" // si_hashmap_t
+#include "si_map.h" // si_map_t
+#include "si_parray.h" // si_parray_t
+
+#ifndef SI_SNAPSHOT_H
+#define SI_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+#define SI_SNAPSHOT_MAGIC "SISS"
+#define SI_SNAPSHOT_VERSION (1u)
+#define SI_SNAPSHOT_ENDIAN_TAG (0x01020304UL)
+#define SI_SNAPSHOT_ALIGNMENT (16u)
+#define SI_SNAPSHOT_NULL_OFFSET (UINT64_MAX)
+
+typedef enum si_snapshot_type_t
+{
+	SI_SNAPSHOT_NONE    = 0,
+	SI_SNAPSHOT_ARRAY   = 1,
+	SI_SNAPSHOT_PARRAY  = 2,
+	SI_SNAPSHOT_MAP     = 3,
+	SI_SNAPSHOT_HASHMAP = 4,
+} si_snapshot_type_t;
+
+typedef struct si_snapshot_header_t
+{
+	uint8_t  magic[4];
+	uint16_t version;
+	uint16_t header_size;
+	uint32_t endian_tag;
+	uint32_t section_count;
+	uint32_t checksum;
+	uint32_t reserved;
+	uint64_t body_size;
+} si_snapshot_header_t;
+
+// element_size is the array element size or the hashmap bucket capacity.
+typedef struct si_snapshot_section_t
+{
+	uint32_t type;
+	uint32_t reserved;
+	uint64_t element_size;
+	uint64_t count;
+	uint64_t length;
+} si_snapshot_section_t;
+
+// Offset table entries of the pointer container payloads.
+typedef struct si_snapshot_blob_t
+{
+	uint64_t offset;
+	uint64_t size;
+} si_snapshot_blob_t;
+
+typedef struct si_snapshot_pair_t
+{
+	si_snapshot_blob_t key;
+	si_snapshot_blob_t value;
+} si_snapshot_pair_t;
+
+typedef struct si_snapshot_hash_entry_t
+{
+	uint64_t hash;
+	si_snapshot_blob_t value;
+} si_snapshot_hash_entry_t;
+
+// Returns the number of bytes to be saved from a value pointer.
+typedef size_t (*si_snapshot_size_f)(const void* const);
+
+
+typedef struct si_snapshot_writer_t
+{
+	FILE* p_file;
+	long start;
+	uint32_t section_count;
+	uint32_t sum_a;
+	uint32_t sum_b;
+	uint64_t body_size;
+} si_snapshot_writer_t;
+
+/** Doxygen
+ * @brief Begins a new snapshot at the current position of a FILE stream.
+ *
+ * @param p_writer Pointer to the writer struct to be initialized.
+ * @param p_file Pointer to a seekable FILE opened for binary writing.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_writer_init(si_snapshot_writer_t* const p_writer,
+	FILE* const p_file);
+
+/** Doxygen
+ * @brief Appends an array section holding the raw elements of a si_array_t.
+ *
+ * @param p_writer Pointer to an initialized snapshot writer.
+ * @param p_array Pointer to the array to be saved.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_write_array(si_snapshot_writer_t* const p_writer,
+	const si_array_t* const p_array);
+
+/** Doxygen
+ * @brief Appends a pointer array section holding copies of its values.
+ *
+ * @param p_writer Pointer to an initialized snapshot writer.
+ * @param p_parray Pointer to the pointer array to be saved.
+ * @param p_size_f Function returning the byte size of each value.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_write_parray(si_snapshot_writer_t* const p_writer,
+	const si_parray_t* const p_parray, si_snapshot_size_f p_size_f);
+
+/** Doxygen
+ * @brief Appends a map section holding copies of its keys and values.
+ *
+ * @param p_writer Pointer to an initialized snapshot writer.
+ * @param p_map Pointer to the map to be saved.
+ * @param p_key_size_f Function returning the byte size of each key.
+ * @param p_value_size_f Function returning the byte size of each value.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_write_map(si_snapshot_writer_t* const p_writer,
+	const si_map_t* const p_map, si_snapshot_size_f p_key_size_f,
+	si_snapshot_size_f p_value_size_f);
+
+/** Doxygen
+ * @brief Appends a hashmap section holding its hashes and value copies.
+ *
+ * @param p_writer Pointer to an initialized snapshot writer.
+ * @param p_hashmap Pointer to the hashmap to be saved.
+ * @param p_value_size_f Function returning the byte size of each value.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_write_hashmap(si_snapshot_writer_t* const p_writer,
+	const si_hashmap_t* const p_hashmap, si_snapshot_size_f p_value_size_f);
+
+/** Doxygen
+ * @brief Completes a snapshot by writing its final header and checksum.
+ *
+ * @param p_writer Pointer to the snapshot writer to be finished.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_writer_finish(si_snapshot_writer_t* const p_writer);
+
+
+typedef struct si_snapshot_t
+{
+	uint8_t* p_data;
+	size_t size;
+	bool is_mapped;
+	// Set when p_data was allocated by si_snapshot_open() & is freed with it.
+	bool is_owned;
+	si_array_t sections;
+} si_snapshot_t;
+
+/** Doxygen
+ * @brief Maps (or reads) a snapshot file into memory and validates it.
+ *
+ * @param p_snapshot Pointer to the snapshot struct to be initialized.
+ * @param p_path String path of the snapshot file to be opened.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_open(si_snapshot_t* const p_snapshot,
+	const char* const p_path);
+
+/** Doxygen
+ * @brief Validates a snapshot from a memory buffer. Buffer is not copied.
+ *
+ * @param p_snapshot Pointer to the snapshot struct to be initialized.
+ * @param p_buffer Pointer to the snapshot bytes. Must outlive p_snapshot.
+ * @param size Number of bytes in the buffer.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_open_buffer(si_snapshot_t* const p_snapshot,
+	const void* const p_buffer, const size_t size);
+
+/** Doxygen
+ * @brief Returns the number of sections within an opened snapshot.
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ *
+ * @return Returns section count on success. Returns 0u otherwise.
+ */
+size_t si_snapshot_count(const si_snapshot_t* const p_snapshot);
+
+/** Doxygen
+ * @brief Gets the header of a section by its index.
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of the section in the order it was written.
+ *
+ * @return Returns pointer into the snapshot on success. Returns NULL otherwise.
+ */
+const si_snapshot_section_t* si_snapshot_section_at(
+	const si_snapshot_t* const p_snapshot, const size_t index);
+
+/** Doxygen
+ * @brief Zero-copy access to the elements of an array section.
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of an array section.
+ * @param p_count Optional pointer set to the element count.
+ *
+ * @return Returns pointer to the first element on success. NULL otherwise.
+ */
+const void* si_snapshot_array_data(const si_snapshot_t* const p_snapshot,
+	const size_t index, size_t* const p_count);
+
+/** Doxygen
+ * @brief Loads an array section into a new buffer of an uninitialized array.
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of an array section.
+ * @param p_array Pointer to the array to be initialized with the section.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_snapshot_load_array(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_array_t* const p_array);
+
+/** Doxygen
+ * @brief Loads a pointer array section. Values are heap copies freed by free()
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of a pointer array section.
+ * @param p_parray Pointer to the pointer array to be initialized.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise, a partly
+ *         loaded pointer array is freed along with its values.
+ */
+bool si_snapshot_load_parray(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_parray_t* const p_parray);
+
+/** Doxygen
+ * @brief Loads a map section into an initialized, empty map. Keys & values
+ *        are heap copies and the map's free functions are set to free().
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of a map section.
+ * @param p_map Pointer to the initialized map (compare functions kept).
+ *
+ * @return Returns stdbool true on success. Returns false otherwise, loaded
+ *         pairs are freed & the map's capacity & free functions restored.
+ */
+bool si_snapshot_load_map(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_map_t* const p_map);
+
+/** Doxygen
+ * @brief Loads a hashmap section. Values are heap copies freed by the map.
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of a hashmap section.
+ * @param p_hashmap Pointer to the zeroed hashmap to be initialized.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise, a partly
+ *         loaded hashmap is freed along with its values.
+ */
+bool si_snapshot_load_hashmap(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_hashmap_t* const p_hashmap);
+
+/** Doxygen
+ * @brief Releases the memory mapping or buffer of an opened snapshot.
+ *
+ * @param p_snapshot Pointer to the snapshot to be closed.
+ */
+void si_snapshot_free(si_snapshot_t* const p_snapshot);
+
+/** Doxygen
+ * @brief Writes snapshot header/sections to a FILE stream. Used to debug.
+ *
+ * @param p_file Pointer to the FILE to be written to.
+ * @param p_snapshot Pointer to the opened snapshot to be printed.
+ */
+void si_snapshot_fprint(FILE* const p_file,
+	const si_snapshot_t* const p_snapshot);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_SNAPSHOT_H
@@ -13,6 +13,10 @@ typedef struct si_stack_t
 	size_t count;
 	si_realloc_settings_t settings;
 	si_array_t dynamic;
+	// Resize history, drives adaptive settings.
+	si_realloc_stats_t stats;
+	// Caller owned storage used before spilling to the heap. (Optional)
+	void* p_inline;
 } si_stack_t;
 
 /** Doxygen
@@ -29,6 +33,32 @@ void si_stack_new_3(si_stack_t* p_stack, const size_t element_size,
 	const size_t initial_capacity);
 void si_stack_new(si_stack_t* p_stack, const size_t element_size);
 
+/** Doxygen
+ * @brief Initializes a si_stack struct that stores items in p_buffer until it
+ *        is full, only then spilling onto the heap.
+ *
+ * @param p_stack Pointer to the struct to be initialized.
+ * @param element_size Size in bytes of the items to be stacked.
+ * @param p_buffer Caller owned storage for buffer_capacity items. Must outlive
+ *                 the stack.
+ * @param buffer_capacity Number of items p_buffer can hold.
+ * @param p_settings Pointer to si_realloc_settings to read from.
+ */
+void si_stack_init_inline_5(si_stack_t* p_stack, const size_t element_size,
+	void* const p_buffer, const size_t buffer_capacity,
+	const si_realloc_settings_t* p_settings);
+void si_stack_init_inline(si_stack_t* p_stack, const size_t element_size,
+	void* const p_buffer, const size_t buffer_capacity);
+
+/** Doxygen
+ * @brief Determines if the items are currently stored in the inline buffer.
+ *
+ * @param p_stack Pointer to the si_stack struct to check.
+ *
+ * @return Returns true if no heap memory is in use. False otherwise.
+ */
+bool si_stack_is_inline(const si_stack_t* p_stack);
+
 /** Doxygen
  * @brief Determines if the allocated memory is currently full or not.
  *
@@ -2,6 +2,10 @@
 
 #include "si_array.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (2 <= _M_IX86_FP))
+#include <emmintrin.h> // _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#endif// SSE2
+
 #ifdef __cplusplus
 extern "C" {
 #endif //__cplusplus
@@ -268,6 +272,815 @@ END:
 	return;
 }
 
+/** Doxygen
+ * @brief Validates a range of elements lies within the buffer.
+ *
+ * @param p_array Pointer to si_array_t struct to be bounds checked.
+ * @param index Index of the first element in the range.
+ * @param count Number of elements in the range.
+ * @param p_offset Pointer set to the byte offset of index.
+ * @param p_bytes Pointer set to the byte length of the range.
+ *
+ * @return Returns stdbool true if range is valid. Returns false otherwise.
+ */
+static bool si_array_range_bytes(const si_array_t* const p_array,
+	const size_t index, const size_t count, size_t* const p_offset,
+	size_t* const p_bytes)
+{
+	bool result = false;
+	if ((NULL == p_array) || (NULL == p_offset) || (NULL == p_bytes))
+	{
+		goto END;
+	}
+	if ((index > p_array->capacity) || (count > (p_array->capacity - index)))
+	{
+		goto END;
+	}
+	// si_array_size() verifies capacity * element_size doesn't overflow.
+	if ((0u < p_array->capacity) && (0u >= si_array_size(p_array)))
+	{
+		goto END;
+	}
+	*p_offset = index * p_array->element_size;
+	*p_bytes = count * p_array->element_size;
+	result = true;
+END:
+	return result;
+}
+
+bool si_array_set_range(si_array_t* const p_array, const size_t index,
+	const void* const p_items, const size_t count)
+{
+	bool result = false;
+	size_t offset = 0u;
+	size_t bytes = 0u;
+	if (NULL == p_items)
+	{
+		goto END;
+	}
+	if (true != si_array_range_bytes(p_array, index, count, &offset, &bytes))
+	{
+		goto END;
+	}
+	if (0u < bytes)
+	{
+		memmove(((uint8_t*)p_array->p_data) + offset, p_items, bytes);
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_array_get_range(const si_array_t* const p_array, const size_t index,
+	void* const p_items, const size_t count)
+{
+	bool result = false;
+	size_t offset = 0u;
+	size_t bytes = 0u;
+	if (NULL == p_items)
+	{
+		goto END;
+	}
+	if (true != si_array_range_bytes(p_array, index, count, &offset, &bytes))
+	{
+		goto END;
+	}
+	if (0u < bytes)
+	{
+		memmove(p_items, ((const uint8_t*)p_array->p_data) + offset, bytes);
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_array_fill(si_array_t* const p_array, const size_t index,
+	const void* const p_item, const size_t count)
+{
+	bool result = false;
+	size_t offset = 0u;
+	size_t bytes = 0u;
+	if (NULL == p_item)
+	{
+		goto END;
+	}
+	if (true != si_array_range_bytes(p_array, index, count, &offset, &bytes))
+	{
+		goto END;
+	}
+	if (0u >= bytes)
+	{
+		result = true;
+		goto END;
+	}
+	uint8_t* const p_start = ((uint8_t*)p_array->p_data) + offset;
+	const uint8_t* const p_bytes = p_item;
+	bool is_uniform = true;
+	for (size_t iii = 1u; iii < p_array->element_size; iii++)
+	{
+		if (p_bytes[iii] != p_bytes[0])
+		{
+			is_uniform = false;
+			break;
+		}
+	}
+	if (true == is_uniform)
+	{
+		// Single byte pattern (E.G. zeroing)
+		memset(p_start, p_bytes[0], bytes);
+		result = true;
+		goto END;
+	}
+	// Copy the first element then double the filled span each pass.
+	memmove(p_start, p_item, p_array->element_size);
+	size_t filled = p_array->element_size;
+	while (filled < bytes)
+	{
+		const size_t next = ((bytes - filled) < filled) ?
+			(bytes - filled) : filled;
+		memcpy(p_start + filled, p_start, next);
+		filled += next;
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_array_insert_range(si_array_t* const p_array, const size_t index,
+	const void* const p_items, const size_t count)
+{
+	bool result = false;
+	if ((NULL == p_array) || (NULL == p_items))
+	{
+		goto END;
+	}
+	if ((index > p_array->capacity) || (0u >= p_array->element_size))
+	{
+		goto END;
+	}
+	if (0u >= count)
+	{
+		result = true;
+		goto END;
+	}
+	if ((SIZE_MAX - p_array->capacity) < count)
+	{
+		goto END;
+	}
+	const size_t old_capacity = p_array->capacity;
+	const size_t bytes = count * p_array->element_size;
+	if ((bytes / p_array->element_size) != count)
+	{
+		goto END;
+	}
+	// Items within the buffer would move or be shifted by the resize.
+	void* p_copy = NULL;
+	const void* p_source = p_items;
+	if (true == si_array_is_pointer_within(p_array, p_items))
+	{
+		p_copy = malloc(bytes);
+		if (NULL == p_copy)
+		{
+			goto END;
+		}
+		memcpy(p_copy, p_items, bytes);
+		p_source = p_copy;
+	}
+	if (true != si_array_resize(p_array, old_capacity + count))
+	{
+		free(p_copy);
+		goto END;
+	}
+	uint8_t* const p_at = ((uint8_t*)p_array->p_data) +
+		(index * p_array->element_size);
+	const size_t tail = (old_capacity - index) * p_array->element_size;
+	if (0u < tail)
+	{
+		memmove(p_at + bytes, p_at, tail);
+	}
+	memcpy(p_at, p_source, bytes);
+	free(p_copy);
+	p_copy = NULL;
+	result = true;
+END:
+	return result;
+}
+
+bool si_array_erase_range(si_array_t* const p_array, const size_t index,
+	const size_t count)
+{
+	bool result = false;
+	size_t offset = 0u;
+	size_t bytes = 0u;
+	if (true != si_array_range_bytes(p_array, index, count, &offset, &bytes))
+	{
+		goto END;
+	}
+	if (0u >= count)
+	{
+		result = true;
+		goto END;
+	}
+	uint8_t* const p_at = ((uint8_t*)p_array->p_data) + offset;
+	const size_t tail = si_array_size(p_array) - (offset + bytes);
+	if (0u < tail)
+	{
+		memmove(p_at, p_at + bytes, tail);
+	}
+	result = si_array_resize(p_array, p_array->capacity - count);
+END:
+	return result;
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (2 <= _M_IX86_FP))
+/** Doxygen
+ * @brief Scans 16 byte blocks for a 1, 2, 4 or 8 byte value using SSE2.
+ *
+ * @param p_start Pointer to the first element to be compared.
+ * @param count Number of elements to be compared.
+ * @param p_item Pointer to the element value to search for.
+ * @param element_size Size of each element. One of 1, 2, 4 or 8.
+ * @param p_index Pointer set to the index (relative to p_start) when found.
+ *
+ * @return Returns number of elements scanned without finding a match.
+ */
+static size_t si_array_find_sse2(const uint8_t* const p_start,
+	const size_t count, const void* const p_item, const size_t element_size,
+	size_t* const p_index)
+{
+	__m128i needle;
+	switch (element_size)
+	{
+	case 1u:
+		needle = _mm_set1_epi8(*((const char*)p_item));
+		break;
+	case 2u:
+	{
+		int16_t value = 0;
+		memcpy(&value, p_item, sizeof(value));
+		needle = _mm_set1_epi16(value);
+		break;
+	}
+	case 4u:
+	{
+		int32_t value = 0;
+		memcpy(&value, p_item, sizeof(value));
+		needle = _mm_set1_epi32(value);
+		break;
+	}
+	default:
+	{
+		int64_t value = 0;
+		memcpy(&value, p_item, sizeof(value));
+		needle = _mm_set1_epi64x(value);
+		break;
+	}
+	}
+	const size_t per_block = 16u / element_size;
+	size_t scanned = 0u;
+	while ((count - scanned) >= per_block)
+	{
+		const __m128i block = _mm_loadu_si128(
+			(const __m128i*)(p_start + (scanned * element_size))
+		);
+		__m128i equal;
+		switch (element_size)
+		{
+		case 1u:
+			equal = _mm_cmpeq_epi8(block, needle);
+			break;
+		case 2u:
+			equal = _mm_cmpeq_epi16(block, needle);
+			break;
+		case 4u:
+			equal = _mm_cmpeq_epi32(block, needle);
+			break;
+		default:
+			// SSE2 lacks cmpeq_epi64, both 32-bit halves must match.
+			equal = _mm_cmpeq_epi32(block, needle);
+			equal = _mm_and_si128(
+				equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))
+			);
+			break;
+		}
+		const unsigned int mask = (unsigned int)_mm_movemask_epi8(equal);
+		if (0u != mask)
+		{
+			unsigned int bit = 0u;
+			while (0u == ((mask >> bit) & 1u))
+			{
+				bit++;
+			}
+			*p_index = scanned + (bit / element_size);
+			goto END;
+		}
+		scanned += per_block;
+	}
+END:
+	return scanned;
+}
+#define SI_ARRAY_FIND_SIMD si_array_find_sse2
+#endif// SSE2
+
+size_t si_array_find_3(const si_array_t* const p_array,
+	const void* const p_item, const size_t start)
+{
+	size_t result = SIZE_MAX;
+	if ((NULL == p_array) || (NULL == p_item) || (NULL == p_array->p_data))
+	{
+		goto END;
+	}
+	if ((start >= p_array->capacity) || (0u >= p_array->element_size))
+	{
+		goto END;
+	}
+	const size_t element_size = p_array->element_size;
+	const uint8_t* const p_start = ((const uint8_t*)p_array->p_data) +
+		(start * element_size);
+	const size_t count = p_array->capacity - start;
+	size_t scanned = 0u;
+	if (1u == element_size)
+	{
+		// libc's memchr() is already vectorized.
+		const uint8_t* const p_found = memchr(
+			p_start, *((const uint8_t*)p_item), count
+		);
+		if (NULL != p_found)
+		{
+			result = start + (size_t)(p_found - p_start);
+		}
+		goto END;
+	}
+#ifdef SI_ARRAY_FIND_SIMD
+	if ((2u == element_size) || (4u == element_size) || (8u == element_size))
+	{
+		size_t found = SIZE_MAX;
+		scanned = SI_ARRAY_FIND_SIMD(
+			p_start, count, p_item, element_size, &found
+		);
+		if (SIZE_MAX != found)
+		{
+			result = start + found;
+			goto END;
+		}
+	}
+#endif// SI_ARRAY_FIND_SIMD
+	for (size_t iii = scanned; iii < count; iii++)
+	{
+		if (0 == memcmp(p_start + (iii * element_size), p_item, element_size))
+		{
+			result = start + iii;
+			break;
+		}
+	}
+END:
+	return result;
+}
+inline size_t si_array_find(const si_array_t* const p_array,
+	const void* const p_item)
+{
+	// Default value of start is 0u
+	return si_array_find_3(p_array, p_item, 0u);
+}
+
+// Swaps size bytes between two non-overlapping elements, a word at a time.
+static inline void si_array_swap_bytes(uint8_t* p_left, uint8_t* p_right,
+	size_t size)
+{
+	while (sizeof(uint64_t) <= size)
+	{
+		uint64_t word = 0u;
+		memcpy(&word, p_left, sizeof(uint64_t));
+		memcpy(p_left, p_right, sizeof(uint64_t));
+		memcpy(p_right, &word, sizeof(uint64_t));
+		p_left += sizeof(uint64_t);
+		p_right += sizeof(uint64_t);
+		size -= sizeof(uint64_t);
+	}
+	while (0u < size)
+	{
+		const uint8_t byte = *p_left;
+		*p_left++ = *p_right;
+		*p_right++ = byte;
+		size--;
+	}
+}
+
+// Ranges at or below this many elements are finished with insertion sort.
+#define SI_ARRAY_SORT_INSERTION_MAX (16u)
+
+static void si_array_insertion_sort(uint8_t* const p_data, const size_t count,
+	const size_t element_size,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	for (size_t iii = 1u; iii < count; iii++)
+	{
+		size_t jjj = iii;
+		while ((0u < jjj) && (0 < p_cmp_f(
+			p_data + ((jjj - 1u) * element_size), p_data + (jjj * element_size)
+		)))
+		{
+			si_array_swap_bytes(
+				p_data + ((jjj - 1u) * element_size),
+				p_data + (jjj * element_size), element_size
+			);
+			jjj--;
+		}
+	}
+}
+
+static void si_array_heap_sift(uint8_t* const p_data, size_t root,
+	const size_t count, const size_t element_size,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	for (;;)
+	{
+		size_t child = (2u * root) + 1u;
+		if (child >= count)
+		{
+			break;
+		}
+		if (((child + 1u) < count) && (0 > p_cmp_f(
+			p_data + (child * element_size),
+			p_data + ((child + 1u) * element_size)
+		)))
+		{
+			child++;
+		}
+		if (0 <= p_cmp_f(
+			p_data + (root * element_size), p_data + (child * element_size)
+		))
+		{
+			break;
+		}
+		si_array_swap_bytes(
+			p_data + (root * element_size), p_data + (child * element_size),
+			element_size
+		);
+		root = child;
+	}
+}
+
+static void si_array_heap_sort(uint8_t* const p_data, const size_t count,
+	const size_t element_size,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	for (size_t iii = count / 2u; iii > 0u; iii--)
+	{
+		si_array_heap_sift(p_data, iii - 1u, count, element_size, p_cmp_f);
+	}
+	for (size_t iii = count; iii > 1u; iii--)
+	{
+		si_array_swap_bytes(
+			p_data, p_data + ((iii - 1u) * element_size), element_size
+		);
+		si_array_heap_sift(p_data, 0u, iii - 1u, element_size, p_cmp_f);
+	}
+}
+
+// Moves the median of the first, middle & last elements to the front and
+// returns the final index of that pivot after partitioning.
+static size_t si_array_partition(uint8_t* const p_data, const size_t count,
+	const size_t element_size,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	uint8_t* const p_first = p_data;
+	uint8_t* const p_middle = p_data + ((count / 2u) * element_size);
+	uint8_t* const p_last = p_data + ((count - 1u) * element_size);
+	if (0 < p_cmp_f(p_first, p_middle))
+	{
+		si_array_swap_bytes(p_first, p_middle, element_size);
+	}
+	if (0 < p_cmp_f(p_middle, p_last))
+	{
+		si_array_swap_bytes(p_middle, p_last, element_size);
+		if (0 < p_cmp_f(p_first, p_middle))
+		{
+			si_array_swap_bytes(p_first, p_middle, element_size);
+		}
+	}
+	si_array_swap_bytes(p_first, p_middle, element_size);
+	// Pivot now lives at index 0 and stops the right hand scan.
+	size_t left = 0u;
+	size_t right = count;
+	for (;;)
+	{
+		do
+		{
+			left++;
+		} while ((left < (count - 1u)) &&
+			(0 > p_cmp_f(p_data + (left * element_size), p_first)));
+		do
+		{
+			right--;
+		} while (0 > p_cmp_f(p_first, p_data + (right * element_size)));
+		if (left >= right)
+		{
+			break;
+		}
+		si_array_swap_bytes(
+			p_data + (left * element_size), p_data + (right * element_size),
+			element_size
+		);
+	}
+	si_array_swap_bytes(p_first, p_data + (right * element_size), element_size);
+	return right;
+}
+
+static void si_array_introsort(uint8_t* p_data, size_t count,
+	const size_t element_size, size_t depth_limit,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	while (SI_ARRAY_SORT_INSERTION_MAX < count)
+	{
+		if (0u == depth_limit)
+		{
+			si_array_heap_sort(p_data, count, element_size, p_cmp_f);
+			return;
+		}
+		depth_limit--;
+		const size_t pivot = si_array_partition(
+			p_data, count, element_size, p_cmp_f
+		);
+		const size_t left_count = pivot;
+		const size_t right_count = count - pivot - 1u;
+		uint8_t* const p_right = p_data + ((pivot + 1u) * element_size);
+		// Recurse into the smaller side to bound stack depth by log2(count).
+		if (left_count < right_count)
+		{
+			si_array_introsort(
+				p_data, left_count, element_size, depth_limit, p_cmp_f
+			);
+			p_data = p_right;
+			count = right_count;
+		}
+		else
+		{
+			si_array_introsort(
+				p_right, right_count, element_size, depth_limit, p_cmp_f
+			);
+			count = left_count;
+		}
+	}
+	si_array_insertion_sort(p_data, count, element_size, p_cmp_f);
+}
+
+bool si_array_sort(si_array_t* const p_array,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	bool result = false;
+	if ((NULL == p_array) || (NULL == p_cmp_f))
+	{
+		goto END;
+	}
+	if (0u >= p_array->element_size)
+	{
+		goto END;
+	}
+	if (2u > p_array->capacity)
+	{
+		result = true;
+		goto END;
+	}
+	if (NULL == p_array->p_data)
+	{
+		goto END;
+	}
+	size_t depth_limit = 0u;
+	for (size_t remaining = p_array->capacity; 1u < remaining; remaining >>= 1u)
+	{
+		depth_limit += 2u;
+	}
+	si_array_introsort(
+		p_array->p_data, p_array->capacity, p_array->element_size,
+		depth_limit, p_cmp_f
+	);
+	result = true;
+END:
+	return result;
+}
+
+// Reads a key_size byte host-endian unsigned integer.
+static inline uint64_t si_array_radix_key(const uint8_t* const p_key,
+	const size_t key_size)
+{
+	uint64_t result = 0u;
+	switch (key_size)
+	{
+	case sizeof(uint8_t):
+		result = *p_key;
+		break;
+	case sizeof(uint16_t):
+	{
+		uint16_t value = 0u;
+		memcpy(&value, p_key, sizeof(value));
+		result = value;
+		break;
+	}
+	case sizeof(uint32_t):
+	{
+		uint32_t value = 0u;
+		memcpy(&value, p_key, sizeof(value));
+		result = value;
+		break;
+	}
+	default:
+		memcpy(&result, p_key, sizeof(result));
+		break;
+	}
+	return result;
+}
+
+// Copies one element, letting the compiler inline the common sizes.
+static inline void si_array_radix_copy(uint8_t* const p_dst,
+	const uint8_t* const p_src, const size_t element_size)
+{
+	switch (element_size)
+	{
+	case sizeof(uint32_t):
+		memcpy(p_dst, p_src, sizeof(uint32_t));
+		break;
+	case sizeof(uint64_t):
+		memcpy(p_dst, p_src, sizeof(uint64_t));
+		break;
+	case 2u * sizeof(uint64_t):
+		memcpy(p_dst, p_src, 2u * sizeof(uint64_t));
+		break;
+	default:
+		memcpy(p_dst, p_src, element_size);
+		break;
+	}
+}
+
+bool si_array_sort_radix_4(si_array_t* const p_array, const size_t key_offset,
+	const size_t key_size, const bool is_signed)
+{
+	bool result = false;
+	uint8_t* p_scratch = NULL;
+	size_t* p_counts = NULL;
+	if (NULL == p_array)
+	{
+		goto END;
+	}
+	if ((sizeof(uint8_t) != key_size) && (sizeof(uint16_t) != key_size) &&
+		(sizeof(uint32_t) != key_size) && (sizeof(uint64_t) != key_size))
+	{
+		goto END;
+	}
+	const size_t element_size = p_array->element_size;
+	if ((key_offset >= element_size) || (key_size > (element_size - key_offset)))
+	{
+		goto END;
+	}
+	const size_t count = p_array->capacity;
+	if (2u > count)
+	{
+		result = true;
+		goto END;
+	}
+	if (NULL == p_array->p_data)
+	{
+		goto END;
+	}
+	p_scratch = malloc(count * element_size);
+	p_counts = calloc(key_size * 256u, sizeof(size_t));
+	if ((NULL == p_scratch) || (NULL == p_counts))
+	{
+		goto END;
+	}
+	const uint64_t sign_flip = is_signed ?
+		(UINT64_C(1) << ((key_size * 8u) - 1u)) : 0u;
+	uint8_t* p_source = p_array->p_data;
+	uint8_t* p_destination = p_scratch;
+	// Build every digit's histogram in a single pass over the keys.
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const uint64_t key = sign_flip ^ si_array_radix_key(
+			p_source + (iii * element_size) + key_offset, key_size
+		);
+		for (size_t digit = 0u; digit < key_size; digit++)
+		{
+			p_counts[(digit * 256u) + ((key >> (digit * 8u)) & 0xFFu)]++;
+		}
+	}
+	for (size_t digit = 0u; digit < key_size; digit++)
+	{
+		size_t* const p_digit_counts = p_counts + (digit * 256u);
+		// Every key shares this byte, so the pass would be a plain copy.
+		const uint64_t first_key = sign_flip ^ si_array_radix_key(
+			p_source + key_offset, key_size
+		);
+		if (count == p_digit_counts[(first_key >> (digit * 8u)) & 0xFFu])
+		{
+			continue;
+		}
+		size_t offset = 0u;
+		for (size_t bucket = 0u; bucket < 256u; bucket++)
+		{
+			const size_t bucket_count = p_digit_counts[bucket];
+			p_digit_counts[bucket] = offset;
+			offset += bucket_count;
+		}
+		for (size_t iii = 0u; iii < count; iii++)
+		{
+			const uint8_t* const p_element = p_source + (iii * element_size);
+			const uint64_t key = sign_flip ^ si_array_radix_key(
+				p_element + key_offset, key_size
+			);
+			const size_t bucket = (size_t)((key >> (digit * 8u)) & 0xFFu);
+			si_array_radix_copy(
+				p_destination + (p_digit_counts[bucket] * element_size),
+				p_element, element_size
+			);
+			p_digit_counts[bucket]++;
+		}
+		uint8_t* const p_swap = p_source;
+		p_source = p_destination;
+		p_destination = p_swap;
+	}
+	if (p_source != p_array->p_data)
+	{
+		memcpy(p_array->p_data, p_source, count * element_size);
+	}
+	result = true;
+END:
+	free(p_counts);
+	p_counts = NULL;
+	free(p_scratch);
+	p_scratch = NULL;
+	return result;
+}
+inline bool si_array_sort_radix_2(si_array_t* const p_array,
+	const bool is_signed)
+{
+	// Default value of key_offset is 0u
+	// Default value of key_size is element_size
+	if (NULL == p_array)
+	{
+		return false;
+	}
+	return si_array_sort_radix_4(
+		p_array, 0u, p_array->element_size, is_signed
+	);
+}
+inline bool si_array_sort_radix(si_array_t* const p_array)
+{
+	// Default value of is_signed is false
+	return si_array_sort_radix_2(p_array, false);
+}
+
+size_t si_array_lower_bound(const si_array_t* const p_array,
+	const void* const p_key,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	size_t result = SIZE_MAX;
+	if ((NULL == p_array) || (NULL == p_key) || (NULL == p_cmp_f))
+	{
+		goto END;
+	}
+	if ((NULL == p_array->p_data) && (0u < p_array->capacity))
+	{
+		goto END;
+	}
+	const uint8_t* const p_data = p_array->p_data;
+	size_t low = 0u;
+	size_t count = p_array->capacity;
+	while (0u < count)
+	{
+		const size_t half = count / 2u;
+		if (0 > p_cmp_f(p_data + ((low + half) * p_array->element_size), p_key))
+		{
+			low += half + 1u;
+			count -= half + 1u;
+		}
+		else
+		{
+			count = half;
+		}
+	}
+	result = low;
+END:
+	return result;
+}
+
+size_t si_array_bsearch(const si_array_t* const p_array,
+	const void* const p_key,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	size_t result = si_array_lower_bound(p_array, p_key, p_cmp_f);
+	if ((SIZE_MAX == result) || (result >= p_array->capacity))
+	{
+		result = SIZE_MAX;
+		goto END;
+	}
+	if (0 != p_cmp_f(si_array_at(p_array, result), p_key))
+	{
+		result = SIZE_MAX;
+	}
+END:
+	return result;
+}
+
 bool si_array_swp(si_array_t* const p_array,
 	const size_t left, const size_t right)
 {
@@ -11,6 +11,7 @@ void si_parray_init_2(si_parray_t* const p_array,
 	p_array->p_free_value = NULL;
 	p_array->p_settings = NULL;
 	si_array_init_3(&(p_array->array), sizeof(void*), initial_capacity);
+	si_realloc_stats_init(&(p_array->stats));
 END:
 	return;
 }
@@ -80,7 +81,9 @@ bool si_parray_fit(si_parray_t* const p_array)
 		goto END;
 	}
 	const size_t count = si_parray_count(p_array);
-	result = si_array_resize(&(p_array->array), count);
+	result = si_realloc_stats_resize(
+		&(p_array->stats), &(p_array->array), count
+	);
 END:
 	return result;
 }
@@ -275,17 +278,20 @@ static bool handle_shrink(si_parray_t* const p_array)
 	else
 	{
 		const size_t count = si_parray_count(p_array);
-		const size_t next_capacity = si_realloc_settings_next_shrink_capacity(
+		const size_t next_capacity = si_realloc_settings_next_shrink_capacity_3(
 			p_array->p_settings,
-			p_array->array.capacity
+			p_array->array.capacity,
+			count
 		);
 		if (next_capacity < count)
 		{
 			goto END;
 		}
-		result = si_realloc_settings_shrink(
+		result = si_realloc_settings_shrink_4(
 			p_array->p_settings,
-			&(p_array->array)
+			&(p_array->array),
+			count,
+			&(p_array->stats)
 		);
 	}
 END:
@@ -306,17 +312,18 @@ bool si_parray_remove_at(si_parray_t* const p_array, const size_t index)
 		// index or array is invalid
 		goto END;
 	}
-	if (NULL != p_array->p_free_value)
-	{
-		p_array->p_free_value(*pp_target);
-		*pp_target = NULL;
-	}
+	// Find the tail before the target slot is cleared, count stops at NULL.
 	void** const pp_tail = si_parray_tail(p_array);
 	if (NULL == pp_tail)
 	{
 		// Array is empty
 		goto END;
 	}
+	if (NULL != p_array->p_free_value)
+	{
+		p_array->p_free_value(*pp_target);
+		*pp_target = NULL;
+	}
 	void** pp_next = NULL;
 	while (pp_target != pp_tail)
 	{
@@ -335,11 +342,7 @@ bool si_parray_remove_at(si_parray_t* const p_array, const size_t index)
 		}
 		counter++;
 	}
-	// Remove tail
-	if (NULL != p_array->p_free_value)
-	{
-		p_array->p_free_value(*pp_tail);
-	}
+	// Remove tail, its value was shifted left so must not be freed.
 	*pp_tail = NULL;
 	handle_shrink(p_array);
 	result = true;
@@ -502,13 +505,16 @@ size_t si_parray_append(si_parray_t* const p_array, const void* const p_value)
 		bool did_grow = false;
 		if (NULL == p_array->p_settings)
 		{
-			did_grow = si_array_resize(&(p_array->array), count + 1u);
+			did_grow = si_realloc_stats_resize(
+				&(p_array->stats), &(p_array->array), count + 1u
+			);
 		}
 		else
 		{
-			did_grow = si_realloc_settings_grow(
+			did_grow = si_realloc_settings_grow_3(
 				p_array->p_settings,
-				&(p_array->array)
+				&(p_array->array),
+				&(p_array->stats)
 			);
 		}
 		if (false == did_grow)
@@ -1,5 +1,6 @@
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "si_queue.h"
@@ -14,7 +15,9 @@ void si_queue_init_4(si_queue_t* const p_queue, const size_t element_size,
 	p_queue->front = 0u;
 	p_queue->back  = 0u;
 	p_queue->p_settings = p_settings;
+	p_queue->p_inline = NULL;
 	p_queue->array = (si_array_t){0};
+	si_realloc_stats_init(&(p_queue->stats));
 	si_array_init_3(
 		&(p_queue->array), element_size, (initial_capacity + 1u)
 	);
@@ -33,6 +36,42 @@ inline void si_queue_init(si_queue_t* const p_queue, const size_t element_size)
 	si_queue_init_3(p_queue, element_size, 0u);
 }
 
+void si_queue_init_inline_5(si_queue_t* const p_queue,
+	const size_t element_size, void* const p_buffer,
+	const size_t buffer_capacity, const si_realloc_settings_t* p_settings)
+{
+	if (NULL == p_queue)
+	{
+		goto END;
+	}
+	if ((NULL == p_buffer) || (2u > buffer_capacity))
+	{
+		// Too small to hold an item, fall back to the heap.
+		si_queue_init_4(p_queue, element_size, 0u, p_settings);
+		goto END;
+	}
+	p_queue->front = 0u;
+	p_queue->back  = 0u;
+	p_queue->p_settings = p_settings;
+	p_queue->p_inline = p_buffer;
+	p_queue->array = (si_array_t){0};
+	si_realloc_stats_init(&(p_queue->stats));
+	p_queue->array.p_data = p_buffer;
+	p_queue->array.element_size = element_size;
+	p_queue->array.capacity = buffer_capacity;
+END:
+	return;
+}
+inline void si_queue_init_inline(si_queue_t* const p_queue,
+	const size_t element_size, void* const p_buffer,
+	const size_t buffer_capacity)
+{
+	// Default p_settings value is NULL (initializes with defaults)
+	si_queue_init_inline_5(
+		p_queue, element_size, p_buffer, buffer_capacity, NULL
+	);
+}
+
 si_queue_t* si_queue_new_3(const size_t element_size,
 	const size_t initial_capacity, const si_realloc_settings_t* p_settings)
 {
@@ -96,6 +135,19 @@ END:
 	return result;
 }
 
+bool si_queue_is_inline(const si_queue_t* const p_queue)
+{
+	bool is_inline = false;
+	if (NULL == p_queue)
+	{
+		goto END;
+	}
+	is_inline = ((NULL != p_queue->p_inline) &&
+		(p_queue->array.p_data == p_queue->p_inline));
+END:
+	return is_inline;
+}
+
 bool si_queue_is_empty(const si_queue_t* const p_queue)
 {
 	bool is_empty = true;
@@ -130,6 +182,61 @@ END:
 		return is_full;
 }
 
+/** Doxygen
+ * @brief Moves the queued items, in order, into a larger heap buffer.
+ * @details A plain realloc() would split a wrapped ring & can't be used on the
+ *          inline buffer, so items are copied out front first.
+ *
+ * @param p_queue Pointer to the queue struct to grow.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_queue_grow(si_queue_t* const p_queue)
+{
+	bool result = false;
+	const size_t old_capacity = p_queue->array.capacity;
+	size_t new_capacity = si_realloc_settings_next_grow_capacity_3(
+		p_queue->p_settings, old_capacity, &(p_queue->stats)
+	);
+	if (new_capacity <= old_capacity)
+	{
+		// Settings failed or missing, try using a default grow by 1.
+		new_capacity = old_capacity + 1u;
+	}
+	const size_t element_size = p_queue->array.element_size;
+	uint8_t* const p_heap = calloc(new_capacity, element_size);
+	if (NULL == p_heap)
+	{
+		goto END;
+	}
+	const size_t count = si_queue_count(p_queue);
+	const uint8_t* const p_old = p_queue->array.p_data;
+	if (0u < count)
+	{
+		const size_t first_run = (p_queue->front < p_queue->back) ?
+			count : (old_capacity - p_queue->front);
+		memcpy(p_heap, p_old + (p_queue->front * element_size),
+			first_run * element_size);
+		memcpy(p_heap + (first_run * element_size), p_old,
+			(count - first_run) * element_size);
+	}
+	const bool is_inline = si_queue_is_inline(p_queue);
+	if (true != is_inline)
+	{
+		si_array_free(&(p_queue->array));
+	}
+	p_queue->array.p_data = p_heap;
+	p_queue->array.element_size = element_size;
+	p_queue->array.capacity = new_capacity;
+	p_queue->front = 0u;
+	p_queue->back = count;
+	si_realloc_stats_record(&(p_queue->stats), old_capacity, new_capacity,
+		count * element_size);
+	result = true;
+END:
+	return result;
+}
+
 size_t si_queue_enqueue(si_queue_t* const p_queue, const void* const p_item)
 {
 	size_t new_count = 0u;
@@ -141,29 +248,12 @@ size_t si_queue_enqueue(si_queue_t* const p_queue, const void* const p_item)
 	const bool needs_to_grow = si_queue_is_full(p_queue);
 	if (true == needs_to_grow)
 	{
-		const bool did_settings_grow = si_realloc_settings_grow(
-			p_queue->p_settings, &(p_queue->array)
-		);
-		bool is_still_full = si_queue_is_full(p_queue);
-		if ((true == did_settings_grow) && (true == is_still_full))
+		const bool did_grow = si_queue_grow(p_queue);
+		if (true != did_grow)
 		{
-			// Failed to grow with defined settings.
-			// Or growth amount didn't increase capacity(0).
+			// All else has failed.
 			goto END;
 		}
-		else if (true != did_settings_grow)
-		{
-			// Settings failed or missing, try using a default grow by 1.
-			const bool did_grow = si_array_resize(
-				&(p_queue->array), p_queue->array.capacity + 1u
-			);
-			is_still_full = si_queue_is_full(p_queue);
-			if ((true != did_grow) || (true == is_still_full))
-			{
-				// All else has failed.
-				goto END;
-			}
-		}
 	}
 	si_array_set(&(p_queue->array), p_queue->back, p_item);
 	p_queue->back = (p_queue->back + 1) % p_queue->array.capacity;
@@ -197,7 +287,19 @@ void si_queue_free(si_queue_t* const p_queue)
 	{
 		goto END;
 	}
-	si_array_free(&(p_queue->array));
+	const bool is_inline = si_queue_is_inline(p_queue);
+	if (true == is_inline)
+	{
+		// Caller owns the inline buffer.
+		p_queue->array.p_data = NULL;
+		p_queue->array.capacity = 0u;
+	}
+	else
+	{
+		si_array_free(&(p_queue->array));
+	}
+	p_queue->front = 0u;
+	p_queue->back = 0u;
 END:
 	return;
 }
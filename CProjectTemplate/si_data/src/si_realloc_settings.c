@@ -48,11 +48,111 @@ void si_realloc_settings_new(si_realloc_settings_t* p_settings)
 	p_settings->shrink_value = SI_DEFAULT_RESIZE_VALUE;
 	p_settings->max_capacity = SIZE_MAX;
 	p_settings->max_size = SIZE_MAX;
+	p_settings->is_adaptive = false;
 END:
 	return;
 }
 
-size_t si_realloc_settings_next_grow_capacity(
+void si_realloc_stats_init(si_realloc_stats_t* p_stats)
+{
+	if (NULL == p_stats)
+	{
+		goto END;
+	}
+	p_stats->grow_count = 0u;
+	p_stats->shrink_count = 0u;
+	p_stats->bytes_copied = 0u;
+	p_stats->peak_capacity = 0u;
+	p_stats->grow_streak = 0u;
+END:
+	return;
+}
+
+void si_realloc_stats_record(si_realloc_stats_t* p_stats,
+	const size_t old_capacity, const size_t new_capacity,
+	const size_t bytes_copied)
+{
+	if (NULL == p_stats)
+	{
+		goto END;
+	}
+	if (new_capacity > old_capacity)
+	{
+		p_stats->grow_count++;
+		p_stats->grow_streak++;
+	}
+	else if (new_capacity < old_capacity)
+	{
+		p_stats->shrink_count++;
+		p_stats->grow_streak = 0u;
+	}
+	if ((SIZE_MAX - p_stats->bytes_copied) < bytes_copied)
+	{
+		// Saturate rather than wrap.
+		p_stats->bytes_copied = SIZE_MAX;
+	}
+	else
+	{
+		p_stats->bytes_copied += bytes_copied;
+	}
+	if (new_capacity > p_stats->peak_capacity)
+	{
+		p_stats->peak_capacity = new_capacity;
+	}
+END:
+	return;
+}
+
+bool si_realloc_stats_resize(si_realloc_stats_t* p_stats,
+	si_array_t* p_array, const size_t new_capacity)
+{
+	bool result = false;
+	if (NULL == p_array)
+	{
+		goto END;
+	}
+	const size_t old_capacity = p_array->capacity;
+	const void* const p_old_data = p_array->p_data;
+	result = si_array_resize(p_array, new_capacity);
+	if (true != result)
+	{
+		goto END;
+	}
+	size_t bytes_copied = 0u;
+	if ((NULL != p_old_data) && (NULL != p_array->p_data) &&
+	    (p_old_data != p_array->p_data))
+	{
+		// realloc() moved the buffer, copying what fit.
+		const size_t kept = (old_capacity < new_capacity) ?
+			old_capacity : new_capacity;
+		bytes_copied = kept * p_array->element_size;
+	}
+	si_realloc_stats_record(p_stats, old_capacity, new_capacity, bytes_copied);
+END:
+	return result;
+}
+
+void si_realloc_stats_fprint(FILE* p_file, const si_realloc_stats_t* p_stats)
+{
+	if ((NULL == p_file) || (NULL == p_stats))
+	{
+		goto END;
+	}
+	fprintf(p_file, "{Grows: %zu Shrinks: %zu Copied: %zu Peak: %zu}",
+		p_stats->grow_count, p_stats->shrink_count, p_stats->bytes_copied,
+		p_stats->peak_capacity
+	);
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Finds the capacity of next grow with settings from current_capacity.
+ *
+ * @param p_settings Pointer to si_realloc_settings struct on how to grow.
+ * @param current_capacity What capacity the buffer is already at.
+ */
+static size_t si_realloc_settings_next_grow_base(
 	const si_realloc_settings_t* p_settings, const size_t current_capacity)
 {
 	size_t new_capacity = current_capacity;
@@ -98,7 +198,7 @@ size_t si_realloc_settings_next_grow_capacity(
 				}
 			}
 			// Truncation here is intended behavior
-			new_capacity *= (size_t)scaled;
+			new_capacity = (size_t)scaled;
 			break;
 		}
 		case EXPONENTIAL:
@@ -129,7 +229,65 @@ END:
 	return new_capacity;
 }
 
-size_t si_realloc_settings_next_shrink_capacity(
+size_t si_realloc_settings_next_grow_capacity_3(
+	const si_realloc_settings_t* p_settings, const size_t current_capacity,
+	const si_realloc_stats_t* p_stats)
+{
+	size_t new_capacity = si_realloc_settings_next_grow_base(
+		p_settings, current_capacity
+	);
+	if ((NULL == p_settings) || (NULL == p_stats))
+	{
+		goto END;
+	}
+	if ((true != p_settings->is_adaptive) || (new_capacity <= current_capacity))
+	{
+		goto END;
+	}
+	const size_t shift = (SI_REALLOC_ADAPTIVE_MAX_SHIFT < p_stats->grow_streak)
+		? SI_REALLOC_ADAPTIVE_MAX_SHIFT : p_stats->grow_streak;
+	size_t step = new_capacity - current_capacity;
+	// Prevent Overflows
+	if ((SIZE_MAX >> shift) < step)
+	{
+		step = SIZE_MAX;
+	}
+	else
+	{
+		step <<= shift;
+	}
+	if ((SIZE_MAX - step) < current_capacity)
+	{
+		new_capacity = SIZE_MAX;
+	}
+	else
+	{
+		new_capacity = current_capacity + step;
+	}
+	// Cap capacity to max.
+	if (new_capacity > p_settings->max_capacity)
+	{
+		new_capacity = p_settings->max_capacity;
+	}
+END:
+	return new_capacity;
+}
+inline size_t si_realloc_settings_next_grow_capacity(
+	const si_realloc_settings_t* p_settings, const size_t current_capacity)
+{
+	// Default value of p_stats is NULL (no adaptation)
+	return si_realloc_settings_next_grow_capacity_3(
+		p_settings, current_capacity, NULL
+	);
+}
+
+/** Doxygen
+ * @brief Find the capacity of next shrink with settings from current_capacity.
+ *
+ * @param p_settings Pointer to si_realloc_settings struct on how to shrink.
+ * @param current_capacity What capacity the buffer is already at.
+ */
+static size_t si_realloc_settings_next_shrink_base(
 	const si_realloc_settings_t* p_settings, const size_t current_capacity)
 {
 	size_t new_capacity = current_capacity;
@@ -204,45 +362,86 @@ END:
 	return new_capacity;
 }
 
-bool si_realloc_settings_grow(
-	const si_realloc_settings_t* p_settings, si_array_t* p_array)
+size_t si_realloc_settings_next_shrink_capacity_3(
+	const si_realloc_settings_t* p_settings, const size_t current_capacity,
+	const size_t count)
+{
+	size_t new_capacity = si_realloc_settings_next_shrink_base(
+		p_settings, current_capacity
+	);
+	if ((NULL == p_settings) || (true != p_settings->is_adaptive))
+	{
+		goto END;
+	}
+	// Hysteresis, shrink lazily once well below the smaller capacity.
+	const size_t slack = SI_REALLOC_ADAPTIVE_SHRINK_SLACK;
+	if ((0u < count) && ((new_capacity / slack) < count))
+	{
+		new_capacity = current_capacity;
+	}
+END:
+	return new_capacity;
+}
+inline size_t si_realloc_settings_next_shrink_capacity(
+	const si_realloc_settings_t* p_settings, const size_t current_capacity)
+{
+	// Default value of count is 0u (no hysteresis)
+	return si_realloc_settings_next_shrink_capacity_3(
+		p_settings, current_capacity, 0u
+	);
+}
+
+bool si_realloc_settings_grow_3(const si_realloc_settings_t* p_settings,
+	si_array_t* p_array, si_realloc_stats_t* p_stats)
 {
 	bool result = false;
 	if (NULL == p_array)
 	{
 		goto END;
 	}
-	const size_t new_capacity = si_realloc_settings_next_grow_capacity(
-		p_settings, p_array->capacity
+	const size_t new_capacity = si_realloc_settings_next_grow_capacity_3(
+		p_settings, p_array->capacity, p_stats
 	);
 	if (new_capacity == p_array->capacity)
 	{
 		goto END;
 	}
-	result = si_array_resize(p_array, new_capacity);
+	result = si_realloc_stats_resize(p_stats, p_array, new_capacity);
 END:
 	return result;
 }
-
-bool si_realloc_settings_shrink(
+inline bool si_realloc_settings_grow(
 	const si_realloc_settings_t* p_settings, si_array_t* p_array)
+{
+	// Default value of p_stats is NULL
+	return si_realloc_settings_grow_3(p_settings, p_array, NULL);
+}
+
+bool si_realloc_settings_shrink_4(const si_realloc_settings_t* p_settings,
+	si_array_t* p_array, const size_t count, si_realloc_stats_t* p_stats)
 {
 	bool result = false;
 	if (NULL == p_array)
 	{
 		goto END;
 	}
-	const size_t new_capacity = si_realloc_settings_next_shrink_capacity(
-		p_settings, p_array->capacity
+	const size_t new_capacity = si_realloc_settings_next_shrink_capacity_3(
+		p_settings, p_array->capacity, count
 	);
 	if (new_capacity == p_array->capacity)
 	{
 		goto END;
 	}
-	result = si_array_resize(p_array, new_capacity);
+	result = si_realloc_stats_resize(p_stats, p_array, new_capacity);
 END:
 	return result;
 }
+inline bool si_realloc_settings_shrink(
+	const si_realloc_settings_t* p_settings, si_array_t* p_array)
+{
+	// Default values of count & p_stats are 0u & NULL
+	return si_realloc_settings_shrink_4(p_settings, p_array, 0u, NULL);
+}
 
 
 void si_realloc_settings_fprint(FILE* p_file,
@@ -274,7 +473,12 @@ void si_realloc_settings_fprint(FILE* p_file,
 	}
 	fprintf(p_file, "; Shrink: ");
 	si_resize_mode_fprint(p_file, p_settings->shrink_mode);
-	fprintf(p_file, "@%f}", p_settings->shrink_value);
+	fprintf(p_file, "@%f", p_settings->shrink_value);
+	if (true == p_settings->is_adaptive)
+	{
+		fprintf(p_file, " Adaptive");
+	}
+	fprintf(p_file, "}");
 END:
 	return;
 }
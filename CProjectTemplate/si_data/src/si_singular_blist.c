@@ -300,9 +300,26 @@ bool si_singular_blist_append(si_singular_blist_t* const p_list,
 	{
 		goto END;
 	}
+	if (NULL == p_list->p_head)
+	{
+		// Emptied by removals, start over with a single node.
+		p_list->p_head = si_singular_list_new_2(false, 1u);
+		if (NULL == p_list->p_head)
+		{
+			goto END;
+		}
+		p_list->p_head->p_data = (void*)p_data;
+		p_list->p_tail = p_list->p_head;
+		p_list->count = 1u;
+		p_list->capacity = 1u;
+		result = true;
+		goto END;
+	}
 	result = si_singular_list_insert_next(p_list->p_tail, p_data);
 	if (true == result)
 	{
+		// Keep appends O(1) and in order.
+		p_list->p_tail = p_list->p_tail->p_next;
 		p_list->count++;
 		p_list->capacity++;
 	}
@@ -314,14 +331,56 @@ bool si_singular_blist_remove_at(si_singular_blist_t* p_list,
 	const size_t index)
 {
 	bool result = false;
-	if (NULL == p_list)
+	if ((NULL == p_list) || (NULL == p_list->p_head))
 	{
 		goto END;
 	}
-	result = si_singular_list_remove_at(p_list->p_head, index);
+	si_singular_list_t* const p_head = p_list->p_head;
+	const bool had_data = (NULL != si_singular_list_at(p_head, index));
+	if (0u == index)
+	{
+		if ((NULL == p_head->p_next) || (p_head == p_head->p_next))
+		{
+			// Removing the only node empties the list.
+			free(p_head);
+			p_list->p_head = NULL;
+			p_list->p_tail = NULL;
+			result = true;
+		}
+		else
+		{
+			// The head takes over its next node, which may be the tail.
+			const bool is_tail = (p_head->p_next == p_list->p_tail);
+			result = si_singular_list_remove(p_head);
+			if ((true == result) && (true == is_tail))
+			{
+				p_list->p_tail = p_head;
+			}
+		}
+	}
+	else
+	{
+		si_singular_list_t* const p_parent = si_singular_list_node_at(
+			p_head, index - 1u
+		);
+		// Circular indexes must not wrap around onto the head node.
+		if ((NULL == p_parent) || (p_head == p_parent->p_next))
+		{
+			goto END;
+		}
+		const bool is_tail = (p_parent->p_next == p_list->p_tail);
+		result = si_singular_list_remove_next(p_parent);
+		if ((true == result) && (true == is_tail))
+		{
+			p_list->p_tail = p_parent;
+		}
+	}
 	if (true == result)
 	{
-		p_list->count--;
+		if (true == had_data)
+		{
+			p_list->count--;
+		}
 		p_list->capacity--;
 	}
 END:
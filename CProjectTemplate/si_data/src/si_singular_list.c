@@ -190,10 +190,10 @@ bool si_singular_list_sort(si_singular_list_t* const p_list,
 	for (size_t iii = 0u; iii < capacity; iii++)
 	{
 		// iii is the index for the next smallest value (ascending)
+		p_test_node = p_small_node->p_next;
 		for (size_t jjj = 1u; jjj < (capacity - iii); jjj++)
 		{
 			// jjj is the number of possible indexs after iii for smaller value
-			p_test_node = si_singular_list_node_at(p_small_node, jjj);
 			const int cmp_result = p_cmp_f(
 				p_small_node->p_data, p_test_node->p_data
 			);
@@ -204,9 +204,12 @@ bool si_singular_list_sort(si_singular_list_t* const p_list,
 				p_test_node->p_data = p_small_node->p_data;
 				p_small_node->p_data = p_tmp;
 			}
+			// Walk on instead of seeking from p_small_node each time.
+			p_test_node = p_test_node->p_next;
 		}
 		p_small_node = p_small_node->p_next;
 	}
+	result = true;
 END:
 	return result;
 }
@@ -442,12 +445,9 @@ bool si_singular_list_remove_next(si_singular_list_t* const p_list)
 		goto END;
 	}
 	si_singular_list_t* p_next_node = p_list->p_next;
-	if (NULL != p_next_node->p_next)
-	{
-		// Continue the chain
-		p_list->p_next = p_next_node->p_next;
-		p_next_node->p_next = NULL;
-	}
+	// Continue the chain, a removed leaf leaves p_list as the new leaf.
+	p_list->p_next = p_next_node->p_next;
+	p_next_node->p_next = NULL;
 	free(p_next_node);
 	result = true;
 END:
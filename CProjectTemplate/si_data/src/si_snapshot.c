@@ -0,0 +1,1207 @@
+//si_snapshot.c
+
+#include "si_snapshot.h"
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#define SI_SNAPSHOT_MMAP (1)
+#include <fcntl.h> // open(), O_RDONLY
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+#else
+#define SI_SNAPSHOT_MMAP (0)
+#endif// mmap() support
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+// Largest prime below 2^16 (Same as ADLER_32_PRIME)
+#define SI_SNAPSHOT_ADLER_MOD (65521u)
+// Most bytes that can be summed before the 32-bit sums may overflow.
+#define SI_SNAPSHOT_ADLER_NMAX (5552u)
+
+/** Doxygen
+ * @brief Updates running Adler-32 sums with a buffer of bytes.
+ * @details si_adler_t supports any block size but allocates per call and works
+ *          a byte at a time on big integers, too slow for multi GB snapshots.
+ *
+ * @param p_sum_a Pointer to the running sum of bytes.
+ * @param p_sum_b Pointer to the running sum of sums.
+ * @param p_buffer Pointer to the bytes to be summed.
+ * @param size Number of bytes in the buffer.
+ */
+static void si_snapshot_adler_update(uint32_t* const p_sum_a,
+	uint32_t* const p_sum_b, const uint8_t* p_buffer, size_t size)
+{
+	if ((NULL == p_sum_a) || (NULL == p_sum_b) || (NULL == p_buffer))
+	{
+		goto END;
+	}
+	uint32_t sum_a = *p_sum_a;
+	uint32_t sum_b = *p_sum_b;
+	while (0u < size)
+	{
+		size_t block = size;
+		if (SI_SNAPSHOT_ADLER_NMAX < block)
+		{
+			block = SI_SNAPSHOT_ADLER_NMAX;
+		}
+		size -= block;
+		for (size_t iii = 0u; iii < block; iii++)
+		{
+			sum_a += p_buffer[iii];
+			sum_b += sum_a;
+		}
+		p_buffer += block;
+		sum_a %= SI_SNAPSHOT_ADLER_MOD;
+		sum_b %= SI_SNAPSHOT_ADLER_MOD;
+	}
+	*p_sum_a = sum_a;
+	*p_sum_b = sum_b;
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Rounds a size up to the next multiple of SI_SNAPSHOT_ALIGNMENT.
+ *
+ * @param size Number of bytes to be aligned.
+ *
+ * @return Returns aligned size. Returns SIZE_MAX on overflow.
+ */
+static size_t si_snapshot_align(const size_t size)
+{
+	size_t result = SIZE_MAX;
+	const size_t mask = (SI_SNAPSHOT_ALIGNMENT - 1u);
+	if ((SIZE_MAX - mask) < size)
+	{
+		goto END;
+	}
+	result = ((size + mask) & ~mask);
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Writes bytes to the snapshot body while updating its checksum.
+ *
+ * @param p_writer Pointer to the snapshot writer.
+ * @param p_buffer Pointer to bytes to be written. NULL writes zeros.
+ * @param size Number of bytes to be written.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_snapshot_writer_put(si_snapshot_writer_t* const p_writer,
+	const void* const p_buffer, const size_t size)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_writer->p_file))
+	{
+		goto END;
+	}
+	if (0u >= size)
+	{
+		result = true;
+		goto END;
+	}
+	if (NULL == p_buffer)
+	{
+		// Padding
+		const uint8_t p_zeros[SI_SNAPSHOT_ALIGNMENT] = {0};
+		if (SI_SNAPSHOT_ALIGNMENT < size)
+		{
+			goto END;
+		}
+		result = si_snapshot_writer_put(p_writer, p_zeros, size);
+		goto END;
+	}
+	const size_t written = fwrite(p_buffer, 1u, size, p_writer->p_file);
+	if (written != size)
+	{
+		goto END;
+	}
+	si_snapshot_adler_update(
+		&(p_writer->sum_a), &(p_writer->sum_b), p_buffer, size
+	);
+	p_writer->body_size += size;
+	result = true;
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Writes a section header followed by the section payload & padding.
+ *
+ * @param p_writer Pointer to the snapshot writer.
+ * @param p_section Pointer to the filled out section header.
+ * @param p_payload Optional contiguous payload of p_section->length bytes.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_snapshot_writer_put_section(si_snapshot_writer_t* const p_writer,
+	const si_snapshot_section_t* const p_section, const void* const p_payload)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_section))
+	{
+		goto END;
+	}
+	if (UINT32_MAX <= p_writer->section_count)
+	{
+		goto END;
+	}
+	result = si_snapshot_writer_put(
+		p_writer, p_section, sizeof(si_snapshot_section_t)
+	);
+	if ((true != result) || (NULL == p_payload))
+	{
+		goto END;
+	}
+	result = si_snapshot_writer_put(
+		p_writer, p_payload, (size_t)p_section->length
+	);
+	if (true != result)
+	{
+		goto END;
+	}
+	const size_t aligned = si_snapshot_align((size_t)p_section->length);
+	result = si_snapshot_writer_put(
+		p_writer, NULL, aligned - (size_t)p_section->length
+	);
+	if (true == result)
+	{
+		p_writer->section_count++;
+	}
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Writes the blob bytes of a pointer container then its padding.
+ *
+ * @param p_writer Pointer to the snapshot writer.
+ * @param p_section Pointer to the section header already written.
+ * @param written Number of payload bytes already written.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_snapshot_writer_end_section(si_snapshot_writer_t* const p_writer,
+	const si_snapshot_section_t* const p_section, const size_t written)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_section))
+	{
+		goto END;
+	}
+	if (written != p_section->length)
+	{
+		goto END;
+	}
+	const size_t aligned = si_snapshot_align(written);
+	result = si_snapshot_writer_put(p_writer, NULL, aligned - written);
+	if (true == result)
+	{
+		p_writer->section_count++;
+	}
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Fills an offset table entry for a value and advances the offset.
+ *
+ * @param p_blob Pointer to the table entry to be set.
+ * @param p_value Pointer value to be saved. NULL is saved as a NULL offset.
+ * @param p_size_f Function returning the byte size of p_value.
+ * @param p_offset Pointer to the running payload offset.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_snapshot_blob_plan(si_snapshot_blob_t* const p_blob,
+	const void* const p_value, si_snapshot_size_f p_size_f,
+	uint64_t* const p_offset)
+{
+	bool result = false;
+	if ((NULL == p_blob) || (NULL == p_offset))
+	{
+		goto END;
+	}
+	if (NULL == p_value)
+	{
+		p_blob->offset = SI_SNAPSHOT_NULL_OFFSET;
+		p_blob->size = 0u;
+		result = true;
+		goto END;
+	}
+	if (NULL == p_size_f)
+	{
+		goto END;
+	}
+	const size_t size = p_size_f(p_value);
+	if ((UINT64_MAX - *p_offset) < size)
+	{
+		goto END;
+	}
+	p_blob->offset = *p_offset;
+	p_blob->size = size;
+	*p_offset += size;
+	result = true;
+END:
+	return result;
+}
+
+bool si_snapshot_writer_init(si_snapshot_writer_t* const p_writer,
+	FILE* const p_file)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_file))
+	{
+		goto END;
+	}
+	p_writer->p_file = p_file;
+	p_writer->start = ftell(p_file);
+	p_writer->section_count = 0u;
+	p_writer->sum_a = 1u;
+	p_writer->sum_b = 0u;
+	p_writer->body_size = 0u;
+	if (0L > p_writer->start)
+	{
+		// Stream isn't seekable so the header can't be completed.
+		p_writer->p_file = NULL;
+		goto END;
+	}
+	// Reserve space for the header. Finished by si_snapshot_writer_finish().
+	const si_snapshot_header_t header = {0};
+	const size_t written = fwrite(
+		&header, sizeof(si_snapshot_header_t), 1u, p_file
+	);
+	result = (1u == written);
+END:
+	return result;
+}
+
+bool si_snapshot_write_array(si_snapshot_writer_t* const p_writer,
+	const si_array_t* const p_array)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_array))
+	{
+		goto END;
+	}
+	si_snapshot_section_t section = {0};
+	section.type = SI_SNAPSHOT_ARRAY;
+	section.element_size = p_array->element_size;
+	section.count = p_array->capacity;
+	section.length = si_array_size(p_array);
+	if ((0u >= section.length) && (0u < p_array->capacity))
+	{
+		// Overflowed or missing buffer.
+		goto END;
+	}
+	const uint8_t empty = 0u;
+	const void* p_payload = p_array->p_data;
+	if (NULL == p_payload)
+	{
+		p_payload = &empty;
+	}
+	result = si_snapshot_writer_put_section(p_writer, &section, p_payload);
+END:
+	return result;
+}
+
+bool si_snapshot_write_parray(si_snapshot_writer_t* const p_writer,
+	const si_parray_t* const p_parray, si_snapshot_size_f p_size_f)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_parray) || (NULL == p_size_f))
+	{
+		goto END;
+	}
+	const size_t count = si_parray_count(p_parray);
+	if (SIZE_MAX == count)
+	{
+		goto END;
+	}
+	si_snapshot_blob_t* p_table = calloc(count + 1u, sizeof(si_snapshot_blob_t));
+	if (NULL == p_table)
+	{
+		goto END;
+	}
+	const size_t table_size = count * sizeof(si_snapshot_blob_t);
+	uint64_t offset = table_size;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const void* const p_value = si_parray_at(p_parray, iii);
+		const bool planned = si_snapshot_blob_plan(
+			&(p_table[iii]), p_value, p_size_f, &offset
+		);
+		if (true != planned)
+		{
+			goto CLEAN;
+		}
+	}
+	si_snapshot_section_t section = {0};
+	section.type = SI_SNAPSHOT_PARRAY;
+	section.count = count;
+	section.length = offset;
+	if (true != si_snapshot_writer_put_section(p_writer, &section, NULL))
+	{
+		goto CLEAN;
+	}
+	if (true != si_snapshot_writer_put(p_writer, p_table, table_size))
+	{
+		goto CLEAN;
+	}
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const void* const p_value = si_parray_at(p_parray, iii);
+		if (true != si_snapshot_writer_put(
+			p_writer, p_value, (size_t)p_table[iii].size))
+		{
+			goto CLEAN;
+		}
+	}
+	result = si_snapshot_writer_end_section(
+		p_writer, &section, (size_t)offset
+	);
+CLEAN:
+	free(p_table);
+	p_table = NULL;
+END:
+	return result;
+}
+
+bool si_snapshot_write_map(si_snapshot_writer_t* const p_writer,
+	const si_map_t* const p_map, si_snapshot_size_f p_key_size_f,
+	si_snapshot_size_f p_value_size_f)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_map) || (NULL == p_key_size_f))
+	{
+		goto END;
+	}
+	const size_t count = si_map_count(p_map);
+	if (SIZE_MAX == count)
+	{
+		goto END;
+	}
+	si_snapshot_pair_t* p_table = calloc(count + 1u, sizeof(si_snapshot_pair_t));
+	if (NULL == p_table)
+	{
+		goto END;
+	}
+	const size_t table_size = count * sizeof(si_snapshot_pair_t);
+	uint64_t offset = table_size;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const si_map_pair_t* const p_pair = si_parray_at(
+			&(p_map->entries), iii
+		);
+		if (NULL == p_pair)
+		{
+			goto CLEAN;
+		}
+		bool planned = si_snapshot_blob_plan(
+			&(p_table[iii].key), p_pair->p_key, p_key_size_f, &offset
+		);
+		planned &= si_snapshot_blob_plan(
+			&(p_table[iii].value), p_pair->p_value, p_value_size_f, &offset
+		);
+		if (true != planned)
+		{
+			goto CLEAN;
+		}
+	}
+	si_snapshot_section_t section = {0};
+	section.type = SI_SNAPSHOT_MAP;
+	section.count = count;
+	section.length = offset;
+	if (true != si_snapshot_writer_put_section(p_writer, &section, NULL))
+	{
+		goto CLEAN;
+	}
+	if (true != si_snapshot_writer_put(p_writer, p_table, table_size))
+	{
+		goto CLEAN;
+	}
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const si_map_pair_t* const p_pair = si_parray_at(
+			&(p_map->entries), iii
+		);
+		bool did_put = si_snapshot_writer_put(
+			p_writer, p_pair->p_key, (size_t)p_table[iii].key.size
+		);
+		did_put &= si_snapshot_writer_put(
+			p_writer, p_pair->p_value, (size_t)p_table[iii].value.size
+		);
+		if (true != did_put)
+		{
+			goto CLEAN;
+		}
+	}
+	result = si_snapshot_writer_end_section(
+		p_writer, &section, (size_t)offset
+	);
+CLEAN:
+	free(p_table);
+	p_table = NULL;
+END:
+	return result;
+}
+
+bool si_snapshot_write_hashmap(si_snapshot_writer_t* const p_writer,
+	const si_hashmap_t* const p_hashmap, si_snapshot_size_f p_value_size_f)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_hashmap))
+	{
+		goto END;
+	}
+	const size_t count = si_hashmap_count(p_hashmap);
+	if (SIZE_MAX == count)
+	{
+		goto END;
+	}
+	si_snapshot_hash_entry_t* p_table = calloc(
+		count + 1u, sizeof(si_snapshot_hash_entry_t)
+	);
+	// Keeps the value pointers in table order for the second pass.
+	const void** pp_values = calloc(count + 1u, sizeof(void*));
+	if ((NULL == p_table) || (NULL == pp_values))
+	{
+		goto CLEAN;
+	}
+	const size_t table_size = count * sizeof(si_snapshot_hash_entry_t);
+	uint64_t offset = table_size;
+	size_t entry = 0u;
+	for (size_t iii = 0u; iii < p_hashmap->maps.capacity; iii++)
+	{
+		si_map_t** const pp_map = si_array_at(&(p_hashmap->maps), iii);
+		if ((NULL == pp_map) || (NULL == *pp_map))
+		{
+			continue;
+		}
+		const size_t map_count = si_map_count(*pp_map);
+		for (size_t jjj = 0u; jjj < map_count; jjj++)
+		{
+			const si_map_pair_t* const p_pair = si_parray_at(
+				&((*pp_map)->entries), jjj
+			);
+			if ((NULL == p_pair) || (NULL == p_pair->p_key) ||
+				(count <= entry))
+			{
+				goto CLEAN;
+			}
+			p_table[entry].hash = *((const size_t*)p_pair->p_key);
+			pp_values[entry] = p_pair->p_value;
+			const bool planned = si_snapshot_blob_plan(
+				&(p_table[entry].value), p_pair->p_value,
+				p_value_size_f, &offset
+			);
+			if (true != planned)
+			{
+				goto CLEAN;
+			}
+			entry++;
+		}
+	}
+	si_snapshot_section_t section = {0};
+	section.type = SI_SNAPSHOT_HASHMAP;
+	section.element_size = p_hashmap->maps.capacity;
+	section.count = entry;
+	section.length = offset;
+	if (true != si_snapshot_writer_put_section(p_writer, &section, NULL))
+	{
+		goto CLEAN;
+	}
+	if (true != si_snapshot_writer_put(p_writer, p_table, table_size))
+	{
+		goto CLEAN;
+	}
+	for (size_t iii = 0u; iii < entry; iii++)
+	{
+		if (true != si_snapshot_writer_put(
+			p_writer, pp_values[iii], (size_t)p_table[iii].value.size))
+		{
+			goto CLEAN;
+		}
+	}
+	result = si_snapshot_writer_end_section(
+		p_writer, &section, (size_t)offset
+	);
+CLEAN:
+	free(p_table);
+	p_table = NULL;
+	free(pp_values);
+	pp_values = NULL;
+END:
+	return result;
+}
+
+bool si_snapshot_writer_finish(si_snapshot_writer_t* const p_writer)
+{
+	bool result = false;
+	if ((NULL == p_writer) || (NULL == p_writer->p_file))
+	{
+		goto END;
+	}
+	si_snapshot_header_t header = {0};
+	memcpy(header.magic, SI_SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SI_SNAPSHOT_VERSION;
+	header.header_size = sizeof(si_snapshot_header_t);
+	header.endian_tag = SI_SNAPSHOT_ENDIAN_TAG;
+	header.section_count = p_writer->section_count;
+	header.checksum = ((p_writer->sum_b << 16u) | p_writer->sum_a);
+	header.body_size = p_writer->body_size;
+
+	const long end = ftell(p_writer->p_file);
+	if ((0L > end) || (0 != fseek(p_writer->p_file, p_writer->start, SEEK_SET)))
+	{
+		goto END;
+	}
+	const size_t written = fwrite(
+		&header, sizeof(si_snapshot_header_t), 1u, p_writer->p_file
+	);
+	(void)fseek(p_writer->p_file, end, SEEK_SET);
+	if (1u != written)
+	{
+		goto END;
+	}
+	result = (0 == fflush(p_writer->p_file));
+	p_writer->p_file = NULL;
+END:
+	return result;
+}
+
+
+/** Doxygen
+ * @brief Validates the header, checksum and sections of loaded snapshot bytes
+ *        and records the offset of each section.
+ *
+ * @param p_snapshot Pointer to the snapshot with p_data and size set.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_snapshot_validate(si_snapshot_t* const p_snapshot)
+{
+	bool result = false;
+	if ((NULL == p_snapshot) || (NULL == p_snapshot->p_data))
+	{
+		goto END;
+	}
+	if (sizeof(si_snapshot_header_t) > p_snapshot->size)
+	{
+		goto END;
+	}
+	const si_snapshot_header_t* const p_header =
+		(const si_snapshot_header_t*)p_snapshot->p_data;
+	if (0 != memcmp(p_header->magic, SI_SNAPSHOT_MAGIC, sizeof(p_header->magic)))
+	{
+		goto END;
+	}
+	if ((SI_SNAPSHOT_VERSION != p_header->version) ||
+	    (sizeof(si_snapshot_header_t) != p_header->header_size) ||
+	    (SI_SNAPSHOT_ENDIAN_TAG != p_header->endian_tag))
+	{
+		goto END;
+	}
+	const size_t body_limit = p_snapshot->size - sizeof(si_snapshot_header_t);
+	if (body_limit < p_header->body_size)
+	{
+		goto END;
+	}
+	const uint8_t* const p_body = p_snapshot->p_data + p_header->header_size;
+	uint32_t sum_a = 1u;
+	uint32_t sum_b = 0u;
+	si_snapshot_adler_update(&sum_a, &sum_b, p_body, p_header->body_size);
+	if (((sum_b << 16u) | sum_a) != p_header->checksum)
+	{
+		goto END;
+	}
+
+	// Index sections so lookups don't walk the file.
+	si_array_init_3(
+		&(p_snapshot->sections), sizeof(size_t), p_header->section_count
+	);
+	if ((NULL == p_snapshot->sections.p_data) &&
+	    (0u < p_header->section_count))
+	{
+		goto END;
+	}
+	size_t offset = 0u;
+	for (size_t iii = 0u; iii < p_header->section_count; iii++)
+	{
+		if ((p_header->body_size - offset) < sizeof(si_snapshot_section_t))
+		{
+			goto END;
+		}
+		const si_snapshot_section_t* const p_section =
+			(const si_snapshot_section_t*)(p_body + offset);
+		const size_t absolute = p_header->header_size + offset;
+		si_array_set(&(p_snapshot->sections), iii, &absolute);
+		offset += sizeof(si_snapshot_section_t);
+		const size_t aligned = si_snapshot_align((size_t)p_section->length);
+		if ((SIZE_MAX == aligned) ||
+		    ((p_header->body_size - offset) < aligned))
+		{
+			goto END;
+		}
+		offset += aligned;
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_snapshot_open_buffer(si_snapshot_t* const p_snapshot,
+	const void* const p_buffer, const size_t size)
+{
+	bool result = false;
+	if ((NULL == p_snapshot) || (NULL == p_buffer))
+	{
+		goto END;
+	}
+	p_snapshot->p_data = (uint8_t*)p_buffer;
+	p_snapshot->size = size;
+	p_snapshot->is_mapped = false;
+	p_snapshot->is_owned = false;
+	p_snapshot->sections = (si_array_t){0};
+	result = si_snapshot_validate(p_snapshot);
+	if (true != result)
+	{
+		si_array_free(&(p_snapshot->sections));
+		p_snapshot->p_data = NULL;
+		p_snapshot->size = 0u;
+	}
+END:
+	return result;
+}
+
+bool si_snapshot_open(si_snapshot_t* const p_snapshot,
+	const char* const p_path)
+{
+	bool result = false;
+	if ((NULL == p_snapshot) || (NULL == p_path))
+	{
+		goto END;
+	}
+	*p_snapshot = (si_snapshot_t){0};
+#if SI_SNAPSHOT_MMAP
+	const int file_d = open(p_path, O_RDONLY);
+	if (0 > file_d)
+	{
+		goto END;
+	}
+	struct stat file_stat = {0};
+	if ((0 != fstat(file_d, &file_stat)) || (0 >= file_stat.st_size))
+	{
+		(void)close(file_d);
+		goto END;
+	}
+	void* const p_map = mmap(
+		NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file_d, 0
+	);
+	(void)close(file_d);
+	if (MAP_FAILED == p_map)
+	{
+		goto END;
+	}
+	p_snapshot->p_data = p_map;
+	p_snapshot->size = (size_t)file_stat.st_size;
+	p_snapshot->is_mapped = true;
+#else
+	FILE* const p_file = fopen(p_path, "rb");
+	if (NULL == p_file)
+	{
+		goto END;
+	}
+	long file_size = -1L;
+	if (0 == fseek(p_file, 0L, SEEK_END))
+	{
+		file_size = ftell(p_file);
+	}
+	if ((0L >= file_size) || (0 != fseek(p_file, 0L, SEEK_SET)))
+	{
+		(void)fclose(p_file);
+		goto END;
+	}
+	p_snapshot->p_data = calloc((size_t)file_size, sizeof(uint8_t));
+	if (NULL == p_snapshot->p_data)
+	{
+		(void)fclose(p_file);
+		goto END;
+	}
+	p_snapshot->is_owned = true;
+	p_snapshot->size = fread(
+		p_snapshot->p_data, 1u, (size_t)file_size, p_file
+	);
+	(void)fclose(p_file);
+#endif// SI_SNAPSHOT_MMAP
+	result = si_snapshot_validate(p_snapshot);
+	if (true != result)
+	{
+		si_snapshot_free(p_snapshot);
+	}
+END:
+	return result;
+}
+
+size_t si_snapshot_count(const si_snapshot_t* const p_snapshot)
+{
+	size_t result = 0u;
+	if ((NULL == p_snapshot) || (NULL == p_snapshot->p_data))
+	{
+		goto END;
+	}
+	result = p_snapshot->sections.capacity;
+END:
+	return result;
+}
+
+const si_snapshot_section_t* si_snapshot_section_at(
+	const si_snapshot_t* const p_snapshot, const size_t index)
+{
+	const si_snapshot_section_t* p_result = NULL;
+	if ((NULL == p_snapshot) || (NULL == p_snapshot->p_data))
+	{
+		goto END;
+	}
+	const size_t* const p_offset = si_array_at(&(p_snapshot->sections), index);
+	if (NULL == p_offset)
+	{
+		goto END;
+	}
+	p_result = (const si_snapshot_section_t*)(p_snapshot->p_data + *p_offset);
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Finds the payload of a section by index if it is of the given type.
+ *
+ * @param p_snapshot Pointer to the opened snapshot.
+ * @param index Index of the section.
+ * @param type Expected si_snapshot_type_t of the section.
+ * @param pp_section Pointer set to the section header on success.
+ *
+ * @return Returns pointer to the payload on success. Returns NULL otherwise.
+ */
+static const uint8_t* si_snapshot_payload_at(
+	const si_snapshot_t* const p_snapshot, const size_t index,
+	const si_snapshot_type_t type,
+	const si_snapshot_section_t** const pp_section)
+{
+	const uint8_t* p_result = NULL;
+	if (NULL == pp_section)
+	{
+		goto END;
+	}
+	*pp_section = si_snapshot_section_at(p_snapshot, index);
+	if (NULL == *pp_section)
+	{
+		goto END;
+	}
+	if ((uint32_t)type != (*pp_section)->type)
+	{
+		goto END;
+	}
+	p_result = ((const uint8_t*)*pp_section) + sizeof(si_snapshot_section_t);
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Checks an array section's element_size * count matches its length
+ *        without overflowing the multiplication.
+ *
+ * @param p_section Pointer to the section header.
+ *
+ * @return Returns stdbool true when the sizes agree. Returns false otherwise.
+ */
+static bool si_snapshot_is_array_sized(
+	const si_snapshot_section_t* const p_section)
+{
+	bool result = false;
+	if (NULL == p_section)
+	{
+		goto END;
+	}
+	if (0u == p_section->element_size)
+	{
+		result = (0u == p_section->length);
+		goto END;
+	}
+	result = ((0u == (p_section->length % p_section->element_size)) &&
+		((p_section->length / p_section->element_size) == p_section->count));
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Validates a blob against its payload and returns a heap copy of it.
+ *
+ * @param p_payload Pointer to the start of the section payload.
+ * @param p_section Pointer to the section header.
+ * @param p_blob Pointer to the offset table entry.
+ * @param pp_copy Pointer set to the heap copy. (NULL for NULL blobs)
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_snapshot_blob_clone(const uint8_t* const p_payload,
+	const si_snapshot_section_t* const p_section,
+	const si_snapshot_blob_t* const p_blob, void** const pp_copy)
+{
+	bool result = false;
+	if ((NULL == p_payload) || (NULL == p_section) ||
+	    (NULL == p_blob) || (NULL == pp_copy))
+	{
+		goto END;
+	}
+	*pp_copy = NULL;
+	if (SI_SNAPSHOT_NULL_OFFSET == p_blob->offset)
+	{
+		result = true;
+		goto END;
+	}
+	if ((p_blob->offset > p_section->length) ||
+	    (p_blob->size > (p_section->length - p_blob->offset)))
+	{
+		goto END;
+	}
+	// Zero sized values still need a unique non-NULL pointer.
+	*pp_copy = calloc((0u < p_blob->size) ? (size_t)p_blob->size : 1u, 1u);
+	if (NULL == *pp_copy)
+	{
+		goto END;
+	}
+	memcpy(*pp_copy, p_payload + p_blob->offset, (size_t)p_blob->size);
+	result = true;
+END:
+	return result;
+}
+
+const void* si_snapshot_array_data(const si_snapshot_t* const p_snapshot,
+	const size_t index, size_t* const p_count)
+{
+	const void* p_result = NULL;
+	const si_snapshot_section_t* p_section = NULL;
+	p_result = si_snapshot_payload_at(
+		p_snapshot, index, SI_SNAPSHOT_ARRAY, &p_section
+	);
+	if ((NULL != p_result) && (true != si_snapshot_is_array_sized(p_section)))
+	{
+		p_result = NULL;
+	}
+	if ((NULL != p_result) && (NULL != p_count))
+	{
+		*p_count = (size_t)p_section->count;
+	}
+	return p_result;
+}
+
+bool si_snapshot_load_array(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_array_t* const p_array)
+{
+	bool result = false;
+	if (NULL == p_array)
+	{
+		goto END;
+	}
+	const si_snapshot_section_t* p_section = NULL;
+	const uint8_t* const p_payload = si_snapshot_payload_at(
+		p_snapshot, index, SI_SNAPSHOT_ARRAY, &p_section
+	);
+	if (NULL == p_payload)
+	{
+		goto END;
+	}
+	if (true != si_snapshot_is_array_sized(p_section))
+	{
+		goto END;
+	}
+	*p_array = (si_array_t){0};
+	si_array_init_3(
+		p_array, (size_t)p_section->element_size, (size_t)p_section->count
+	);
+	if ((NULL == p_array->p_data) && (0u < p_section->length))
+	{
+		goto END;
+	}
+	p_array->element_size = (size_t)p_section->element_size;
+	if (0u < p_section->length)
+	{
+		memcpy(p_array->p_data, p_payload, (size_t)p_section->length);
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_snapshot_load_parray(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_parray_t* const p_parray)
+{
+	bool result = false;
+	if (NULL == p_parray)
+	{
+		goto END;
+	}
+	const si_snapshot_section_t* p_section = NULL;
+	const uint8_t* const p_payload = si_snapshot_payload_at(
+		p_snapshot, index, SI_SNAPSHOT_PARRAY, &p_section
+	);
+	if (NULL == p_payload)
+	{
+		goto END;
+	}
+	if ((p_section->length / sizeof(si_snapshot_blob_t)) < p_section->count)
+	{
+		goto END;
+	}
+	const si_snapshot_blob_t* const p_table =
+		(const si_snapshot_blob_t*)p_payload;
+	const size_t count = (size_t)p_section->count;
+	si_parray_init_2(p_parray, count);
+	p_parray->p_free_value = free;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		void* p_value = NULL;
+		const bool cloned = si_snapshot_blob_clone(
+			p_payload, p_section, &(p_table[iii]), &p_value
+		);
+		if ((true != cloned) || (NULL == p_value))
+		{
+			// Pointer arrays are contiguous and can't hold NULL values.
+			free(p_value);
+			si_parray_free(p_parray);
+			goto END;
+		}
+		// Direct set avoids the count() walk done by si_parray_append().
+		si_parray_set(p_parray, iii, p_value);
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_snapshot_load_map(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_map_t* const p_map)
+{
+	bool result = false;
+	if (NULL == p_map)
+	{
+		goto END;
+	}
+	const si_snapshot_section_t* p_section = NULL;
+	const uint8_t* const p_payload = si_snapshot_payload_at(
+		p_snapshot, index, SI_SNAPSHOT_MAP, &p_section
+	);
+	if (NULL == p_payload)
+	{
+		goto END;
+	}
+	if ((p_section->length / sizeof(si_snapshot_pair_t)) < p_section->count)
+	{
+		goto END;
+	}
+	const size_t count = (size_t)p_section->count;
+	if (0u < si_map_count(p_map))
+	{
+		goto END;
+	}
+	// Kept to hand the map back as it was passed in on a partial load.
+	const size_t old_capacity = p_map->entries.array.capacity;
+	void (*const p_old_free_key_f)(void* const) = p_map->p_free_key_f;
+	void (*const p_old_free_value_f)(void* const) = p_map->p_free_value_f;
+	const bool did_resize = si_array_resize(&(p_map->entries.array), count);
+	if (true != did_resize)
+	{
+		goto END;
+	}
+	p_map->p_free_key_f = free;
+	p_map->p_free_value_f = free;
+	const si_snapshot_pair_t* const p_table =
+		(const si_snapshot_pair_t*)p_payload;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		void* p_key = NULL;
+		void* p_value = NULL;
+		bool cloned = si_snapshot_blob_clone(
+			p_payload, p_section, &(p_table[iii].key), &p_key
+		);
+		cloned &= si_snapshot_blob_clone(
+			p_payload, p_section, &(p_table[iii].value), &p_value
+		);
+		si_map_pair_t* p_pair = si_map_pair_new(p_key, p_value);
+		if ((true != cloned) || (NULL == p_pair))
+		{
+			free(p_key);
+			free(p_value);
+			free(p_pair);
+			// Undo the pairs already loaded, the map is left empty.
+			for (size_t jjj = 0u; jjj < iii; jjj++)
+			{
+				si_map_pair_t** const pp_pair = si_array_at(
+					&(p_map->entries.array), jjj
+				);
+				free((*pp_pair)->p_key);
+				free((*pp_pair)->p_value);
+				free(*pp_pair);
+				*pp_pair = NULL;
+			}
+			(void)si_array_resize(&(p_map->entries.array), old_capacity);
+			p_map->p_free_key_f = p_old_free_key_f;
+			p_map->p_free_value_f = p_old_free_value_f;
+			goto END;
+		}
+		// Keys were unique when saved so the O(n) collision check is skipped.
+		si_parray_set(&(p_map->entries), iii, p_pair);
+	}
+	result = true;
+END:
+	return result;
+}
+
+bool si_snapshot_load_hashmap(const si_snapshot_t* const p_snapshot,
+	const size_t index, si_hashmap_t* const p_hashmap)
+{
+	bool result = false;
+	if (NULL == p_hashmap)
+	{
+		goto END;
+	}
+	const si_snapshot_section_t* p_section = NULL;
+	const uint8_t* const p_payload = si_snapshot_payload_at(
+		p_snapshot, index, SI_SNAPSHOT_HASHMAP, &p_section
+	);
+	if (NULL == p_payload)
+	{
+		goto END;
+	}
+	const size_t entry_size = sizeof(si_snapshot_hash_entry_t);
+	if (((p_section->length / entry_size) < p_section->count) ||
+	    (0u >= p_section->element_size))
+	{
+		goto END;
+	}
+	si_hashmap_init(p_hashmap, (size_t)p_section->element_size);
+	if (NULL == p_hashmap->maps.p_data)
+	{
+		goto END;
+	}
+	const si_snapshot_hash_entry_t* const p_table =
+		(const si_snapshot_hash_entry_t*)p_payload;
+	bool did_load = true;
+	for (size_t iii = 0u; iii < p_section->count; iii++)
+	{
+		void* p_value = NULL;
+		did_load = si_snapshot_blob_clone(
+			p_payload, p_section, &(p_table[iii].value), &p_value
+		);
+		if (true == did_load)
+		{
+			did_load = si_hashmap_insert_hash(
+				p_hashmap, (size_t)p_table[iii].hash, p_value
+			);
+		}
+		if (true != did_load)
+		{
+			free(p_value);
+			break;
+		}
+	}
+	// Hand ownership of the cloned values to the bucket maps.
+	for (size_t iii = 0u; iii < p_hashmap->maps.capacity; iii++)
+	{
+		si_map_t** const pp_map = si_array_at(&(p_hashmap->maps), iii);
+		if ((NULL == pp_map) || (NULL == *pp_map))
+		{
+			continue;
+		}
+		(*pp_map)->p_free_value_f = free;
+	}
+	if (true != did_load)
+	{
+		// Frees the values inserted before the failure.
+		si_hashmap_free(p_hashmap);
+		goto END;
+	}
+	result = true;
+END:
+	return result;
+}
+
+void si_snapshot_free(si_snapshot_t* const p_snapshot)
+{
+	if (NULL == p_snapshot)
+	{
+		goto END;
+	}
+	si_array_free(&(p_snapshot->sections));
+	if (NULL == p_snapshot->p_data)
+	{
+		goto END;
+	}
+	if (true == p_snapshot->is_mapped)
+	{
+#if SI_SNAPSHOT_MMAP
+		(void)munmap(p_snapshot->p_data, p_snapshot->size);
+#endif// SI_SNAPSHOT_MMAP
+	}
+	else if (true == p_snapshot->is_owned)
+	{
+		free(p_snapshot->p_data);
+	}
+	p_snapshot->p_data = NULL;
+	p_snapshot->size = 0u;
+	p_snapshot->is_mapped = false;
+	p_snapshot->is_owned = false;
+END:
+	return;
+}
+
+void si_snapshot_fprint(FILE* const p_file,
+	const si_snapshot_t* const p_snapshot)
+{
+	if (NULL == p_file)
+	{
+		goto END;
+	}
+	if ((NULL == p_snapshot) || (NULL == p_snapshot->p_data))
+	{
+		fprintf(p_file, "NULL");
+		goto END;
+	}
+	const si_snapshot_header_t* const p_header =
+		(const si_snapshot_header_t*)p_snapshot->p_data;
+	fprintf(p_file, "{version: %u, ", (unsigned int)p_header->version);
+	fprintf(p_file, "checksum: 0x%08X, ", (unsigned int)p_header->checksum);
+	fprintf(p_file, "sections: [");
+	const size_t count = si_snapshot_count(p_snapshot);
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const si_snapshot_section_t* const p_section = si_snapshot_section_at(
+			p_snapshot, iii
+		);
+		if (NULL == p_section)
+		{
+			break;
+		}
+		fprintf(p_file, "{type: %u, count: %lu, length: %lu}",
+			(unsigned int)p_section->type,
+			(unsigned long)p_section->count, (unsigned long)p_section->length
+		);
+		if (iii < (count - 1u))
+		{
+			fprintf(p_file, ", ");
+		}
+	}
+	fprintf(p_file, "]}:%lu@%p", p_snapshot->size, (void*)p_snapshot->p_data);
+END:
+	return;
+}
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
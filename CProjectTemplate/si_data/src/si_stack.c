@@ -12,7 +12,9 @@ void si_stack_new_4(si_stack_t* p_stack, const size_t element_size,
 	{
 		memcpy(&(p_stack->settings), p_settings, sizeof(si_realloc_settings_t));
 	}
+	p_stack->p_inline = NULL;
 	si_array_init_3(&(p_stack->dynamic), element_size, initial_capacity);
+	si_realloc_stats_init(&(p_stack->stats));
 }
 inline void si_stack_new_3(si_stack_t* p_stack, const size_t element_size,
     const size_t initial_capacity)
@@ -25,6 +27,91 @@ inline void si_stack_new(si_stack_t* p_stack, const size_t element_size)
 	si_stack_new_3(p_stack, element_size, 0u);
 }
 
+void si_stack_init_inline_5(si_stack_t* p_stack, const size_t element_size,
+	void* const p_buffer, const size_t buffer_capacity,
+	const si_realloc_settings_t* p_settings)
+{
+	if (NULL == p_stack)
+	{
+		goto END;
+	}
+	si_stack_new_4(p_stack, element_size, 0u, p_settings);
+	if ((NULL == p_buffer) || (0u >= buffer_capacity))
+	{
+		goto END;
+	}
+	si_array_free(&(p_stack->dynamic));
+	p_stack->p_inline = p_buffer;
+	p_stack->dynamic.p_data = p_buffer;
+	p_stack->dynamic.capacity = buffer_capacity;
+END:
+	return;
+}
+inline void si_stack_init_inline(si_stack_t* p_stack,
+	const size_t element_size, void* const p_buffer,
+	const size_t buffer_capacity)
+{
+	// Default p_settings value is NULL (initializes with defaults)
+	si_stack_init_inline_5(p_stack, element_size, p_buffer, buffer_capacity,
+		NULL);
+}
+
+bool si_stack_is_inline(const si_stack_t* p_stack)
+{
+	bool is_inline = false;
+	if (NULL == p_stack)
+	{
+		goto END;
+	}
+	is_inline = ((NULL != p_stack->p_inline) &&
+		(p_stack->dynamic.p_data == p_stack->p_inline));
+END:
+	return is_inline;
+}
+
+/** Doxygen
+ * @brief Grows the stack's storage, moving items off the inline buffer.
+ *
+ * @param p_stack Pointer to the stack struct to grow.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_stack_grow(si_stack_t* p_stack)
+{
+	bool result = false;
+	const bool is_inline = si_stack_is_inline(p_stack);
+	if (true != is_inline)
+	{
+		result = si_realloc_settings_grow_3(
+			&(p_stack->settings), &(p_stack->dynamic), &(p_stack->stats)
+		);
+		goto END;
+	}
+	// The inline buffer is never realloc()'d, spill into a new heap buffer.
+	const size_t old_capacity = p_stack->dynamic.capacity;
+	const size_t new_capacity = si_realloc_settings_next_grow_capacity_3(
+		&(p_stack->settings), old_capacity, &(p_stack->stats)
+	);
+	if (new_capacity <= p_stack->dynamic.capacity)
+	{
+		goto END;
+	}
+	void* const p_heap = calloc(new_capacity, p_stack->dynamic.element_size);
+	if (NULL == p_heap)
+	{
+		goto END;
+	}
+	memcpy(p_heap, p_stack->p_inline,
+		p_stack->count * p_stack->dynamic.element_size);
+	p_stack->dynamic.p_data = p_heap;
+	p_stack->dynamic.capacity = new_capacity;
+	si_realloc_stats_record(&(p_stack->stats), old_capacity, new_capacity,
+		p_stack->count * p_stack->dynamic.element_size);
+	result = true;
+END:
+	return result;
+}
+
 bool si_stack_is_full(const si_stack_t* p_stack)
 {
 	bool is_full = true;
@@ -58,9 +145,7 @@ void si_stack_push(si_stack_t* p_stack, const void* p_item)
 	bool is_full = si_stack_is_full(p_stack);
 	if (true == is_full)
 	{
-		const bool did_grow = si_realloc_settings_grow(
-			&(p_stack->settings), &(p_stack->dynamic)
-		);
+		const bool did_grow = si_stack_grow(p_stack);
 		if (true != did_grow)
 		{
 			// Failed to grow
@@ -91,12 +176,15 @@ void si_stack_pop(si_stack_t* p_stack, void* p_item)
 		goto END;
 	}
 	si_array_get(&(p_stack->dynamic), p_stack->count - 1u, p_item);
-	const size_t next_shrink = si_realloc_settings_next_shrink_capacity(
-		&(p_stack->settings), p_stack->dynamic.capacity);
-	const bool safe_to_shrink = (p_stack->count <= next_shrink);
+	const size_t next_shrink = si_realloc_settings_next_shrink_capacity_3(
+		&(p_stack->settings), p_stack->dynamic.capacity, p_stack->count);
+	// The inline buffer is never shrunk.
+	const bool safe_to_shrink = ((p_stack->count <= next_shrink) &&
+		(true != si_stack_is_inline(p_stack)));
 	if (true == safe_to_shrink)
 	{
-		si_realloc_settings_shrink(&(p_stack->settings), &(p_stack->dynamic));
+		si_realloc_settings_shrink_4(&(p_stack->settings), &(p_stack->dynamic),
+			p_stack->count, &(p_stack->stats));
 	}
 	p_stack->count--;
 END:
@@ -109,7 +197,18 @@ void si_stack_free(si_stack_t* p_stack)
 	{
 		goto END;
 	}
-	si_array_free(&(p_stack->dynamic));
+	const bool is_inline = si_stack_is_inline(p_stack);
+	if (true == is_inline)
+	{
+		// Caller owns the inline buffer.
+		p_stack->dynamic.p_data = NULL;
+		p_stack->dynamic.capacity = 0u;
+	}
+	else
+	{
+		si_array_free(&(p_stack->dynamic));
+	}
+	p_stack->count = 0u;
 END:
 	return;
 }
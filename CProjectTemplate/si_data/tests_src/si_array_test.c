@@ -1,4 +1,6 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "unity.h"
 
@@ -24,10 +26,152 @@ void si_array_test_main(void)
 	char_array_free(&array);
 }
 
+void si_array_test_range(void)
+{
+	const char letters[] = "abcdef";
+	char buffer[8] = {0};
+	char_array_t array = {0};
+	char_array_init_2(&array, 6u);
+
+	printf("Testing set_range() & get_range():\n");
+	TEST_ASSERT_FALSE(char_array_set_range(&array, 1u, letters, 6u));
+	TEST_ASSERT_TRUE(char_array_set_range(&array, 0u, letters, 6u));
+	TEST_ASSERT_TRUE(char_array_get_range(&array, 2u, buffer, 4u));
+	TEST_ASSERT_EQUAL_STRING("cdef", buffer);
+
+	printf("Testing insert_range() & erase_range():\n");
+	TEST_ASSERT_TRUE(char_array_insert_range(&array, 3u, "XYZ", 3u));
+	TEST_ASSERT_EQUAL_size_t(9u, array.capacity);
+	TEST_ASSERT_EQUAL_MEMORY("abcXYZdef", array.p_data, 9u);
+	// Insert from within the buffer itself.
+	TEST_ASSERT_TRUE(char_array_insert_range(&array, 0u, array.p_data, 2u));
+	TEST_ASSERT_EQUAL_MEMORY("ababcXYZdef", array.p_data, 11u);
+	TEST_ASSERT_FALSE(char_array_erase_range(&array, 10u, 2u));
+	TEST_ASSERT_TRUE(char_array_erase_range(&array, 0u, 5u));
+	TEST_ASSERT_EQUAL_MEMORY("XYZdef", array.p_data, 6u);
+
+	printf("Testing fill():\n");
+	TEST_ASSERT_TRUE(char_array_fill(&array, 1u, '-', 4u));
+	TEST_ASSERT_EQUAL_MEMORY("X----f", array.p_data, 6u);
+	char_array_free(&array);
+
+	si_array_t wide = {0};
+	si_array_init_3(&wide, 3u, 5u);
+	TEST_ASSERT_TRUE(si_array_fill(&wide, 0u, "ab", 5u));
+	TEST_ASSERT_EQUAL_MEMORY("ab\0ab\0ab\0ab\0ab\0", wide.p_data, 15u);
+	si_array_free(&wide);
+}
+
+void si_array_test_find(void)
+{
+	const size_t count = 100u;
+	const size_t sizes[] = { 1u, 2u, 3u, 4u, 8u };
+	for (size_t iii = 0u; iii < (sizeof(sizes) / sizeof(sizes[0])); iii++)
+	{
+		const uint64_t needle = 0x0102030405060708ull;
+		si_array_t array = {0};
+		si_array_init_3(&array, sizes[iii], count);
+		TEST_ASSERT_EQUAL_size_t(SIZE_MAX, si_array_find(&array, &needle));
+		// Near matches must not be reported for multi-byte elements.
+		uint8_t partial[8] = {0};
+		memcpy(partial, &needle, 1u);
+		si_array_set(&array, 10u, partial);
+		if (1u < sizes[iii])
+		{
+			TEST_ASSERT_EQUAL_size_t(SIZE_MAX, si_array_find(&array, &needle));
+		}
+		si_array_set(&array, 37u, &needle);
+		si_array_set(&array, 98u, &needle);
+		const size_t expected = (1u == sizes[iii]) ? 10u : 37u;
+		TEST_ASSERT_EQUAL_size_t(expected, si_array_find(&array, &needle));
+		TEST_ASSERT_EQUAL_size_t(98u, si_array_find_3(&array, &needle, 38u));
+		TEST_ASSERT_EQUAL_size_t(SIZE_MAX, si_array_find_3(&array, &needle, 99u));
+		TEST_ASSERT_EQUAL_size_t(SIZE_MAX, si_array_find_3(&array, &needle, count));
+		si_array_free(&array);
+	}
+}
+
+static int si_array_test_cmp_int64(const void* const p_left,
+	const void* const p_right)
+{
+	const int64_t left = *(const int64_t*)p_left;
+	const int64_t right = *(const int64_t*)p_right;
+	return (left > right) - (left < right);
+}
+
+void si_array_test_sort(void)
+{
+	const size_t count = 5000u;
+	si_array_t array = {0};
+	si_array_t expected = {0};
+	si_array_init_3(&array, sizeof(int64_t), count);
+	si_array_init_3(&expected, sizeof(int64_t), count);
+	uint64_t state = 42u;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		state = (state * 6364136223846793005ull) + 1442695040888963407ull;
+		// Mix of negatives and plenty of duplicates.
+		const int64_t value = ((int64_t)(state >> 33) % 1000) - 500;
+		si_array_set(&array, iii, &value);
+	}
+	memcpy(expected.p_data, array.p_data, count * sizeof(int64_t));
+	qsort(expected.p_data, count, sizeof(int64_t), si_array_test_cmp_int64);
+
+	printf("Testing sort():\n");
+	si_array_t copy = {0};
+	si_array_init_3(&copy, sizeof(int64_t), count);
+	memcpy(copy.p_data, array.p_data, count * sizeof(int64_t));
+	TEST_ASSERT_TRUE(si_array_sort(&copy, si_array_test_cmp_int64));
+	TEST_ASSERT_EQUAL_MEMORY(expected.p_data, copy.p_data, count * sizeof(int64_t));
+	// Already sorted & reversed input must not degrade or misorder.
+	TEST_ASSERT_TRUE(si_array_sort(&copy, si_array_test_cmp_int64));
+	TEST_ASSERT_EQUAL_MEMORY(expected.p_data, copy.p_data, count * sizeof(int64_t));
+
+	printf("Testing sort_radix():\n");
+	memcpy(copy.p_data, array.p_data, count * sizeof(int64_t));
+	TEST_ASSERT_TRUE(si_array_sort_radix_2(&copy, true));
+	TEST_ASSERT_EQUAL_MEMORY(expected.p_data, copy.p_data, count * sizeof(int64_t));
+	TEST_ASSERT_FALSE(si_array_sort_radix_4(&copy, 4u, 8u, false));
+
+	printf("Testing bsearch():\n");
+	const int64_t present = *(const int64_t*)si_array_at(&expected, 1234u);
+	const size_t found = si_array_bsearch(&copy, &present, si_array_test_cmp_int64);
+	TEST_ASSERT_NOT_EQUAL(SIZE_MAX, found);
+	TEST_ASSERT_EQUAL_INT64(present, *(const int64_t*)si_array_at(&copy, found));
+	if (0u < found)
+	{
+		TEST_ASSERT_TRUE(present > *(const int64_t*)si_array_at(&copy, found - 1u));
+	}
+	const int64_t missing = 100000;
+	TEST_ASSERT_EQUAL_size_t(
+		SIZE_MAX, si_array_bsearch(&copy, &missing, si_array_test_cmp_int64)
+	);
+	TEST_ASSERT_EQUAL_size_t(
+		count, si_array_lower_bound(&copy, &missing, si_array_test_cmp_int64)
+	);
+	si_array_free(&copy);
+	si_array_free(&expected);
+	si_array_free(&array);
+
+	// Records are ordered by a key inside them & the radix pass is stable.
+	uint16_t records[6][2] = {
+		{ 3u, 0u }, { 1u, 1u }, { 3u, 2u }, { 2u, 3u }, { 1u, 4u }, { 0u, 5u }
+	};
+	const uint16_t sorted[6][2] = {
+		{ 0u, 5u }, { 1u, 1u }, { 1u, 4u }, { 2u, 3u }, { 3u, 0u }, { 3u, 2u }
+	};
+	si_array_t view = { records, sizeof(records[0]), 6u };
+	TEST_ASSERT_TRUE(si_array_sort_radix_4(&view, 0u, sizeof(uint16_t), false));
+	TEST_ASSERT_EQUAL_MEMORY(sorted, records, sizeof(records));
+}
+
 void si_array_test_all(void)
 {
 	UNITY_BEGIN();
 	RUN_TEST(si_array_test_main);
+	RUN_TEST(si_array_test_range);
+	RUN_TEST(si_array_test_find);
+	RUN_TEST(si_array_test_sort);
 	UNITY_END();
 }
 
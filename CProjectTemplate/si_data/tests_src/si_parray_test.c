@@ -125,6 +125,92 @@ void parray_test_modify(void)
 
 	si_parray_destroy(&p_array);
 	TEST_ASSERT_NULL(p_array);
+
+	printf("Testing remove_at with owned values: ");
+	si_parray_t owner = {0};
+	si_parray_init(&owner);
+	for (size_t iii = 0u; iii < 4u; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(iii, si_parray_append_clone(
+			&owner, &data[iii], sizeof(int)
+		));
+	}
+	// Removing from the middle must shift later values, not free them.
+	TEST_ASSERT_TRUE(si_parray_remove_at(&owner, 1u));
+	TEST_ASSERT_EQUAL_size_t(3u, si_parray_count(&owner));
+	TEST_ASSERT_EQUAL_INT(data[2], *(int*)si_parray_at(&owner, 1u));
+	TEST_ASSERT_EQUAL_INT(data[3], *(int*)si_parray_at(&owner, 2u));
+	TEST_ASSERT_TRUE(si_parray_remove_at(&owner, 2u));
+	TEST_ASSERT_EQUAL_size_t(2u, si_parray_count(&owner));
+	si_parray_free(&owner);
+	printf("Done.\n");
+}
+
+/** Doxygen
+ * @brief Appends count values, then bounces the count across a capacity
+ *        boundary by removing & re-appending the last value.
+ *
+ * @param p_settings Pointer to the realloc settings the array uses.
+ * @param count Number of values to append.
+ * @param bounces Number of remove & append pairs.
+ *
+ * @return Returns the resize history of the array.
+ */
+static si_realloc_stats_t parray_test_churn(si_realloc_settings_t* p_settings,
+	const size_t count, const size_t bounces)
+{
+	static int value = 42;
+	si_parray_t pointer_array = {0};
+	si_parray_init(&pointer_array);
+	pointer_array.p_settings = p_settings;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(iii, si_parray_append(&pointer_array, &value));
+	}
+	for (size_t iii = 0u; iii < bounces; iii++)
+	{
+		TEST_ASSERT_TRUE(si_parray_remove_at(&pointer_array, count - 1u));
+		TEST_ASSERT_EQUAL_size_t(
+			count - 1u, si_parray_append(&pointer_array, &value)
+		);
+	}
+	const si_realloc_stats_t stats = pointer_array.stats;
+	si_parray_free(&pointer_array);
+	return stats;
+}
+
+/** Doxygen
+ * @brief Tests resize statistics & the adaptive resize mode.
+ */
+void parray_test_stats(void)
+{
+	si_realloc_settings_t settings = {0};
+	si_realloc_settings_new(&settings);
+
+	// Linear steps of 32 take a grow per 32 appends.
+	si_realloc_stats_t stats = parray_test_churn(&settings, 1000u, 0u);
+	TEST_ASSERT_EQUAL_size_t(32u, stats.grow_count);
+	TEST_ASSERT_EQUAL_size_t(0u, stats.shrink_count);
+	TEST_ASSERT_EQUAL_size_t(1024u, stats.peak_capacity);
+
+	// Back to back grows double the step, up to 8 times.
+	settings.is_adaptive = true;
+	stats = parray_test_churn(&settings, 1000u, 0u);
+	TEST_ASSERT_EQUAL_size_t(7u, stats.grow_count);
+	TEST_ASSERT_EQUAL_size_t(1248u, stats.peak_capacity);
+
+	// A count bouncing over a boundary resizes on every crossing...
+	settings.is_adaptive = false;
+	stats = parray_test_churn(&settings, 33u, 10u);
+	TEST_ASSERT_EQUAL_size_t(12u, stats.grow_count);
+	TEST_ASSERT_EQUAL_size_t(10u, stats.shrink_count);
+	// ...unless shrinks wait for the count to fall well below the boundary.
+	// The doubled step (96) is trimmed once, then bounces never resize.
+	settings.is_adaptive = true;
+	stats = parray_test_churn(&settings, 33u, 10u);
+	TEST_ASSERT_EQUAL_size_t(2u, stats.grow_count);
+	TEST_ASSERT_EQUAL_size_t(1u, stats.shrink_count);
+	TEST_ASSERT_EQUAL_size_t(96u, stats.peak_capacity);
 }
 
 /** Doxygen
@@ -135,6 +221,7 @@ void parray_test_all(void)
 	UNITY_BEGIN();
 	RUN_TEST(parray_test_init);
 	RUN_TEST(parray_test_modify);
+	RUN_TEST(parray_test_stats);
 	UNITY_END();
 }
 
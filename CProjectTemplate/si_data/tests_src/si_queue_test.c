@@ -69,6 +69,7 @@ void si_queue_test_modify(void)
 
 
 #define SI_TEMPLATE_TYPE char
+#define SI_TEMPLATE_INLINE_CAPACITY 4u
 #include "si_queue.template"
 
 void si_queue_test_template(void)
@@ -112,12 +113,64 @@ void si_queue_test_template(void)
 	p_queue = NULL;
 }
 
+void si_queue_test_inline(void)
+{
+	char_queue_inline_t storage = {0};
+	char_queue_t* const p_queue = char_queue_inline_init(&storage);
+	TEST_ASSERT_TRUE(char_queue_is_inline(p_queue));
+	TEST_ASSERT_EQUAL_size_t(4u, si_queue_capacity(p_queue));
+
+	// Wrap the ring around the inline buffer before it has to spill.
+	char next_in = 'a';
+	char next_out = 'a';
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		char_queue_enqueue(p_queue, next_in++);
+	}
+	for (size_t iii = 0u; iii < 2u; iii++)
+	{
+		TEST_ASSERT_EQUAL_CHAR(next_out++, char_queue_dequeue(p_queue));
+	}
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		char_queue_enqueue(p_queue, next_in++);
+	}
+	TEST_ASSERT_TRUE(char_queue_is_full(p_queue));
+	TEST_ASSERT_TRUE(char_queue_is_inline(p_queue));
+
+	printf("Testing spill to heap:\n");
+	for (size_t iii = 0u; iii < 6u; iii++)
+	{
+		char_queue_enqueue(p_queue, next_in++);
+	}
+	TEST_ASSERT_FALSE(char_queue_is_inline(p_queue));
+	TEST_ASSERT_EQUAL_size_t(10u, char_queue_count(p_queue));
+	// Wrap the heap ring too, then force it to grow again.
+	for (size_t iii = 0u; iii < 8u; iii++)
+	{
+		TEST_ASSERT_EQUAL_CHAR(next_out++, char_queue_dequeue(p_queue));
+	}
+	const size_t heap_capacity = si_queue_capacity(p_queue);
+	while (char_queue_count(p_queue) <= heap_capacity)
+	{
+		char_queue_enqueue(p_queue, next_in++);
+	}
+	while (false == char_queue_is_empty(p_queue))
+	{
+		TEST_ASSERT_EQUAL_CHAR(next_out++, char_queue_dequeue(p_queue));
+	}
+	TEST_ASSERT_EQUAL_CHAR(next_in, next_out);
+	char_queue_free(p_queue);
+	TEST_ASSERT_NULL(p_queue->array.p_data);
+}
+
 void si_queue_test_all(void)
 {
 	UNITY_BEGIN();
 	RUN_TEST(si_queue_test_init);
 	RUN_TEST(si_queue_test_modify);
 	RUN_TEST(si_queue_test_template);
+	RUN_TEST(si_queue_test_inline);
 	UNITY_END();
 }
 
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "si_singular_blist.h"
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+/** Doxygen
+ * @brief Tests creation and destruction only.
+ */
+void singular_blist_test_init(void)
+{
+	const size_t initial_capacity = 2u;
+	si_singular_blist_t* p_list = si_singular_blist_new_2(
+		false, initial_capacity
+	);
+	TEST_ASSERT_NOT_NULL(p_list);
+	TEST_ASSERT_EQUAL_size_t(initial_capacity, p_list->capacity);
+	TEST_ASSERT_EQUAL_size_t(0u, p_list->count);
+	TEST_ASSERT_NOT_NULL(p_list->p_head);
+	TEST_ASSERT_EQUAL_PTR(p_list->p_head->p_next, p_list->p_tail);
+	si_singular_blist_free(p_list);
+}
+
+/** Doxygen
+ * @brief Returns a heap copy of value, lists free their data.
+ */
+static int* singular_blist_test_int(const int value)
+{
+	int* const p_value = calloc(1u, sizeof(int));
+	TEST_ASSERT_NOT_NULL(p_value);
+	*p_value = value;
+	return p_value;
+}
+
+/** Doxygen
+ * @brief Removes index from p_list & frees the data it held.
+ */
+static bool singular_blist_test_remove_at(si_singular_blist_t* const p_list,
+	const size_t index)
+{
+	void* const p_data = si_singular_blist_at(p_list, index);
+	const bool result = si_singular_blist_remove_at(p_list, index);
+	if (true == result)
+	{
+		free(p_data);
+	}
+	return result;
+}
+
+/** Doxygen
+ * @brief Tests the tail stays valid across removals & appends.
+ */
+void singular_blist_test_modify(void)
+{
+	si_singular_blist_t* p_list = si_singular_blist_new_2(false, 1u);
+	TEST_ASSERT_NOT_NULL(p_list);
+	TEST_ASSERT_EQUAL_size_t(
+		0u, si_singular_blist_push(p_list, singular_blist_test_int(1))
+	);
+	TEST_ASSERT_TRUE(si_singular_blist_append(
+		p_list, singular_blist_test_int(2)
+	));
+	TEST_ASSERT_TRUE(si_singular_blist_append(
+		p_list, singular_blist_test_int(3)
+	));
+	TEST_ASSERT_EQUAL_size_t(3u, p_list->count);
+	TEST_ASSERT_EQUAL_INT(3, *((int*)p_list->p_tail->p_data));
+
+	printf("Testing remove_at() of the tail then append():\n");
+	TEST_ASSERT_FALSE(singular_blist_test_remove_at(p_list, 3u));
+	TEST_ASSERT_TRUE(singular_blist_test_remove_at(p_list, 2u));
+	TEST_ASSERT_EQUAL_size_t(2u, p_list->count);
+	TEST_ASSERT_EQUAL_INT(2, *((int*)p_list->p_tail->p_data));
+	TEST_ASSERT_NULL(p_list->p_tail->p_next);
+	TEST_ASSERT_TRUE(si_singular_blist_append(
+		p_list, singular_blist_test_int(4)
+	));
+	TEST_ASSERT_EQUAL_INT(4, *((int*)si_singular_blist_at(p_list, 2u)));
+	TEST_ASSERT_EQUAL_INT(4, *((int*)p_list->p_tail->p_data));
+
+	printf("Testing remove_at() of the head:\n");
+	TEST_ASSERT_TRUE(singular_blist_test_remove_at(p_list, 0u));
+	TEST_ASSERT_TRUE(singular_blist_test_remove_at(p_list, 0u));
+	TEST_ASSERT_EQUAL_PTR(p_list->p_head, p_list->p_tail);
+	TEST_ASSERT_TRUE(singular_blist_test_remove_at(p_list, 0u));
+	TEST_ASSERT_NULL(p_list->p_head);
+	TEST_ASSERT_NULL(p_list->p_tail);
+	TEST_ASSERT_EQUAL_size_t(0u, p_list->count);
+	TEST_ASSERT_FALSE(singular_blist_test_remove_at(p_list, 0u));
+	TEST_ASSERT_TRUE(si_singular_blist_append(
+		p_list, singular_blist_test_int(5)
+	));
+	TEST_ASSERT_EQUAL_INT(5, *((int*)si_singular_blist_at(p_list, 0u)));
+	TEST_ASSERT_EQUAL_size_t(1u, p_list->count);
+
+	si_singular_blist_free(p_list);
+}
+
+/** Doxygen
+ * @brief Runs all unity tests available.
+ */
+void singular_blist_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(singular_blist_test_init);
+	RUN_TEST(singular_blist_test_modify);
+	UNITY_END();
+}
+
+int main(void)
+{
+	printf("Start of si_singular_blist unit test.\n");
+	singular_blist_test_all();
+	printf("End of si_singular_blist unit test.\n");
+}
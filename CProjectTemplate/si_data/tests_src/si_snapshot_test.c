@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+#include "si_snapshot.h"
+
+static const char* const SNAPSHOT_TEST_PATH = "./si_snapshot_test.bin";
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+	(void)remove(SNAPSHOT_TEST_PATH);
+}
+
+static size_t si_snapshot_test_int_size(const void* const p_value)
+{
+	(void)p_value;
+	return sizeof(int);
+}
+
+static size_t si_snapshot_test_str_size(const void* const p_value)
+{
+	return strlen((const char*)p_value) + 1u;
+}
+
+void si_snapshot_test_round_trip(void)
+{
+	const size_t count = 1000u;
+	int values[] = { 6, 7, 8, 9, 42 };
+	const char* keys[] = { "six", "seven", "eight", "nine", "answer" };
+	const size_t values_size = 5u;
+
+	si_array_t array = {0};
+	si_array_init_3(&array, sizeof(int), count);
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const int value = (int)(iii * 3u);
+		si_array_set(&array, iii, &value);
+	}
+	si_parray_t parray = {0};
+	si_parray_init(&parray);
+	si_map_t map = {0};
+	si_map_init(&map);
+	map.p_cmp_key_f = (int (*)(const void* const, const void* const))strcmp;
+	si_hashmap_t hashmap = {0};
+	si_hashmap_init(&hashmap, 16u);
+	for (size_t iii = 0u; iii < values_size; iii++)
+	{
+		TEST_ASSERT_NOT_EQUAL_size_t(
+			SIZE_MAX, si_parray_append(&parray, &(values[iii]))
+		);
+		TEST_ASSERT_TRUE(si_map_insert(&map, keys[iii], &(values[iii])));
+		TEST_ASSERT_TRUE(si_hashmap_insert_hash(
+			&hashmap, (size_t)values[iii], keys[iii]
+		));
+	}
+
+	printf("Testing writer:\n");
+	FILE* p_file = fopen(SNAPSHOT_TEST_PATH, "wb");
+	TEST_ASSERT_NOT_NULL(p_file);
+	si_snapshot_writer_t writer = {0};
+	TEST_ASSERT_FALSE(si_snapshot_writer_init(NULL, p_file));
+	TEST_ASSERT_TRUE(si_snapshot_writer_init(&writer, p_file));
+	TEST_ASSERT_TRUE(si_snapshot_write_array(&writer, &array));
+	TEST_ASSERT_FALSE(si_snapshot_write_parray(&writer, &parray, NULL));
+	TEST_ASSERT_TRUE(si_snapshot_write_parray(
+		&writer, &parray, si_snapshot_test_int_size
+	));
+	TEST_ASSERT_TRUE(si_snapshot_write_map(
+		&writer, &map, si_snapshot_test_str_size, si_snapshot_test_int_size
+	));
+	TEST_ASSERT_TRUE(si_snapshot_write_hashmap(
+		&writer, &hashmap, si_snapshot_test_str_size
+	));
+	TEST_ASSERT_TRUE(si_snapshot_writer_finish(&writer));
+	fclose(p_file);
+
+	printf("Testing open():\n");
+	si_snapshot_t snapshot = {0};
+	TEST_ASSERT_FALSE(si_snapshot_open(&snapshot, "./does_not_exist.bin"));
+	TEST_ASSERT_TRUE(si_snapshot_open(&snapshot, SNAPSHOT_TEST_PATH));
+	TEST_ASSERT_EQUAL_size_t(4u, si_snapshot_count(&snapshot));
+	si_snapshot_fprint(stdout, &snapshot);
+	printf("\n");
+
+	printf("Testing array_data() & load_array():\n");
+	size_t loaded_count = 0u;
+	const int* p_ints = si_snapshot_array_data(&snapshot, 0u, &loaded_count);
+	TEST_ASSERT_NOT_NULL(p_ints);
+	TEST_ASSERT_EQUAL_size_t(count, loaded_count);
+	TEST_ASSERT_EQUAL_INT(999 * 3, p_ints[999]);
+	TEST_ASSERT_NULL(si_snapshot_array_data(&snapshot, 1u, NULL));
+	si_array_t loaded_array = {0};
+	TEST_ASSERT_TRUE(si_snapshot_load_array(&snapshot, 0u, &loaded_array));
+	TEST_ASSERT_EQUAL_INT(0, si_array_cmp(&array, &loaded_array));
+
+	printf("Testing load_parray():\n");
+	si_parray_t loaded_parray = {0};
+	TEST_ASSERT_FALSE(si_snapshot_load_parray(&snapshot, 0u, &loaded_parray));
+	TEST_ASSERT_TRUE(si_snapshot_load_parray(&snapshot, 1u, &loaded_parray));
+	TEST_ASSERT_EQUAL_size_t(values_size, si_parray_count(&loaded_parray));
+	TEST_ASSERT_EQUAL_INT(42, *((int*)si_parray_at(&loaded_parray, 4u)));
+
+	printf("Testing load_map():\n");
+	si_map_t loaded_map = {0};
+	si_map_init(&loaded_map);
+	loaded_map.p_cmp_key_f = map.p_cmp_key_f;
+	TEST_ASSERT_TRUE(si_snapshot_load_map(&snapshot, 2u, &loaded_map));
+	TEST_ASSERT_EQUAL_size_t(values_size, si_map_count(&loaded_map));
+	TEST_ASSERT_EQUAL_INT(42, *((int*)si_map_at(&loaded_map, "answer")));
+
+	printf("Testing load_hashmap():\n");
+	si_hashmap_t loaded_hashmap = {0};
+	TEST_ASSERT_TRUE(si_snapshot_load_hashmap(&snapshot, 3u, &loaded_hashmap));
+	TEST_ASSERT_EQUAL_size_t(values_size, si_hashmap_count(&loaded_hashmap));
+	TEST_ASSERT_EQUAL_STRING(
+		"answer", (const char*)si_hashmap_at_hash(&loaded_hashmap, 42u)
+	);
+
+	si_hashmap_free(&loaded_hashmap);
+	si_map_free(&loaded_map);
+	si_parray_free(&loaded_parray);
+	si_array_free(&loaded_array);
+	si_snapshot_free(&snapshot);
+	TEST_ASSERT_NULL(snapshot.p_data);
+
+	si_hashmap_free(&hashmap);
+	si_map_free(&map);
+	si_parray_free(&parray);
+	si_array_free(&array);
+}
+
+// Plain Adler-32 so tests can re-sign bytes they tamper with.
+static uint32_t si_snapshot_test_adler(const uint8_t* p_bytes, size_t size)
+{
+	uint32_t sum_a = 1u;
+	uint32_t sum_b = 0u;
+	while (0u < size--)
+	{
+		sum_a = (sum_a + *(p_bytes++)) % 65521u;
+		sum_b = (sum_b + sum_a) % 65521u;
+	}
+	return (sum_b << 16u) | sum_a;
+}
+
+void si_snapshot_test_corrupt(void)
+{
+	const int value = 42;
+	si_array_t array = {0};
+	si_array_init_3(&array, sizeof(int), 4u);
+	si_array_set(&array, 2u, &value);
+
+	FILE* p_file = fopen(SNAPSHOT_TEST_PATH, "w+b");
+	TEST_ASSERT_NOT_NULL(p_file);
+	si_snapshot_writer_t writer = {0};
+	TEST_ASSERT_TRUE(si_snapshot_writer_init(&writer, p_file));
+	TEST_ASSERT_TRUE(si_snapshot_write_array(&writer, &array));
+	TEST_ASSERT_TRUE(si_snapshot_writer_finish(&writer));
+
+	uint8_t buffer[256] = {0};
+	rewind(p_file);
+	const size_t size = fread(buffer, 1u, sizeof(buffer), p_file);
+	fclose(p_file);
+
+	printf("Testing open_buffer():\n");
+	si_snapshot_t snapshot = {0};
+	TEST_ASSERT_FALSE(si_snapshot_open_buffer(&snapshot, NULL, size));
+	TEST_ASSERT_FALSE(si_snapshot_open_buffer(&snapshot, buffer, 8u));
+	TEST_ASSERT_TRUE(si_snapshot_open_buffer(&snapshot, buffer, size));
+	si_snapshot_free(&snapshot);
+
+	// Flip a payload byte so the checksum no longer matches.
+	buffer[size - 8u] ^= 0xFFu;
+	TEST_ASSERT_FALSE(si_snapshot_open_buffer(&snapshot, buffer, size));
+	buffer[size - 8u] ^= 0xFFu;
+	// Signed section whose element_size * count wraps around to its length.
+	si_snapshot_header_t header = {0};
+	memcpy(&header, buffer, sizeof(header));
+	si_snapshot_section_t section = {0};
+	memcpy(&section, buffer + sizeof(header), sizeof(section));
+	section.element_size = (UINT64_MAX / section.count) + 1u + sizeof(int);
+	TEST_ASSERT_EQUAL_UINT64(
+		section.length, section.element_size * section.count
+	);
+	memcpy(buffer + sizeof(header), &section, sizeof(section));
+	header.checksum = si_snapshot_test_adler(
+		buffer + sizeof(header), (size_t)header.body_size
+	);
+	memcpy(buffer, &header, sizeof(header));
+	TEST_ASSERT_TRUE(si_snapshot_open_buffer(&snapshot, buffer, size));
+	TEST_ASSERT_NULL(si_snapshot_array_data(&snapshot, 0u, NULL));
+	si_array_t loaded_array = {0};
+	TEST_ASSERT_FALSE(si_snapshot_load_array(&snapshot, 0u, &loaded_array));
+	si_snapshot_free(&snapshot);
+	// Wrong magic
+	buffer[0] = 'X';
+	TEST_ASSERT_FALSE(si_snapshot_open_buffer(&snapshot, buffer, size));
+
+	si_array_free(&array);
+}
+
+void si_snapshot_test_partial(void)
+{
+	int values[] = { 6, 7, 8 };
+	const char* keys[] = { "six", "seven", "eight" };
+	const size_t values_size = 3u;
+	si_map_t map = {0};
+	si_map_init(&map);
+	map.p_cmp_key_f = (int (*)(const void* const, const void* const))strcmp;
+	si_hashmap_t hashmap = {0};
+	si_hashmap_init(&hashmap, 16u);
+	for (size_t iii = 0u; iii < values_size; iii++)
+	{
+		TEST_ASSERT_TRUE(si_map_insert(&map, keys[iii], &(values[iii])));
+		TEST_ASSERT_TRUE(si_hashmap_insert_hash(
+			&hashmap, (size_t)values[iii], keys[iii]
+		));
+	}
+
+	FILE* p_file = fopen(SNAPSHOT_TEST_PATH, "w+b");
+	TEST_ASSERT_NOT_NULL(p_file);
+	si_snapshot_writer_t writer = {0};
+	TEST_ASSERT_TRUE(si_snapshot_writer_init(&writer, p_file));
+	TEST_ASSERT_TRUE(si_snapshot_write_map(
+		&writer, &map, si_snapshot_test_str_size, si_snapshot_test_int_size
+	));
+	TEST_ASSERT_TRUE(si_snapshot_write_hashmap(
+		&writer, &hashmap, si_snapshot_test_str_size
+	));
+	TEST_ASSERT_TRUE(si_snapshot_writer_finish(&writer));
+
+	uint8_t buffer[1024] = {0};
+	rewind(p_file);
+	const size_t size = fread(buffer, 1u, sizeof(buffer), p_file);
+	fclose(p_file);
+	TEST_ASSERT_TRUE(size < sizeof(buffer));
+
+	// Points the last value of each section past its payload & re-signs.
+	si_snapshot_t snapshot = {0};
+	TEST_ASSERT_TRUE(si_snapshot_open_buffer(&snapshot, buffer, size));
+	for (size_t iii = 0u; iii < 2u; iii++)
+	{
+		uint8_t* const p_bytes = buffer +
+			*(size_t*)si_array_at(&(snapshot.sections), iii);
+		si_snapshot_section_t section = {0};
+		memcpy(&section, p_bytes, sizeof(section));
+		TEST_ASSERT_EQUAL_UINT64(values_size, section.count);
+		const size_t entry_size = (0u == iii) ?
+			sizeof(si_snapshot_pair_t) : sizeof(si_snapshot_hash_entry_t);
+		uint8_t* const p_last = p_bytes + sizeof(section) +
+			(entry_size * (values_size - 1u));
+		si_snapshot_blob_t* const p_value = (si_snapshot_blob_t*)(
+			p_last + entry_size - sizeof(si_snapshot_blob_t)
+		);
+		p_value->offset = section.length + 1u;
+	}
+	si_snapshot_free(&snapshot);
+	si_snapshot_header_t header = {0};
+	memcpy(&header, buffer, sizeof(header));
+	header.checksum = si_snapshot_test_adler(
+		buffer + sizeof(header), (size_t)header.body_size
+	);
+	memcpy(buffer, &header, sizeof(header));
+	TEST_ASSERT_TRUE(si_snapshot_open_buffer(&snapshot, buffer, size));
+
+	printf("Testing load_map() roll back:\n");
+	si_map_t loaded_map = {0};
+	si_map_init(&loaded_map);
+	loaded_map.p_cmp_key_f = map.p_cmp_key_f;
+	const size_t capacity = loaded_map.entries.array.capacity;
+	TEST_ASSERT_FALSE(si_snapshot_load_map(&snapshot, 0u, &loaded_map));
+	TEST_ASSERT_EQUAL_size_t(0u, si_map_count(&loaded_map));
+	TEST_ASSERT_EQUAL_size_t(capacity, loaded_map.entries.array.capacity);
+	TEST_ASSERT_NULL(loaded_map.p_free_key_f);
+	TEST_ASSERT_NULL(loaded_map.p_free_value_f);
+
+	printf("Testing load_hashmap() roll back:\n");
+	si_hashmap_t loaded_hashmap = {0};
+	TEST_ASSERT_FALSE(si_snapshot_load_hashmap(&snapshot, 1u, &loaded_hashmap));
+	TEST_ASSERT_NULL(loaded_hashmap.maps.p_data);
+
+	si_map_free(&loaded_map);
+	si_snapshot_free(&snapshot);
+	si_hashmap_free(&hashmap);
+	si_map_free(&map);
+}
+
+void si_snapshot_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_snapshot_test_round_trip);
+	RUN_TEST(si_snapshot_test_corrupt);
+	RUN_TEST(si_snapshot_test_partial);
+	UNITY_END();
+}
+
+int main(void)
+{
+	printf("Start of si_snapshot unit test.\n");
+	si_snapshot_test_all();
+	printf("End of si_snapshot unit test.\n");
+	return 0;
+}
@@ -31,6 +31,7 @@ void si_stack_test_modify(void)
 
 
 #define SI_TEMPLATE_TYPE int
+#define SI_TEMPLATE_INLINE_CAPACITY 4u
 #include "si_stack.template"
 
 void si_stack_test_template(void)
@@ -50,11 +51,79 @@ void si_stack_test_template(void)
 	int_stack_free(&stack);
 }
 
+void si_stack_test_inline(void)
+{
+	int_stack_inline_t storage = {0};
+	int_stack_t* const p_stack = int_stack_inline_init(&storage);
+	TEST_ASSERT_TRUE(int_stack_is_inline(p_stack));
+	for (int iii = 0; iii < 4; iii++)
+	{
+		int_stack_push(p_stack, iii);
+	}
+	TEST_ASSERT_TRUE(int_stack_is_full(p_stack));
+	TEST_ASSERT_TRUE(int_stack_is_inline(p_stack));
+	TEST_ASSERT_EQUAL_INT(3, storage.buffer[3]);
+
+	printf("Testing spill to heap:\n");
+	for (int iii = 4; iii < 10; iii++)
+	{
+		int_stack_push(p_stack, iii);
+	}
+	TEST_ASSERT_FALSE(int_stack_is_inline(p_stack));
+	TEST_ASSERT_EQUAL_size_t(10u, p_stack->count);
+	for (int iii = 9; iii >= 0; iii--)
+	{
+		TEST_ASSERT_EQUAL_INT(iii, int_stack_pop(p_stack));
+	}
+	TEST_ASSERT_TRUE(int_stack_is_empty(p_stack));
+	int_stack_free(p_stack);
+	TEST_ASSERT_NULL(p_stack->dynamic.p_data);
+}
+
+/** Doxygen
+ * @brief Tests pops hand the stack's count to adaptive shrinks.
+ */
+void si_stack_test_adaptive(void)
+{
+	si_realloc_settings_t settings = {0};
+	si_realloc_settings_new(&settings);
+	for (size_t mode = 0u; mode < 2u; mode++)
+	{
+		settings.is_adaptive = (1u == mode);
+		si_stack_t stack = {0};
+		si_stack_new_4(&stack, sizeof(size_t), 0u, &settings);
+		for (size_t iii = 0u; iii < 100u; iii++)
+		{
+			si_stack_push(&stack, &iii);
+		}
+		// Drains to empty, the capacity follows the count back down.
+		for (size_t iii = 100u; iii > 0u; iii--)
+		{
+			size_t value = SIZE_MAX;
+			si_stack_pop(&stack, &value);
+			TEST_ASSERT_EQUAL_size_t(iii - 1u, value);
+			TEST_ASSERT_TRUE(stack.count <= stack.dynamic.capacity);
+		}
+		// Adaptive grows double their step (32, 96, 224) & shrinks wait until
+		// the count fits twice into the smaller capacity. (96, 80, ... 16)
+		const size_t grows[2] = {4u, 3u};
+		const size_t shrinks[2] = {3u, 6u};
+		const size_t peaks[2] = {128u, 224u};
+		TEST_ASSERT_EQUAL_size_t(grows[mode], stack.stats.grow_count);
+		TEST_ASSERT_EQUAL_size_t(shrinks[mode], stack.stats.shrink_count);
+		TEST_ASSERT_EQUAL_size_t(peaks[mode], stack.stats.peak_capacity);
+		TEST_ASSERT_EQUAL_size_t(32u, stack.dynamic.capacity);
+		si_stack_free(&stack);
+	}
+}
+
 void si_stack_test_all(void)
 {
 	UNITY_BEGIN();
 	RUN_TEST(si_stack_test_modify);
 	RUN_TEST(si_stack_test_template);
+	RUN_TEST(si_stack_test_inline);
+	RUN_TEST(si_stack_test_adaptive);
 	UNITY_END();
 }
 
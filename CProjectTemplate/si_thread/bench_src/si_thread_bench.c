@@ -0,0 +1,811 @@
+//si_thread_bench.c
+// Times si_threadpool_t throughput, latency, fan-out/fan-in, looping tasks,
+// priority & producer contention over a curve of worker counts. A thread per
+// task baseline is timed next to the pool where it applies.
+
+// OS Specific feature flags must go before standard includes
+#include "si_bench.h"
+
+#include "si_futex.h"
+#include "si_thread.h"
+#include "si_threadpool.h"
+
+#include <stdio.h> // fprintf(), snprintf()
+#include <stdlib.h> // calloc(), free()
+#include <string.h> // strstr()
+
+// Tasks per fan-out round, each round is awaited before the next.
+#define SI_THREAD_BENCH_FANOUT (64u)
+// Thread per task baseline sizes above this are skipped to keep runs short.
+#define SI_THREAD_BENCH_BASELINE_MAX (20000u)
+// Low priority backlog tasks queued per worker ahead of a priority probe.
+#define SI_THREAD_BENCH_BACKLOG (4u)
+// Nanoseconds each backlog task keeps its worker busy for.
+#define SI_THREAD_BENCH_BACKLOG_NS (20000u)
+// Max probes timed per priority case.
+#define SI_THREAD_BENCH_PROBES (200u)
+// Max points of the worker count curve.
+#define SI_THREAD_BENCH_MAX_CURVE (16u)
+
+typedef struct si_thread_bench_pool_state_t
+{
+	si_threadpool_t* p_pool;
+	size_t worker_count;
+	// Opened by the tasks once the run is complete.
+	si_latch_t done;
+	// Iterations made by looping tasks.
+	volatile _Atomic size_t count;
+	size_t target;
+	// Batch parameters, every entry points at done.
+	void** pp_parameters;
+	si_thread_t threads[SI_THREAD_BENCH_FANOUT];
+} si_thread_bench_pool_state_t;
+
+// Timestamps of one latency sample.
+typedef struct si_thread_bench_stamp_t
+{
+	uint64_t enqueue_ns;
+	uint64_t start_ns;
+	// Counted down after stamping when not NULL.
+	si_latch_t* p_done;
+} si_thread_bench_stamp_t;
+
+/** Doxygen
+ * @brief Checks the --filter option against a group name.
+ */
+static bool si_thread_bench_is_selected(
+	const si_bench_options_t* const p_options, const char* const p_group)
+{
+	return (NULL == p_options->p_filter) ||
+		(NULL != strstr(p_group, p_options->p_filter));
+}
+
+/** Doxygen
+ * @brief Fills out the worker count curve. Doubles from 1u up to twice the
+ *        core count so oversubscription shows up on small machines too.
+ *
+ * @param p_counts Array of SI_THREAD_BENCH_MAX_CURVE counts to fill.
+ *
+ * @return Returns the number of points in the curve.
+ */
+static size_t si_thread_bench_worker_curve(size_t* const p_counts)
+{
+	const size_t core_count = si_cpu_core_count();
+	const size_t max_workers = (0u < core_count) ? (2u * core_count) : 2u;
+	size_t count = 0u;
+	for (size_t workers = 1u; (workers <= max_workers) &&
+		(SI_THREAD_BENCH_MAX_CURVE > count); workers *= 2u)
+	{
+		p_counts[count++] = workers;
+		// Odd core counts get their own point.
+		if ((workers < core_count) && ((workers * 2u) > core_count) &&
+		    (SI_THREAD_BENCH_MAX_CURVE > count))
+		{
+			p_counts[count++] = core_count;
+		}
+	}
+	return count;
+}
+
+/** Doxygen
+ * @brief Allocates & starts a pool of two priorities with worker_count
+ *        workers.
+ *
+ * @return Returns heap pointer on success. Returns NULL otherwise.
+ */
+static si_threadpool_t* si_thread_bench_pool_new(const size_t worker_count)
+{
+	si_threadpool_t* const p_pool = si_threadpool_new_1(2u);
+	if (NULL != p_pool)
+	{
+		si_threadpool_start_2(p_pool, worker_count);
+	}
+	return p_pool;
+}
+
+/** Doxygen
+ * @brief Task counting down the latch passed as its parameter.
+ */
+static void* si_thread_bench_done_task(void* p_parameter)
+{
+	si_latch_count_down(p_parameter);
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Looping task opening the done latch at its target iteration.
+ */
+static void* si_thread_bench_loop_task(void* p_parameter)
+{
+	si_thread_bench_pool_state_t* const p_state = p_parameter;
+	const size_t count = atomic_fetch_add(&(p_state->count), 1u) + 1u;
+	if (p_state->target == count)
+	{
+		si_latch_count_down(&(p_state->done));
+	}
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Task stamping its start. Returns its parameter so it can be awaited.
+ */
+static void* si_thread_bench_stamp_task(void* p_parameter)
+{
+	si_thread_bench_stamp_t* const p_stamp = p_parameter;
+	p_stamp->start_ns = si_bench_now_ns();
+	if (NULL != p_stamp->p_done)
+	{
+		si_latch_count_down(p_stamp->p_done);
+	}
+	return p_parameter;
+}
+
+/** Doxygen
+ * @brief Task keeping its worker busy, then counting down its latch.
+ */
+static void* si_thread_bench_busy_task(void* p_parameter)
+{
+	const uint64_t until = si_bench_now_ns() + SI_THREAD_BENCH_BACKLOG_NS;
+	while (si_bench_now_ns() < until)
+	{
+		// Busy wait.
+	}
+	si_latch_count_down(p_parameter);
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Thread per task baseline body. Does no work.
+ */
+static si_thread_func_t si_thread_bench_empty_thread(void* p_void)
+{
+	(void)p_void;
+	return 0;
+}
+
+/** Doxygen
+ * @brief Thread per task baseline body stamping its start.
+ */
+static si_thread_func_t si_thread_bench_stamp_thread(void* p_void)
+{
+	(void)si_thread_bench_stamp_task(p_void);
+	return 0;
+}
+
+static void si_thread_bench_pool_teardown(void* const p_state_v)
+{
+	si_thread_bench_pool_state_t* const p_state = p_state_v;
+	si_threadpool_destroy(&(p_state->p_pool));
+	free(p_state->pp_parameters);
+	p_state->pp_parameters = NULL;
+	free(p_state);
+}
+
+/** Doxygen
+ * @brief Starts a pool of the worker count at p_context outside the timing.
+ *
+ * @param p_context Pointer to the size_t number of workers. (NULL no pool)
+ * @param size Number of tasks the run will enqueue.
+ *
+ * @return Returns heap state on success. Returns NULL otherwise.
+ */
+static void* si_thread_bench_pool_setup(const void* const p_context,
+	const size_t size)
+{
+	si_thread_bench_pool_state_t* p_state = calloc(1u, sizeof(*p_state));
+	if (NULL == p_state)
+	{
+		goto END;
+	}
+	si_latch_init(&(p_state->done), (uint32_t)size);
+	const size_t parameter_count = (SI_THREAD_BENCH_FANOUT < size) ?
+		size : SI_THREAD_BENCH_FANOUT;
+	p_state->pp_parameters = calloc(parameter_count, sizeof(void*));
+	if (NULL == p_state->pp_parameters)
+	{
+		si_thread_bench_pool_teardown(p_state);
+		p_state = NULL;
+		goto END;
+	}
+	for (size_t iii = 0u; iii < parameter_count; iii++)
+	{
+		p_state->pp_parameters[iii] = &(p_state->done);
+	}
+	if (NULL == p_context)
+	{
+		goto END;
+	}
+	p_state->worker_count = *((const size_t*)p_context);
+	p_state->p_pool = si_thread_bench_pool_new(p_state->worker_count);
+	if (NULL == p_state->p_pool)
+	{
+		si_thread_bench_pool_teardown(p_state);
+		p_state = NULL;
+	}
+END:
+	return p_state;
+}
+
+/** Doxygen
+ * @brief Enqueues size empty tasks one at a time & waits for all of them.
+ */
+static size_t si_thread_bench_run_enqueue(void* const p_state_v,
+	const size_t size)
+{
+	si_thread_bench_pool_state_t* const p_state = p_state_v;
+	for (size_t iii = 0u; iii < size; iii++)
+	{
+		(void)si_threadpool_enqueue_3(
+			p_state->p_pool, si_thread_bench_done_task, &(p_state->done)
+		);
+	}
+	(void)si_latch_wait(&(p_state->done));
+	return size;
+}
+
+/** Doxygen
+ * @brief Enqueues size empty tasks as one batch & waits for all of them.
+ */
+static size_t si_thread_bench_run_batch(void* const p_state_v,
+	const size_t size)
+{
+	si_thread_bench_pool_state_t* const p_state = p_state_v;
+	const size_t count = si_threadpool_enqueue_batch(
+		p_state->p_pool, si_thread_bench_done_task, p_state->pp_parameters,
+		size
+	);
+	(void)si_latch_wait(&(p_state->done));
+	return count;
+}
+
+/** Doxygen
+ * @brief Starts & joins a thread per task, SI_THREAD_BENCH_FANOUT at a time.
+ */
+static size_t si_thread_bench_run_threads(void* const p_state_v,
+	const size_t size)
+{
+	si_thread_bench_pool_state_t* const p_state = p_state_v;
+	for (size_t iii = 0u; iii < size; iii += SI_THREAD_BENCH_FANOUT)
+	{
+		const size_t count = ((size - iii) < SI_THREAD_BENCH_FANOUT) ?
+			(size - iii) : SI_THREAD_BENCH_FANOUT;
+		for (size_t jjj = 0u; jjj < count; jjj++)
+		{
+			si_thread_create(
+				&(p_state->threads[jjj]), si_thread_bench_empty_thread, NULL
+			);
+		}
+		for (size_t jjj = 0u; jjj < count; jjj++)
+		{
+			(void)si_thread_join(&(p_state->threads[jjj]));
+		}
+	}
+	return size;
+}
+
+/** Doxygen
+ * @brief Fans out SI_THREAD_BENCH_FANOUT tasks & fans back in on a latch,
+ *        one round after another until size tasks ran.
+ */
+static size_t si_thread_bench_run_fanout(void* const p_state_v,
+	const size_t size)
+{
+	si_thread_bench_pool_state_t* const p_state = p_state_v;
+	for (size_t iii = 0u; iii < size; iii += SI_THREAD_BENCH_FANOUT)
+	{
+		const size_t count = ((size - iii) < SI_THREAD_BENCH_FANOUT) ?
+			(size - iii) : SI_THREAD_BENCH_FANOUT;
+		si_latch_init(&(p_state->done), (uint32_t)count);
+		(void)si_threadpool_enqueue_batch(
+			p_state->p_pool, si_thread_bench_done_task, p_state->pp_parameters,
+			count
+		);
+		(void)si_latch_wait(&(p_state->done));
+	}
+	return size;
+}
+
+/** Doxygen
+ * @brief Runs one looping task per worker until size iterations were made.
+ */
+static size_t si_thread_bench_run_loop(void* const p_state_v,
+	const size_t size)
+{
+	si_thread_bench_pool_state_t* const p_state = p_state_v;
+	p_state->target = size;
+	si_latch_init(&(p_state->done), 1u);
+	for (size_t iii = 0u; iii < p_state->worker_count; iii++)
+	{
+		(void)si_threadpool_enqueue_4(
+			p_state->p_pool, si_thread_bench_loop_task, p_state, false
+		);
+	}
+	(void)si_latch_wait(&(p_state->done));
+	// Loops keep going until the teardown stops the pool.
+	return atomic_load(&(p_state->count));
+}
+
+/** Doxygen
+ * @brief Times a case for every point of the worker curve, then once more
+ *        with the thread per task baseline when one is given.
+ */
+static void si_thread_bench_curve(si_bench_t* const p_bench,
+	const si_bench_options_t* const p_options, const char* const p_group,
+	size_t (*p_run_f)(void* const, const size_t),
+	size_t (*p_baseline_f)(void* const, const size_t))
+{
+	size_t workers[SI_THREAD_BENCH_MAX_CURVE] = {0};
+	const size_t curve_count = si_thread_bench_worker_curve(workers);
+	for (size_t iii = 0u; iii < p_options->size_count; iii++)
+	{
+		const size_t size = p_options->sizes[iii];
+		for (size_t jjj = 0u; jjj <= curve_count; jjj++)
+		{
+			char name[32] = {0};
+			si_bench_case_t bench_case = {
+				p_group, name, NULL, si_thread_bench_pool_setup, p_run_f,
+				si_thread_bench_pool_teardown
+			};
+			if (curve_count > jjj)
+			{
+				(void)snprintf(name, sizeof(name), "pool_w%zu", workers[jjj]);
+				bench_case.p_context = &(workers[jjj]);
+			}
+			else if ((NULL != p_baseline_f) &&
+				(SI_THREAD_BENCH_BASELINE_MAX >= size))
+			{
+				(void)snprintf(name, sizeof(name), "thread_per_task");
+				bench_case.p_run_f = p_baseline_f;
+			}
+			else
+			{
+				continue;
+			}
+			if (true != si_bench_run(
+				p_bench, &bench_case, size, p_options->repetitions))
+			{
+				fprintf(stderr, "%s %s %zu failed to run.\n",
+					p_group, name, size
+				);
+			}
+		}
+	}
+}
+
+/** Doxygen
+ * @brief Summarizes nanosecond samples & writes them as one result row.
+ */
+static void si_thread_bench_report_samples(si_bench_t* const p_bench,
+	const char* const p_group, const char* const p_name,
+	double* const p_samples, const size_t count)
+{
+	si_bench_result_t result = {0};
+	result.p_group = p_group;
+	result.p_name = p_name;
+	result.size = count;
+	si_bench_summarize(&result, p_samples, count);
+	si_bench_report(p_bench, &result);
+}
+
+/** Doxygen
+ * @brief Times enqueue to start of each task. idle awaits every task before
+ *        the next, burst enqueues all of them at once so queueing counts.
+ *
+ * @param p_pool Pointer to a running pool. (NULL times a thread per task)
+ * @param is_burst Enqueues every task before waiting when true.
+ * @param p_samples Array of count samples to fill out.
+ * @param p_stamps Array of count stamps to use.
+ * @param count Number of tasks to time.
+ */
+static void si_thread_bench_sample_latency(si_threadpool_t* const p_pool,
+	const bool is_burst, double* const p_samples,
+	si_thread_bench_stamp_t* const p_stamps, const size_t count)
+{
+	si_latch_t done = {0};
+	si_latch_init(&done, (uint32_t)count);
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		si_thread_bench_stamp_t* const p_stamp = &(p_stamps[iii]);
+		p_stamp->p_done = is_burst ? &done : NULL;
+		p_stamp->enqueue_ns = si_bench_now_ns();
+		if (NULL == p_pool)
+		{
+			si_thread_t thread = {0};
+			si_thread_create(&thread, si_thread_bench_stamp_thread, p_stamp);
+			(void)si_thread_join(&thread);
+			continue;
+		}
+		const size_t task_id = si_threadpool_enqueue_3(
+			p_pool, si_thread_bench_stamp_task, p_stamp
+		);
+		if (true != is_burst)
+		{
+			(void)si_threadpool_await_results(p_pool, task_id);
+		}
+	}
+	if ((NULL != p_pool) && (true == is_burst))
+	{
+		(void)si_latch_wait(&done);
+	}
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		p_samples[iii] = (double)(p_stamps[iii].start_ns -
+			p_stamps[iii].enqueue_ns);
+	}
+}
+
+/** Doxygen
+ * @brief Reports enqueue to start latency percentiles per worker count.
+ */
+static void si_thread_bench_latency(si_bench_t* const p_bench,
+	const si_bench_options_t* const p_options)
+{
+	size_t workers[SI_THREAD_BENCH_MAX_CURVE] = {0};
+	const size_t curve_count = si_thread_bench_worker_curve(workers);
+	for (size_t iii = 0u; iii < p_options->size_count; iii++)
+	{
+		const size_t size = p_options->sizes[iii];
+		double* const p_samples = calloc(size, sizeof(double));
+		si_thread_bench_stamp_t* const p_stamps = calloc(
+			size, sizeof(si_thread_bench_stamp_t)
+		);
+		if ((NULL == p_samples) || (NULL == p_stamps))
+		{
+			fprintf(stderr, "latency %zu failed to run.\n", size);
+			free(p_samples);
+			free(p_stamps);
+			continue;
+		}
+		for (size_t jjj = 0u; jjj < curve_count; jjj++)
+		{
+			si_threadpool_t* p_pool = si_thread_bench_pool_new(workers[jjj]);
+			if (NULL == p_pool)
+			{
+				continue;
+			}
+			char name[32] = {0};
+			si_thread_bench_sample_latency(
+				p_pool, false, p_samples, p_stamps, size
+			);
+			(void)snprintf(name, sizeof(name), "idle_w%zu", workers[jjj]);
+			si_thread_bench_report_samples(
+				p_bench, "latency", name, p_samples, size
+			);
+			si_thread_bench_sample_latency(
+				p_pool, true, p_samples, p_stamps, size
+			);
+			(void)snprintf(name, sizeof(name), "burst_w%zu", workers[jjj]);
+			si_thread_bench_report_samples(
+				p_bench, "latency", name, p_samples, size
+			);
+			si_threadpool_destroy(&p_pool);
+		}
+		if (SI_THREAD_BENCH_BASELINE_MAX >= size)
+		{
+			si_thread_bench_sample_latency(
+				NULL, false, p_samples, p_stamps, size
+			);
+			si_thread_bench_report_samples(
+				p_bench, "latency", "thread_per_task", p_samples, size
+			);
+		}
+		free(p_samples);
+		free(p_stamps);
+	}
+}
+
+/** Doxygen
+ * @brief Reports how long a probe task waits behind a backlog of busy low
+ *        priority tasks, enqueued at the high & then at the same priority.
+ *        Up to SI_THREAD_BENCH_PROBES probes, fewer for small --sizes.
+ */
+static void si_thread_bench_priority(si_bench_t* const p_bench,
+	const si_bench_options_t* const p_options)
+{
+	size_t workers[SI_THREAD_BENCH_MAX_CURVE] = {0};
+	const size_t curve_count = si_thread_bench_worker_curve(workers);
+	double samples[SI_THREAD_BENCH_PROBES] = {0};
+	size_t probe_count = 0u;
+	for (size_t iii = 0u; iii < p_options->size_count; iii++)
+	{
+		if (probe_count < p_options->sizes[iii])
+		{
+			probe_count = p_options->sizes[iii];
+		}
+	}
+	if (SI_THREAD_BENCH_PROBES < probe_count)
+	{
+		probe_count = SI_THREAD_BENCH_PROBES;
+	}
+	for (size_t iii = 0u; iii < curve_count; iii++)
+	{
+		si_threadpool_t* p_pool = si_thread_bench_pool_new(workers[iii]);
+		if (NULL == p_pool)
+		{
+			continue;
+		}
+		const size_t backlog = SI_THREAD_BENCH_BACKLOG * workers[iii];
+		for (size_t priority = 2u; 0u < priority; priority--)
+		{
+			for (size_t jjj = 0u; jjj < probe_count; jjj++)
+			{
+				si_latch_t done = {0};
+				si_latch_init(&done, (uint32_t)(backlog + 1u));
+				for (size_t kkk = 0u; kkk < backlog; kkk++)
+				{
+					(void)si_threadpool_enqueue_5(p_pool,
+						si_thread_bench_busy_task, &done, true,
+						SI_THREADPOOL_PRIORITY_MIN
+					);
+				}
+				si_thread_bench_stamp_t stamp = {0};
+				stamp.p_done = &done;
+				stamp.enqueue_ns = si_bench_now_ns();
+				(void)si_threadpool_enqueue_5(p_pool,
+					si_thread_bench_stamp_task, &stamp, true, priority - 1u
+				);
+				(void)si_latch_wait(&done);
+				samples[jjj] = (double)(stamp.start_ns - stamp.enqueue_ns);
+			}
+			char name[32] = {0};
+			(void)snprintf(name, sizeof(name), "%s_w%zu",
+				(2u == priority) ? "high" : "same", workers[iii]
+			);
+			si_thread_bench_report_samples(
+				p_bench, "priority", name, samples, probe_count
+			);
+		}
+		si_threadpool_destroy(&p_pool);
+	}
+}
+
+typedef struct si_thread_bench_contention_t
+{
+	const char* p_name;
+	size_t producer_count;
+	// Producers await every result when true, otherwise only enqueue.
+	bool is_awaiting;
+} si_thread_bench_contention_t;
+
+typedef struct si_thread_bench_producer_t
+{
+	si_thread_t thread;
+	si_threadpool_t* p_pool;
+	si_latch_t* p_start;
+	size_t task_count;
+	bool is_awaiting;
+	size_t sum;
+} si_thread_bench_producer_t;
+
+typedef struct si_thread_bench_state_t
+{
+	si_threadpool_t* p_pool;
+	si_latch_t start;
+	size_t producer_count;
+	si_thread_bench_producer_t* p_producers;
+} si_thread_bench_state_t;
+
+/** Doxygen
+ * @brief Task doing no work. Returns its parameter so awaiters get a result.
+ */
+static void* si_thread_bench_empty_task(void* p_parameter)
+{
+	return p_parameter;
+}
+
+/** Doxygen
+ * @brief Producer thread enqueuing its share of tasks once released.
+ *
+ * @param p_void Pointer to the si_thread_bench_producer_t of this thread.
+ */
+static si_thread_func_t si_thread_bench_producer(void* p_void)
+{
+	si_thread_bench_producer_t* const p_producer = p_void;
+	(void)si_latch_wait(p_producer->p_start);
+	// Enqueue only producers pass NULL so no result is stored.
+	void* const p_parameter = p_producer->is_awaiting ? p_producer : NULL;
+	for (size_t iii = 0u; iii < p_producer->task_count; iii++)
+	{
+		const size_t task_id = si_threadpool_enqueue_3(
+			p_producer->p_pool, si_thread_bench_empty_task, p_parameter
+		);
+		if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+		{
+			continue;
+		}
+		p_producer->sum += task_id;
+		if (true == p_producer->is_awaiting)
+		{
+			(void)si_threadpool_await_results(p_producer->p_pool, task_id);
+		}
+	}
+	return 0;
+}
+
+static void si_thread_bench_teardown(void* const p_state_v)
+{
+	si_thread_bench_state_t* const p_state = p_state_v;
+	if (NULL != p_state->p_producers)
+	{
+		// Producers left waiting by a failed setup are released first.
+		si_latch_count_down(&(p_state->start));
+		for (size_t iii = 0u; iii < p_state->producer_count; iii++)
+		{
+			(void)si_thread_join(&(p_state->p_producers[iii].thread));
+		}
+		free(p_state->p_producers);
+		p_state->p_producers = NULL;
+	}
+	si_threadpool_destroy(&(p_state->p_pool));
+	free(p_state);
+}
+
+/** Doxygen
+ * @brief Starts a pool & parks every producer on the start latch so thread
+ *        creation is kept out of the timing.
+ *
+ * @param p_context Pointer to the si_thread_bench_contention_t to set up.
+ * @param size Total number of tasks split over the producers.
+ *
+ * @return Returns heap state on success. Returns NULL otherwise.
+ */
+static void* si_thread_bench_contention_setup(const void* const p_context,
+	const size_t size)
+{
+	const si_thread_bench_contention_t* const p_contention = p_context;
+	si_thread_bench_state_t* p_state = calloc(1u, sizeof(*p_state));
+	if (NULL == p_state)
+	{
+		goto END;
+	}
+	si_latch_init(&(p_state->start), 1u);
+	p_state->p_pool = si_threadpool_new();
+	p_state->p_producers = calloc(
+		p_contention->producer_count, sizeof(si_thread_bench_producer_t)
+	);
+	if ((NULL == p_state->p_pool) || (NULL == p_state->p_producers))
+	{
+		free(p_state->p_producers);
+		p_state->p_producers = NULL;
+		si_thread_bench_teardown(p_state);
+		p_state = NULL;
+		goto END;
+	}
+	si_threadpool_start(p_state->p_pool);
+	const size_t share = size / p_contention->producer_count;
+	const size_t remainder = size % p_contention->producer_count;
+	for (size_t iii = 0u; iii < p_contention->producer_count; iii++)
+	{
+		si_thread_bench_producer_t* const p_producer =
+			&(p_state->p_producers[iii]);
+		p_producer->p_pool = p_state->p_pool;
+		p_producer->p_start = &(p_state->start);
+		p_producer->task_count = share + ((iii < remainder) ? 1u : 0u);
+		p_producer->is_awaiting = p_contention->is_awaiting;
+		si_thread_create(
+			&(p_producer->thread), si_thread_bench_producer, p_producer
+		);
+		p_state->producer_count++;
+	}
+END:
+	return p_state;
+}
+
+/** Doxygen
+ * @brief Releases the producers, joins them & drains the pool.
+ */
+static size_t si_thread_bench_contention_run(void* const p_state_v,
+	const size_t size)
+{
+	(void)size;
+	si_thread_bench_state_t* const p_state = p_state_v;
+	size_t sum = 0u;
+	si_latch_count_down(&(p_state->start));
+	for (size_t iii = 0u; iii < p_state->producer_count; iii++)
+	{
+		(void)si_thread_join(&(p_state->p_producers[iii].thread));
+		sum += p_state->p_producers[iii].sum;
+	}
+	p_state->producer_count = 0u;
+	si_threadpool_shutdown_2(p_state->p_pool, true);
+	return sum;
+}
+
+static const si_thread_bench_contention_t g_contentions[] = {
+	{"enqueue_32", 32u, false},
+	{"enqueue_64", 64u, false},
+	{"await_32", 32u, true},
+	{"await_64", 64u, true},
+};
+
+/** Doxygen
+ * @brief Runs every producer contention case at every size.
+ */
+static void si_thread_bench_contention(si_bench_t* const p_bench,
+	const si_bench_options_t* const p_options)
+{
+	if (true != si_thread_bench_is_selected(p_options, "contention"))
+	{
+		return;
+	}
+	const size_t count = sizeof(g_contentions) / sizeof(g_contentions[0]);
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const si_thread_bench_contention_t* const p_contention =
+			&(g_contentions[iii]);
+		const si_bench_case_t bench_case = {
+			"contention", p_contention->p_name, p_contention,
+			si_thread_bench_contention_setup, si_thread_bench_contention_run,
+			si_thread_bench_teardown
+		};
+		for (size_t jjj = 0u; jjj < p_options->size_count; jjj++)
+		{
+			const size_t size = p_options->sizes[jjj];
+			if (true != si_bench_run(
+				p_bench, &bench_case, size, p_options->repetitions))
+			{
+				fprintf(stderr, "contention %s %zu failed to run.\n",
+					p_contention->p_name, size
+				);
+			}
+		}
+	}
+}
+
+int main(int argc, char** pp_argv)
+{
+	int result = 1;
+	si_bench_options_t options = {0};
+	options.cpu = -1;
+	options.repetitions = SI_BENCH_DEFAULT_REPETITIONS;
+	options.size_count = 1u;
+	options.sizes[0] = 10000u;
+	if (true != si_bench_options_parse(&options, argc, pp_argv))
+	{
+		si_bench_options_usage(stderr, pp_argv[0]);
+		goto END;
+	}
+	if ((0 <= options.cpu) && (true != si_bench_pin_cpu(options.cpu)))
+	{
+		fprintf(stderr, "Failed to pin to CPU %d.\n", options.cpu);
+	}
+
+	si_bench_t bench = {0};
+	si_bench_init(&bench, stdout, &options);
+	const struct
+	{
+		const char* p_group;
+		size_t (*p_run_f)(void* const, const size_t);
+		size_t (*p_baseline_f)(void* const, const size_t);
+	} curves[] = {
+		{"throughput", si_thread_bench_run_enqueue,
+			si_thread_bench_run_threads},
+		{"batch", si_thread_bench_run_batch, NULL},
+		{"fanout", si_thread_bench_run_fanout, si_thread_bench_run_threads},
+		{"loop", si_thread_bench_run_loop, NULL},
+	};
+	const size_t curve_count = sizeof(curves) / sizeof(curves[0]);
+	for (size_t iii = 0u; iii < curve_count; iii++)
+	{
+		if (true == si_thread_bench_is_selected(&options, curves[iii].p_group))
+		{
+			si_thread_bench_curve(&bench, &options, curves[iii].p_group,
+				curves[iii].p_run_f, curves[iii].p_baseline_f
+			);
+		}
+	}
+	if (true == si_thread_bench_is_selected(&options, "latency"))
+	{
+		si_thread_bench_latency(&bench, &options);
+	}
+	if (true == si_thread_bench_is_selected(&options, "priority"))
+	{
+		si_thread_bench_priority(&bench, &options);
+	}
+	si_thread_bench_contention(&bench, &options);
+	si_bench_free(&bench);
+	fprintf(stderr, "sink: %llu\n", (unsigned long long)bench.sink);
+	result = 0;
+END:
+	return result;
+}
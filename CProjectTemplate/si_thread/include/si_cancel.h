@@ -0,0 +1,114 @@
+/* si_cancel.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Cooperative cancellation token. Work polls it at safe points
+ *           instead of being cancelled asynchronously. Tokens may expire at a
+ *           deadline & are cancelled along with their parent.
+ */
+
+#include <stdatomic.h> // atomic_bool, _Atomic
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // uint32_t, uint64_t
+
+#ifndef SI_CANCEL_H
+#define SI_CANCEL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+typedef struct si_cancel_token_t
+{
+	volatile atomic_bool is_cancelled;
+	// Monotonic nanosecs at which the token reads cancelled. (0u = never)
+	volatile _Atomic uint64_t deadline_ns;
+	volatile _Atomic size_t ref_count;
+	// Cancelling the parent cancels this token too. (Holds a reference)
+	struct si_cancel_token_t* p_parent;
+} si_cancel_token_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_cancel_token_t struct as not cancelled.
+ *
+ * @param p_token Pointer to the token struct to be initialized.
+ * @param p_parent Pointer to a token whose cancellation also cancels this
+ *                 one, retained until freed. (NULL ok)
+ */
+void si_cancel_token_init_2(si_cancel_token_t* const p_token,
+	si_cancel_token_t* const p_parent);
+void si_cancel_token_init(si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Allocates and initializes a new si_cancel_token_t on the heap.
+ *
+ * @param p_parent Pointer to the parent token, retained until freed. (NULL ok)
+ *
+ * @return Returns heap pointer with one reference on success. NULL otherwise.
+ */
+si_cancel_token_t* si_cancel_token_new_1(si_cancel_token_t* const p_parent);
+si_cancel_token_t* si_cancel_token_new();
+
+/** Doxygen
+ * @brief Adds a reference to a token. (Released by si_cancel_token_destroy)
+ *
+ * @param p_token Pointer to the token to be retained. (NULL ok)
+ *
+ * @return Returns p_token.
+ */
+si_cancel_token_t* si_cancel_token_retain(si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Cancels a token & every token below it. (Sticky)
+ *
+ * @param p_token Pointer to the token to be cancelled.
+ */
+void si_cancel_token_cancel(si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Makes a token read cancelled once a delay has passed.
+ * @details Only ever moves the deadline earlier.
+ *
+ * @param p_token Pointer to the token to set the deadline of.
+ * @param millisecs Millisecs from now until the token reads cancelled.
+ */
+void si_cancel_token_cancel_after(si_cancel_token_t* const p_token,
+	const uint32_t millisecs);
+
+/** Doxygen
+ * @brief Checks a token & its parents. An atomic load per token unless a
+ *        deadline is set, which also costs a monotonic clock read.
+ *
+ * @param p_token Pointer to the token to check. (NULL reads not cancelled)
+ *
+ * @return Returns stdbool true when cancelled. Returns false otherwise.
+ */
+bool si_cancel_token_is_cancelled(si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Clears the cancellation & deadline of a token for reuse.
+ *
+ * @param p_token Pointer to the token to be reset.
+ */
+void si_cancel_token_reset(si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Frees the contents of an existing si_cancel_token_t struct.
+ *
+ * @param p_token Pointer to the token struct to have its contents freed.
+ */
+void si_cancel_token_free(si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Releases a reference to a heap token, freeing it on the last one.
+ *
+ * @param pp_token Pointer to the token's heap pointer. (Set to NULL)
+ */
+void si_cancel_token_destroy(si_cancel_token_t** const pp_token);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_CANCEL_H
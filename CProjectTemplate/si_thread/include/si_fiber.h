@@ -0,0 +1,183 @@
+/* si_fiber.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Stackful coroutines (fibers) that run until they yield back to
+ *           whoever resumed them, on stacks recycled from a guarded pool.
+ *           POSIX ucontext based, SI_FIBER reads 0 where it's unavailable.
+ */
+
+#if defined(__APPLE__) || defined(__linux__) || defined(__unix__)
+#define SI_FIBER (1)
+#else
+#define SI_FIBER (0)
+#endif// Test for ucontext
+
+#if SI_FIBER
+#if defined(__APPLE__)
+#ifndef _XOPEN_SOURCE
+// Mac OS only exposes the deprecated ucontext functions to XSI sources.
+#define _XOPEN_SOURCE (600)
+#endif//_XOPEN_SOURCE
+#ifndef _DARWIN_C_SOURCE
+#define _DARWIN_C_SOURCE // MAP_ANON
+#endif//_DARWIN_C_SOURCE
+#else
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // makecontext(), MAP_ANONYMOUS
+#endif//_GNU_SOURCE
+#endif//__APPLE__
+#include <ucontext.h> // ucontext_t
+#endif//SI_FIBER
+
+// OS Specific feature flags must go before standard includes
+#include <stdatomic.h> // _Atomic
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+
+#include "si_mutex.h" // si_mutex_t
+
+#ifndef SI_FIBER_DEFAULT_STACK_SIZE
+// Usable bytes of each fiber stack, a guard page is added below it.
+#define SI_FIBER_DEFAULT_STACK_SIZE (64u * 1024u)
+#endif//SI_FIBER_DEFAULT_STACK_SIZE
+
+#ifndef SI_FIBER_DEFAULT_MAX_FREE
+// Released stacks kept mapped for reuse, the rest are unmapped.
+#define SI_FIBER_DEFAULT_MAX_FREE (64u)
+#endif//SI_FIBER_DEFAULT_MAX_FREE
+
+#ifndef SI_FIBER_H
+#define SI_FIBER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// Recycles fiber stacks. Each is mapped with an inaccessible guard page
+// below it, so an overflow faults instead of corrupting its neighbour.
+typedef struct si_fiber_stack_pool_t
+{
+	si_mutex_t lock;
+	// Usable bytes per stack, rounded up to whole pages.
+	size_t stack_size;
+	size_t guard_size;
+	// Released stacks, linked through their first bytes.
+	void* p_free;
+	size_t free_count;
+	size_t max_free;
+	// Stacks currently mapped, in use or free.
+	volatile _Atomic size_t map_count;
+} si_fiber_stack_pool_t;
+
+typedef enum si_fiber_state_t
+{
+	SI_FIBER_STATE_READY = 0,
+	SI_FIBER_STATE_RUNNING = 1,
+	SI_FIBER_STATE_SUSPENDED = 2,
+	SI_FIBER_STATE_DONE = 3,
+} si_fiber_state_t;
+
+// Body of a fiber, returning ends it.
+typedef void (*p_fiber_f)(void* p_arg);
+
+typedef struct si_fiber_t
+{
+#if SI_FIBER
+	ucontext_t context;
+	// Context of the si_fiber_resume() call running the fiber.
+	ucontext_t caller;
+#endif//SI_FIBER
+	si_fiber_stack_pool_t* p_stack_pool;
+	void* p_stack;
+	p_fiber_f p_function;
+	void* p_arg;
+	si_fiber_state_t state;
+} si_fiber_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_fiber_stack_pool_t struct holding none.
+ *
+ * @param p_pool Pointer to the stack pool to be initialized.
+ * @param stack_size Usable bytes per stack. (Rounded up to whole pages)
+ * @param max_free Number of released stacks kept for reuse.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_fiber_stack_pool_init_3(si_fiber_stack_pool_t* const p_pool,
+	const size_t stack_size, const size_t max_free);
+bool si_fiber_stack_pool_init(si_fiber_stack_pool_t* const p_pool);
+
+/** Doxygen
+ * @brief Takes a stack from the pool, mapping a new one if none are free.
+ *
+ * @param p_pool Pointer to the stack pool to take from.
+ *
+ * @return Returns lowest usable address of the stack on success.
+ *         Returns NULL otherwise.
+ */
+void* si_fiber_stack_pool_acquire(si_fiber_stack_pool_t* const p_pool);
+
+/** Doxygen
+ * @brief Gives a stack back to the pool. (Unmapped if enough are free)
+ *
+ * @param p_pool Pointer to the stack pool it was taken from.
+ * @param p_stack Stack returned by si_fiber_stack_pool_acquire().
+ */
+void si_fiber_stack_pool_release(si_fiber_stack_pool_t* const p_pool,
+	void* const p_stack);
+
+/** Doxygen
+ * @brief Unmaps the free stacks & frees the contents of a stack pool.
+ *        Stacks still in use are not tracked & must be released first.
+ *
+ * @param p_pool Pointer to the stack pool to be freed.
+ */
+void si_fiber_stack_pool_free(si_fiber_stack_pool_t* const p_pool);
+
+/** Doxygen
+ * @brief Initializes an existing si_fiber_t struct ready to be resumed.
+ *
+ * @param p_fiber Pointer to the fiber to be initialized.
+ * @param p_stack_pool Pointer to the stack pool to run the fiber on.
+ * @param p_function Body of the fiber. void func(void* p_arg);
+ * @param p_arg Pointer passed to the body.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_fiber_init(si_fiber_t* const p_fiber,
+	si_fiber_stack_pool_t* const p_stack_pool, p_fiber_f const p_function,
+	void* const p_arg);
+
+/** Doxygen
+ * @brief Runs a fiber on the calling thread until it yields or returns.
+ *        A suspended fiber may be resumed again from any thread.
+ *
+ * @param p_fiber Pointer to the fiber to be resumed.
+ *
+ * @return Returns stdbool true while the fiber is suspended. Returns false
+ *         once it has returned, or on error.
+ */
+bool si_fiber_resume(si_fiber_t* const p_fiber);
+
+/** Doxygen
+ * @brief Suspends the running fiber, returning from its si_fiber_resume().
+ *        Called only from within the fiber itself.
+ *
+ * @param p_fiber Pointer to the running fiber.
+ */
+void si_fiber_yield(si_fiber_t* const p_fiber);
+
+/** Doxygen
+ * @brief Frees the contents of a fiber that is not running, giving its stack
+ *        back. A suspended fiber is dropped without unwinding its stack.
+ *
+ * @param p_fiber Pointer to the fiber to be freed.
+ */
+void si_fiber_free(si_fiber_t* const p_fiber);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_FIBER_H
@@ -0,0 +1,229 @@
+/* si_futex.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Wait/wake primitives built on a single 32-bit word each. Linux
+ *           futexes (WaitOnAddress() on Windows) park the waiters, and wakers
+ *           skip the system call entirely while nobody is waiting.
+ */
+
+#if defined(__linux__)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // syscall()
+#endif//_GNU_SOURCE
+#include <linux/futex.h> // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h> // SYS_futex
+#include <unistd.h> // syscall()
+#elif defined(_WIN32)
+#include <windows.h>
+#include <synchapi.h> // WaitOnAddress(), WakeByAddressSingle()
+#else
+// Other OSes poll the word with short sleeps instead.
+#endif // OS Specific Includes
+
+// OS Specific feature flags must go before standard includes
+#include <stdatomic.h> // _Atomic
+#include <stdbool.h> // bool, false, true
+#include <stdint.h> // uint32_t, UINT32_MAX
+
+#ifndef SI_FUTEX_H
+#define SI_FUTEX_H
+
+// Millisecs value waiting without a timeout.
+#define SI_FUTEX_INFINITE (UINT32_MAX)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+/** Doxygen
+ * @brief Sleeps while a word still holds an expected value. May wake
+ *        spuriously, so callers re-check their condition.
+ *
+ * @param p_word Pointer to the 32-bit word to wait on.
+ * @param expected Value the word must hold for the caller to sleep.
+ * @param millisecs Max time to sleep. (SI_FUTEX_INFINITE for no limit)
+ *
+ * @return Returns stdbool false on timeout. Returns true otherwise.
+ */
+bool si_futex_wait_3(volatile _Atomic uint32_t* const p_word,
+	const uint32_t expected, const uint32_t millisecs);
+bool si_futex_wait(volatile _Atomic uint32_t* const p_word,
+	const uint32_t expected);
+
+/** Doxygen
+ * @brief Wakes up to count threads sleeping on a word.
+ *
+ * @param p_word Pointer to the 32-bit word being waited on.
+ * @param count Max number of threads to wake. (UINT32_MAX for all)
+ */
+void si_futex_wake(volatile _Atomic uint32_t* const p_word,
+	const uint32_t count);
+
+
+// Event count: waiters take a key, re-check their condition & then sleep
+// until a notify bumps the epoch past that key. No lock is needed around the
+// condition, as notifies between the key & the sleep are never lost.
+typedef struct si_event_t
+{
+	// Futex word bumped by every notify.
+	volatile _Atomic uint32_t epoch;
+	// Threads between si_event_prepare_wait() & the end of their wait.
+	volatile _Atomic uint32_t waiters;
+} si_event_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_event_t struct with no waiters.
+ *
+ * @param p_event Pointer to the event to be initialized.
+ */
+void si_event_init(si_event_t* const p_event);
+
+/** Doxygen
+ * @brief Registers the caller as a waiter. Must be followed by exactly one
+ *        si_event_wait_3() or si_event_cancel_wait().
+ *
+ * @param p_event Pointer to the event to wait on.
+ *
+ * @return Returns the uint32_t key to pass to si_event_wait_3().
+ */
+uint32_t si_event_prepare_wait(si_event_t* const p_event);
+
+/** Doxygen
+ * @brief Unregisters a prepared waiter whose condition turned out true.
+ *
+ * @param p_event Pointer to the event prepared on.
+ */
+void si_event_cancel_wait(si_event_t* const p_event);
+
+/** Doxygen
+ * @brief Sleeps until a notify made after the key was taken, then
+ *        unregisters the waiter.
+ *
+ * @param p_event Pointer to the event prepared on.
+ * @param key Value returned by the matching si_event_prepare_wait().
+ * @param millisecs Max time to sleep. (SI_FUTEX_INFINITE for no limit)
+ *
+ * @return Returns stdbool true when notified. Returns false on timeout.
+ */
+bool si_event_wait_3(si_event_t* const p_event, const uint32_t key,
+	const uint32_t millisecs);
+bool si_event_wait(si_event_t* const p_event, const uint32_t key);
+
+/** Doxygen
+ * @brief Wakes up to count waiters. Only an atomic add & load when no thread
+ *        is waiting.
+ *
+ * @param p_event Pointer to the event to notify.
+ * @param count Max number of waiters to wake.
+ */
+void si_event_notify_2(si_event_t* const p_event, const uint32_t count);
+void si_event_notify(si_event_t* const p_event);
+
+/** Doxygen
+ * @brief Wakes every waiter of an event.
+ *
+ * @param p_event Pointer to the event to notify.
+ */
+void si_event_notify_all(si_event_t* const p_event);
+
+
+// One-shot countdown latch. Opens for good once counted down to zero.
+typedef struct si_latch_t
+{
+	// Futex word counting down to open.
+	volatile _Atomic uint32_t count;
+	volatile _Atomic uint32_t waiters;
+} si_latch_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_latch_t struct as closed.
+ *
+ * @param p_latch Pointer to the latch to be initialized.
+ * @param count Number of count downs needed to open it. (0u opens it)
+ */
+void si_latch_init(si_latch_t* const p_latch, const uint32_t count);
+
+/** Doxygen
+ * @brief Counts a latch down, waking every waiter when it opens.
+ *
+ * @param p_latch Pointer to the latch to count down.
+ * @param count Number to count down by, clamped to what remains.
+ */
+void si_latch_count_down_2(si_latch_t* const p_latch, const uint32_t count);
+void si_latch_count_down(si_latch_t* const p_latch);
+
+/** Doxygen
+ * @brief Checks whether a latch is open without blocking.
+ *
+ * @param p_latch Pointer to the latch to check.
+ *
+ * @return Returns stdbool true when open. Returns false otherwise.
+ */
+bool si_latch_try_wait(si_latch_t* const p_latch);
+
+/** Doxygen
+ * @brief Sleeps until a latch opens.
+ *
+ * @param p_latch Pointer to the latch to wait on.
+ * @param millisecs Max time to sleep. (SI_FUTEX_INFINITE for no limit)
+ *
+ * @return Returns stdbool true when open. Returns false on timeout/error.
+ */
+bool si_latch_wait_2(si_latch_t* const p_latch, const uint32_t millisecs);
+bool si_latch_wait(si_latch_t* const p_latch);
+
+
+// Counting semaphore.
+typedef struct si_semaphore_t
+{
+	// Futex word holding the available count.
+	volatile _Atomic uint32_t value;
+	volatile _Atomic uint32_t waiters;
+} si_semaphore_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_semaphore_t struct.
+ *
+ * @param p_semaphore Pointer to the semaphore to be initialized.
+ * @param value Initial available count.
+ */
+void si_semaphore_init(si_semaphore_t* const p_semaphore,
+	const uint32_t value);
+
+/** Doxygen
+ * @brief Adds to a semaphore's count, waking as many waiters.
+ *
+ * @param p_semaphore Pointer to the semaphore to post to.
+ * @param count Number to add to the available count.
+ */
+void si_semaphore_post_2(si_semaphore_t* const p_semaphore,
+	const uint32_t count);
+void si_semaphore_post(si_semaphore_t* const p_semaphore);
+
+/** Doxygen
+ * @brief Takes one from a semaphore's count without blocking.
+ *
+ * @param p_semaphore Pointer to the semaphore to take from.
+ *
+ * @return Returns stdbool true on success. Returns false when none is left.
+ */
+bool si_semaphore_try_wait(si_semaphore_t* const p_semaphore);
+
+/** Doxygen
+ * @brief Takes one from a semaphore's count, sleeping until one is posted.
+ *
+ * @param p_semaphore Pointer to the semaphore to take from.
+ * @param millisecs Max time to sleep. (SI_FUTEX_INFINITE for no limit)
+ *
+ * @return Returns stdbool true on success. Returns false on timeout/error.
+ */
+bool si_semaphore_wait_2(si_semaphore_t* const p_semaphore,
+	const uint32_t millisecs);
+bool si_semaphore_wait(si_semaphore_t* const p_semaphore);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_FUTEX_H
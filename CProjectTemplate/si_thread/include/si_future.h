@@ -0,0 +1,156 @@
+/* si_future.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Reference counted one-shot completion handle for a task result.
+ */
+
+#include "si_mutex.h" // si_mutex_t, si_cond_t
+
+#include <stdatomic.h> // _Atomic, atomic_load()
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+
+#ifndef SI_FUTURE_H
+#define SI_FUTURE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+typedef enum si_future_state_t
+{
+	SI_FUTURE_PENDING   = 0,
+	SI_FUTURE_READY     = 1,
+	SI_FUTURE_CANCELLED = 2,
+} si_future_state_t;
+
+// Registration of a wait_any() caller on one future. (Lives on its stack)
+typedef struct si_future_link_t
+{
+	struct si_future_waiter_t* p_waiter;
+	struct si_future_link_t* p_next;
+} si_future_link_t;
+
+typedef struct si_future_t
+{
+	volatile _Atomic int state;
+	volatile _Atomic size_t ref_count;
+	// Callers blocked on this future, completion skips the lock when 0u.
+	volatile _Atomic size_t waiter_count;
+	void* p_result;
+	si_mutex_t lock;
+	si_cond_t ready_signal;
+	si_future_link_t* p_links;
+} si_future_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_future_t struct as pending.
+ *
+ * @param p_future Pointer to the future struct to be initialized.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_future_init(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Allocates and initializes a new pending si_future_t on the heap.
+ *
+ * @return Returns heap pointer with one reference on success. NULL otherwise.
+ */
+si_future_t* si_future_new();
+
+/** Doxygen
+ * @brief Adds a reference to a heap future. (Released by si_future_destroy)
+ *
+ * @param p_future Pointer to the heap future to be retained.
+ *
+ * @return Returns p_future.
+ */
+si_future_t* si_future_retain(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Stores the result & wakes only the callers waiting on this future.
+ *
+ * @param p_future Pointer to the future to be completed.
+ * @param p_result Result pointer to be returned by si_future_wait(). (NULL ok)
+ *
+ * @return Returns stdbool true on success. Returns false if already done.
+ */
+bool si_future_complete(si_future_t* const p_future, void* const p_result);
+
+/** Doxygen
+ * @brief Marks a pending future as cancelled & wakes its waiters.
+ *
+ * @param p_future Pointer to the future to be cancelled.
+ *
+ * @return Returns stdbool true on success. Returns false if already done.
+ */
+bool si_future_cancel(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Gets the current state of a future without blocking.
+ *
+ * @param p_future Pointer to the future to read.
+ *
+ * @return Returns si_future_state_t. Returns SI_FUTURE_CANCELLED on error.
+ */
+si_future_state_t si_future_state(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Checks if a future has been completed or cancelled. (Non-blocking)
+ *
+ * @param p_future Pointer to the future to check.
+ *
+ * @return Returns stdbool true when done. Returns false otherwise.
+ */
+bool si_future_is_done(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Blocks until a future is done. O(1), wakes for this future only.
+ *
+ * @param p_future Pointer to the future to wait on.
+ *
+ * @return Returns the result pointer. Returns NULL if cancelled or on error.
+ */
+void* si_future_wait(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Blocks until at least one of the futures is done.
+ *
+ * @param pp_futures Array of future pointers to wait on. (NULLs are skipped)
+ * @param count Number of future pointers in pp_futures.
+ *
+ * @return Returns lowest index of a done future. Returns SIZE_MAX on error.
+ */
+size_t si_future_wait_any(si_future_t** const pp_futures, const size_t count);
+
+/** Doxygen
+ * @brief Blocks until every one of the futures is done.
+ *
+ * @param pp_futures Array of future pointers to wait on. (NULLs are skipped)
+ * @param count Number of future pointers in pp_futures.
+ *
+ * @return Returns stdbool true if none were cancelled. Returns false otherwise.
+ */
+bool si_future_wait_all(si_future_t** const pp_futures, const size_t count);
+
+/** Doxygen
+ * @brief Frees the contents of an existing si_future_t struct.
+ *
+ * @param p_future Pointer to the future struct to have its contents freed.
+ */
+void si_future_free(si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Releases a reference to a heap future, freeing it on the last one.
+ *
+ * @param pp_future Pointer to the future's heap pointer. (Set to NULL)
+ */
+void si_future_destroy(si_future_t** const pp_future);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_FUTURE_H
@@ -0,0 +1,85 @@
+/* si_magazine.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Small block allocator. Each thread keeps magazines (stacks of
+ *           free blocks) per size class, a shared depot rebalances full &
+ *           empty magazines between threads. Only a depot trip takes a lock.
+ */
+
+// OS Specific feature flags must go before standard includes
+#include <stdatomic.h> // _Atomic
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+
+#ifndef SI_MAGAZINE_SIZE
+// Blocks held by a single magazine.
+#define SI_MAGAZINE_SIZE (32u)
+#endif//SI_MAGAZINE_SIZE
+
+#ifndef SI_MAGAZINE_DEPOT_MAX
+// Full & empty magazines each kept per size class by the depot. Magazines
+// beyond that go back to malloc() with their blocks.
+#define SI_MAGAZINE_DEPOT_MAX (64u)
+#endif//SI_MAGAZINE_DEPOT_MAX
+
+// Largest block size served from magazines, bigger ones use malloc().
+#define SI_MAGAZINE_MAX_SIZE (1024u)
+
+#ifndef SI_MAGAZINE_H
+#define SI_MAGAZINE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+/** Doxygen
+ * @brief Allocates a block from the calling thread's magazines, falling back
+ *        to the depot & then malloc(). Blocks may be freed by any thread.
+ *
+ * @param size Number of bytes needed.
+ *
+ * @return Returns pointer to the block on success. Returns NULL otherwise.
+ */
+void* si_magazine_alloc(const size_t size);
+
+/** Doxygen
+ * @brief Allocates a zeroed block for count elements of size bytes each.
+ *
+ * @param count Number of elements.
+ * @param size Number of bytes per element.
+ *
+ * @return Returns pointer to the block on success. Returns NULL otherwise.
+ */
+void* si_magazine_calloc(const size_t count, const size_t size);
+
+/** Doxygen
+ * @brief Gives a block back to the calling thread's magazines.
+ *
+ * @param p_block Block from si_magazine_alloc() or si_magazine_calloc().
+ */
+void si_magazine_free(void* const p_block);
+
+/** Doxygen
+ * @brief Hands the calling thread's magazines over to the depot. Threads do
+ *        so on exit by themselves, calling it sooner frees up idle caches.
+ */
+void si_magazine_thread_flush(void);
+
+/** Doxygen
+ * @brief Frees every magazine & block held by the depot.
+ */
+void si_magazine_trim(void);
+
+/** Doxygen
+ * @brief Counts the magazine served blocks that were taken from malloc().
+ *
+ * @return Returns the running total over all size classes.
+ */
+size_t si_magazine_malloc_count(void);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_MAGAZINE_H
@@ -1,7 +1,8 @@
 /* si_mutex.h
  * Created: 20250908
- * Updated: 20250930
+ * Updated: 20261019
  * Purpose: Generalize mutex functions for better cross-platform support.
+ *          Also provides reader-writer & sequence locks for read-mostly data.
  */
 
 #if defined(__APPLE__) || defined(__linux__) || defined(__unix__)
@@ -25,9 +26,18 @@
 #endif//_POSIX_C_SOURCE
 #include <time.h>
 
+#ifndef __USE_UNIX98
 #define __USE_UNIX98 // PTHREAD_MUTEX_ERRORCHECK
+#endif//__USE_UNIX98
 #include <pthread.h>
+#ifndef SI_PTHREAD_MUTEX_DEFAULT_TYPE
+#ifdef NDEBUG
+// Release builds skip the ownership checks made on every lock & unlock.
+#define SI_PTHREAD_MUTEX_DEFAULT_TYPE (PTHREAD_MUTEX_NORMAL)
+#else
 #define SI_PTHREAD_MUTEX_DEFAULT_TYPE (PTHREAD_MUTEX_ERRORCHECK)
+#endif//NDEBUG
+#endif//SI_PTHREAD_MUTEX_DEFAULT_TYPE
 
 #else
 #warning Unknown/Unsupported OS
@@ -36,10 +46,17 @@
 
 // OS Specific feature flags must go before standard includes
 #include <errno.h> // EBUSY, errno
+#include <stdatomic.h> // _Atomic
 #include <stdbool.h> // bool, false, true
-#include <stdint.h> // uint32_t
+#include <stddef.h> // size_t
+#include <stdint.h> // uint32_t, uint64_t
 #include <stdlib.h> // calloc(), free()
 
+#ifndef SI_MUTEX_SPIN_COUNT
+// Max try_lock attempts made on a held mutex before sleeping on it.
+#define SI_MUTEX_SPIN_COUNT (100u)
+#endif//SI_MUTEX_SPIN_COUNT
+
 
 #ifndef SI_MUTEX_H
 #define SI_MUTEX_H
@@ -49,6 +66,23 @@ extern "C"
 {
 #endif //__cplusplus
 
+// Optional per lock contention counters. (Relaxed, read them when quiet)
+typedef struct si_lock_stats_t
+{
+	volatile _Atomic uint64_t acquisitions;
+	// Acquisitions that found the lock held & had to spin or sleep.
+	volatile _Atomic uint64_t contended;
+	// Total nanosecs contended acquisitions spent waiting.
+	volatile _Atomic uint64_t wait_ns;
+} si_lock_stats_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_lock_stats_t struct to all zero counts.
+ *
+ * @param p_stats Pointer to the counters to be initialized.
+ */
+void si_lock_stats_init(si_lock_stats_t* const p_stats);
+
 #ifdef _WIN32
 
 #define SI_COND_STATIC_INIT CONDITION_VARIABLE_INIT
@@ -57,6 +91,7 @@ typedef CONDITION_VARIABLE si_cond_t;
 #define si_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
 #define si_cond_signal(c) WakeConditionVariable(c)
 #define si_cond_broadcast(c) WakeAllConditionVariable(c)
+#define si_cond_timedwait(c, m, t) (0 != SleepConditionVariableCS(c, m, t))
 // Windows does not have an explicit DestroyConditionVariable function.
 #define si_cond_free(c) // NOP
 
@@ -64,6 +99,8 @@ typedef CONDITION_VARIABLE si_cond_t;
 typedef CRITICAL_SECTION si_mutex_t;
 
 #define si_mutex_lock(m) EnterCriticalSection(m)
+// Critical sections already spin before sleeping. (Counters unsupported)
+#define si_mutex_lock_2(m, s) ((void)(s), EnterCriticalSection(m))
 #define si_mutex_try_lock(m) TryEnterCriticalSection(m)
 #define si_mutex_unlock(m) LeaveCriticalSection(m)
 #define si_mutex_free(m) DeleteCriticalSection(m)
@@ -141,10 +178,26 @@ si_mutex_t* si_mutex_new_1(const int mutex_type);
 bool si_mutex_timedlock(si_mutex_t* const p_mutex, const uint32_t millisecs);
 
 /** Doxygen
- * @brief Blocking mode locks a si_mutex_t by pointer.
+ * @brief Waits on a condition for at most a given time. (Mutex held)
+ * 
+ * @param p_cond Pointer to the condition to wait on.
+ * @param p_mutex Pointer to the locked mutex released while waiting.
+ * @param millisecs Time from now in millisecs that the wait will expire.
+ * 
+ * @return Returns stdbool true when woken. Returns false on timeout/error.
+ */
+bool si_cond_timedwait(si_cond_t* const p_cond, si_mutex_t* const p_mutex,
+	const uint32_t millisecs);
+
+/** Doxygen
+ * @brief Blocking mode locks a si_mutex_t by pointer. A held mutex is retried
+ *        up to SI_MUTEX_SPIN_COUNT times before sleeping. (Multi-core only)
  * 
  * @param p_mutex Pointer to the mutex to be locked.
+ * @param p_stats Pointer to contention counters to be updated. (NULL ok)
  */
+void si_mutex_lock_2(si_mutex_t* const p_mutex,
+	si_lock_stats_t* const p_stats);
 void si_mutex_lock(si_mutex_t* const p_mutex);
 
 // Returns a boolean just like the Windows try_lock implementation.
@@ -189,6 +242,145 @@ si_mutex_t* si_mutex_new();
  */
 void si_mutex_destroy(si_mutex_t** const pp_mutex);
 
+
+typedef struct si_rwlock_t
+{
+#ifdef _WIN32
+	SRWLOCK lock;
+#elif SI_PTHREAD
+	pthread_rwlock_t lock;
+#endif // OS Specific lock type
+	// Optional contention counters shared by readers & writers. (NULL ok)
+	si_lock_stats_t* p_stats;
+} si_rwlock_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_rwlock_t struct as unlocked.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be initialized.
+ * @param p_stats Pointer to contention counters updated by each lock. (NULL ok)
+ *
+ * @return Returns int 0 on success. Returns int -1 otherwise.
+ */
+int si_rwlock_init_2(si_rwlock_t* const p_rwlock,
+	si_lock_stats_t* const p_stats);
+int si_rwlock_init(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Blocking mode locks a si_rwlock_t shared with other readers.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be read locked.
+ */
+void si_rwlock_read_lock(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Attempts to read lock a si_rwlock_t without blocking.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be read locked.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_rwlock_try_read_lock(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Releases a read lock taken on a si_rwlock_t.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be read unlocked.
+ */
+void si_rwlock_read_unlock(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Blocking mode locks a si_rwlock_t excluding all others.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be write locked.
+ */
+void si_rwlock_write_lock(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Attempts to write lock a si_rwlock_t without blocking.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be write locked.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_rwlock_try_write_lock(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Releases a write lock taken on a si_rwlock_t.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be write unlocked.
+ */
+void si_rwlock_write_unlock(si_rwlock_t* const p_rwlock);
+
+/** Doxygen
+ * @brief Frees the contents of an existing unlocked si_rwlock_t struct.
+ *
+ * @param p_rwlock Pointer to the reader-writer lock to be freed.
+ */
+void si_rwlock_free(si_rwlock_t* const p_rwlock);
+
+
+// Sequence lock: readers never block or write shared memory. They copy the
+// data between read_begin & read_retry, then retry if a writer overlapped.
+// Protected fields should be read with relaxed atomics to be race free.
+typedef struct si_seqlock_t
+{
+	// Odd while a writer is mid update.
+	volatile _Atomic size_t sequence;
+	// Serializes writers only.
+	si_mutex_t write_lock;
+} si_seqlock_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_seqlock_t struct as unlocked.
+ *
+ * @param p_seqlock Pointer to the sequence lock to be initialized.
+ *
+ * @return Returns int 0 on success. Returns int -1 otherwise.
+ */
+int si_seqlock_init(si_seqlock_t* const p_seqlock);
+
+/** Doxygen
+ * @brief Begins a read, spinning while a writer is mid update.
+ *
+ * @param p_seqlock Pointer to the sequence lock to read under.
+ *
+ * @return Returns the size_t sequence to pass to si_seqlock_read_retry().
+ */
+size_t si_seqlock_read_begin(si_seqlock_t* const p_seqlock);
+
+/** Doxygen
+ * @brief Ends a read, checking whether a writer overlapped it.
+ *
+ * @param p_seqlock Pointer to the sequence lock read under.
+ * @param sequence Value returned by the matching si_seqlock_read_begin().
+ *
+ * @return Returns stdbool true when the read must be retried. False otherwise.
+ */
+bool si_seqlock_read_retry(si_seqlock_t* const p_seqlock,
+	const size_t sequence);
+
+/** Doxygen
+ * @brief Blocking mode locks a si_seqlock_t for an update.
+ *
+ * @param p_seqlock Pointer to the sequence lock to be write locked.
+ */
+void si_seqlock_write_lock(si_seqlock_t* const p_seqlock);
+
+/** Doxygen
+ * @brief Publishes an update & unlocks a si_seqlock_t.
+ *
+ * @param p_seqlock Pointer to the sequence lock to be write unlocked.
+ */
+void si_seqlock_write_unlock(si_seqlock_t* const p_seqlock);
+
+/** Doxygen
+ * @brief Frees the contents of an existing unlocked si_seqlock_t struct.
+ *
+ * @param p_seqlock Pointer to the sequence lock to be freed.
+ */
+void si_seqlock_free(si_seqlock_t* const p_seqlock);
+
 #ifdef __cplusplus
 }
 #endif //__cplusplus
@@ -0,0 +1,142 @@
+/* si_parallel.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Data parallel algorithms over si_data containers on a threadpool.
+ */
+
+#include "si_array.h" // si_array_t, si_array_sort(), si_array_bsearch()
+#include "si_threadpool.h" // si_threadpool_t, si_threadpool_parallel_for()
+
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+
+// Arrays smaller than this are sorted on the calling thread.
+#ifndef SI_PARALLEL_SORT_MIN
+#define SI_PARALLEL_SORT_MIN (16384u)
+#endif//SI_PARALLEL_SORT_MIN
+
+// Minimum number of keys handed to a single bsearch_many() task.
+#ifndef SI_PARALLEL_BSEARCH_GRAIN
+#define SI_PARALLEL_BSEARCH_GRAIN (1024u)
+#endif//SI_PARALLEL_BSEARCH_GRAIN
+
+// Minimum number of elements in a map(), reduce() or inclusive_scan() chunk.
+#ifndef SI_PARALLEL_GRAIN
+#define SI_PARALLEL_GRAIN (4096u)
+#endif//SI_PARALLEL_GRAIN
+
+// Chunks an array is split into at most, larger arrays get larger chunks.
+#ifndef SI_PARALLEL_MAX_CHUNKS
+#define SI_PARALLEL_MAX_CHUNKS (64u)
+#endif//SI_PARALLEL_MAX_CHUNKS
+
+// Partial results are padded to this many bytes so no two share a line.
+#ifndef SI_PARALLEL_CACHE_LINE
+#define SI_PARALLEL_CACHE_LINE (64u)
+#endif//SI_PARALLEL_CACHE_LINE
+
+#ifndef SI_PARALLEL_H
+#define SI_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+/** Doxygen
+ * @brief Sorts an array across the workers of a running threadpool.
+ * @details Chunks are introsorted in parallel then merged pairwise, each merge
+ *          split at binary searched pivots so every round keeps all workers
+ *          busy. The calling thread claims jobs alongside the workers. Falls
+ *          back to si_array_sort() when p_pool is NULL or not running.
+ *
+ * @param p_pool Pointer to the running threadpool to execute tasks on.
+ * @param p_array Pointer to si_array_t struct to be sorted.
+ * @param p_cmp_f Function pointer used to order two elements like qsort().
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_parallel_sort(si_threadpool_t* const p_pool, si_array_t* const p_array,
+	int (*p_cmp_f)(const void* const, const void* const));
+
+/** Doxygen
+ * @brief Binary searches a sorted array for a batch of keys in parallel.
+ *
+ * @param p_pool Pointer to the running threadpool to execute tasks on.
+ * @param p_sorted Pointer to the sorted si_array_t struct to be searched.
+ * @param p_keys Pointer to si_array_t struct of keys to search for.
+ * @param p_indexes Pointer to uninitialized si_array_t struct to receive one
+ *                  size_t index per key. (SIZE_MAX where not found)
+ * @param p_cmp_f Function pointer called as p_cmp_f(p_element, p_key).
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_parallel_bsearch_many(si_threadpool_t* const p_pool,
+	const si_array_t* const p_sorted, const si_array_t* const p_keys,
+	si_array_t* const p_indexes,
+	int (*p_cmp_f)(const void* const, const void* const));
+
+/** Doxygen
+ * @brief Transforms every element of an array into a new array in parallel.
+ * @details Chunks of SI_PARALLEL_GRAIN or more elements are claimed by the
+ *          workers & the calling thread. Runs inline when p_pool is NULL or
+ *          not running.
+ *
+ * @param p_pool Pointer to the running threadpool to execute tasks on.
+ * @param p_source Pointer to si_array_t struct of elements to transform.
+ * @param p_destination Pointer to uninitialized si_array_t struct to receive
+ *                      one element_size element per source element.
+ * @param element_size Size in bytes of each destination element.
+ * @param p_map_f Function called as p_map_f(p_out, p_in, p_context).
+ * @param p_context Pointer passed to every p_map_f call.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_parallel_map(si_threadpool_t* const p_pool,
+	const si_array_t* const p_source, si_array_t* const p_destination,
+	const size_t element_size,
+	void (*p_map_f)(void* const, const void* const, void* const),
+	void* const p_context);
+
+/** Doxygen
+ * @brief Folds every element of an array into one value in parallel.
+ * @details Each chunk folds into its own cache line padded partial, then the
+ *          partials are folded in chunk order on the calling thread. Chunks
+ *          only depend on the element count, so floating point results are
+ *          the same for any number of workers, or none.
+ *
+ * @param p_pool Pointer to the running threadpool to execute tasks on.
+ * @param p_array Pointer to si_array_t struct of elements to fold.
+ * @param p_result Pointer to an element holding the initial value, receives
+ *                 the result. (Left unchanged on failure)
+ * @param p_op_f Associative function called as p_op_f(p_accumulator,
+ *               p_element), folding the element into the accumulator.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_parallel_reduce(si_threadpool_t* const p_pool,
+	const si_array_t* const p_array, void* const p_result,
+	void (*p_op_f)(void* const, const void* const));
+
+/** Doxygen
+ * @brief Replaces every element of an array with the fold of itself & all
+ *        before it, in parallel.
+ * @details Chunks fold their totals in parallel, the totals are prefixed in
+ *          chunk order on the calling thread, then each chunk is scanned
+ *          from its prefix in parallel. Deterministic like reduce().
+ *
+ * @param p_pool Pointer to the running threadpool to execute tasks on.
+ * @param p_array Pointer to si_array_t struct to be scanned in place.
+ * @param p_op_f Associative function called as p_op_f(p_accumulator,
+ *               p_element), folding the element into the accumulator.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_parallel_inclusive_scan(si_threadpool_t* const p_pool,
+	si_array_t* const p_array, void (*p_op_f)(void* const, const void* const));
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_PARALLEL_H
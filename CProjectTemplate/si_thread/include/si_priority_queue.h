@@ -9,9 +9,15 @@
 #include "si_parray.h" // si_parray_t
 #include "si_realloc_settings.h" // si_realloc_settings_t
 
+#include <stdatomic.h> // _Atomic
 #include <stdbool.h> // bool, false, true
 #include <stdlib.h> // calloc(), free()
 
+#ifndef SI_PRIORITY_QUEUE_MAX_SCHEDULE
+// Upper bound of the summed weights given to si_priority_queue_set_weights().
+#define SI_PRIORITY_QUEUE_MAX_SCHEDULE (1024u)
+#endif//SI_PRIORITY_QUEUE_MAX_SCHEDULE
+
 #ifndef SI_PRIORITY_QUEUE_H
 #define SI_PRIORITY_QUEUE_H
 
@@ -26,6 +32,12 @@ typedef struct si_priority_queue_t
 	void (*p_free_value)(void*);
 	si_parray_t locks;
 	si_parray_t queues;
+	// Weighted fair order of levels, one per dequeue turn. (NULL = strict)
+	size_t* p_schedule;
+	size_t schedule_length;
+	// Dequeue turns between promotions of a level's oldest entry. (0u = off)
+	size_t aging_period;
+	volatile _Atomic size_t turn;
 } si_priority_queue_t;
 
 /** Doxygen
@@ -66,6 +78,17 @@ size_t si_priority_queue_priority_count(
  */
 size_t si_priority_queue_count(const si_priority_queue_t* const p_pqueue);
 
+/** Doxygen
+ * @brief Determine the entries waiting at a single priority level.
+ * 
+ * @param p_pqueue Pointer to the priority_queue struct to read from.
+ * @param priority Priority level to count. 0->(priority_count-1)
+ * 
+ * @return Returns size_t count on success. Returns SIZE_MAX otherwise.
+ */
+size_t si_priority_queue_count_at(const si_priority_queue_t* const p_pqueue,
+	const size_t priority);
+
 /** Doxygen
  * @brief Determines if the queue is empty.
  * 
@@ -77,7 +100,7 @@ bool si_priority_queue_is_empty(const si_priority_queue_t* const p_pqueue);
 
 /** Doxygen
  * @brief Prevents item starvation by moving items up the available priority
- *        levels by size_t amount.
+ *        levels by size_t amount. Items are clamped to the highest level.
  * 
  * @param p_pqueue Pointer to the priority_queue struct to be feed.
  * @param amount Increase in priority level amount.
@@ -99,8 +122,48 @@ size_t si_priority_queue_feed(si_priority_queue_t* const p_pqueue,
 bool si_priority_queue_enqueue(si_priority_queue_t* const p_pqueue,
 	void* const p_data, const size_t priority);
 
+/** Doxygen
+ * @brief Adds many data pointers at one priority under a single lock.
+ * 
+ * @param p_pqueue Pointer to the priority_queue struct to add to.
+ * @param pp_data Array of pointer values to be enqueued in order.
+ * @param count Number of pointer values in pp_data.
+ * @param priority Priority of the values as size_t.
+ * 
+ * @return Returns number of leading values enqueued. Returns 0u on error.
+ */
+size_t si_priority_queue_enqueue_batch(si_priority_queue_t* const p_pqueue,
+	void* const* const pp_data, const size_t count, const size_t priority);
+
+/** Doxygen
+ * @brief Sets per level weights for weighted fair dequeuing. While every
+ *        level has entries, level i is served weight[i] of each sum(weights)
+ *        dequeues. Turns of an empty level go to the highest non-empty one.
+ *        Call before the queue is shared between threads.
+ * 
+ * @param p_pqueue Pointer to the priority_queue struct to be scheduled.
+ * @param p_weights Array of priority_count weights. (NULL = strict priority)
+ * 
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_priority_queue_set_weights(si_priority_queue_t* const p_pqueue,
+	const size_t* const p_weights);
+
+/** Doxygen
+ * @brief Enables age based promotion. Every period dequeue turns the oldest
+ *        entry of one level below the top is moved up by a level, cycling
+ *        through the levels from the bottom.
+ * 
+ * @param p_pqueue Pointer to the priority_queue struct to age.
+ * @param period Dequeue turns between promotions. (0u disables aging)
+ */
+void si_priority_queue_set_aging(si_priority_queue_t* const p_pqueue,
+	const size_t period);
+
 /** Doxygen
  * @brief Determines and pops highest priority item from a priority queue.
+ * @details With weights set the level is taken from the weighted schedule
+ *          first. Either way the pick costs O(1) while that level has items.
  * 
  * @param Pointer to the priority_queue struct to remove item from.
  * 
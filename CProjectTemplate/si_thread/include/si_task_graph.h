@@ -0,0 +1,170 @@
+/* si_task_graph.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Dependency graph (DAG) of tasks run on a si_threadpool_t. A task
+ *           is enqueued by whichever predecessor finishes last.
+ */
+
+#include "si_array.h" // si_array_t
+#include "si_future.h" // si_future_t
+#include "si_threadpool.h" // si_threadpool_t, p_task_f
+
+#include <stdatomic.h> // _Atomic, atomic_bool
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // SIZE_MAX
+
+#define SI_TASK_GRAPH_NODE_INVALID (SIZE_MAX)
+
+#ifndef SI_TASK_GRAPH_H
+#define SI_TASK_GRAPH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+typedef struct si_task_graph_node_t
+{
+	p_task_f p_task;
+	void* p_param;
+	void* p_result;
+	// Copied into pending_count at the start of every run.
+	size_t predecessor_count;
+	volatile _Atomic size_t pending_count;
+	// Range of this node's successors within the graph's successors array.
+	size_t successor_begin;
+	size_t successor_end;
+	struct si_task_graph_t* p_graph;
+	// Future of the pool task running this node. (NULL when run inline)
+	_Atomic(si_future_t*) p_future;
+	// Set once a dropped task or predecessor means this node never runs.
+	volatile atomic_bool is_abandoned;
+} si_task_graph_node_t;
+
+typedef struct si_task_graph_edge_t
+{
+	size_t before;
+	size_t after;
+} si_task_graph_edge_t;
+
+typedef struct si_task_graph_t
+{
+	si_array_t nodes;
+	size_t node_count;
+	si_array_t edges;
+	size_t edge_count;
+	// Successor node indexes grouped by node, rebuilt by each run.
+	si_array_t successors;
+	si_threadpool_t* p_pool;
+	volatile _Atomic size_t remaining_count;
+	// Nodes of the run that will never run, counted by si_task_graph_wait().
+	volatile _Atomic size_t abandoned_count;
+	volatile atomic_bool is_running;
+	// Completed when the last node of a run finishes.
+	si_future_t done;
+} si_task_graph_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_task_graph_t struct as an empty graph.
+ *
+ * @param p_graph Pointer to the task graph struct to be initialized.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_task_graph_init(si_task_graph_t* const p_graph);
+
+/** Doxygen
+ * @brief Allocates and initializes a new empty si_task_graph_t on the heap.
+ *
+ * @return Returns heap pointer on success. Returns NULL otherwise.
+ */
+si_task_graph_t* si_task_graph_new();
+
+/** Doxygen
+ * @brief Adds a task node to a graph that isn't running.
+ *
+ * @param p_graph Pointer to the task graph struct to add to.
+ * @param p_task Function of the task to be executed. void* func(void* p_arg);
+ * @param p_param Pointer parameter to pass to the task function on run.
+ *
+ * @return Returns node index on success. SI_TASK_GRAPH_NODE_INVALID otherwise.
+ */
+size_t si_task_graph_add_3(si_task_graph_t* const p_graph,
+	p_task_f const p_task, void* const p_param);
+size_t si_task_graph_add(si_task_graph_t* const p_graph,
+	p_task_f const p_task);
+
+/** Doxygen
+ * @brief Declares that node before must finish before node after starts.
+ *
+ * @param p_graph Pointer to the task graph struct holding both nodes.
+ * @param before Index of the predecessor node.
+ * @param after Index of the successor node.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_task_graph_precede(si_task_graph_t* const p_graph,
+	const size_t before, const size_t after);
+
+/** Doxygen
+ * @brief Starts a run of the graph on a threadpool without blocking.
+ * @details Nodes without predecessors are enqueued first. A finishing
+ *          node enqueues each successor it released, except one it runs
+ *          next itself, so no worker blocks on upstream results. Runs the
+ *          whole graph on the caller when p_pool is NULL or not running.
+ *
+ * @param p_graph Pointer to the task graph struct to run.
+ * @param p_pool Pointer to the threadpool to run on. (NULL ok)
+ *
+ * @return Returns stdbool true on success. Returns false if already running
+ *         or when the graph has a cycle.
+ */
+bool si_task_graph_run(si_task_graph_t* const p_graph,
+	si_threadpool_t* const p_pool);
+
+/** Doxygen
+ * @brief Blocks until the current run of the graph has finished.
+ * @details Called from one of the pool's workers it runs other tasks while
+ *          waiting, like si_threadpool_await_future(). Nodes whose task the
+ *          pool dropped, along with everything after them, are counted as
+ *          cancelled so the run still finishes. Nodes a stopped pool still
+ *          holds in its queue run once it's restarted or drop when it's freed.
+ *
+ * @param p_graph Pointer to the task graph struct to wait on.
+ *
+ * @return Returns stdbool true when every node ran. Returns false otherwise.
+ */
+bool si_task_graph_wait(si_task_graph_t* const p_graph);
+
+/** Doxygen
+ * @brief Gets the value a node's task returned in the last finished run.
+ *
+ * @param p_graph Pointer to the task graph struct to read from.
+ * @param node Index of the node to read.
+ *
+ * @return Returns the task's result pointer. Returns NULL otherwise.
+ */
+void* si_task_graph_result(si_task_graph_t* const p_graph, const size_t node);
+
+/** Doxygen
+ * @brief Frees the contents of an existing si_task_graph_t struct.
+ * @details Waits out a current run first. A stopped pool still holding nodes
+ *          of the run must be shut down or freed before the graph is.
+ *
+ * @param p_graph Pointer to the task graph struct to have its contents freed.
+ */
+void si_task_graph_free(si_task_graph_t* const p_graph);
+
+/** Doxygen
+ * @brief Frees a heap si_task_graph_t struct by its pointer's address.
+ *
+ * @param pp_graph Pointer to the task graph struct's heap pointer to destroy.
+ */
+void si_task_graph_destroy(si_task_graph_t** const pp_graph);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_TASK_GRAPH_H
@@ -35,6 +35,7 @@
 #endif// Linux or Unix(FreeBSD)
 
 #include <pthread.h> // pthread_create()
+#include <sched.h> // sched_yield()
 #include <signal.h> // pthread_kill()
 #include <unistd.h> // sysconf, usleep
 
@@ -81,6 +82,7 @@ int pthread_timedjoin(pthread_t thread, void** pp_result,
 	(WAIT_TIMEOUT == WaitForSingleObject(thread, 0))
 
 #define si_thread_exit(code) ExitThread(code)
+#define si_thread_yield() ((void)SwitchToThread())
 #define si_thread_kill(thread) \
 	(SI_PTHREAD_SUCCESS != TerminateThread(thread, 0))
 #define si_thread_free(thread) \
@@ -106,6 +108,7 @@ int pthread_timedjoin(pthread_t thread, void** pp_result,
 	(si_thread_is_valid(thread))
 
 #define si_thread_exit(p_ret) pthread_exit(p_ret)
+#define si_thread_yield() ((void)sched_yield())
 #define si_thread_kill(thread) \
 	(SI_PTHREAD_SUCCESS == pthread_kill(thread, SIGKILL))
 #define si_thread_free(thread) // NOP
@@ -116,6 +119,22 @@ int pthread_timedjoin(pthread_t thread, void** pp_result,
 #ifndef SI_THREAD_H
 #define SI_THREAD_H
 
+// Longest sysfs CPU list line read when discovering NUMA topology.
+#ifndef SI_THREAD_CPULIST_MAX
+#define SI_THREAD_CPULIST_MAX (4096u)
+#endif//SI_THREAD_CPULIST_MAX
+
+// Hints to the CPU that the caller is busy waiting in a spin loop.
+#if defined(_MSC_VER)
+#define si_cpu_relax() YieldProcessor()
+#elif defined(__x86_64__) || defined(__i386__)
+#define si_cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define si_cpu_relax() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define si_cpu_relax() // NOP
+#endif// Architecture specific spin hint
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -128,6 +147,38 @@ extern "C"
  */
 size_t si_cpu_core_count();
 
+/** Doxygen
+ * @brief Determines the number of NUMA nodes. (Linux sysfs, 1 elsewhere)
+ * 
+ * @return Returns the size_t count of NUMA nodes on success, or 1 otherwise.
+ */
+size_t si_cpu_numa_node_count();
+
+/** Doxygen
+ * @brief Lists the CPU indexes belonging to a NUMA node.
+ * @details Reads /sys/devices/system/node/node<N>/cpulist on Linux. Without
+ *          NUMA information node 0 holds every CPU of si_cpu_core_count().
+ * 
+ * @param node Index of the NUMA node to list.
+ * @param p_cpus Pointer to array receiving up to capacity CPU indexes.
+ * @param capacity Number of size_t slots in p_cpus.
+ * 
+ * @return Returns number of CPU indexes written. Returns 0u on error.
+ */
+size_t si_cpu_numa_node_cpus(const size_t node, size_t* const p_cpus,
+	const size_t capacity);
+
+/** Doxygen
+ * @brief Pins the calling thread to a set of CPUs.
+ * 
+ * @param p_cpus Pointer to array of CPU indexes to allow.
+ * @param count Number of CPU indexes in p_cpus.
+ * 
+ * @return Returns stdbool true on success. Returns false otherwise or where
+ *         the OS offers no affinity control (Mac OS).
+ */
+bool si_thread_pin_cpus(const size_t* const p_cpus, const size_t count);
+
 /** Doxygen
  * @brief Joins a specified si_thread_t and returns its thread value.
  * 
@@ -5,10 +5,16 @@
  */
 
 #include "si_array.h" // si_array_t
+#include "si_cancel.h" // si_cancel_token_t
+#include "si_fiber.h" // si_fiber_stack_pool_t
+#include "si_futex.h" // si_event_t
+#include "si_future.h" // si_future_t, si_future_wait()
 #include "si_parray.h" // si_parray_t
 #include "si_priority_queue.h" // si_priority_queue_t
 #include "si_thread.h" // si_thread_t
 #include "si_mutex.h" // si_mutex_new(), si_mutex_lock(), si_mutex_unlock()
+#include "si_timer_wheel.h" // si_timer_wheel_t
+#include "si_ws_deque.h" // si_ws_deque_t
 
 #include <errno.h> // ETIMEDOUT
 #include <stdatomic.h> // atomic_bool
@@ -19,6 +25,55 @@
 #define SI_THREADPOOL_PRIORITY_MIN (0u)
 #define SI_THREADPOOL_DEFAULT_PRIORITY_COUNT (1u)
 
+// Bounds of the adaptive spin an idle worker does before parking.
+#ifndef SI_THREADPOOL_SPIN_MIN
+#define SI_THREADPOOL_SPIN_MIN (64u)
+#endif//SI_THREADPOOL_SPIN_MIN
+#ifndef SI_THREADPOOL_SPIN_MAX
+#define SI_THREADPOOL_SPIN_MAX (16384u)
+#endif//SI_THREADPOOL_SPIN_MAX
+
+// Recycled task descriptors kept per worker & shared by the whole pool.
+#ifndef SI_THREADPOOL_TASK_CACHE
+#define SI_THREADPOOL_TASK_CACHE (64u)
+#endif//SI_THREADPOOL_TASK_CACHE
+#ifndef SI_THREADPOOL_FREE_TASKS_MAX
+#define SI_THREADPOOL_FREE_TASKS_MAX (4096u)
+#endif//SI_THREADPOOL_FREE_TASKS_MAX
+
+// Tasks built per queue lock hold by si_threadpool_enqueue_batch().
+#ifndef SI_THREADPOOL_BATCH_CHUNK
+#define SI_THREADPOOL_BATCH_CHUNK (64u)
+#endif//SI_THREADPOOL_BATCH_CHUNK
+// Chunks per thread aimed for when parallel_for() picks its own grain.
+#ifndef SI_THREADPOOL_FOR_CHUNKS_PER_THREAD
+#define SI_THREADPOOL_FOR_CHUNKS_PER_THREAD (4u)
+#endif//SI_THREADPOOL_FOR_CHUNKS_PER_THREAD
+
+// Most CPUs a worker is pinned to, bounds a stack buffer in each worker.
+#ifndef SI_THREADPOOL_PIN_CPUS_MAX
+#define SI_THREADPOOL_PIN_CPUS_MAX (1024u)
+#endif//SI_THREADPOOL_PIN_CPUS_MAX
+
+// Elastic mode defaults, queue wait that adds a worker & idle time that
+// retires one. (Millisecs)
+#ifndef SI_THREADPOOL_DEFAULT_SPAWN_WAIT
+#define SI_THREADPOOL_DEFAULT_SPAWN_WAIT (5u)
+#endif//SI_THREADPOOL_DEFAULT_SPAWN_WAIT
+#ifndef SI_THREADPOOL_DEFAULT_IDLE_TIMEOUT
+#define SI_THREADPOOL_DEFAULT_IDLE_TIMEOUT (1000u)
+#endif//SI_THREADPOOL_DEFAULT_IDLE_TIMEOUT
+
+#ifndef SI_THREADPOOL_IO_CANCEL_POLL
+// Millisecs between cancellation checks of fibers waiting on descriptors.
+#define SI_THREADPOOL_IO_CANCEL_POLL (50)
+#endif//SI_THREADPOOL_IO_CANCEL_POLL
+
+// Per-worker scheduler counters, see si_threadpool_stats.h. (0 = disabled)
+#ifndef SI_THREADPOOL_STATS
+#define SI_THREADPOOL_STATS (1)
+#endif//SI_THREADPOOL_STATS
+
 #ifdef _GNU_SOURCE
 #define SI_THREADPOOL_DEFAULT_JOIN_TIMEOUT (100)
 #endif//_GNU_SOURCE
@@ -33,15 +88,78 @@ extern "C"
 
 typedef void* (*p_task_f)(void*);
 
+typedef enum si_threadpool_affinity_t
+{
+	// Workers float wherever the OS schedules them.
+	SI_THREADPOOL_AFFINITY_NONE = 0,
+	// Worker N is pinned to the Nth CPU, filling one NUMA node at a time.
+	SI_THREADPOOL_AFFINITY_CORE = 1,
+	// Workers are dealt round-robin to NUMA nodes & pinned to all its CPUs.
+	SI_THREADPOOL_AFFINITY_NUMA = 2,
+} si_threadpool_affinity_t;
+// Loop body run over the half-open index range [begin, end).
+typedef void (*p_range_f)(size_t begin, size_t end, void* p_context);
+
 typedef struct si_threadpool_t
 {
-	si_mutex_t task_counter_lock;
 	si_mutex_t pool_lock;
 	si_mutex_t results_lock;
 	volatile atomic_bool is_running;
+	// Cancelled by stop & shutdown, polled by tasks via is_cancelled().
+	si_cancel_token_t cancel_token;
+	// Next task ID, taken with a single atomic add. (No lock)
 	volatile _Atomic size_t task_counter;
-	si_cond_t results_appended_signal;
-	si_cond_t task_completed_signal;
+	// Tasks enqueued but not yet taken by a worker.
+	volatile _Atomic size_t pending_count;
+	// Workers currently waiting on work_available_event.
+	volatile _Atomic size_t parked_count;
+	// Stack list of threads awaiting a result, an append only wakes those
+	// awaiting its UID. (results_lock held)
+	struct local_results_waiter_t* p_results_waiters;
+	// Futex events, notifying them costs no system call without waiters.
+	si_event_t task_completed_event;
+	si_event_t work_available_event;
+	// Work-stealing mode gives each worker its own deque for spawned tasks.
+	bool is_work_stealing;
+	si_array_t deques;
+	// Placement of workers, NUMA node of each worker index. (size_t)
+	si_threadpool_affinity_t affinity;
+	si_array_t worker_nodes;
+	// Task descriptors are recycled instead of freed after each run.
+	si_mutex_t task_free_lock;
+	void* p_free_tasks;
+	size_t free_task_count;
+	si_array_t task_caches;
+	// Descriptors that had to come from the heap. (Flat in steady state)
+	volatile _Atomic size_t task_alloc_count;
+	// Delayed & periodic tasks wait here for the timer thread. (1 tick = 1ms)
+	si_mutex_t timer_lock;
+	si_cond_t timer_signal;
+	si_timer_wheel_t timers;
+	si_thread_t timer_thread;
+	bool has_timer_thread;
+	// Elastic mode runs min_threads->max_threads workers. (Millisec settings)
+	bool is_elastic;
+	size_t min_threads;
+	size_t max_threads;
+	uint32_t spawn_wait;
+	uint32_t idle_timeout;
+	// Workers started & not yet retired, and those inside blocking sections.
+	volatile _Atomic size_t live_count;
+	volatile _Atomic size_t blocked_count;
+	// Fiber tasks run on guarded stacks. Those waiting on a file descriptor
+	// are polled by the I/O thread, woken through io_wake_fds[1].
+	si_fiber_stack_pool_t fiber_stacks;
+	si_mutex_t fiber_lock;
+	void* p_io_waiters;
+	int io_wake_fds[2];
+	si_thread_t io_thread;
+	bool has_io_thread;
+#if SI_THREADPOOL_STATS
+	// One si_threadpool_worker_stats_t per worker index.
+	si_array_t worker_stats;
+#endif//SI_THREADPOOL_STATS
+	// One slot per worker index, sized to max_threads in elastic mode.
 	si_array_t pool;
 	si_parray_t results;
 	si_priority_queue_t queue;
@@ -49,10 +167,16 @@ typedef struct si_threadpool_t
 
 /** Doxygen
  * @brief Initializes an existing si_threadpool at pointer address.
+ * @details In work-stealing mode tasks enqueued from inside a task go to the
+ *          running worker's own deque (priority ignored) and idle workers
+ *          steal from random peers. Other enqueues use the priority queue.
  * 
  * @param p_pool Pointer to si_threadpool_t to be initialized.
  * @param priority_count Number of priority levels to allow.
+ * @param is_work_stealing Enables per-worker deques when true.
  */
+void si_threadpool_init_3(si_threadpool_t* const p_pool,
+	const size_t priority_count, const bool is_work_stealing);
 void si_threadpool_init_2(si_threadpool_t* const p_pool,
 	const size_t priority_count);
 void si_threadpool_init  (si_threadpool_t* const p_pool);
@@ -61,9 +185,12 @@ void si_threadpool_init  (si_threadpool_t* const p_pool);
  * @brief Allocates and initializes a new si_threadpool_t on the heap.
  * 
  * @param priority_count Number of priority levels to allow.
+ * @param is_work_stealing Enables per-worker deques when true.
  * 
  * @return Returns heap pointer on success. Returns NULL otherwise.
  */
+si_threadpool_t* si_threadpool_new_2(const size_t priority_count,
+	const bool is_work_stealing);
 si_threadpool_t* si_threadpool_new_1(const size_t priority_count);
 si_threadpool_t* si_threadpool_new  ();
 
@@ -99,6 +226,172 @@ size_t si_threadpool_enqueue_3(si_threadpool_t* const p_pool,
 size_t si_threadpool_enqueue  (si_threadpool_t* const p_pool,
 	p_task_f const p_task);
 
+/** Doxygen
+ * @brief Enqueues count one-shot tasks running the same function.
+ * @details Task UIDs are reserved with one atomic add and tasks are
+ *          published SI_THREADPOOL_BATCH_CHUNK at a time under one queue lock
+ *          with one wake-up. Non-NULL results are stored as usual.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add tasks to.
+ * @param p_task Function every task executes. void* func(void* p_arg);
+ * @param pp_parameters Array of count parameters, one passed to each task.
+ * @param count Number of tasks to enqueue.
+ * @param p_task_ids Optional array receiving count task UIDs. (NULL ok)
+ * @param priority QoS size_t priority level of the tasks.
+ * 
+ * @return Returns number of leading tasks enqueued. (count on success)
+ */
+size_t si_threadpool_enqueue_batch_6(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	const size_t count, size_t* const p_task_ids, const size_t priority);
+size_t si_threadpool_enqueue_batch_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	const size_t count, size_t* const p_task_ids);
+size_t si_threadpool_enqueue_batch(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	const size_t count);
+
+/** Doxygen
+ * @brief Enqueues a one-shot task whose result is delivered via a future.
+ * @details The result skips the shared results list and is stored even when
+ *          NULL. Tasks dropped by si_threadpool_free() cancel their future.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed. void* func(void* p_arg);
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param priority QoS size_t priority level of the task. 0->(priority_count-1)
+ * 
+ * @return Returns heap future on success, release with si_future_destroy().
+ *         Returns NULL otherwise.
+ */
+si_future_t* si_threadpool_enqueue_future_4(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const size_t priority);
+si_future_t* si_threadpool_enqueue_future_3(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter);
+si_future_t* si_threadpool_enqueue_future(si_threadpool_t* const p_pool,
+	p_task_f const p_task);
+
+/** Doxygen
+ * @brief Enqueues a one-shot task that is skipped if a token is cancelled.
+ * @details A task whose token is cancelled before it starts never runs and
+ *          its future is cancelled. Once running it polls
+ *          si_threadpool_is_cancelled(), which also reads this token.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed. void* func(void* p_arg);
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param p_token Pointer to the task's token, retained until it's done.
+ * @param priority QoS size_t priority level of the task. 0->(priority_count-1)
+ * 
+ * @return Returns heap future on success, release with si_future_destroy().
+ *         Returns NULL otherwise.
+ */
+si_future_t* si_threadpool_enqueue_cancellable_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter,
+	si_cancel_token_t* const p_token, const size_t priority);
+si_future_t* si_threadpool_enqueue_cancellable(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter,
+	si_cancel_token_t* const p_token);
+
+/** Doxygen
+ * @brief Checks if the calling task should stop early. Cheap enough to poll
+ *        from inner loops.
+ * 
+ * @param p_pool Pointer to the thread pool struct running the calling task.
+ * 
+ * @return Returns stdbool true when the pool is stopping or the calling
+ *         task's own token is cancelled. Returns false otherwise.
+ */
+bool si_threadpool_is_cancelled(si_threadpool_t* const p_pool);
+
+/** Doxygen
+ * @brief Enqueues a one-shot task once a delay has passed.
+ * @details Waiting tasks sit in a timing wheel serviced by a timer thread
+ *          that sleeps until the earliest deadline, so they cost no CPU.
+ *          The result is stored under the returned UID as usual.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed. void* func(void* p_arg);
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param delay Millisecs from now before the task is enqueued.
+ * @param priority QoS size_t priority level of the task. 0->(priority_count-1)
+ * 
+ * @return Returns task UID on success. Otherwise SI_THREADPOOL_TASK_ID_INVALID
+ */
+size_t si_threadpool_enqueue_after_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t delay,
+	const size_t priority);
+size_t si_threadpool_enqueue_after(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t delay);
+
+/** Doxygen
+ * @brief Enqueues a one-shot task run as a fiber on its own stack, so it can
+ *        give its worker up with si_task_yield() & si_task_wait_fd().
+ * @details Each resume runs as a task at the given priority, on whichever
+ *          worker takes it. Fibers still suspended when the pool is freed,
+ *          or dropped by a stop, are abandoned without unwinding their stack
+ *          & cancel their future. Thread-locals must not be cached across a
+ *          yield. (Needs SI_FIBER)
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed. void* func(void* p_arg);
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param p_token Pointer to the task's token, retained until done. (NULL ok)
+ * @param priority QoS size_t priority level of the task. 0->(priority_count-1)
+ * 
+ * @return Returns heap future on success, release with si_future_destroy().
+ *         Returns NULL otherwise.
+ */
+si_future_t* si_threadpool_enqueue_fiber_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter,
+	si_cancel_token_t* const p_token, const size_t priority);
+si_future_t* si_threadpool_enqueue_fiber(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter);
+
+/** Doxygen
+ * @brief Suspends the calling fiber task, queueing it to be resumed behind
+ *        the tasks already waiting. Outside a fiber it yields the thread.
+ * 
+ * @return Returns stdbool true if a fiber was suspended & has resumed.
+ *         Returns false otherwise.
+ */
+bool si_task_yield(void);
+
+/** Doxygen
+ * @brief Waits for a file descriptor to be ready. Fiber tasks are suspended
+ *        & handed to the pool's I/O thread, other callers block in poll().
+ * 
+ * @param fd File descriptor to wait on.
+ * @param events poll() events to wait for. (POLLIN, POLLOUT, ...)
+ * @param timeout Max millisecs to wait. (Negative for no limit)
+ * 
+ * @return Returns the poll() revents when ready, 0 on timeout & -1 on error
+ *         or when a waiting fiber was cancelled.
+ */
+int si_task_wait_fd_3(const int fd, const short events, const int timeout);
+int si_task_wait_fd(const int fd, const short events);
+
+/** Doxygen
+ * @brief Enqueues a one-shot run of a task every period millisecs.
+ * @details Firings are scheduled at a fixed rate from the timer wheel and
+ *          don't wait for the previous run to finish. Firings missed while
+ *          the pool was stopped are skipped. Results are discarded.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed. void* func(void* p_arg);
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param period Millisecs between firings, the first one period from now.
+ * @param priority QoS size_t priority level of the task. 0->(priority_count-1)
+ * 
+ * @return Returns a pending heap future on success. si_future_cancel() stops
+ *         further firings, release with si_future_destroy(). NULL otherwise.
+ */
+si_future_t* si_threadpool_enqueue_every_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t period,
+	const size_t priority);
+si_future_t* si_threadpool_enqueue_every(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t period);
+
 /** Doxygen
  * @brief Pops a task result by UID from threadpool.
  * 
@@ -112,6 +405,8 @@ void* si_threadpool_pop_results(si_threadpool_t* const p_pool,
 
 /** Doxygen
  * @brief Blocks waiting for a task result to become ready. (Pops task result)
+ * @details When called from one of the pool's own workers it runs other
+ *          queued tasks while waiting, so tasks may await tasks they spawned.
  * 
  * @param p_pool Pointer to the thread pool struct to read from.
  * @param task_id UID of size_t to id the results to be waited on.
@@ -121,6 +416,40 @@ void* si_threadpool_pop_results(si_threadpool_t* const p_pool,
 void* si_threadpool_await_results(si_threadpool_t* const p_pool,
 	const size_t task_id);
 
+/** Doxygen
+ * @brief Blocks waiting on a future of a task enqueued into the pool.
+ * @details Same as si_future_wait() except that one of the pool's own workers
+ *          runs other queued tasks while waiting.
+ * 
+ * @param p_pool Pointer to the thread pool struct the task was enqueued to.
+ * @param p_future Pointer to the future to wait on. (Not released)
+ * 
+ * @return Returns result pointer on Success. Returns NULL otherwise.
+ */
+void* si_threadpool_await_future(si_threadpool_t* const p_pool,
+	si_future_t* const p_future);
+
+/** Doxygen
+ * @brief Runs p_body over [begin, end) split into grain sized chunks.
+ * @details One helper task per idle worker is published in a single batch;
+ *          helpers and the caller then claim chunks from a shared atomic
+ *          counter. Runs inline when the pool is NULL or not running. The
+ *          pool must keep running until this returns.
+ * 
+ * @param p_pool Pointer to the thread pool struct to run helpers on.
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param grain Indexes per chunk. 0u picks SI_THREADPOOL_FOR_CHUNKS_PER_THREAD
+ *              chunks per thread.
+ * @param p_body Function called as p_body(chunk_begin, chunk_end, p_context).
+ * @param p_context Pointer passed to every p_body call.
+ * 
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_threadpool_parallel_for(si_threadpool_t* const p_pool,
+	const size_t begin, const size_t end, const size_t grain,
+	p_range_f const p_body, void* const p_context);
+
 /** Doxygen
  * @brief Blocks waiting for the pool to be stopped or freed.
  * 
@@ -128,8 +457,59 @@ void* si_threadpool_await_results(si_threadpool_t* const p_pool,
  */
 void si_threadpool_await(si_threadpool_t** const pp_pool);
 
+/** Doxygen
+ * @brief Sets how the next started workers are placed on CPUs.
+ * @details Each worker pins itself before it touches any pool memory, then
+ *          sets up its own deque & descriptor cache so they are first
+ *          touched on its NUMA node. Work-stealing workers steal from peers
+ *          on their own node before crossing to another.
+ * 
+ * @param p_pool Pointer to the thread pool struct to configure.
+ * @param affinity Placement to apply from the next si_threadpool_start_2().
+ */
+void si_threadpool_set_affinity(si_threadpool_t* const p_pool,
+	const si_threadpool_affinity_t affinity);
+
+/** Doxygen
+ * @brief Lets the pool grow & shrink between two worker counts once started.
+ * @details A worker is added when a task waited longer than spawn_wait in the
+ *          queue while no worker was parked, or when every worker is inside a
+ *          blocking section. Workers above min_threads exit after idle_timeout
+ *          without work. Has no effect on a running pool.
+ * 
+ * @param p_pool Pointer to the thread pool struct to configure.
+ * @param min_threads Workers always kept running. (At least 1u)
+ * @param max_threads Most workers ever running. 0u turns elastic mode off.
+ * @param spawn_wait Queue wait in millisecs that adds a worker.
+ * @param idle_timeout Millisecs a worker above min_threads idles before exit.
+ */
+void si_threadpool_set_elastic_5(si_threadpool_t* const p_pool,
+	const size_t min_threads, const size_t max_threads,
+	const uint32_t spawn_wait, const uint32_t idle_timeout);
+void si_threadpool_set_elastic(si_threadpool_t* const p_pool,
+	const size_t min_threads, const size_t max_threads);
+
+/** Doxygen
+ * @brief Marks the calling task as about to block, e.g. on I/O or a lock.
+ * @details In elastic mode a compensating worker is started when tasks are
+ *          waiting & no worker is parked. Calls from threads that aren't
+ *          workers of the pool are ignored. Pair with blocking_end().
+ * 
+ * @param p_pool Pointer to the thread pool struct running the calling task.
+ */
+void si_threadpool_blocking_begin(si_threadpool_t* const p_pool);
+
+/** Doxygen
+ * @brief Marks the end of a blocking section started by blocking_begin().
+ * @details Extra workers it caused are retired after their idle timeout.
+ * 
+ * @param p_pool Pointer to the thread pool struct running the calling task.
+ */
+void si_threadpool_blocking_end(si_threadpool_t* const p_pool);
+
 /** Doxygen
  * @brief Starts the threadpool's worker threads of a specified count.
+ * @details In elastic mode the count is clamped to min/max threads.
  * 
  * @param p_pool Pointer to the thread pool struct to start threads in.
  * @param thread_count Target number of worker threads to start.
@@ -139,10 +519,13 @@ void si_threadpool_start_2(si_threadpool_t* const p_pool,
 void si_threadpool_start  (si_threadpool_t* const p_pool);
 
 /** Doxygen
- * @brief Stops a started/running threadpool at address with a timeout.
+ * @brief Stops a started/running threadpool at address with a grace period.
+ * @details Workers finish their current task & take no new ones. The pool's
+ *          token is cancelled after the grace period, then every worker is
+ *          joined. Queued tasks are kept for a restart.
  * 
  * @param p_pool Pointer to the thread pool struct to stop threads of.
- * @param timeout millisec offset before kill is signaled. 0 = no timeout
+ * @param timeout millisec offset before cancel is signaled. 0 = right away
  */
 void si_threadpool_stop_2(si_threadpool_t* const p_pool,
 	const uint32_t timeout);
@@ -154,6 +537,18 @@ void si_threadpool_stop_2(si_threadpool_t* const p_pool,
  */
 void si_threadpool_stop  (si_threadpool_t* const p_pool);
 
+/** Doxygen
+ * @brief Stops a pool after running or abandoning all of its queued tasks.
+ * @details Draining waits until the queue is empty & every worker is idle.
+ *          Tasks left in the queue are freed & their futures cancelled. Not
+ *          to be called from the pool's own tasks.
+ * 
+ * @param p_pool Pointer to the thread pool struct to shut down.
+ * @param drain Runs queued tasks first when true, abandons them otherwise.
+ */
+void si_threadpool_shutdown_2(si_threadpool_t* const p_pool, const bool drain);
+void si_threadpool_shutdown(si_threadpool_t* const p_pool);
+
 /** Doxygen
  * @brief Stops and frees the contents of an existing si_threadpool_t struct.
  * 
@@ -0,0 +1,143 @@
+/* si_threadpool_stats.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Scheduler counters & latency histograms of a si_threadpool_t.
+ *           Workers only write their own counters, readers aggregate them on
+ *           demand. Compiled out when SI_THREADPOOL_STATS is 0.
+ */
+
+#include "si_array.h" // si_array_t
+#include "si_threadpool.h" // si_threadpool_t, SI_THREADPOOL_STATS
+
+#include <stdatomic.h> // _Atomic
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t
+#include <stdio.h> // FILE, fprintf()
+
+// Bucket N of a histogram counts durations in [2^N, 2^(N+1)) nanosecs. The
+// first bucket also holds 0ns & the last one everything longer.
+#ifndef SI_THREADPOOL_STATS_BUCKETS
+#define SI_THREADPOOL_STATS_BUCKETS (40u)
+#endif//SI_THREADPOOL_STATS_BUCKETS
+
+#ifndef SI_THREADPOOL_STATS_H
+#define SI_THREADPOOL_STATS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+typedef struct si_threadpool_histogram_t
+{
+	uint64_t buckets[SI_THREADPOOL_STATS_BUCKETS];
+	uint64_t count;
+	uint64_t sum_ns;
+} si_threadpool_histogram_t;
+
+// Live counters of one worker. Written by that worker only. (Relaxed)
+typedef struct si_threadpool_worker_stats_t
+{
+	volatile _Atomic uint64_t tasks_run;
+	volatile _Atomic uint64_t steals;
+	volatile _Atomic uint64_t parks;
+	volatile _Atomic uint64_t idle_ns;
+	volatile _Atomic uint64_t busy_ns;
+	volatile _Atomic uint64_t wait_ns;
+	volatile _Atomic uint64_t wait_buckets[SI_THREADPOOL_STATS_BUCKETS];
+	volatile _Atomic uint64_t run_buckets[SI_THREADPOOL_STATS_BUCKETS];
+} si_threadpool_worker_stats_t;
+
+// Point in time aggregate of a pool's counters.
+typedef struct si_threadpool_stats_t
+{
+	size_t worker_count;
+	size_t parked_count;
+	size_t pending_count;
+	size_t timer_count;
+	// Tasks waiting in the shared queue per priority level. (size_t)
+	si_array_t queue_depths;
+	uint64_t tasks_run;
+	uint64_t steals;
+	uint64_t parks;
+	uint64_t idle_ns;
+	uint64_t busy_ns;
+	// Time from enqueue to the start of a run.
+	si_threadpool_histogram_t wait;
+	// Time spent running a task.
+	si_threadpool_histogram_t run;
+} si_threadpool_stats_t;
+
+/** Doxygen
+ * @brief Gets the histogram bucket a duration is counted in.
+ *
+ * @param duration_ns Duration in nanosecs.
+ *
+ * @return Returns bucket index. 0->(SI_THREADPOOL_STATS_BUCKETS-1)
+ */
+size_t si_threadpool_stats_bucket(const uint64_t duration_ns);
+
+/** Doxygen
+ * @brief Estimates a percentile of a histogram.
+ *
+ * @param p_histogram Pointer to the histogram to read.
+ * @param percentile Fraction of samples at or below the result. (0.0->1.0)
+ *
+ * @return Returns the upper bound in nanosecs of the bucket holding the
+ *         percentile. Returns 0u when empty or on error.
+ */
+uint64_t si_threadpool_histogram_percentile(
+	const si_threadpool_histogram_t* const p_histogram, const double percentile);
+
+/** Doxygen
+ * @brief Initializes an existing si_threadpool_stats_t struct to zeros.
+ *
+ * @param p_stats Pointer to the stats struct to be initialized.
+ */
+void si_threadpool_stats_init(si_threadpool_stats_t* const p_stats);
+
+/** Doxygen
+ * @brief Aggregates the per-worker counters & queue depths of a pool.
+ * @details Counters are read without stopping the workers, so totals may
+ *          be a few events apart. Counters are kept across stop & restart.
+ *
+ * @param p_pool Pointer to the thread pool struct to read.
+ * @param p_stats Pointer to an initialized stats struct to fill.
+ *
+ * @return Returns stdbool true on success. Returns false on error or when
+ *         compiled with SI_THREADPOOL_STATS 0.
+ */
+bool si_threadpool_stats_snapshot(si_threadpool_t* const p_pool,
+	si_threadpool_stats_t* const p_stats);
+
+/** Doxygen
+ * @brief Prints a stats snapshot in a human readable form.
+ *
+ * @param p_file Pointer to the FILE to print to.
+ * @param p_stats Pointer to the stats struct to print.
+ */
+void si_threadpool_stats_fprint(FILE* const p_file,
+	const si_threadpool_stats_t* const p_stats);
+
+/** Doxygen
+ * @brief Prints a stats snapshot as a single JSON object.
+ *
+ * @param p_file Pointer to the FILE to print to.
+ * @param p_stats Pointer to the stats struct to print.
+ */
+void si_threadpool_stats_fprint_json(FILE* const p_file,
+	const si_threadpool_stats_t* const p_stats);
+
+/** Doxygen
+ * @brief Frees the contents of an existing si_threadpool_stats_t struct.
+ *
+ * @param p_stats Pointer to the stats struct to have its contents freed.
+ */
+void si_threadpool_stats_free(si_threadpool_stats_t* const p_stats);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_THREADPOOL_STATS_H
@@ -0,0 +1,117 @@
+/* si_timer_wheel.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Hierarchical timing wheel of deadlines in abstract ticks. Adding
+ *           & firing are O(1), idle ticks are skipped over. (Not thread-safe)
+ */
+
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t, UINT64_MAX
+
+// Each level has 2^SI_TIMER_WHEEL_SLOT_BITS slots, covering that many times
+// the span of the level below. 4 levels of 64 cover 2^24 ticks, later
+// deadlines wait in the top level & are re-filed as it turns.
+#define SI_TIMER_WHEEL_SLOT_BITS (6u)
+#define SI_TIMER_WHEEL_SLOTS (1u << SI_TIMER_WHEEL_SLOT_BITS)
+#define SI_TIMER_WHEEL_LEVELS (4u)
+#define SI_TIMER_WHEEL_NEVER (UINT64_MAX)
+
+#ifndef SI_TIMER_WHEEL_H
+#define SI_TIMER_WHEEL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// Called per expired entry. Returning true re-arms it at *p_deadline, which
+// holds the deadline that just expired. Returning false drops the entry.
+typedef bool (*p_timer_expire_f)(void* p_data, uint64_t* p_deadline,
+	void* p_context);
+
+typedef struct si_timer_wheel_entry_t
+{
+	uint64_t deadline;
+	void* p_data;
+	struct si_timer_wheel_entry_t* p_next;
+} si_timer_wheel_entry_t;
+
+typedef struct si_timer_wheel_t
+{
+	// Next tick to be processed.
+	uint64_t current;
+	size_t count;
+	si_timer_wheel_entry_t* slots[SI_TIMER_WHEEL_LEVELS][SI_TIMER_WHEEL_SLOTS];
+	// Called on the data of entries still pending when freed. (NULL ok)
+	void (*p_free_value)(void*);
+} si_timer_wheel_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_timer_wheel_t struct as empty.
+ *
+ * @param p_wheel Pointer to the timer wheel struct to be initialized.
+ * @param now Tick the wheel starts at.
+ */
+void si_timer_wheel_init_2(si_timer_wheel_t* const p_wheel,
+	const uint64_t now);
+void si_timer_wheel_init(si_timer_wheel_t* const p_wheel);
+
+/** Doxygen
+ * @brief Adds a data pointer that expires at a deadline tick. O(1)
+ * @details Deadlines already passed expire on the next advance.
+ *
+ * @param p_wheel Pointer to the timer wheel struct to add to.
+ * @param deadline Tick at which the entry expires.
+ * @param p_data Pointer handed to the expire function. (NULL ok)
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_timer_wheel_add(si_timer_wheel_t* const p_wheel,
+	const uint64_t deadline, void* const p_data);
+
+/** Doxygen
+ * @brief Gets a tick no later than the next one with work for advance().
+ *
+ * @param p_wheel Pointer to the timer wheel struct to read.
+ *
+ * @return Returns the tick. Returns SI_TIMER_WHEEL_NEVER when empty.
+ */
+uint64_t si_timer_wheel_next(const si_timer_wheel_t* const p_wheel);
+
+/** Doxygen
+ * @brief Expires every entry with a deadline up to & including now.
+ * @details Ticks without work are skipped so the cost follows the number of
+ *          entries touched, not the time passed. p_expire may add entries.
+ *
+ * @param p_wheel Pointer to the timer wheel struct to advance.
+ * @param now Tick to advance to.
+ * @param p_expire Function called for each expired entry.
+ * @param p_context Pointer passed to every p_expire call.
+ *
+ * @return Returns the number of entries expired.
+ */
+size_t si_timer_wheel_advance(si_timer_wheel_t* const p_wheel,
+	const uint64_t now, p_timer_expire_f const p_expire, void* const p_context);
+
+/** Doxygen
+ * @brief Gets the number of pending entries in the wheel.
+ *
+ * @param p_wheel Pointer to the timer wheel struct to read.
+ *
+ * @return Returns size_t count of pending entries.
+ */
+size_t si_timer_wheel_count(const si_timer_wheel_t* const p_wheel);
+
+/** Doxygen
+ * @brief Frees the contents of an existing si_timer_wheel_t struct.
+ *
+ * @param p_wheel Pointer to the timer wheel struct to have its contents freed.
+ */
+void si_timer_wheel_free(si_timer_wheel_t* const p_wheel);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_TIMER_WHEEL_H
@@ -0,0 +1,100 @@
+/* si_ws_deque.h
+ * Language: C
+ * Created : 20261019
+ * Purpose : Lock-free Chase-Lev work-stealing deque of pointers. One owner
+ *           thread pushes & takes at the bottom, any thread steals the top.
+ */
+
+#include <stdatomic.h> // _Atomic, atomic_load_explicit()
+#include <stdbool.h> // bool, false, true
+#include <stddef.h> // size_t
+#include <stdint.h> // int64_t
+
+#define SI_WS_DEQUE_DEFAULT_CAPACITY (64u)
+
+#ifndef SI_WS_DEQUE_H
+#define SI_WS_DEQUE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+// Circular buffer of slots. Replaced buffers stay allocated (p_retired) until
+// the deque is freed since a thief may still be reading from them.
+typedef struct si_ws_deque_buffer_t
+{
+	struct si_ws_deque_buffer_t* p_retired;
+	size_t mask;
+	_Atomic(void*) slots[];
+} si_ws_deque_buffer_t;
+
+typedef struct si_ws_deque_t
+{
+	volatile _Atomic int64_t top;
+	volatile _Atomic int64_t bottom;
+	_Atomic(si_ws_deque_buffer_t*) p_buffer;
+} si_ws_deque_t;
+
+/** Doxygen
+ * @brief Initializes an existing si_ws_deque_t struct.
+ *
+ * @param p_deque Pointer to the deque struct to be initialized.
+ * @param initial_capacity Slots to start with. (Rounded up to a power of 2)
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_ws_deque_init_2(si_ws_deque_t* const p_deque,
+	const size_t initial_capacity);
+bool si_ws_deque_init(si_ws_deque_t* const p_deque);
+
+/** Doxygen
+ * @brief Pushes an item onto the bottom of the deque. (Owner thread only)
+ *
+ * @param p_deque Pointer to the deque struct to push onto.
+ * @param p_item Non-NULL pointer to be stored.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+bool si_ws_deque_push(si_ws_deque_t* const p_deque, void* const p_item);
+
+/** Doxygen
+ * @brief Takes the most recently pushed item. (Owner thread only, LIFO)
+ *
+ * @param p_deque Pointer to the deque struct to take from.
+ *
+ * @return Returns the item on success. Returns NULL when empty.
+ */
+void* si_ws_deque_take(si_ws_deque_t* const p_deque);
+
+/** Doxygen
+ * @brief Steals the oldest item. (Any thread, FIFO)
+ *
+ * @param p_deque Pointer to the deque struct to steal from.
+ *
+ * @return Returns the item on success. Returns NULL when empty or when it
+ *         lost a race for the item.
+ */
+void* si_ws_deque_steal(si_ws_deque_t* const p_deque);
+
+/** Doxygen
+ * @brief Counts the items in the deque. (A snapshot when used concurrently)
+ *
+ * @param p_deque Pointer to the deque struct to count.
+ *
+ * @return Returns number of items. Returns 0u on error.
+ */
+size_t si_ws_deque_count(si_ws_deque_t* const p_deque);
+
+/** Doxygen
+ * @brief Frees the buffers of a deque. Items left inside are not freed.
+ *
+ * @param p_deque Pointer to the deque struct to have its contents freed.
+ */
+void si_ws_deque_free(si_ws_deque_t* const p_deque);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif//SI_WS_DEQUE_H
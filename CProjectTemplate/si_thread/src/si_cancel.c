@@ -0,0 +1,172 @@
+// si_cancel.c
+#include "si_cancel.h"
+#include "si_magazine.h" // si_magazine_calloc(), si_magazine_free()
+
+#include <time.h> // timespec, clock_gettime()
+
+/** Doxygen
+ * @brief Gets the monotonic time deadlines are measured against.
+ *
+ * @return Returns nanosecs since an arbitrary fixed point.
+ */
+static uint64_t local_si_cancel_now_ns(void)
+{
+	struct timespec now = {0};
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+void si_cancel_token_init_2(si_cancel_token_t* const p_token,
+	si_cancel_token_t* const p_parent)
+{
+	if (NULL == p_token)
+	{
+		goto END;
+	}
+	atomic_init(&(p_token->is_cancelled), false);
+	atomic_init(&(p_token->deadline_ns), 0u);
+	atomic_init(&(p_token->ref_count), 1u);
+	p_token->p_parent = si_cancel_token_retain(p_parent);
+END:
+	return;
+}
+inline void si_cancel_token_init(si_cancel_token_t* const p_token)
+{
+	// Default value of p_parent is NULL
+	si_cancel_token_init_2(p_token, NULL);
+}
+
+si_cancel_token_t* si_cancel_token_new_1(si_cancel_token_t* const p_parent)
+{
+	si_cancel_token_t* p_result = si_magazine_calloc(
+		1u, sizeof(si_cancel_token_t)
+	);
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	si_cancel_token_init_2(p_result, p_parent);
+END:
+	return p_result;
+}
+inline si_cancel_token_t* si_cancel_token_new()
+{
+	// Default value of p_parent is NULL
+	return si_cancel_token_new_1(NULL);
+}
+
+si_cancel_token_t* si_cancel_token_retain(si_cancel_token_t* const p_token)
+{
+	if (NULL == p_token)
+	{
+		goto END;
+	}
+	atomic_fetch_add(&(p_token->ref_count), 1u);
+END:
+	return p_token;
+}
+
+void si_cancel_token_cancel(si_cancel_token_t* const p_token)
+{
+	if (NULL == p_token)
+	{
+		goto END;
+	}
+	atomic_store_explicit(&(p_token->is_cancelled), true, memory_order_release);
+END:
+	return;
+}
+
+void si_cancel_token_cancel_after(si_cancel_token_t* const p_token,
+	const uint32_t millisecs)
+{
+	if (NULL == p_token)
+	{
+		goto END;
+	}
+	// 0u means no deadline, so an immediate one is moved to the next nanosec.
+	const uint64_t deadline = local_si_cancel_now_ns() +
+		((uint64_t)millisecs * 1000000u) + 1u;
+	uint64_t current = atomic_load(&(p_token->deadline_ns));
+	while ((0u == current) || (deadline < current))
+	{
+		if (true == atomic_compare_exchange_weak(
+			&(p_token->deadline_ns), &current, deadline))
+		{
+			break;
+		}
+	}
+END:
+	return;
+}
+
+bool si_cancel_token_is_cancelled(si_cancel_token_t* const p_token)
+{
+	bool result = false;
+	for (si_cancel_token_t* p_node = p_token; NULL != p_node;
+		p_node = p_node->p_parent)
+	{
+		result = atomic_load_explicit(
+			&(p_node->is_cancelled), memory_order_acquire
+		);
+		if (true == result)
+		{
+			break;
+		}
+		const uint64_t deadline = atomic_load_explicit(
+			&(p_node->deadline_ns), memory_order_relaxed
+		);
+		if ((0u < deadline) && (deadline <= local_si_cancel_now_ns()))
+		{
+			// Latch it so later checks skip the clock.
+			si_cancel_token_cancel(p_node);
+			result = true;
+			break;
+		}
+	}
+	return result;
+}
+
+void si_cancel_token_reset(si_cancel_token_t* const p_token)
+{
+	if (NULL == p_token)
+	{
+		goto END;
+	}
+	atomic_store(&(p_token->deadline_ns), 0u);
+	atomic_store(&(p_token->is_cancelled), false);
+END:
+	return;
+}
+
+void si_cancel_token_free(si_cancel_token_t* const p_token)
+{
+	if (NULL == p_token)
+	{
+		goto END;
+	}
+	si_cancel_token_destroy(&(p_token->p_parent));
+END:
+	return;
+}
+
+void si_cancel_token_destroy(si_cancel_token_t** const pp_token)
+{
+	if (NULL == pp_token)
+	{
+		goto END;
+	}
+	if (NULL == *pp_token)
+	{
+		goto END;
+	}
+	const size_t previous = atomic_fetch_sub(&((*pp_token)->ref_count), 1u);
+	if (1u == previous)
+	{
+		si_cancel_token_free(*pp_token);
+		si_magazine_free(*pp_token);
+	}
+	*pp_token = NULL;
+END:
+	return;
+}
@@ -0,0 +1,257 @@
+// si_fiber.c
+#include "si_fiber.h"
+
+#include <stdint.h> // uintptr_t, UINT32_MAX
+
+#if SI_FIBER
+#include <sys/mman.h> // mmap(), mprotect(), munmap()
+#include <unistd.h> // sysconf()
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif//MAP_ANONYMOUS
+#endif//SI_FIBER
+
+bool si_fiber_stack_pool_init_3(si_fiber_stack_pool_t* const p_pool,
+	const size_t stack_size, const size_t max_free)
+{
+	bool result = false;
+	if ((NULL == p_pool) || (0u >= stack_size))
+	{
+		goto END;
+	}
+#if SI_FIBER
+	const long page_size = sysconf(_SC_PAGESIZE);
+	p_pool->guard_size = (0L < page_size) ? (size_t)page_size : 4096u;
+#else
+	p_pool->guard_size = 0u;
+#endif//SI_FIBER
+	const size_t page_count = (stack_size + p_pool->guard_size - 1u) /
+		p_pool->guard_size;
+	p_pool->stack_size = page_count * p_pool->guard_size;
+	p_pool->p_free = NULL;
+	p_pool->free_count = 0u;
+	p_pool->max_free = max_free;
+	atomic_init(&(p_pool->map_count), 0u);
+	result = (SI_PTHREAD_SUCCESS == si_mutex_init(&(p_pool->lock)));
+END:
+	return result;
+}
+inline bool si_fiber_stack_pool_init(si_fiber_stack_pool_t* const p_pool)
+{
+	// Default value of stack_size is SI_FIBER_DEFAULT_STACK_SIZE
+	// Default value of max_free is SI_FIBER_DEFAULT_MAX_FREE
+	return si_fiber_stack_pool_init_3(
+		p_pool, SI_FIBER_DEFAULT_STACK_SIZE, SI_FIBER_DEFAULT_MAX_FREE
+	);
+}
+
+/** Doxygen
+ * @brief Unmaps a stack along with its guard page.
+ *
+ * @param p_pool Pointer to the stack pool it was mapped by.
+ * @param p_stack Lowest usable address of the stack.
+ */
+static void local_si_fiber_stack_unmap(si_fiber_stack_pool_t* const p_pool,
+	void* const p_stack)
+{
+#if SI_FIBER
+	(void)munmap((char*)p_stack - p_pool->guard_size,
+		p_pool->stack_size + p_pool->guard_size
+	);
+	atomic_fetch_sub(&(p_pool->map_count), 1u);
+#else
+	(void)p_pool;
+	(void)p_stack;
+#endif//SI_FIBER
+}
+
+void* si_fiber_stack_pool_acquire(si_fiber_stack_pool_t* const p_pool)
+{
+	void* p_result = NULL;
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	si_mutex_lock(&(p_pool->lock));
+	p_result = p_pool->p_free;
+	if (NULL != p_result)
+	{
+		p_pool->p_free = *(void**)p_result;
+		p_pool->free_count--;
+	}
+	si_mutex_unlock(&(p_pool->lock));
+	if (NULL != p_result)
+	{
+		goto END;
+	}
+#if SI_FIBER
+	const size_t map_size = p_pool->stack_size + p_pool->guard_size;
+	char* const p_map = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+	);
+	if (MAP_FAILED == p_map)
+	{
+		goto END;
+	}
+	// Stacks grow down, so the guard goes below the lowest usable address.
+	if (SI_PTHREAD_SUCCESS != mprotect(p_map, p_pool->guard_size, PROT_NONE))
+	{
+		(void)munmap(p_map, map_size);
+		goto END;
+	}
+	atomic_fetch_add(&(p_pool->map_count), 1u);
+	p_result = p_map + p_pool->guard_size;
+#endif//SI_FIBER
+END:
+	return p_result;
+}
+
+void si_fiber_stack_pool_release(si_fiber_stack_pool_t* const p_pool,
+	void* const p_stack)
+{
+	if ((NULL == p_pool) || (NULL == p_stack))
+	{
+		goto END;
+	}
+	si_mutex_lock(&(p_pool->lock));
+	const bool is_kept = (p_pool->free_count < p_pool->max_free);
+	if (true == is_kept)
+	{
+		*(void**)p_stack = p_pool->p_free;
+		p_pool->p_free = p_stack;
+		p_pool->free_count++;
+	}
+	si_mutex_unlock(&(p_pool->lock));
+	if (true != is_kept)
+	{
+		local_si_fiber_stack_unmap(p_pool, p_stack);
+	}
+END:
+	return;
+}
+
+void si_fiber_stack_pool_free(si_fiber_stack_pool_t* const p_pool)
+{
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	void* p_stack = p_pool->p_free;
+	while (NULL != p_stack)
+	{
+		void* const p_next = *(void**)p_stack;
+		local_si_fiber_stack_unmap(p_pool, p_stack);
+		p_stack = p_next;
+	}
+	p_pool->p_free = NULL;
+	p_pool->free_count = 0u;
+	si_mutex_free(&(p_pool->lock));
+END:
+	return;
+}
+
+#if SI_FIBER
+/** Doxygen
+ * @brief First function run on a fiber's stack. Runs its body, then switches
+ *        back to the resumer for good.
+ * @details makecontext() only passes int arguments, so the fiber's pointer
+ *          arrives split into two 32-bit halves.
+ *
+ * @param high Upper 32 bits of the si_fiber_t pointer.
+ * @param low Lower 32 bits of the si_fiber_t pointer.
+ */
+static void local_si_fiber_entry(unsigned int high, unsigned int low)
+{
+	si_fiber_t* const p_fiber = (si_fiber_t*)(
+		((uintptr_t)high << 16u << 16u) | (uintptr_t)low
+	);
+	p_fiber->p_function(p_fiber->p_arg);
+	p_fiber->state = SI_FIBER_STATE_DONE;
+	(void)swapcontext(&(p_fiber->context), &(p_fiber->caller));
+}
+#endif//SI_FIBER
+
+bool si_fiber_init(si_fiber_t* const p_fiber,
+	si_fiber_stack_pool_t* const p_stack_pool, p_fiber_f const p_function,
+	void* const p_arg)
+{
+	bool result = false;
+	if ((NULL == p_fiber) || (NULL == p_stack_pool) || (NULL == p_function))
+	{
+		goto END;
+	}
+	p_fiber->p_stack_pool = p_stack_pool;
+	p_fiber->p_function = p_function;
+	p_fiber->p_arg = p_arg;
+	p_fiber->state = SI_FIBER_STATE_READY;
+	p_fiber->p_stack = si_fiber_stack_pool_acquire(p_stack_pool);
+	if (NULL == p_fiber->p_stack)
+	{
+		goto END;
+	}
+#if SI_FIBER
+	if (SI_PTHREAD_SUCCESS != getcontext(&(p_fiber->context)))
+	{
+		si_fiber_free(p_fiber);
+		goto END;
+	}
+	p_fiber->context.uc_stack.ss_sp = p_fiber->p_stack;
+	p_fiber->context.uc_stack.ss_size = p_stack_pool->stack_size;
+	p_fiber->context.uc_link = NULL;
+	const uintptr_t address = (uintptr_t)p_fiber;
+	makecontext(&(p_fiber->context), (void (*)(void))local_si_fiber_entry, 2,
+		(unsigned int)(address >> 16u >> 16u),
+		(unsigned int)(address & UINT32_MAX)
+	);
+	result = true;
+#else
+	si_fiber_free(p_fiber);
+#endif//SI_FIBER
+END:
+	return result;
+}
+
+bool si_fiber_resume(si_fiber_t* const p_fiber)
+{
+	bool result = false;
+	if ((NULL == p_fiber) || ((SI_FIBER_STATE_READY != p_fiber->state) &&
+		(SI_FIBER_STATE_SUSPENDED != p_fiber->state)))
+	{
+		goto END;
+	}
+#if SI_FIBER
+	p_fiber->state = SI_FIBER_STATE_RUNNING;
+	(void)swapcontext(&(p_fiber->caller), &(p_fiber->context));
+	result = (SI_FIBER_STATE_SUSPENDED == p_fiber->state);
+#endif//SI_FIBER
+END:
+	return result;
+}
+
+void si_fiber_yield(si_fiber_t* const p_fiber)
+{
+	if ((NULL == p_fiber) || (SI_FIBER_STATE_RUNNING != p_fiber->state))
+	{
+		goto END;
+	}
+#if SI_FIBER
+	p_fiber->state = SI_FIBER_STATE_SUSPENDED;
+	(void)swapcontext(&(p_fiber->context), &(p_fiber->caller));
+#endif//SI_FIBER
+END:
+	return;
+}
+
+void si_fiber_free(si_fiber_t* const p_fiber)
+{
+	if ((NULL == p_fiber) || (SI_FIBER_STATE_RUNNING == p_fiber->state))
+	{
+		goto END;
+	}
+	si_fiber_stack_pool_release(p_fiber->p_stack_pool, p_fiber->p_stack);
+	p_fiber->p_stack = NULL;
+	p_fiber->state = SI_FIBER_STATE_DONE;
+END:
+	return;
+}
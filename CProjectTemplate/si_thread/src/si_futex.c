@@ -0,0 +1,421 @@
+// si_futex.c
+#include "si_futex.h"
+
+#include <errno.h> // errno, ETIMEDOUT
+#include <limits.h> // INT_MAX
+#include <stddef.h> // NULL
+#include <time.h> // timespec, clock_gettime(), nanosleep()
+
+/** Doxygen
+ * @brief Gets the monotonic time wait deadlines are measured against.
+ *
+ * @return Returns millisecs since an arbitrary fixed point.
+ */
+static uint64_t local_si_futex_now_ms(void)
+{
+#ifdef _WIN32
+	return (uint64_t)GetTickCount64();
+#else
+	struct timespec now = {0};
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000u) + ((uint64_t)now.tv_nsec / 1000000u);
+#endif//_WIN32
+}
+
+/** Doxygen
+ * @brief Converts a wait's timeout into a deadline.
+ *
+ * @param millisecs Max time to wait. (SI_FUTEX_INFINITE for no limit)
+ *
+ * @return Returns the monotonic deadline in millisecs. (UINT64_MAX = never)
+ */
+static uint64_t local_si_futex_deadline(const uint32_t millisecs)
+{
+	uint64_t result = UINT64_MAX;
+	if (SI_FUTEX_INFINITE != millisecs)
+	{
+		result = local_si_futex_now_ms() + millisecs;
+	}
+	return result;
+}
+
+/** Doxygen
+ * @brief Gets the time left until a deadline.
+ *
+ * @param deadline_ms Deadline from local_si_futex_deadline().
+ * @param p_millisecs Pointer to store the millisecs left in.
+ *
+ * @return Returns stdbool false once the deadline has passed. True otherwise.
+ */
+static bool local_si_futex_remaining(const uint64_t deadline_ms,
+	uint32_t* const p_millisecs)
+{
+	bool result = true;
+	*p_millisecs = SI_FUTEX_INFINITE;
+	if (UINT64_MAX == deadline_ms)
+	{
+		goto END;
+	}
+	const uint64_t now_ms = local_si_futex_now_ms();
+	if (now_ms >= deadline_ms)
+	{
+		result = false;
+		goto END;
+	}
+	// Never exceeds the uint32_t timeout it was made from.
+	*p_millisecs = (uint32_t)(deadline_ms - now_ms);
+END:
+	return result;
+}
+
+bool si_futex_wait_3(volatile _Atomic uint32_t* const p_word,
+	const uint32_t expected, const uint32_t millisecs)
+{
+	bool result = false;
+	if (NULL == p_word)
+	{
+		goto END;
+	}
+#if defined(__linux__)
+	struct timespec timeout = {0};
+	timeout.tv_sec = (time_t)(millisecs / 1000u);
+	timeout.tv_nsec = (long)(millisecs % 1000u) * 1000000L;
+	// Returns straight away if the word no longer holds expected.
+	const long wait_result = syscall(SYS_futex, (void*)p_word,
+		FUTEX_WAIT_PRIVATE, expected,
+		(SI_FUTEX_INFINITE == millisecs) ? NULL : &timeout, NULL, 0
+	);
+	result = ((0L == wait_result) || (ETIMEDOUT != errno));
+#elif defined(_WIN32)
+	uint32_t compare = expected;
+	const DWORD timeout = (SI_FUTEX_INFINITE == millisecs) ?
+		INFINITE : (DWORD)millisecs;
+	const BOOL wait_result = WaitOnAddress(
+		(volatile VOID*)p_word, &compare, sizeof(uint32_t), timeout
+	);
+	result = ((FALSE != wait_result) || (ERROR_TIMEOUT != GetLastError()));
+#else
+	// Polls as no address based wait is available.
+	if ((0u >= millisecs) ||
+		(expected != atomic_load_explicit(p_word, memory_order_acquire)))
+	{
+		result = (0u < millisecs);
+		goto END;
+	}
+	const struct timespec poll_delay = {0, 100000L}; // 100us
+	(void)nanosleep(&poll_delay, NULL);
+	result = true;
+#endif // OS Specific implementation(s)
+END:
+	return result;
+}
+inline bool si_futex_wait(volatile _Atomic uint32_t* const p_word,
+	const uint32_t expected)
+{
+	// Default value of millisecs is SI_FUTEX_INFINITE
+	return si_futex_wait_3(p_word, expected, SI_FUTEX_INFINITE);
+}
+
+void si_futex_wake(volatile _Atomic uint32_t* const p_word,
+	const uint32_t count)
+{
+	if ((NULL == p_word) || (0u >= count))
+	{
+		goto END;
+	}
+#if defined(__linux__)
+	const int wake_count = (INT_MAX < count) ? INT_MAX : (int)count;
+	(void)syscall(SYS_futex, (void*)p_word, FUTEX_WAKE_PRIVATE, wake_count,
+		NULL, NULL, 0
+	);
+#elif defined(_WIN32)
+	if (1u == count)
+	{
+		WakeByAddressSingle((PVOID)p_word);
+	}
+	else
+	{
+		// Waiters re-check, so waking more than count is harmless.
+		WakeByAddressAll((PVOID)p_word);
+	}
+#else
+	// NOP pollers see the change themselves.
+#endif // OS Specific implementation(s)
+END:
+	return;
+}
+
+
+void si_event_init(si_event_t* const p_event)
+{
+	if (NULL == p_event)
+	{
+		goto END;
+	}
+	atomic_init(&(p_event->epoch), 0u);
+	atomic_init(&(p_event->waiters), 0u);
+END:
+	return;
+}
+
+uint32_t si_event_prepare_wait(si_event_t* const p_event)
+{
+	uint32_t result = 0u;
+	if (NULL == p_event)
+	{
+		goto END;
+	}
+	// Registered before the key is read, so a notify either sees the waiter
+	// or bumps the epoch before the key is taken.
+	atomic_fetch_add(&(p_event->waiters), 1u);
+	result = atomic_load(&(p_event->epoch));
+END:
+	return result;
+}
+
+void si_event_cancel_wait(si_event_t* const p_event)
+{
+	if (NULL == p_event)
+	{
+		goto END;
+	}
+	atomic_fetch_sub(&(p_event->waiters), 1u);
+END:
+	return;
+}
+
+bool si_event_wait_3(si_event_t* const p_event, const uint32_t key,
+	const uint32_t millisecs)
+{
+	bool result = false;
+	if (NULL == p_event)
+	{
+		goto END;
+	}
+	const uint64_t deadline_ms = local_si_futex_deadline(millisecs);
+	uint32_t remaining = millisecs;
+	while (key == atomic_load_explicit(&(p_event->epoch), memory_order_acquire))
+	{
+		if (true != local_si_futex_remaining(deadline_ms, &remaining))
+		{
+			goto UNREGISTER;
+		}
+		(void)si_futex_wait_3(&(p_event->epoch), key, remaining);
+	}
+	result = true;
+UNREGISTER:
+	atomic_fetch_sub(&(p_event->waiters), 1u);
+END:
+	return result;
+}
+inline bool si_event_wait(si_event_t* const p_event, const uint32_t key)
+{
+	// Default value of millisecs is SI_FUTEX_INFINITE
+	return si_event_wait_3(p_event, key, SI_FUTEX_INFINITE);
+}
+
+void si_event_notify_2(si_event_t* const p_event, const uint32_t count)
+{
+	if (NULL == p_event)
+	{
+		goto END;
+	}
+	atomic_fetch_add(&(p_event->epoch), 1u);
+	if (0u >= atomic_load(&(p_event->waiters)))
+	{
+		// Nobody to wake, skips the system call.
+		goto END;
+	}
+	si_futex_wake(&(p_event->epoch), count);
+END:
+	return;
+}
+inline void si_event_notify(si_event_t* const p_event)
+{
+	// Default value of count is 1u
+	si_event_notify_2(p_event, 1u);
+}
+
+inline void si_event_notify_all(si_event_t* const p_event)
+{
+	si_event_notify_2(p_event, UINT32_MAX);
+}
+
+
+void si_latch_init(si_latch_t* const p_latch, const uint32_t count)
+{
+	if (NULL == p_latch)
+	{
+		goto END;
+	}
+	atomic_init(&(p_latch->count), count);
+	atomic_init(&(p_latch->waiters), 0u);
+END:
+	return;
+}
+
+void si_latch_count_down_2(si_latch_t* const p_latch, const uint32_t count)
+{
+	if ((NULL == p_latch) || (0u >= count))
+	{
+		goto END;
+	}
+	uint32_t current = atomic_load(&(p_latch->count));
+	uint32_t next = 0u;
+	do
+	{
+		if (0u >= current)
+		{
+			// Already open.
+			goto END;
+		}
+		next = (count >= current) ? 0u : (current - count);
+	} while (true != atomic_compare_exchange_weak(
+		&(p_latch->count), &current, next
+	));
+	if ((0u >= next) && (0u < atomic_load(&(p_latch->waiters))))
+	{
+		si_futex_wake(&(p_latch->count), UINT32_MAX);
+	}
+END:
+	return;
+}
+inline void si_latch_count_down(si_latch_t* const p_latch)
+{
+	// Default value of count is 1u
+	si_latch_count_down_2(p_latch, 1u);
+}
+
+bool si_latch_try_wait(si_latch_t* const p_latch)
+{
+	bool result = false;
+	if (NULL == p_latch)
+	{
+		goto END;
+	}
+	result = (0u >= atomic_load_explicit(
+		&(p_latch->count), memory_order_acquire
+	));
+END:
+	return result;
+}
+
+bool si_latch_wait_2(si_latch_t* const p_latch, const uint32_t millisecs)
+{
+	bool result = si_latch_try_wait(p_latch);
+	if ((NULL == p_latch) || (true == result))
+	{
+		goto END;
+	}
+	const uint64_t deadline_ms = local_si_futex_deadline(millisecs);
+	uint32_t remaining = millisecs;
+	atomic_fetch_add(&(p_latch->waiters), 1u);
+	for (uint32_t current = atomic_load(&(p_latch->count)); 0u < current;
+		current = atomic_load(&(p_latch->count)))
+	{
+		if (true != local_si_futex_remaining(deadline_ms, &remaining))
+		{
+			break;
+		}
+		(void)si_futex_wait_3(&(p_latch->count), current, remaining);
+	}
+	atomic_fetch_sub(&(p_latch->waiters), 1u);
+	result = si_latch_try_wait(p_latch);
+END:
+	return result;
+}
+inline bool si_latch_wait(si_latch_t* const p_latch)
+{
+	// Default value of millisecs is SI_FUTEX_INFINITE
+	return si_latch_wait_2(p_latch, SI_FUTEX_INFINITE);
+}
+
+
+void si_semaphore_init(si_semaphore_t* const p_semaphore,
+	const uint32_t value)
+{
+	if (NULL == p_semaphore)
+	{
+		goto END;
+	}
+	atomic_init(&(p_semaphore->value), value);
+	atomic_init(&(p_semaphore->waiters), 0u);
+END:
+	return;
+}
+
+void si_semaphore_post_2(si_semaphore_t* const p_semaphore,
+	const uint32_t count)
+{
+	if ((NULL == p_semaphore) || (0u >= count))
+	{
+		goto END;
+	}
+	atomic_fetch_add(&(p_semaphore->value), count);
+	if (0u >= atomic_load(&(p_semaphore->waiters)))
+	{
+		// Nobody to wake, skips the system call.
+		goto END;
+	}
+	si_futex_wake(&(p_semaphore->value), count);
+END:
+	return;
+}
+inline void si_semaphore_post(si_semaphore_t* const p_semaphore)
+{
+	// Default value of count is 1u
+	si_semaphore_post_2(p_semaphore, 1u);
+}
+
+bool si_semaphore_try_wait(si_semaphore_t* const p_semaphore)
+{
+	bool result = false;
+	if (NULL == p_semaphore)
+	{
+		goto END;
+	}
+	uint32_t current = atomic_load(&(p_semaphore->value));
+	while (0u < current)
+	{
+		result = atomic_compare_exchange_weak(
+			&(p_semaphore->value), &current, current - 1u
+		);
+		if (true == result)
+		{
+			break;
+		}
+	}
+END:
+	return result;
+}
+
+bool si_semaphore_wait_2(si_semaphore_t* const p_semaphore,
+	const uint32_t millisecs)
+{
+	bool result = si_semaphore_try_wait(p_semaphore);
+	if ((NULL == p_semaphore) || (true == result))
+	{
+		goto END;
+	}
+	const uint64_t deadline_ms = local_si_futex_deadline(millisecs);
+	uint32_t remaining = millisecs;
+	atomic_fetch_add(&(p_semaphore->waiters), 1u);
+	result = si_semaphore_try_wait(p_semaphore);
+	while (true != result)
+	{
+		if (true != local_si_futex_remaining(deadline_ms, &remaining))
+		{
+			break;
+		}
+		(void)si_futex_wait_3(&(p_semaphore->value), 0u, remaining);
+		result = si_semaphore_try_wait(p_semaphore);
+	}
+	atomic_fetch_sub(&(p_semaphore->waiters), 1u);
+END:
+	return result;
+}
+inline bool si_semaphore_wait(si_semaphore_t* const p_semaphore)
+{
+	// Default value of millisecs is SI_FUTEX_INFINITE
+	return si_semaphore_wait_2(p_semaphore, SI_FUTEX_INFINITE);
+}
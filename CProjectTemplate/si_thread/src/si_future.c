@@ -0,0 +1,329 @@
+// si_future.c
+#include "si_future.h"
+#include "si_magazine.h" // si_magazine_calloc(), si_magazine_free()
+
+#include <stdint.h> // SIZE_MAX
+#include <stdlib.h> // calloc(), free()
+
+// Shared by every link of a single wait_any() call.
+typedef struct si_future_waiter_t
+{
+	si_mutex_t lock;
+	si_cond_t signal;
+	bool is_signaled;
+} si_future_waiter_t;
+
+bool si_future_init(si_future_t* const p_future)
+{
+	bool result = false;
+	if (NULL == p_future)
+	{
+		goto END;
+	}
+	atomic_init(&(p_future->state), SI_FUTURE_PENDING);
+	atomic_init(&(p_future->ref_count), 1u);
+	atomic_init(&(p_future->waiter_count), 0u);
+	p_future->p_result = NULL;
+	p_future->p_links = NULL;
+	const int init_results = si_mutex_init(&(p_future->lock));
+	if (SI_PTHREAD_SUCCESS != init_results)
+	{
+		goto END;
+	}
+	si_cond_init(&(p_future->ready_signal));
+	result = true;
+END:
+	return result;
+}
+
+si_future_t* si_future_new()
+{
+	si_future_t* p_result = si_magazine_calloc(1u, sizeof(si_future_t));
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	const bool did_init = si_future_init(p_result);
+	if (true != did_init)
+	{
+		si_magazine_free(p_result);
+		p_result = NULL;
+	}
+END:
+	return p_result;
+}
+
+si_future_t* si_future_retain(si_future_t* const p_future)
+{
+	if (NULL == p_future)
+	{
+		goto END;
+	}
+	atomic_fetch_add(&(p_future->ref_count), 1u);
+END:
+	return p_future;
+}
+
+/** Doxygen
+ * @brief Moves a pending future to a final state & wakes its waiters.
+ *
+ * @param p_future Pointer to the future to be finished.
+ * @param state Final si_future_state_t to store.
+ * @param p_result Result pointer to store.
+ *
+ * @return Returns stdbool true on success. Returns false if already done.
+ */
+static bool local_si_future_finish(si_future_t* const p_future,
+	const si_future_state_t state, void* const p_result)
+{
+	bool result = false;
+	if (NULL == p_future)
+	{
+		goto END;
+	}
+	si_mutex_lock(&(p_future->lock));
+	if (SI_FUTURE_PENDING != atomic_load(&(p_future->state)))
+	{
+		si_mutex_unlock(&(p_future->lock));
+		goto END;
+	}
+	p_future->p_result = p_result;
+	atomic_store(&(p_future->state), state);
+	if (0u < atomic_load(&(p_future->waiter_count)))
+	{
+		si_cond_broadcast(&(p_future->ready_signal));
+		for (si_future_link_t* p_link = p_future->p_links; NULL != p_link;
+			p_link = p_link->p_next)
+		{
+			si_future_waiter_t* const p_waiter = p_link->p_waiter;
+			si_mutex_lock(&(p_waiter->lock));
+			p_waiter->is_signaled = true;
+			si_cond_signal(&(p_waiter->signal));
+			si_mutex_unlock(&(p_waiter->lock));
+		}
+	}
+	si_mutex_unlock(&(p_future->lock));
+	result = true;
+END:
+	return result;
+}
+
+inline bool si_future_complete(si_future_t* const p_future,
+	void* const p_result)
+{
+	return local_si_future_finish(p_future, SI_FUTURE_READY, p_result);
+}
+
+inline bool si_future_cancel(si_future_t* const p_future)
+{
+	return local_si_future_finish(p_future, SI_FUTURE_CANCELLED, NULL);
+}
+
+si_future_state_t si_future_state(si_future_t* const p_future)
+{
+	si_future_state_t result = SI_FUTURE_CANCELLED;
+	if (NULL == p_future)
+	{
+		goto END;
+	}
+	result = (si_future_state_t)atomic_load(&(p_future->state));
+END:
+	return result;
+}
+
+inline bool si_future_is_done(si_future_t* const p_future)
+{
+	return (SI_FUTURE_PENDING != si_future_state(p_future));
+}
+
+void* si_future_wait(si_future_t* const p_future)
+{
+	void* p_result = NULL;
+	if (NULL == p_future)
+	{
+		goto END;
+	}
+	if (SI_FUTURE_PENDING == atomic_load(&(p_future->state)))
+	{
+		si_mutex_lock(&(p_future->lock));
+		atomic_fetch_add(&(p_future->waiter_count), 1u);
+		while (SI_FUTURE_PENDING == atomic_load(&(p_future->state)))
+		{
+			si_cond_wait(&(p_future->ready_signal), &(p_future->lock));
+		}
+		atomic_fetch_sub(&(p_future->waiter_count), 1u);
+		si_mutex_unlock(&(p_future->lock));
+	}
+	if (SI_FUTURE_READY == atomic_load(&(p_future->state)))
+	{
+		p_result = p_future->p_result;
+	}
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Finds the first done future in an array.
+ *
+ * @return Returns the index on success. Returns SIZE_MAX if none are done.
+ */
+static size_t local_si_future_find_done(si_future_t** const pp_futures,
+	const size_t count)
+{
+	size_t result = SIZE_MAX;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		if ((NULL != pp_futures[iii]) && (si_future_is_done(pp_futures[iii])))
+		{
+			result = iii;
+			break;
+		}
+	}
+	return result;
+}
+
+size_t si_future_wait_any(si_future_t** const pp_futures, const size_t count)
+{
+	size_t result = SIZE_MAX;
+	si_future_link_t* p_links = NULL;
+	if ((NULL == pp_futures) || (0u >= count))
+	{
+		goto END;
+	}
+	result = local_si_future_find_done(pp_futures, count);
+	if (SIZE_MAX != result)
+	{
+		goto END;
+	}
+	p_links = calloc(count, sizeof(si_future_link_t));
+	if (NULL == p_links)
+	{
+		goto END;
+	}
+	si_future_waiter_t waiter = {0};
+	if (SI_PTHREAD_SUCCESS != si_mutex_init(&(waiter.lock)))
+	{
+		goto END;
+	}
+	si_cond_init(&(waiter.signal));
+	waiter.is_signaled = false;
+	// Register on every future, completion signals the shared waiter.
+	bool has_future = false;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		si_future_t* const p_future = pp_futures[iii];
+		if (NULL == p_future)
+		{
+			continue;
+		}
+		has_future = true;
+		p_links[iii].p_waiter = &waiter;
+		si_mutex_lock(&(p_future->lock));
+		p_links[iii].p_next = p_future->p_links;
+		p_future->p_links = &(p_links[iii]);
+		atomic_fetch_add(&(p_future->waiter_count), 1u);
+		si_mutex_unlock(&(p_future->lock));
+	}
+	if (true == has_future)
+	{
+		si_mutex_lock(&(waiter.lock));
+		// Re-check after registering, a future may have finished before.
+		while ((true != waiter.is_signaled) &&
+			(SIZE_MAX == local_si_future_find_done(pp_futures, count)))
+		{
+			si_cond_wait(&(waiter.signal), &(waiter.lock));
+		}
+		si_mutex_unlock(&(waiter.lock));
+	}
+	// Unregister before the waiter leaves scope.
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		si_future_t* const p_future = pp_futures[iii];
+		if (NULL == p_future)
+		{
+			continue;
+		}
+		si_mutex_lock(&(p_future->lock));
+		si_future_link_t** pp_link = &(p_future->p_links);
+		while (NULL != *pp_link)
+		{
+			if (&(p_links[iii]) == *pp_link)
+			{
+				*pp_link = (*pp_link)->p_next;
+				break;
+			}
+			pp_link = &((*pp_link)->p_next);
+		}
+		atomic_fetch_sub(&(p_future->waiter_count), 1u);
+		si_mutex_unlock(&(p_future->lock));
+	}
+	si_cond_free(&(waiter.signal));
+	si_mutex_free(&(waiter.lock));
+	result = local_si_future_find_done(pp_futures, count);
+END:
+	free(p_links);
+	return result;
+}
+
+bool si_future_wait_all(si_future_t** const pp_futures, const size_t count)
+{
+	bool result = false;
+	if ((NULL == pp_futures) || (0u >= count))
+	{
+		goto END;
+	}
+	result = true;
+	// Each future is waited on once so the total cost stays O(count).
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		if (NULL == pp_futures[iii])
+		{
+			continue;
+		}
+		(void)si_future_wait(pp_futures[iii]);
+		if (SI_FUTURE_READY != si_future_state(pp_futures[iii]))
+		{
+			result = false;
+		}
+	}
+END:
+	return result;
+}
+
+void si_future_free(si_future_t* const p_future)
+{
+	if (NULL == p_future)
+	{
+		goto END;
+	}
+	// A completer may still hold the lock right after publishing the state.
+	si_mutex_lock(&(p_future->lock));
+	si_mutex_unlock(&(p_future->lock));
+	si_cond_free(&(p_future->ready_signal));
+	si_mutex_free(&(p_future->lock));
+	p_future->p_result = NULL;
+	p_future->p_links = NULL;
+END:
+	return;
+}
+
+void si_future_destroy(si_future_t** const pp_future)
+{
+	if (NULL == pp_future)
+	{
+		goto END;
+	}
+	if (NULL == *pp_future)
+	{
+		goto END;
+	}
+	const size_t previous = atomic_fetch_sub(&((*pp_future)->ref_count), 1u);
+	if (1u == previous)
+	{
+		si_future_free(*pp_future);
+		si_magazine_free(*pp_future);
+	}
+	*pp_future = NULL;
+END:
+	return;
+}
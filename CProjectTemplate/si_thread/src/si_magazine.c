@@ -0,0 +1,453 @@
+// si_magazine.c
+#include "si_magazine.h"
+#include "si_mutex.h" // SI_MUTEX_SPIN_COUNT
+#include "si_thread.h" // si_cpu_relax(), si_thread_yield()
+
+#include <stdint.h> // SIZE_MAX
+#include <stdlib.h> // calloc(), free(), malloc()
+#include <string.h> // memset()
+
+// Bytes in front of every block recording its size class. Keeps the block
+// as aligned as malloc() returned it.
+#define LOCAL_HEADER_SIZE (16u)
+
+// Block sizes served, each request is rounded up to the next one.
+static const size_t g_class_sizes[] = {
+	16u, 32u, 48u, 64u, 96u, 128u, 192u, 256u, 384u, 512u, 768u,
+	SI_MAGAZINE_MAX_SIZE
+};
+#define LOCAL_CLASS_COUNT (sizeof(g_class_sizes) / sizeof(g_class_sizes[0]))
+
+// Local scope stack of free blocks of one size class.
+typedef struct local_magazine_t
+{
+	struct local_magazine_t* p_next;
+	size_t count;
+	void* p_blocks[SI_MAGAZINE_SIZE];
+} local_magazine_t;
+
+// Local scope per thread magazines of one size class. The previous
+// magazine lets a thread alternate allocs & frees at a magazine boundary
+// without a depot trip each time.
+typedef struct local_cache_t
+{
+	local_magazine_t* p_loaded;
+	local_magazine_t* p_previous;
+} local_cache_t;
+
+// Local scope shared magazines of one size class.
+typedef struct local_depot_t
+{
+	// Held only long enough to push or pop a magazine.
+	volatile atomic_bool is_locked;
+	local_magazine_t* p_full;
+	size_t full_count;
+	local_magazine_t* p_empty;
+	size_t empty_count;
+} local_depot_t;
+
+static local_depot_t g_depots[LOCAL_CLASS_COUNT];
+static _Thread_local local_cache_t g_caches[LOCAL_CLASS_COUNT];
+static _Thread_local bool g_is_registered = false;
+static volatile _Atomic size_t g_malloc_count = 0u;
+
+// Flushes each thread's magazines as it exits.
+#ifdef _WIN32
+static INIT_ONCE g_exit_once = INIT_ONCE_STATIC_INIT;
+static DWORD g_exit_key = FLS_OUT_OF_INDEXES;
+#elif SI_PTHREAD
+static pthread_once_t g_exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_exit_key;
+static bool g_has_exit_key = false;
+#endif//_WIN32
+
+/** Doxygen
+ * @brief Finds the smallest size class holding size bytes.
+ *
+ * @param size Number of bytes requested.
+ *
+ * @return Returns class index. Returns LOCAL_CLASS_COUNT when too large.
+ */
+static size_t local_si_magazine_class(const size_t size)
+{
+	size_t result = 0u;
+	while ((LOCAL_CLASS_COUNT > result) && (g_class_sizes[result] < size))
+	{
+		result++;
+	}
+	return result;
+}
+
+/** Doxygen
+ * @brief Thread exit callback handing the thread's magazines over.
+ *
+ * @param p_value Unused non-NULL marker.
+ */
+#ifdef _WIN32
+static void WINAPI local_si_magazine_thread_exit(void* p_value)
+#else
+static void local_si_magazine_thread_exit(void* p_value)
+#endif//_WIN32
+{
+	(void)p_value;
+	si_magazine_thread_flush();
+	// Later destructors using magazines register the thread again.
+	g_is_registered = false;
+}
+
+/** Doxygen
+ * @brief Creates the thread exit key, run once per process.
+ */
+#ifdef _WIN32
+static BOOL CALLBACK local_si_magazine_exit_init(PINIT_ONCE p_once,
+	PVOID p_param, PVOID* pp_context)
+{
+	(void)p_once;
+	(void)p_param;
+	(void)pp_context;
+	g_exit_key = FlsAlloc(local_si_magazine_thread_exit);
+	return TRUE;
+}
+#elif SI_PTHREAD
+static void local_si_magazine_exit_init(void)
+{
+	g_has_exit_key = (SI_PTHREAD_SUCCESS == pthread_key_create(
+		&g_exit_key, local_si_magazine_thread_exit
+	));
+}
+#endif//_WIN32
+
+/** Doxygen
+ * @brief Registers the calling thread to be flushed on exit, once per thread
+ *        before it first holds a magazine.
+ */
+static void local_si_magazine_register(void)
+{
+	if (true == g_is_registered)
+	{
+		goto END;
+	}
+	g_is_registered = true;
+#ifdef _WIN32
+	(void)InitOnceExecuteOnce(
+		&g_exit_once, local_si_magazine_exit_init, NULL, NULL
+	);
+	if (FLS_OUT_OF_INDEXES != g_exit_key)
+	{
+		(void)FlsSetValue(g_exit_key, (PVOID)&g_exit_key);
+	}
+#elif SI_PTHREAD
+	(void)pthread_once(&g_exit_once, local_si_magazine_exit_init);
+	if (true == g_has_exit_key)
+	{
+		(void)pthread_setspecific(g_exit_key, &g_exit_key);
+	}
+#endif//_WIN32
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Spins for a depot's lock, yielding the thread once spun out.
+ *
+ * @param p_depot Pointer to the depot to lock.
+ */
+static void local_si_magazine_depot_lock(local_depot_t* const p_depot)
+{
+	size_t spins = 0u;
+	while (true == atomic_exchange_explicit(
+		&(p_depot->is_locked), true, memory_order_acquire))
+	{
+		if (SI_MUTEX_SPIN_COUNT > spins)
+		{
+			si_cpu_relax();
+			spins++;
+		}
+		else
+		{
+			si_thread_yield();
+		}
+	}
+}
+
+/** Doxygen
+ * @brief Releases a depot's lock.
+ *
+ * @param p_depot Pointer to the depot to unlock.
+ */
+static void local_si_magazine_depot_unlock(local_depot_t* const p_depot)
+{
+	atomic_store_explicit(&(p_depot->is_locked), false, memory_order_release);
+}
+
+/** Doxygen
+ * @brief Frees a magazine along with every block it holds.
+ *
+ * @param p_magazine Pointer to the magazine to be freed.
+ */
+static void local_si_magazine_release(local_magazine_t* const p_magazine)
+{
+	if (NULL == p_magazine)
+	{
+		goto END;
+	}
+	for (size_t iii = 0u; iii < p_magazine->count; iii++)
+	{
+		free((char*)p_magazine->p_blocks[iii] - LOCAL_HEADER_SIZE);
+	}
+	free(p_magazine);
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Takes a full magazine from the depot.
+ *
+ * @param index Size class index.
+ *
+ * @return Returns magazine pointer on success. Returns NULL when none is kept
+ */
+static local_magazine_t* local_si_magazine_take_full(const size_t index)
+{
+	local_depot_t* const p_depot = &(g_depots[index]);
+	local_si_magazine_depot_lock(p_depot);
+	local_magazine_t* const p_result = p_depot->p_full;
+	if (NULL != p_result)
+	{
+		p_depot->p_full = p_result->p_next;
+		p_depot->full_count--;
+	}
+	local_si_magazine_depot_unlock(p_depot);
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Takes an empty magazine from the depot, allocating one if needed.
+ *
+ * @param index Size class index.
+ *
+ * @return Returns magazine pointer on success. Returns NULL otherwise.
+ */
+static local_magazine_t* local_si_magazine_take_empty(const size_t index)
+{
+	local_depot_t* const p_depot = &(g_depots[index]);
+	local_si_magazine_depot_lock(p_depot);
+	local_magazine_t* p_result = p_depot->p_empty;
+	if (NULL != p_result)
+	{
+		p_depot->p_empty = p_result->p_next;
+		p_depot->empty_count--;
+	}
+	local_si_magazine_depot_unlock(p_depot);
+	if (NULL == p_result)
+	{
+		p_result = calloc(1u, sizeof(local_magazine_t));
+	}
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Gives a magazine to the depot, full or empty. Released instead when
+ *        the depot already keeps SI_MAGAZINE_DEPOT_MAX of its kind.
+ *
+ * @param index Size class index.
+ * @param p_magazine Pointer to the magazine handed over.
+ */
+static void local_si_magazine_give(const size_t index,
+	local_magazine_t* const p_magazine)
+{
+	if (NULL == p_magazine)
+	{
+		goto END;
+	}
+	local_depot_t* const p_depot = &(g_depots[index]);
+	const bool is_empty = (0u >= p_magazine->count);
+	bool is_kept = false;
+	local_si_magazine_depot_lock(p_depot);
+	if ((true == is_empty) && (SI_MAGAZINE_DEPOT_MAX > p_depot->empty_count))
+	{
+		p_magazine->p_next = p_depot->p_empty;
+		p_depot->p_empty = p_magazine;
+		p_depot->empty_count++;
+		is_kept = true;
+	}
+	else if ((true != is_empty) &&
+		(SI_MAGAZINE_DEPOT_MAX > p_depot->full_count))
+	{
+		p_magazine->p_next = p_depot->p_full;
+		p_depot->p_full = p_magazine;
+		p_depot->full_count++;
+		is_kept = true;
+	}
+	local_si_magazine_depot_unlock(p_depot);
+	if (true != is_kept)
+	{
+		local_si_magazine_release(p_magazine);
+	}
+END:
+	return;
+}
+
+void* si_magazine_alloc(const size_t size)
+{
+	void* p_result = NULL;
+	if ((SIZE_MAX - LOCAL_HEADER_SIZE) < size)
+	{
+		goto END;
+	}
+	const size_t index = local_si_magazine_class(size);
+	if (LOCAL_CLASS_COUNT <= index)
+	{
+		p_result = malloc(size + LOCAL_HEADER_SIZE);
+		goto HEADER;
+	}
+	local_cache_t* const p_cache = &(g_caches[index]);
+	local_magazine_t* p_loaded = p_cache->p_loaded;
+	if ((NULL == p_loaded) || (0u >= p_loaded->count))
+	{
+		local_magazine_t* const p_previous = p_cache->p_previous;
+		if ((NULL != p_previous) && (0u < p_previous->count))
+		{
+			p_cache->p_previous = p_loaded;
+			p_loaded = p_previous;
+		}
+		else
+		{
+			// Blocks freed by other threads come back through the depot.
+			local_magazine_t* const p_full = local_si_magazine_take_full(index);
+			if (NULL != p_full)
+			{
+				local_si_magazine_register();
+				local_si_magazine_give(index, p_loaded);
+				p_loaded = p_full;
+			}
+		}
+		p_cache->p_loaded = p_loaded;
+	}
+	if ((NULL != p_loaded) && (0u < p_loaded->count))
+	{
+		p_loaded->count--;
+		p_result = p_loaded->p_blocks[p_loaded->count];
+		goto END;
+	}
+	p_result = malloc(g_class_sizes[index] + LOCAL_HEADER_SIZE);
+	if (NULL != p_result)
+	{
+		atomic_fetch_add(&g_malloc_count, 1u);
+	}
+HEADER:
+	if (NULL != p_result)
+	{
+		*(size_t*)p_result = index;
+		p_result = (char*)p_result + LOCAL_HEADER_SIZE;
+	}
+END:
+	return p_result;
+}
+
+void* si_magazine_calloc(const size_t count, const size_t size)
+{
+	void* p_result = NULL;
+	if ((0u < size) && ((SIZE_MAX / size) < count))
+	{
+		goto END;
+	}
+	p_result = si_magazine_alloc(count * size);
+	if (NULL != p_result)
+	{
+		memset(p_result, 0, count * size);
+	}
+END:
+	return p_result;
+}
+
+void si_magazine_free(void* const p_block)
+{
+	if (NULL == p_block)
+	{
+		goto END;
+	}
+	char* const p_start = (char*)p_block - LOCAL_HEADER_SIZE;
+	const size_t index = *(size_t*)p_start;
+	if (LOCAL_CLASS_COUNT <= index)
+	{
+		free(p_start);
+		goto END;
+	}
+	local_cache_t* const p_cache = &(g_caches[index]);
+	local_magazine_t* p_loaded = p_cache->p_loaded;
+	if ((NULL == p_loaded) || (SI_MAGAZINE_SIZE <= p_loaded->count))
+	{
+		local_magazine_t* const p_previous = p_cache->p_previous;
+		if ((NULL != p_previous) && (SI_MAGAZINE_SIZE > p_previous->count))
+		{
+			p_cache->p_previous = p_loaded;
+			p_loaded = p_previous;
+		}
+		else
+		{
+			local_si_magazine_register();
+			local_magazine_t* const p_empty = local_si_magazine_take_empty(
+				index
+			);
+			if (NULL == p_empty)
+			{
+				free(p_start);
+				goto END;
+			}
+			// Full magazines are left for threads that run out.
+			local_si_magazine_give(index, p_previous);
+			p_cache->p_previous = p_loaded;
+			p_loaded = p_empty;
+		}
+		p_cache->p_loaded = p_loaded;
+	}
+	p_loaded->p_blocks[p_loaded->count] = p_block;
+	p_loaded->count++;
+END:
+	return;
+}
+
+void si_magazine_thread_flush(void)
+{
+	for (size_t iii = 0u; iii < LOCAL_CLASS_COUNT; iii++)
+	{
+		local_si_magazine_give(iii, g_caches[iii].p_loaded);
+		local_si_magazine_give(iii, g_caches[iii].p_previous);
+		g_caches[iii].p_loaded = NULL;
+		g_caches[iii].p_previous = NULL;
+	}
+}
+
+void si_magazine_trim(void)
+{
+	for (size_t iii = 0u; iii < LOCAL_CLASS_COUNT; iii++)
+	{
+		local_depot_t* const p_depot = &(g_depots[iii]);
+		local_si_magazine_depot_lock(p_depot);
+		local_magazine_t* p_full = p_depot->p_full;
+		local_magazine_t* p_empty = p_depot->p_empty;
+		p_depot->p_full = NULL;
+		p_depot->full_count = 0u;
+		p_depot->p_empty = NULL;
+		p_depot->empty_count = 0u;
+		local_si_magazine_depot_unlock(p_depot);
+		while (NULL != p_full)
+		{
+			local_magazine_t* const p_next = p_full->p_next;
+			local_si_magazine_release(p_full);
+			p_full = p_next;
+		}
+		while (NULL != p_empty)
+		{
+			local_magazine_t* const p_next = p_empty->p_next;
+			local_si_magazine_release(p_empty);
+			p_empty = p_next;
+		}
+	}
+}
+
+size_t si_magazine_malloc_count(void)
+{
+	return atomic_load(&g_malloc_count);
+}
@@ -1,5 +1,61 @@
 // si_mutex.c
 #include "si_mutex.h"
+#include "si_thread.h" // si_cpu_core_count(), si_cpu_relax()
+
+#include <time.h> // timespec, clock_gettime()
+
+/** Doxygen
+ * @brief Gets the monotonic time lock waits are measured against.
+ *
+ * @return Returns nanosecs since an arbitrary fixed point.
+ */
+static uint64_t local_si_mutex_now_ns(void)
+{
+	struct timespec now = {0};
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+void si_lock_stats_init(si_lock_stats_t* const p_stats)
+{
+	if (NULL == p_stats)
+	{
+		goto END;
+	}
+	atomic_init(&(p_stats->acquisitions), 0u);
+	atomic_init(&(p_stats->contended), 0u);
+	atomic_init(&(p_stats->wait_ns), 0u);
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Counts one acquisition & how long it waited, if it had to.
+ *
+ * @param p_stats Pointer to the counters to update. (NULL ok)
+ * @param start_ns Monotonic nanosecs the wait began. (0u = uncontended)
+ */
+static void local_si_lock_stats_add(si_lock_stats_t* const p_stats,
+	const uint64_t start_ns)
+{
+	if (NULL == p_stats)
+	{
+		goto END;
+	}
+	atomic_fetch_add_explicit(
+		&(p_stats->acquisitions), 1u, memory_order_relaxed
+	);
+	if (0u >= start_ns)
+	{
+		goto END;
+	}
+	atomic_fetch_add_explicit(&(p_stats->contended), 1u, memory_order_relaxed);
+	atomic_fetch_add_explicit(&(p_stats->wait_ns),
+		local_si_mutex_now_ns() - start_ns, memory_order_relaxed
+	);
+END:
+	return;
+}
 
 #ifdef _WIN32
 
@@ -188,21 +244,91 @@ END:
 	return result;
 }
 
-void si_mutex_lock(si_mutex_t* const p_mutex)
+bool si_cond_timedwait(si_cond_t* const p_cond, si_mutex_t* const p_mutex,
+	const uint32_t millisecs)
+{
+	bool result = false;
+	if ((NULL == p_cond) || (NULL == p_mutex))
+	{
+		goto END;
+	}
+	// Conditions time out against CLOCK_REALTIME by default.
+	struct timespec abs_time = {0};
+	const int get_time = clock_gettime(CLOCK_REALTIME, &abs_time);
+	if (SI_PTHREAD_SUCCESS != get_time)
+	{
+		goto END;
+	}
+	const long milli_to_nano = 1000000L;
+	const long nano_per_sec = 1000000000L;
+	abs_time.tv_sec += (time_t)(millisecs / 1000u);
+	abs_time.tv_nsec += ((long)(millisecs % 1000u)) * milli_to_nano;
+	if (nano_per_sec <= abs_time.tv_nsec)
+	{
+		abs_time.tv_sec++;
+		abs_time.tv_nsec -= nano_per_sec;
+	}
+	const int wait_result = pthread_cond_timedwait(p_cond, p_mutex, &abs_time);
+	result = (SI_PTHREAD_SUCCESS == wait_result);
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Gets how many times a held mutex is retried before sleeping on it.
+ *
+ * @return Returns SI_MUTEX_SPIN_COUNT on multi-core machines. 0u otherwise.
+ */
+static size_t local_si_mutex_spin_limit(void)
+{
+	// Cached plus one as 0u marks it unknown.
+	static volatile _Atomic size_t cached = 0u;
+	size_t result = atomic_load_explicit(&cached, memory_order_relaxed);
+	if (0u >= result)
+	{
+		// On a single core spinning only delays the holder being waited on.
+		result = (1u < si_cpu_core_count()) ? (SI_MUTEX_SPIN_COUNT + 1u) : 1u;
+		atomic_store_explicit(&cached, result, memory_order_relaxed);
+	}
+	return result - 1u;
+}
+
+void si_mutex_lock_2(si_mutex_t* const p_mutex, si_lock_stats_t* const p_stats)
 {
 	if (NULL == p_mutex)
 	{
 		goto END;
 	}
+	if (true == si_mutex_try_lock(p_mutex))
+	{
+		local_si_lock_stats_add(p_stats, 0u);
+		goto END;
+	}
+	const uint64_t start_ns = (NULL == p_stats) ? 0u : local_si_mutex_now_ns();
+	// Most critical sections end sooner than a sleep & wake up would.
+	bool is_locked = false;
+	const size_t spin_limit = local_si_mutex_spin_limit();
+	for (size_t iii = 0u; (iii < spin_limit) && (false == is_locked); iii++)
+	{
+		si_cpu_relax();
+		is_locked = si_mutex_try_lock(p_mutex);
+	}
 	// Loop to handle spurious wakeups
-	int lock_result = SI_PTHREAD_ERROR;
+	int lock_result = (true == is_locked) ?
+		SI_PTHREAD_SUCCESS : SI_PTHREAD_ERROR;
 	while (SI_PTHREAD_SUCCESS != lock_result)
 	{
 		lock_result = pthread_mutex_lock(p_mutex);
 	}
+	local_si_lock_stats_add(p_stats, start_ns);
 END:
 	return;
 }
+inline void si_mutex_lock(si_mutex_t* const p_mutex)
+{
+	// Default value of p_stats is NULL
+	si_mutex_lock_2(p_mutex, NULL);
+}
 
 void si_mutex_unlock(si_mutex_t* const p_mutex)
 {
@@ -255,3 +381,260 @@ void si_mutex_destroy(si_mutex_t** const pp_mutex)
 END:
 	return;
 }
+
+
+int si_rwlock_init_2(si_rwlock_t* const p_rwlock,
+	si_lock_stats_t* const p_stats)
+{
+	int result = SI_PTHREAD_ERROR;
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+	p_rwlock->p_stats = p_stats;
+#ifdef _WIN32
+	InitializeSRWLock(&(p_rwlock->lock));
+	result = SI_PTHREAD_SUCCESS;
+#elif SI_PTHREAD
+	result = pthread_rwlock_init(&(p_rwlock->lock), NULL);
+#endif // OS Specific implementation(s)
+END:
+	return result;
+}
+inline int si_rwlock_init(si_rwlock_t* const p_rwlock)
+{
+	// Default value of p_stats is NULL
+	return si_rwlock_init_2(p_rwlock, NULL);
+}
+
+bool si_rwlock_try_read_lock(si_rwlock_t* const p_rwlock)
+{
+	bool result = false;
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+#ifdef _WIN32
+	result = (0 != TryAcquireSRWLockShared(&(p_rwlock->lock)));
+#elif SI_PTHREAD
+	const int try_result = pthread_rwlock_tryrdlock(&(p_rwlock->lock));
+	result = (SI_PTHREAD_SUCCESS == try_result);
+#endif // OS Specific implementation(s)
+END:
+	return result;
+}
+
+void si_rwlock_read_lock(si_rwlock_t* const p_rwlock)
+{
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+	if (true == si_rwlock_try_read_lock(p_rwlock))
+	{
+		local_si_lock_stats_add(p_rwlock->p_stats, 0u);
+		goto END;
+	}
+	const uint64_t start_ns = (NULL == p_rwlock->p_stats) ?
+		0u : local_si_mutex_now_ns();
+#ifdef _WIN32
+	AcquireSRWLockShared(&(p_rwlock->lock));
+#elif SI_PTHREAD
+	// Loop to handle spurious wakeups
+	int lock_result = SI_PTHREAD_ERROR;
+	while (SI_PTHREAD_SUCCESS != lock_result)
+	{
+		lock_result = pthread_rwlock_rdlock(&(p_rwlock->lock));
+	}
+#endif // OS Specific implementation(s)
+	local_si_lock_stats_add(p_rwlock->p_stats, start_ns);
+END:
+	return;
+}
+
+void si_rwlock_read_unlock(si_rwlock_t* const p_rwlock)
+{
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+#ifdef _WIN32
+	ReleaseSRWLockShared(&(p_rwlock->lock));
+#elif SI_PTHREAD
+	(void)pthread_rwlock_unlock(&(p_rwlock->lock));
+#endif // OS Specific implementation(s)
+END:
+	return;
+}
+
+bool si_rwlock_try_write_lock(si_rwlock_t* const p_rwlock)
+{
+	bool result = false;
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+#ifdef _WIN32
+	result = (0 != TryAcquireSRWLockExclusive(&(p_rwlock->lock)));
+#elif SI_PTHREAD
+	const int try_result = pthread_rwlock_trywrlock(&(p_rwlock->lock));
+	result = (SI_PTHREAD_SUCCESS == try_result);
+#endif // OS Specific implementation(s)
+END:
+	return result;
+}
+
+void si_rwlock_write_lock(si_rwlock_t* const p_rwlock)
+{
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+	if (true == si_rwlock_try_write_lock(p_rwlock))
+	{
+		local_si_lock_stats_add(p_rwlock->p_stats, 0u);
+		goto END;
+	}
+	const uint64_t start_ns = (NULL == p_rwlock->p_stats) ?
+		0u : local_si_mutex_now_ns();
+#ifdef _WIN32
+	AcquireSRWLockExclusive(&(p_rwlock->lock));
+#elif SI_PTHREAD
+	// Loop to handle spurious wakeups
+	int lock_result = SI_PTHREAD_ERROR;
+	while (SI_PTHREAD_SUCCESS != lock_result)
+	{
+		lock_result = pthread_rwlock_wrlock(&(p_rwlock->lock));
+	}
+#endif // OS Specific implementation(s)
+	local_si_lock_stats_add(p_rwlock->p_stats, start_ns);
+END:
+	return;
+}
+
+void si_rwlock_write_unlock(si_rwlock_t* const p_rwlock)
+{
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+#ifdef _WIN32
+	ReleaseSRWLockExclusive(&(p_rwlock->lock));
+#elif SI_PTHREAD
+	(void)pthread_rwlock_unlock(&(p_rwlock->lock));
+#endif // OS Specific implementation(s)
+END:
+	return;
+}
+
+void si_rwlock_free(si_rwlock_t* const p_rwlock)
+{
+	if (NULL == p_rwlock)
+	{
+		goto END;
+	}
+#if SI_PTHREAD
+	(void)pthread_rwlock_destroy(&(p_rwlock->lock));
+#endif//SI_PTHREAD
+	// SRWLOCKs hold no resources to be freed.
+	p_rwlock->p_stats = NULL;
+END:
+	return;
+}
+
+
+int si_seqlock_init(si_seqlock_t* const p_seqlock)
+{
+	int result = SI_PTHREAD_ERROR;
+	if (NULL == p_seqlock)
+	{
+		goto END;
+	}
+	atomic_init(&(p_seqlock->sequence), 0u);
+	result = si_mutex_init(&(p_seqlock->write_lock));
+END:
+	return result;
+}
+
+size_t si_seqlock_read_begin(si_seqlock_t* const p_seqlock)
+{
+	size_t result = 0u;
+	if (NULL == p_seqlock)
+	{
+		goto END;
+	}
+	result = atomic_load_explicit(&(p_seqlock->sequence), memory_order_acquire);
+	while (0u != (result & 1u))
+	{
+		si_cpu_relax();
+		result = atomic_load_explicit(
+			&(p_seqlock->sequence), memory_order_acquire
+		);
+	}
+END:
+	return result;
+}
+
+bool si_seqlock_read_retry(si_seqlock_t* const p_seqlock,
+	const size_t sequence)
+{
+	bool result = false;
+	if (NULL == p_seqlock)
+	{
+		goto END;
+	}
+	// Keeps the data reads from sinking below the sequence re-read.
+	atomic_thread_fence(memory_order_acquire);
+	result = (sequence != atomic_load_explicit(
+		&(p_seqlock->sequence), memory_order_relaxed
+	));
+END:
+	return result;
+}
+
+void si_seqlock_write_lock(si_seqlock_t* const p_seqlock)
+{
+	if (NULL == p_seqlock)
+	{
+		goto END;
+	}
+	si_mutex_lock(&(p_seqlock->write_lock));
+	const size_t sequence = atomic_load_explicit(
+		&(p_seqlock->sequence), memory_order_relaxed
+	);
+	atomic_store_explicit(
+		&(p_seqlock->sequence), sequence + 1u, memory_order_relaxed
+	);
+	// Keeps the data writes from rising above the odd sequence.
+	atomic_thread_fence(memory_order_release);
+END:
+	return;
+}
+
+void si_seqlock_write_unlock(si_seqlock_t* const p_seqlock)
+{
+	if (NULL == p_seqlock)
+	{
+		goto END;
+	}
+	const size_t sequence = atomic_load_explicit(
+		&(p_seqlock->sequence), memory_order_relaxed
+	);
+	atomic_store_explicit(
+		&(p_seqlock->sequence), sequence + 1u, memory_order_release
+	);
+	si_mutex_unlock(&(p_seqlock->write_lock));
+END:
+	return;
+}
+
+void si_seqlock_free(si_seqlock_t* const p_seqlock)
+{
+	if (NULL == p_seqlock)
+	{
+		goto END;
+	}
+	si_mutex_free(&(p_seqlock->write_lock));
+END:
+	return;
+}
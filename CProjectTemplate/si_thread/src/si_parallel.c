@@ -0,0 +1,738 @@
+// si_parallel.c
+#include "si_parallel.h"
+
+#include <stdint.h> // uint8_t, uintptr_t, SIZE_MAX
+#include <stdlib.h> // calloc(), free(), malloc()
+#include <string.h> // memcpy()
+
+// Local scope task parameter for sorting one chunk in place.
+typedef struct local_sort_job_t
+{
+	uint8_t* p_data;
+	size_t element_size;
+	size_t count;
+	int (*p_cmp_f)(const void* const, const void* const);
+} local_sort_job_t;
+
+// Local scope task parameter for merging [a_begin,a_end) & [b_begin,b_end)
+// of p_source into p_destination starting at out.
+typedef struct local_merge_job_t
+{
+	const uint8_t* p_source;
+	uint8_t* p_destination;
+	size_t element_size;
+	size_t a_begin;
+	size_t a_end;
+	size_t b_begin;
+	size_t b_end;
+	size_t out;
+	int (*p_cmp_f)(const void* const, const void* const);
+} local_merge_job_t;
+
+// Local scope task parameter for a slice of si_parallel_bsearch_many().
+typedef struct local_search_job_t
+{
+	const si_array_t* p_sorted;
+	const si_array_t* p_keys;
+	size_t* p_indexes;
+	size_t begin;
+	size_t end;
+	int (*p_cmp_f)(const void* const, const void* const);
+} local_search_job_t;
+
+// Local scope task parameter for mapping [begin,end) of p_source.
+typedef struct local_map_job_t
+{
+	const uint8_t* p_source;
+	uint8_t* p_destination;
+	size_t source_size;
+	size_t destination_size;
+	size_t begin;
+	size_t end;
+	void (*p_map_f)(void* const, const void* const, void* const);
+	void* p_context;
+} local_map_job_t;
+
+// Local scope task parameter for folding or scanning [begin,end) of p_data.
+typedef struct local_fold_job_t
+{
+	uint8_t* p_data;
+	size_t element_size;
+	size_t begin;
+	size_t end;
+	// Fold of every chunk before this one. (NULL for the first chunk)
+	const uint8_t* p_prefix;
+	// Cache line padded slot of the chunk's running value.
+	uint8_t* p_accumulator;
+	void (*p_op_f)(void* const, const void* const);
+} local_fold_job_t;
+
+/** Doxygen
+ * @brief Counts the workers able to take tasks right now.
+ *
+ * @param p_pool Pointer to the thread pool struct to inspect.
+ *
+ * @return Returns worker count. Returns 0u when NULL or not running.
+ */
+static size_t local_si_parallel_workers(si_threadpool_t* const p_pool)
+{
+	size_t result = 0u;
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	const bool is_running = atomic_load(&(p_pool->is_running));
+	if (true != is_running)
+	{
+		goto END;
+	}
+	result = atomic_load(&(p_pool->live_count));
+END:
+	return result;
+}
+
+// Local scope parallel_for() context running a task on each job struct.
+typedef struct local_run_t
+{
+	uint8_t* p_jobs;
+	size_t job_size;
+	p_task_f p_task;
+} local_run_t;
+
+static void local_si_parallel_run_range(size_t begin, size_t end,
+	void* p_context)
+{
+	const local_run_t* const p_run = p_context;
+	for (size_t iii = begin; iii < end; iii++)
+	{
+		(void)p_run->p_task(p_run->p_jobs + (iii * p_run->job_size));
+	}
+}
+
+/** Doxygen
+ * @brief Runs job_count tasks over contiguous job structs and waits for all.
+ * @details Each job is one si_threadpool_parallel_for() chunk, so the caller
+ *          and the pool's helpers claim jobs from one shared counter. Runs
+ *          inline when p_pool is NULL or not running.
+ *
+ * @param p_pool Pointer to the threadpool to execute tasks on.
+ * @param p_jobs Pointer to the first of job_count job structs.
+ * @param job_size Size of a single job struct in bytes.
+ * @param job_count Number of job structs at p_jobs.
+ * @param p_task Task function to call with a pointer to each job.
+ *
+ * @return Returns stdbool true if every task completed. Returns false otherwise
+ */
+static bool local_si_parallel_run(si_threadpool_t* const p_pool,
+	void* const p_jobs, const size_t job_size, const size_t job_count,
+	p_task_f const p_task)
+{
+	local_run_t run = {0};
+	run.p_jobs = p_jobs;
+	run.job_size = job_size;
+	run.p_task = p_task;
+	return si_threadpool_parallel_for(
+		p_pool, 0u, job_count, 1u, local_si_parallel_run_range, &run
+	);
+}
+
+static void* local_si_parallel_sort_task(void* const p_param)
+{
+	local_sort_job_t* const p_job = p_param;
+	si_array_t view = { p_job->p_data, p_job->element_size, p_job->count };
+	si_array_sort(&view, p_job->p_cmp_f);
+	return p_param;
+}
+
+static void* local_si_parallel_merge_task(void* const p_param)
+{
+	local_merge_job_t* const p_job = p_param;
+	const size_t element_size = p_job->element_size;
+	const uint8_t* const p_source = p_job->p_source;
+	uint8_t* p_out = p_job->p_destination + (p_job->out * element_size);
+	size_t a = p_job->a_begin;
+	size_t b = p_job->b_begin;
+	while ((a < p_job->a_end) && (b < p_job->b_end))
+	{
+		const uint8_t* const p_a = p_source + (a * element_size);
+		const uint8_t* const p_b = p_source + (b * element_size);
+		// Ties take from the left run to keep the merge stable.
+		if (0 >= p_job->p_cmp_f(p_a, p_b))
+		{
+			memcpy(p_out, p_a, element_size);
+			a++;
+		}
+		else
+		{
+			memcpy(p_out, p_b, element_size);
+			b++;
+		}
+		p_out += element_size;
+	}
+	memcpy(
+		p_out, p_source + (a * element_size), (p_job->a_end - a) * element_size
+	);
+	p_out += (p_job->a_end - a) * element_size;
+	memcpy(
+		p_out, p_source + (b * element_size), (p_job->b_end - b) * element_size
+	);
+	return p_param;
+}
+
+/** Doxygen
+ * @brief Finds the first index in [begin,end) not ordered before p_key, or
+ *        after it when is_upper is true.
+ */
+static size_t local_si_parallel_bound(const uint8_t* const p_data,
+	const size_t element_size, size_t begin, size_t end,
+	const void* const p_key, const bool is_upper,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	while (begin < end)
+	{
+		const size_t middle = begin + ((end - begin) / 2u);
+		const int order = p_cmp_f(p_data + (middle * element_size), p_key);
+		if ((0 > order) || (is_upper && (0 == order)))
+		{
+			begin = middle + 1u;
+		}
+		else
+		{
+			end = middle;
+		}
+	}
+	return begin;
+}
+
+/** Doxygen
+ * @brief Splits the merge of [lo,mid) & [mid,hi) into parts merge jobs.
+ *
+ * @return Returns the number of jobs written to p_jobs.
+ */
+static size_t local_si_parallel_split_merge(local_merge_job_t* const p_jobs,
+	const local_merge_job_t* const p_template, const size_t lo,
+	const size_t mid, const size_t hi, size_t parts)
+{
+	const size_t a_count = mid - lo;
+	const size_t b_count = hi - mid;
+	// Split along the longer run, searching its pivots in the shorter one.
+	const bool split_a = (a_count >= b_count);
+	const size_t split_count = split_a ? a_count : b_count;
+	if (parts > split_count)
+	{
+		parts = (0u < split_count) ? split_count : 1u;
+	}
+	size_t a_previous = lo;
+	size_t b_previous = mid;
+	for (size_t part = 1u; part <= parts; part++)
+	{
+		size_t a_next = mid;
+		size_t b_next = hi;
+		if (part < parts)
+		{
+			const size_t offset = (split_count * part) / parts;
+			if (split_a)
+			{
+				a_next = lo + offset;
+				b_next = local_si_parallel_bound(
+					p_template->p_source, p_template->element_size, mid, hi,
+					p_template->p_source + (a_next * p_template->element_size),
+					false, p_template->p_cmp_f
+				);
+			}
+			else
+			{
+				b_next = mid + offset;
+				a_next = local_si_parallel_bound(
+					p_template->p_source, p_template->element_size, lo, mid,
+					p_template->p_source + (b_next * p_template->element_size),
+					true, p_template->p_cmp_f
+				);
+			}
+		}
+		local_merge_job_t* const p_job = &(p_jobs[part - 1u]);
+		*p_job = *p_template;
+		p_job->a_begin = a_previous;
+		p_job->a_end = a_next;
+		p_job->b_begin = b_previous;
+		p_job->b_end = b_next;
+		p_job->out = a_previous + (b_previous - mid);
+		a_previous = a_next;
+		b_previous = b_next;
+	}
+	return parts;
+}
+
+bool si_parallel_sort(si_threadpool_t* const p_pool, si_array_t* const p_array,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	bool result = false;
+	uint8_t* p_scratch = NULL;
+	size_t* p_bounds = NULL;
+	void* p_jobs = NULL;
+	if ((NULL == p_array) || (NULL == p_cmp_f))
+	{
+		goto END;
+	}
+	const size_t count = p_array->capacity;
+	const size_t element_size = p_array->element_size;
+	const size_t workers = local_si_parallel_workers(p_pool);
+	if ((0u >= workers) || (SI_PARALLEL_SORT_MIN > count) ||
+		(NULL == p_array->p_data))
+	{
+		result = si_array_sort(p_array, p_cmp_f);
+		goto END;
+	}
+	// The calling thread takes a share of every round too.
+	const size_t task_target = workers + 1u;
+	size_t runs = task_target;
+	if (runs > (count / (SI_PARALLEL_SORT_MIN / 4u)))
+	{
+		runs = count / (SI_PARALLEL_SORT_MIN / 4u);
+	}
+	p_scratch = malloc(count * element_size);
+	p_bounds = calloc(runs + 1u, sizeof(size_t));
+	// Rounds never need more jobs than runs + task_target.
+	const size_t job_capacity = runs + task_target;
+	const size_t job_size = (sizeof(local_merge_job_t) > sizeof(local_sort_job_t)) ?
+		sizeof(local_merge_job_t) : sizeof(local_sort_job_t);
+	p_jobs = calloc(job_capacity, job_size);
+	if ((NULL == p_scratch) || (NULL == p_bounds) || (NULL == p_jobs))
+	{
+		goto END;
+	}
+	uint8_t* p_source = p_array->p_data;
+	uint8_t* p_destination = p_scratch;
+	local_sort_job_t* const p_sort_jobs = p_jobs;
+	for (size_t iii = 0u; iii <= runs; iii++)
+	{
+		p_bounds[iii] = (count * iii) / runs;
+	}
+	for (size_t iii = 0u; iii < runs; iii++)
+	{
+		p_sort_jobs[iii].p_data = p_source + (p_bounds[iii] * element_size);
+		p_sort_jobs[iii].element_size = element_size;
+		p_sort_jobs[iii].count = p_bounds[iii + 1u] - p_bounds[iii];
+		p_sort_jobs[iii].p_cmp_f = p_cmp_f;
+	}
+	if (true != local_si_parallel_run(p_pool, p_sort_jobs,
+		sizeof(local_sort_job_t), runs, local_si_parallel_sort_task))
+	{
+		goto END;
+	}
+	local_merge_job_t* const p_merge_jobs = p_jobs;
+	while (1u < runs)
+	{
+		const size_t pairs = (runs + 1u) / 2u;
+		const size_t parts = (task_target + pairs - 1u) / pairs;
+		const local_merge_job_t template = {
+			p_source, p_destination, element_size, 0u, 0u, 0u, 0u, 0u, p_cmp_f
+		};
+		size_t job_count = 0u;
+		for (size_t pair = 0u; pair < pairs; pair++)
+		{
+			const size_t lo = p_bounds[2u * pair];
+			const size_t mid = p_bounds[((2u * pair) + 1u)];
+			const size_t hi = (((2u * pair) + 2u) <= runs) ?
+				p_bounds[(2u * pair) + 2u] : mid;
+			job_count += local_si_parallel_split_merge(
+				p_merge_jobs + job_count, &template, lo, mid, hi,
+				(hi > mid) ? parts : 1u
+			);
+		}
+		if (true != local_si_parallel_run(p_pool, p_merge_jobs,
+			sizeof(local_merge_job_t), job_count, local_si_parallel_merge_task))
+		{
+			goto END;
+		}
+		for (size_t pair = 0u; pair < pairs; pair++)
+		{
+			p_bounds[pair] = p_bounds[2u * pair];
+		}
+		p_bounds[pairs] = count;
+		runs = pairs;
+		uint8_t* const p_swap = p_source;
+		p_source = p_destination;
+		p_destination = p_swap;
+	}
+	if (p_source != p_array->p_data)
+	{
+		memcpy(p_array->p_data, p_source, count * element_size);
+	}
+	result = true;
+END:
+	free(p_jobs);
+	p_jobs = NULL;
+	free(p_bounds);
+	p_bounds = NULL;
+	free(p_scratch);
+	p_scratch = NULL;
+	return result;
+}
+
+static void* local_si_parallel_search_task(void* const p_param)
+{
+	local_search_job_t* const p_job = p_param;
+	for (size_t iii = p_job->begin; iii < p_job->end; iii++)
+	{
+		p_job->p_indexes[iii] = si_array_bsearch(
+			p_job->p_sorted, si_array_at(p_job->p_keys, iii), p_job->p_cmp_f
+		);
+	}
+	return p_param;
+}
+
+bool si_parallel_bsearch_many(si_threadpool_t* const p_pool,
+	const si_array_t* const p_sorted, const si_array_t* const p_keys,
+	si_array_t* const p_indexes,
+	int (*p_cmp_f)(const void* const, const void* const))
+{
+	bool result = false;
+	local_search_job_t* p_jobs = NULL;
+	if ((NULL == p_sorted) || (NULL == p_keys) || (NULL == p_indexes) ||
+		(NULL == p_cmp_f))
+	{
+		goto END;
+	}
+	const size_t count = p_keys->capacity;
+	si_array_init_3(p_indexes, sizeof(size_t), count);
+	if ((0u < count) && (NULL == p_indexes->p_data))
+	{
+		goto END;
+	}
+	size_t job_count = local_si_parallel_workers(p_pool) + 1u;
+	if (job_count > (count / SI_PARALLEL_BSEARCH_GRAIN))
+	{
+		job_count = count / SI_PARALLEL_BSEARCH_GRAIN;
+	}
+	if (0u >= job_count)
+	{
+		job_count = 1u;
+	}
+	p_jobs = calloc(job_count, sizeof(local_search_job_t));
+	if (NULL == p_jobs)
+	{
+		goto END;
+	}
+	for (size_t iii = 0u; iii < job_count; iii++)
+	{
+		p_jobs[iii].p_sorted = p_sorted;
+		p_jobs[iii].p_keys = p_keys;
+		p_jobs[iii].p_indexes = p_indexes->p_data;
+		p_jobs[iii].begin = (count * iii) / job_count;
+		p_jobs[iii].end = (count * (iii + 1u)) / job_count;
+		p_jobs[iii].p_cmp_f = p_cmp_f;
+	}
+	result = local_si_parallel_run(
+		p_pool, p_jobs, sizeof(local_search_job_t), job_count,
+		local_si_parallel_search_task
+	);
+END:
+	free(p_jobs);
+	p_jobs = NULL;
+	return result;
+}
+
+/** Doxygen
+ * @brief Picks the chunk count of an array with count elements. Depends on
+ *        nothing else, so fold orders stay the same from run to run.
+ *
+ * @param count Number of elements in the array.
+ *
+ * @return Returns a chunk count from 1u to SI_PARALLEL_MAX_CHUNKS.
+ */
+static size_t local_si_parallel_chunk_count(const size_t count)
+{
+	size_t result = count / SI_PARALLEL_GRAIN;
+	if (SI_PARALLEL_MAX_CHUNKS < result)
+	{
+		result = SI_PARALLEL_MAX_CHUNKS;
+	}
+	if (0u >= result)
+	{
+		result = 1u;
+	}
+	return result;
+}
+
+/** Doxygen
+ * @brief Allocates count slots of element_size bytes, each starting on its
+ *        own SI_PARALLEL_CACHE_LINE so writers never share a line.
+ *
+ * @param pp_block Receives the block to pass to free() later.
+ * @param count Number of slots needed.
+ * @param element_size Bytes used of each slot.
+ * @param p_stride Receives the distance in bytes between slots.
+ *
+ * @return Returns pointer to the first slot on success. Returns NULL otherwise.
+ */
+static uint8_t* local_si_parallel_slots_new(void** const pp_block,
+	const size_t count, const size_t element_size, size_t* const p_stride)
+{
+	uint8_t* p_result = NULL;
+	const size_t line = SI_PARALLEL_CACHE_LINE;
+	const size_t stride = ((element_size + line - 1u) / line) * line;
+	if ((0u >= stride) || ((SIZE_MAX - line) / stride < count))
+	{
+		goto END;
+	}
+	*pp_block = malloc((count * stride) + line - 1u);
+	if (NULL == *pp_block)
+	{
+		goto END;
+	}
+	const uintptr_t address = (uintptr_t)*pp_block;
+	p_result = (uint8_t*)*pp_block +
+		((line - (address % line)) % line);
+	*p_stride = stride;
+END:
+	return p_result;
+}
+
+static void* local_si_parallel_map_task(void* const p_param)
+{
+	local_map_job_t* const p_job = p_param;
+	for (size_t iii = p_job->begin; iii < p_job->end; iii++)
+	{
+		p_job->p_map_f(p_job->p_destination + (iii * p_job->destination_size),
+			p_job->p_source + (iii * p_job->source_size), p_job->p_context
+		);
+	}
+	return p_param;
+}
+
+static void* local_si_parallel_fold_task(void* const p_param)
+{
+	local_fold_job_t* const p_job = p_param;
+	const size_t element_size = p_job->element_size;
+	memcpy(p_job->p_accumulator,
+		p_job->p_data + (p_job->begin * element_size), element_size
+	);
+	for (size_t iii = p_job->begin + 1u; iii < p_job->end; iii++)
+	{
+		p_job->p_op_f(
+			p_job->p_accumulator, p_job->p_data + (iii * element_size)
+		);
+	}
+	return p_param;
+}
+
+static void* local_si_parallel_scan_task(void* const p_param)
+{
+	local_fold_job_t* const p_job = p_param;
+	const size_t element_size = p_job->element_size;
+	size_t iii = p_job->begin;
+	if (NULL == p_job->p_prefix)
+	{
+		memcpy(p_job->p_accumulator,
+			p_job->p_data + (iii * element_size), element_size
+		);
+		iii++;
+	}
+	else
+	{
+		memcpy(p_job->p_accumulator, p_job->p_prefix, element_size);
+	}
+	for (; iii < p_job->end; iii++)
+	{
+		uint8_t* const p_element = p_job->p_data + (iii * element_size);
+		p_job->p_op_f(p_job->p_accumulator, p_element);
+		memcpy(p_element, p_job->p_accumulator, element_size);
+	}
+	return p_param;
+}
+
+/** Doxygen
+ * @brief Fills one fold job per chunk of an array.
+ *
+ * @param p_jobs Pointer to chunk_count jobs to be filled.
+ * @param chunk_count Number of chunks the array is split into.
+ * @param p_array Pointer to the si_array_t struct being folded.
+ * @param p_slots Pointer to the first of chunk_count accumulator slots.
+ * @param stride Distance in bytes between accumulator slots.
+ * @param p_op_f Fold function the jobs call.
+ */
+static void local_si_parallel_fold_jobs(local_fold_job_t* const p_jobs,
+	const size_t chunk_count, const si_array_t* const p_array,
+	uint8_t* const p_slots, const size_t stride,
+	void (*p_op_f)(void* const, const void* const))
+{
+	const size_t count = p_array->capacity;
+	for (size_t iii = 0u; iii < chunk_count; iii++)
+	{
+		p_jobs[iii].p_data = p_array->p_data;
+		p_jobs[iii].element_size = p_array->element_size;
+		p_jobs[iii].begin = (count * iii) / chunk_count;
+		p_jobs[iii].end = (count * (iii + 1u)) / chunk_count;
+		p_jobs[iii].p_prefix = NULL;
+		p_jobs[iii].p_accumulator = p_slots + (iii * stride);
+		p_jobs[iii].p_op_f = p_op_f;
+	}
+}
+
+bool si_parallel_map(si_threadpool_t* const p_pool,
+	const si_array_t* const p_source, si_array_t* const p_destination,
+	const size_t element_size,
+	void (*p_map_f)(void* const, const void* const, void* const),
+	void* const p_context)
+{
+	bool result = false;
+	local_map_job_t* p_jobs = NULL;
+	if ((NULL == p_source) || (NULL == p_destination) ||
+		(0u >= element_size) || (NULL == p_map_f))
+	{
+		goto END;
+	}
+	const size_t count = p_source->capacity;
+	si_array_init_3(p_destination, element_size, count);
+	if ((0u < count) && (NULL == p_destination->p_data))
+	{
+		goto END;
+	}
+	if (0u >= count)
+	{
+		result = true;
+		goto END;
+	}
+	const size_t chunk_count = local_si_parallel_chunk_count(count);
+	p_jobs = calloc(chunk_count, sizeof(local_map_job_t));
+	if (NULL == p_jobs)
+	{
+		goto END;
+	}
+	for (size_t iii = 0u; iii < chunk_count; iii++)
+	{
+		p_jobs[iii].p_source = p_source->p_data;
+		p_jobs[iii].p_destination = p_destination->p_data;
+		p_jobs[iii].source_size = p_source->element_size;
+		p_jobs[iii].destination_size = element_size;
+		p_jobs[iii].begin = (count * iii) / chunk_count;
+		p_jobs[iii].end = (count * (iii + 1u)) / chunk_count;
+		p_jobs[iii].p_map_f = p_map_f;
+		p_jobs[iii].p_context = p_context;
+	}
+	result = local_si_parallel_run(p_pool, p_jobs, sizeof(local_map_job_t),
+		chunk_count, local_si_parallel_map_task
+	);
+END:
+	free(p_jobs);
+	p_jobs = NULL;
+	return result;
+}
+
+bool si_parallel_reduce(si_threadpool_t* const p_pool,
+	const si_array_t* const p_array, void* const p_result,
+	void (*p_op_f)(void* const, const void* const))
+{
+	bool result = false;
+	local_fold_job_t* p_jobs = NULL;
+	void* p_block = NULL;
+	if ((NULL == p_array) || (NULL == p_result) || (NULL == p_op_f))
+	{
+		goto END;
+	}
+	const size_t count = p_array->capacity;
+	if ((0u >= count) || (NULL == p_array->p_data))
+	{
+		// Nothing to fold, the initial value is the result.
+		result = (0u >= count);
+		goto END;
+	}
+	const size_t chunk_count = local_si_parallel_chunk_count(count);
+	size_t stride = 0u;
+	uint8_t* const p_partials = local_si_parallel_slots_new(
+		&p_block, chunk_count, p_array->element_size, &stride
+	);
+	p_jobs = calloc(chunk_count, sizeof(local_fold_job_t));
+	if ((NULL == p_partials) || (NULL == p_jobs))
+	{
+		goto END;
+	}
+	local_si_parallel_fold_jobs(
+		p_jobs, chunk_count, p_array, p_partials, stride, p_op_f
+	);
+	result = local_si_parallel_run(p_pool, p_jobs, sizeof(local_fold_job_t),
+		chunk_count, local_si_parallel_fold_task
+	);
+	if (true != result)
+	{
+		goto END;
+	}
+	// Always folded in chunk order, whichever chunk finished first.
+	for (size_t iii = 0u; iii < chunk_count; iii++)
+	{
+		p_op_f(p_result, p_partials + (iii * stride));
+	}
+END:
+	free(p_jobs);
+	p_jobs = NULL;
+	free(p_block);
+	p_block = NULL;
+	return result;
+}
+
+bool si_parallel_inclusive_scan(si_threadpool_t* const p_pool,
+	si_array_t* const p_array, void (*p_op_f)(void* const, const void* const))
+{
+	bool result = false;
+	local_fold_job_t* p_jobs = NULL;
+	void* p_block = NULL;
+	if ((NULL == p_array) || (NULL == p_op_f))
+	{
+		goto END;
+	}
+	const size_t count = p_array->capacity;
+	const size_t element_size = p_array->element_size;
+	if ((0u >= count) || (NULL == p_array->p_data))
+	{
+		result = (0u >= count);
+		goto END;
+	}
+	const size_t chunk_count = local_si_parallel_chunk_count(count);
+	// Chunk totals then prefixes first, running values of the scan after.
+	size_t stride = 0u;
+	uint8_t* const p_slots = local_si_parallel_slots_new(
+		&p_block, 2u * chunk_count, element_size, &stride
+	);
+	p_jobs = calloc(chunk_count, sizeof(local_fold_job_t));
+	if ((NULL == p_slots) || (NULL == p_jobs))
+	{
+		goto END;
+	}
+	local_si_parallel_fold_jobs(
+		p_jobs, chunk_count, p_array, p_slots, stride, p_op_f
+	);
+	// The last chunk's total is never needed.
+	const bool did_fold = local_si_parallel_run(p_pool, p_jobs,
+		sizeof(local_fold_job_t), chunk_count - 1u, local_si_parallel_fold_task
+	);
+	if (true != did_fold)
+	{
+		goto END;
+	}
+	// Totals become prefixes in chunk order, slot iii then holds the fold of
+	// chunks [0,iii]. The unused last slot is scratch.
+	uint8_t* const p_scratch = p_slots + ((chunk_count - 1u) * stride);
+	for (size_t iii = 1u; (iii + 1u) < chunk_count; iii++)
+	{
+		uint8_t* const p_total = p_slots + (iii * stride);
+		memcpy(p_scratch, p_total - stride, element_size);
+		p_op_f(p_scratch, p_total);
+		memcpy(p_total, p_scratch, element_size);
+	}
+	for (size_t iii = 0u; iii < chunk_count; iii++)
+	{
+		p_jobs[iii].p_prefix = (0u < iii) ?
+			(p_slots + ((iii - 1u) * stride)) : NULL;
+		p_jobs[iii].p_accumulator = p_slots + ((chunk_count + iii) * stride);
+	}
+	result = local_si_parallel_run(p_pool, p_jobs, sizeof(local_fold_job_t),
+		chunk_count, local_si_parallel_scan_task
+	);
+END:
+	free(p_jobs);
+	p_jobs = NULL;
+	free(p_block);
+	p_block = NULL;
+	return result;
+}
@@ -14,6 +14,10 @@ void si_priority_queue_init(si_priority_queue_t* const p_pqueue,
 	}
 	p_pqueue->p_settings = NULL;
 	p_pqueue->p_free_value = NULL;
+	p_pqueue->p_schedule = NULL;
+	p_pqueue->schedule_length = 0u;
+	p_pqueue->aging_period = 0u;
+	atomic_init(&(p_pqueue->turn), 0u);
 	si_parray_init_2(&(p_pqueue->locks), priority_count);
 	si_parray_init_2(&(p_pqueue->queues), priority_count);
 
@@ -104,6 +108,27 @@ END:
 	return result;
 }
 
+size_t si_priority_queue_count_at(const si_priority_queue_t* const p_pqueue,
+	const size_t priority)
+{
+	size_t result = SIZE_MAX;
+	if (NULL == p_pqueue)
+	{
+		goto END;
+	}
+	si_mutex_t* const p_lock = si_parray_at(&(p_pqueue->locks), priority);
+	si_queue_t* const p_queue = si_parray_at(&(p_pqueue->queues), priority);
+	if ((NULL == p_lock) || (NULL == p_queue))
+	{
+		goto END;
+	}
+	si_mutex_lock(p_lock);
+	result = si_queue_count(p_queue);
+	si_mutex_unlock(p_lock);
+END:
+	return result;
+}
+
 bool si_priority_queue_is_empty(const si_priority_queue_t* const p_pqueue)
 {
 	bool result = true;
@@ -149,32 +174,57 @@ END:
 }
 
 /** Doxygen
- * @brief Increases the priority of all tasks in the queue from priority by
- *        amount to prevent starvation.
+ * @brief Gets the queue of a priority level, creating it on first use.
+ * 
+ * @param p_pqueue Pointer to the priority queue to get the level of.
+ * @param priority Priority level size_t to get. (Its lock held)
+ * @param capacity Initial capacity used when the queue is created.
+ * 
+ * @return Returns queue pointer on success. Returns NULL otherwise.
+ */
+static si_queue_t* si_priority_queue_level(si_priority_queue_t* const p_pqueue,
+	const size_t priority, const size_t capacity)
+{
+	si_queue_t* p_queue = si_parray_at(&(p_pqueue->queues), priority);
+	if (NULL == p_queue)
+	{
+		// Initialize queue
+		p_queue = si_queue_new_3(sizeof(void*), capacity, p_pqueue->p_settings);
+		si_parray_set(&(p_pqueue->queues), priority, p_queue);
+	}
+	return p_queue;
+}
+
+/** Doxygen
+ * @brief Increases the priority of the oldest tasks in the queue at priority
+ *        by amount to prevent starvation.
  * 
  * @param p_pqueue Pointer to the priority queue to preform reprioritization on
  * @param priority Priority level to change from as type size_t.
  * @param amount How much to increase the priority from that level by.
+ * @param limit Max number of entrys to move. (SIZE_MAX moves all of them)
  * 
  * @return Returns number of entrys that have had their priority level changed.
  */
 static size_t si_priority_queue_feed_at(si_priority_queue_t* const p_pqueue,
-	const size_t priority, const size_t amount)
+	const size_t priority, const size_t amount, const size_t limit)
 {
 	size_t result = 0u;
 	if ((NULL == p_pqueue) || (0u >= amount))
 	{
 		goto END;
 	}
-	if (p_pqueue->locks.array.capacity <= priority)
+	const size_t priority_count = si_priority_queue_priority_count(p_pqueue);
+	if ((1u >= priority_count) || ((priority_count - 1u) <= priority))
 	{
+		// Nothing above the top level to move to.
 		goto END;
 	}
 	size_t sink_index = priority + amount;
-	// Handle overflow for ridiculous number of priority levels
-	if (sink_index <= priority)
+	// Handle overflow & clamp to the highest level.
+	if ((sink_index <= priority) || (priority_count <= sink_index))
 	{
-		sink_index = SIZE_MAX;
+		sink_index = priority_count - 1u;
 	}
 
 	si_mutex_t* const p_source_lock = si_parray_at(
@@ -187,23 +237,36 @@ static size_t si_priority_queue_feed_at(si_priority_queue_t* const p_pqueue,
 	{
 		goto END;
 	}
+
+	// Lock source and sink queues, lower level first like everywhere else.
+	si_mutex_lock(p_source_lock);
+	si_mutex_lock(p_sink_lock);
+
 	si_queue_t* const p_source_queue = si_parray_at(
 		&(p_pqueue->queues), priority
 	);
-	si_queue_t* const p_sink_queue = si_parray_at(
-		&(p_pqueue->queues), priority
+	if (NULL == p_source_queue)
+	{
+		goto UNLOCK;
+	}
+	size_t count_items = si_queue_count(p_source_queue);
+	if (limit < count_items)
+	{
+		count_items = limit;
+	}
+	if (0u >= count_items)
+	{
+		goto UNLOCK;
+	}
+	si_queue_t* const p_sink_queue = si_priority_queue_level(
+		p_pqueue, sink_index, count_items
 	);
-	if ((NULL == p_source_queue) || (NULL == p_sink_queue))
+	if (NULL == p_sink_queue)
 	{
-		goto END;
+		goto UNLOCK;
 	}
 
-	// Lock source and sink queues
-	si_mutex_lock(p_source_lock);
-	si_mutex_lock(p_sink_lock);
-
 	// Moves items from source to sink
-	const size_t count_items = si_queue_count(p_source_queue);
 	for (size_t iii = 0u; iii < count_items; iii++)
 	{
 		void* p_data = NULL;
@@ -216,6 +279,7 @@ static size_t si_priority_queue_feed_at(si_priority_queue_t* const p_pqueue,
 		result++;
 	}
 
+UNLOCK:;
 	// Unlock source and sink queues
 	si_mutex_unlock(p_sink_lock);
 	si_mutex_unlock(p_source_lock);
@@ -231,18 +295,102 @@ size_t si_priority_queue_feed(si_priority_queue_t* const p_pqueue,
 	{
 		goto END;
 	}
-	if (0 >= p_pqueue->locks.array.capacity)
+	const size_t priority_count = si_priority_queue_priority_count(p_pqueue);
+	// Top down, so no entry is moved more than once per feed.
+	for (size_t iii = priority_count; 1u < iii; iii--)
+	{
+		result += si_priority_queue_feed_at(
+			p_pqueue, iii - 2u, amount, SIZE_MAX
+		);
+	}
+END:
+	return result;
+}
+
+bool si_priority_queue_set_weights(si_priority_queue_t* const p_pqueue,
+	const size_t* const p_weights)
+{
+	bool result = false;
+	size_t* p_schedule = NULL;
+	size_t* p_current = NULL;
+	if (NULL == p_pqueue)
+	{
+		goto END;
+	}
+	const size_t priority_count = si_priority_queue_priority_count(p_pqueue);
+	if (0u >= priority_count)
 	{
 		goto END;
 	}
-	for (size_t iii = 0u; iii < (p_pqueue->locks.array.capacity - 1u); iii++)
+	size_t total = 0u;
+	if (NULL == p_weights)
 	{
-		result += si_priority_queue_feed_at(p_pqueue, iii, amount);
+		// Back to strict priority order.
+		goto SWAP;
+	}
+	for (size_t iii = 0u; iii < priority_count; iii++)
+	{
+		if ((SI_PRIORITY_QUEUE_MAX_SCHEDULE - total) < p_weights[iii])
+		{
+			goto END;
+		}
+		total += p_weights[iii];
+	}
+	if (0u >= total)
+	{
+		goto END;
 	}
+	p_schedule = calloc(total, sizeof(size_t));
+	p_current = calloc(priority_count, sizeof(size_t));
+	if ((NULL == p_schedule) || (NULL == p_current))
+	{
+		goto END;
+	}
+	// Smooth weighted round-robin, spreads each level's turns over the
+	// schedule. Credits are biased by total to stay unsigned.
+	for (size_t iii = 0u; iii < priority_count; iii++)
+	{
+		p_current[iii] = total;
+	}
+	for (size_t iii = 0u; iii < total; iii++)
+	{
+		size_t pick = 0u;
+		for (size_t jjj = 0u; jjj < priority_count; jjj++)
+		{
+			p_current[jjj] += p_weights[jjj];
+			// Ties go to the higher level.
+			if (p_current[jjj] >= p_current[pick])
+			{
+				pick = jjj;
+			}
+		}
+		p_current[pick] -= total;
+		p_schedule[iii] = pick;
+	}
+SWAP:
+	free(p_pqueue->p_schedule);
+	p_pqueue->p_schedule = p_schedule;
+	p_pqueue->schedule_length = total;
+	p_schedule = NULL;
+	result = true;
 END:
+	free(p_schedule);
+	free(p_current);
 	return result;
 }
 
+void si_priority_queue_set_aging(si_priority_queue_t* const p_pqueue,
+	const size_t period)
+{
+	if (NULL == p_pqueue)
+	{
+		goto END;
+	}
+	p_pqueue->aging_period = period;
+END:
+	return;
+}
+
 bool si_priority_queue_enqueue(si_priority_queue_t* const p_pqueue,
 	void* const p_data, const size_t priority)
 {
@@ -288,6 +436,61 @@ END:
 	return result;
 }
 
+size_t si_priority_queue_enqueue_batch(si_priority_queue_t* const p_pqueue,
+	void* const* const pp_data, const size_t count, const size_t priority)
+{
+	size_t result = 0u;
+	if ((NULL == p_pqueue) || (NULL == pp_data) || (0u >= count))
+	{
+		goto END;
+	}
+	if (p_pqueue->queues.array.capacity <= priority)
+	{
+		goto END;
+	}
+	si_queue_t* p_queue = si_parray_at(&(p_pqueue->queues), priority);
+	si_mutex_t* const p_lock = si_parray_at(&(p_pqueue->locks), priority);
+	if (NULL == p_lock)
+	{
+		goto END;
+	}
+	si_mutex_lock(p_lock);
+
+	size_t queue_count = 0u;
+	if (NULL == p_queue)
+	{
+		// Initialize queue
+		p_queue = si_queue_new_3(sizeof(void*), count, p_pqueue->p_settings);
+		si_parray_set(&(p_pqueue->queues), priority, p_queue);
+	}
+	else
+	{
+		queue_count = si_queue_count(p_queue);
+	}
+	// Validate queue was initialized.
+	if (NULL == p_queue)
+	{
+		goto UNLOCK;
+	}
+	for (; result < count; result++)
+	{
+		if (NULL == pp_data[result])
+		{
+			break;
+		}
+		const size_t new_count = si_queue_enqueue(p_queue, &(pp_data[result]));
+		if (new_count <= queue_count)
+		{
+			break;
+		}
+		queue_count = new_count;
+	}
+UNLOCK:;
+	si_mutex_unlock(p_lock);
+END:
+	return result;
+}
+
 /** Doxygen
  * @brief Attempts to dequeue data at priority level in p_pqueue.
  * 
@@ -345,6 +548,34 @@ void* si_priority_queue_dequeue(si_priority_queue_t* const p_pqueue)
 	{
 		goto END;
 	}
+	const size_t aging_period = p_pqueue->aging_period;
+	if ((NULL != p_pqueue->p_schedule) || (0u < aging_period))
+	{
+		// Strict queues skip the shared turn counter.
+		const size_t turn = atomic_fetch_add(&(p_pqueue->turn), 1u);
+		const bool is_aging_turn = (0u < aging_period) &&
+			((aging_period - 1u) == (turn % aging_period));
+		if ((true == is_aging_turn) && (1u < priority_count))
+		{
+			// Levels below the top take turns, bottom first.
+			const size_t cycle = turn / aging_period;
+			(void)si_priority_queue_feed_at(
+				p_pqueue, cycle % (priority_count - 1u), 1u, 1u
+			);
+		}
+		if (NULL != p_pqueue->p_schedule)
+		{
+			const size_t priority = p_pqueue->p_schedule[
+				turn % p_pqueue->schedule_length
+			];
+			p_result = si_priority_queue_dequeue_at(p_pqueue, priority);
+			if (NULL != p_result)
+			{
+				goto END;
+			}
+		}
+	}
+	// Highest non-empty level first.
 	for (size_t iii = (priority_count - 1u); true; iii--)
 	{
 		p_result = si_priority_queue_dequeue_at(p_pqueue, iii);
@@ -442,6 +673,9 @@ void si_priority_queue_free(si_priority_queue_t* const p_pqueue)
 	}
 	si_parray_free(&(p_pqueue->locks));
 	si_parray_free(&(p_pqueue->queues));
+	free(p_pqueue->p_schedule);
+	p_pqueue->p_schedule = NULL;
+	p_pqueue->schedule_length = 0u;
 END:
 	return;
 }
@@ -0,0 +1,594 @@
+// si_task_graph.c
+#include "si_task_graph.h"
+#include "si_thread.h" // si_thread_yield()
+
+#include <stdlib.h> // calloc(), free()
+
+bool si_task_graph_init(si_task_graph_t* const p_graph)
+{
+	bool result = false;
+	if (NULL == p_graph)
+	{
+		goto END;
+	}
+	si_array_init_3(&(p_graph->nodes), sizeof(si_task_graph_node_t), 0u);
+	p_graph->node_count = 0u;
+	si_array_init_3(&(p_graph->edges), sizeof(si_task_graph_edge_t), 0u);
+	p_graph->edge_count = 0u;
+	si_array_init_3(&(p_graph->successors), sizeof(size_t), 0u);
+	p_graph->p_pool = NULL;
+	atomic_init(&(p_graph->remaining_count), 0u);
+	atomic_init(&(p_graph->abandoned_count), 0u);
+	atomic_init(&(p_graph->is_running), false);
+	result = si_future_init(&(p_graph->done));
+END:
+	return result;
+}
+
+si_task_graph_t* si_task_graph_new()
+{
+	si_task_graph_t* p_result = calloc(1u, sizeof(si_task_graph_t));
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	const bool did_init = si_task_graph_init(p_result);
+	if (true != did_init)
+	{
+		free(p_result);
+		p_result = NULL;
+	}
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Makes room for one more element, doubling the array's capacity.
+ *
+ * @param p_array Pointer to the si_array_t to grow.
+ * @param count Number of elements currently used.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool local_si_task_graph_reserve(si_array_t* const p_array,
+	const size_t count)
+{
+	bool result = true;
+	if (count < p_array->capacity)
+	{
+		goto END;
+	}
+	const size_t new_capacity = (0u == count) ? 8u : (count * 2u);
+	result = si_array_resize(p_array, new_capacity);
+END:
+	return result;
+}
+
+size_t si_task_graph_add_3(si_task_graph_t* const p_graph,
+	p_task_f const p_task, void* const p_param)
+{
+	size_t result = SI_TASK_GRAPH_NODE_INVALID;
+	if ((NULL == p_graph) || (NULL == p_task))
+	{
+		goto END;
+	}
+	if (true == atomic_load(&(p_graph->is_running)))
+	{
+		goto END;
+	}
+	if (true != local_si_task_graph_reserve(
+		&(p_graph->nodes), p_graph->node_count))
+	{
+		goto END;
+	}
+	si_task_graph_node_t* const p_node = si_array_at(
+		&(p_graph->nodes), p_graph->node_count
+	);
+	p_node->p_task = p_task;
+	p_node->p_param = p_param;
+	p_node->p_result = NULL;
+	p_node->predecessor_count = 0u;
+	atomic_init(&(p_node->pending_count), 0u);
+	p_node->successor_begin = 0u;
+	p_node->successor_end = 0u;
+	p_node->p_graph = p_graph;
+	atomic_init(&(p_node->p_future), NULL);
+	atomic_init(&(p_node->is_abandoned), false);
+	result = p_graph->node_count;
+	p_graph->node_count++;
+END:
+	return result;
+}
+inline size_t si_task_graph_add(si_task_graph_t* const p_graph,
+	p_task_f const p_task)
+{
+	// Default value of p_param is NULL
+	return si_task_graph_add_3(p_graph, p_task, NULL);
+}
+
+bool si_task_graph_precede(si_task_graph_t* const p_graph,
+	const size_t before, const size_t after)
+{
+	bool result = false;
+	if (NULL == p_graph)
+	{
+		goto END;
+	}
+	if ((before >= p_graph->node_count) || (after >= p_graph->node_count) ||
+		(before == after))
+	{
+		goto END;
+	}
+	if (true == atomic_load(&(p_graph->is_running)))
+	{
+		goto END;
+	}
+	if (true != local_si_task_graph_reserve(
+		&(p_graph->edges), p_graph->edge_count))
+	{
+		goto END;
+	}
+	const si_task_graph_edge_t edge = {.before = before, .after = after};
+	si_array_set(&(p_graph->edges), p_graph->edge_count, &edge);
+	p_graph->edge_count++;
+	result = true;
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Groups successors by node & counts predecessors. (Counting sort)
+ *
+ * @param p_graph Pointer to the task graph struct to prepare.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool local_si_task_graph_build(si_task_graph_t* const p_graph)
+{
+	bool result = false;
+	si_array_free(&(p_graph->successors));
+	si_array_init_3(&(p_graph->successors), sizeof(size_t), p_graph->edge_count);
+	if ((0u < p_graph->edge_count) && (NULL == p_graph->successors.p_data))
+	{
+		goto END;
+	}
+	for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(&(p_graph->nodes), iii);
+		p_node->predecessor_count = 0u;
+		p_node->successor_begin = 0u;
+		p_node->successor_end = 0u;
+	}
+	for (size_t iii = 0u; iii < p_graph->edge_count; iii++)
+	{
+		const si_task_graph_edge_t* const p_edge = si_array_at(
+			&(p_graph->edges), iii
+		);
+		si_task_graph_node_t* const p_before = si_array_at(
+			&(p_graph->nodes), p_edge->before
+		);
+		si_task_graph_node_t* const p_after = si_array_at(
+			&(p_graph->nodes), p_edge->after
+		);
+		p_before->successor_end++;
+		p_after->predecessor_count++;
+	}
+	// Turn successor counts into ranges, end is reused as the fill cursor.
+	size_t offset = 0u;
+	for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(&(p_graph->nodes), iii);
+		const size_t count = p_node->successor_end;
+		p_node->successor_begin = offset;
+		p_node->successor_end = offset;
+		offset += count;
+	}
+	for (size_t iii = 0u; iii < p_graph->edge_count; iii++)
+	{
+		const si_task_graph_edge_t* const p_edge = si_array_at(
+			&(p_graph->edges), iii
+		);
+		si_task_graph_node_t* const p_before = si_array_at(
+			&(p_graph->nodes), p_edge->before
+		);
+		si_array_set(
+			&(p_graph->successors), p_before->successor_end, &(p_edge->after)
+		);
+		p_before->successor_end++;
+	}
+	result = true;
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Orders the nodes so every node follows its predecessors. (Kahn)
+ *
+ * @param p_graph Pointer to the built task graph struct to order.
+ * @param p_order Pointer to uninitialized si_array_t receiving node indexes.
+ *
+ * @return Returns stdbool true on success. Returns false on a cycle.
+ */
+static bool local_si_task_graph_order(si_task_graph_t* const p_graph,
+	si_array_t* const p_order)
+{
+	bool result = false;
+	si_array_init_3(p_order, sizeof(size_t), p_graph->node_count);
+	if ((0u < p_graph->node_count) && (NULL == p_order->p_data))
+	{
+		goto END;
+	}
+	size_t* const p_indexes = p_order->p_data;
+	size_t tail = 0u;
+	for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(&(p_graph->nodes), iii);
+		atomic_store(&(p_node->pending_count), p_node->predecessor_count);
+		if (0u == p_node->predecessor_count)
+		{
+			p_indexes[tail++] = iii;
+		}
+	}
+	for (size_t head = 0u; head < tail; head++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(
+			&(p_graph->nodes), p_indexes[head]
+		);
+		for (size_t jjj = p_node->successor_begin; jjj < p_node->successor_end;
+			jjj++)
+		{
+			const size_t next = *(size_t*)si_array_at(&(p_graph->successors), jjj);
+			si_task_graph_node_t* const p_next = si_array_at(
+				&(p_graph->nodes), next
+			);
+			if (1u == atomic_fetch_sub(&(p_next->pending_count), 1u))
+			{
+				p_indexes[tail++] = next;
+			}
+		}
+	}
+	// Nodes on a cycle never reach zero pending.
+	result = (tail == p_graph->node_count);
+END:
+	return result;
+}
+
+static void* local_si_task_graph_node_task(void* const p_param);
+
+/** Doxygen
+ * @brief Enqueues a node with a future, so a drop by the pool is noticed by
+ *        si_task_graph_wait(). Runs the node inline when it can't enqueue.
+ *        From a work-stealing worker the node lands on its own deque.
+ *
+ * @param p_graph Pointer to the running task graph.
+ * @param p_node Pointer to the node whose predecessors have all finished.
+ *
+ * @return Returns stdbool true when enqueued. Returns false when run inline.
+ */
+static bool local_si_task_graph_submit(si_task_graph_t* const p_graph,
+	si_task_graph_node_t* const p_node)
+{
+	si_future_t* const p_future = si_threadpool_enqueue_future_3(
+		p_graph->p_pool, local_si_task_graph_node_task, p_node
+	);
+	if (NULL == p_future)
+	{
+		(void)local_si_task_graph_node_task(p_node);
+	}
+	else
+	{
+		atomic_store(&(p_node->p_future), p_future);
+	}
+	return (NULL != p_future);
+}
+
+/** Doxygen
+ * @brief Releases the futures the last run left on the nodes.
+ *
+ * @param p_graph Pointer to a task graph that isn't running.
+ */
+static void local_si_task_graph_clear(si_task_graph_t* const p_graph)
+{
+	for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(&(p_graph->nodes), iii);
+		si_future_t* p_future = atomic_exchange(&(p_node->p_future), NULL);
+		si_future_destroy(&p_future);
+		atomic_store(&(p_node->is_abandoned), false);
+	}
+}
+
+/** Doxygen
+ * @brief Task run for a node. Releases successors whose last predecessor
+ *        this was, keeping one to run next on this thread.
+ *
+ * @param p_param Pointer to the si_task_graph_node_t to run.
+ *
+ * @return Returns NULL, each node's result is kept on the node.
+ */
+static void* local_si_task_graph_node_task(void* const p_param)
+{
+	si_task_graph_node_t* p_node = p_param;
+	while (NULL != p_node)
+	{
+		si_task_graph_t* const p_graph = p_node->p_graph;
+		p_node->p_result = p_node->p_task(p_node->p_param);
+		si_task_graph_node_t* p_continue = NULL;
+		for (size_t iii = p_node->successor_begin; iii < p_node->successor_end;
+			iii++)
+		{
+			const size_t next = *(size_t*)si_array_at(&(p_graph->successors), iii);
+			si_task_graph_node_t* const p_next = si_array_at(
+				&(p_graph->nodes), next
+			);
+			if (1u != atomic_fetch_sub(&(p_next->pending_count), 1u))
+			{
+				continue;
+			}
+			if (NULL == p_continue)
+			{
+				p_continue = p_next;
+				continue;
+			}
+			// Stored before this node is counted, so before the run can end.
+			(void)local_si_task_graph_submit(p_graph, p_next);
+		}
+		// The graph may be freed as soon as the last node is counted.
+		if (1u == atomic_fetch_sub(&(p_graph->remaining_count), 1u))
+		{
+			(void)si_future_complete(&(p_graph->done), p_graph);
+		}
+		p_node = p_continue;
+	}
+	return NULL;
+}
+
+bool si_task_graph_run(si_task_graph_t* const p_graph,
+	si_threadpool_t* const p_pool)
+{
+	bool result = false;
+	si_array_t order = {0};
+	if (NULL == p_graph)
+	{
+		goto END;
+	}
+	bool expected = false;
+	if (true != atomic_compare_exchange_strong(
+		&(p_graph->is_running), &expected, true))
+	{
+		goto END;
+	}
+	if ((true != local_si_task_graph_build(p_graph)) ||
+		(true != local_si_task_graph_order(p_graph, &order)))
+	{
+		atomic_store(&(p_graph->is_running), false);
+		goto END;
+	}
+	si_future_free(&(p_graph->done));
+	(void)si_future_init(&(p_graph->done));
+	local_si_task_graph_clear(p_graph);
+	p_graph->p_pool = p_pool;
+	atomic_store(&(p_graph->remaining_count), p_graph->node_count);
+	atomic_store(&(p_graph->abandoned_count), 0u);
+	size_t root_count = 0u;
+	for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(&(p_graph->nodes), iii);
+		p_node->p_result = NULL;
+		atomic_store(&(p_node->pending_count), p_node->predecessor_count);
+		root_count += (0u == p_node->predecessor_count) ? 1u : 0u;
+	}
+	result = true;
+	if (0u >= p_graph->node_count)
+	{
+		(void)si_future_complete(&(p_graph->done), p_graph);
+		goto END;
+	}
+	const bool is_running = (NULL == p_pool) ?
+		false : atomic_load(&(p_pool->is_running));
+	if (true != is_running)
+	{
+		// Run in dependency order on the caller.
+		for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+		{
+			si_task_graph_node_t* const p_node = si_array_at(
+				&(p_graph->nodes), *(size_t*)si_array_at(&order, iii)
+			);
+			p_node->p_result = p_node->p_task(p_node->p_param);
+		}
+		atomic_store(&(p_graph->remaining_count), 0u);
+		(void)si_future_complete(&(p_graph->done), p_graph);
+		goto END;
+	}
+	// Roots lead the topological order, each gets its own future.
+	for (size_t iii = 0u; iii < root_count; iii++)
+	{
+		(void)local_si_task_graph_submit(p_graph, si_array_at(
+			&(p_graph->nodes), *(size_t*)si_array_at(&order, iii)
+		));
+	}
+END:
+	si_array_free(&order);
+	return result;
+}
+
+/** Doxygen
+ * @brief Marks a node & every node after it as never going to run, counting
+ *        them as finished so the run can still end.
+ *
+ * @param p_graph Pointer to the running task graph.
+ * @param index Index of the node whose task the pool dropped.
+ *
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool local_si_task_graph_abandon(si_task_graph_t* const p_graph,
+	const size_t index)
+{
+	bool result = false;
+	si_array_t stack = {0};
+	si_array_init_3(&stack, sizeof(size_t), p_graph->node_count);
+	if (NULL == stack.p_data)
+	{
+		goto END;
+	}
+	size_t count = 0u;
+	size_t abandoned = 0u;
+	si_array_set(&stack, count++, &index);
+	while (0u < count)
+	{
+		const size_t current = *(size_t*)si_array_at(&stack, --count);
+		si_task_graph_node_t* const p_node = si_array_at(
+			&(p_graph->nodes), current
+		);
+		// Each node is pushed once, after its first abandoned predecessor.
+		if (true == atomic_exchange(&(p_node->is_abandoned), true))
+		{
+			continue;
+		}
+		abandoned++;
+		for (size_t iii = p_node->successor_begin; iii < p_node->successor_end;
+			iii++)
+		{
+			const size_t next = *(size_t*)si_array_at(&(p_graph->successors), iii);
+			si_task_graph_node_t* const p_next = si_array_at(
+				&(p_graph->nodes), next
+			);
+			if (true != atomic_load(&(p_next->is_abandoned)))
+			{
+				si_array_set(&stack, count++, &next);
+			}
+		}
+	}
+	atomic_fetch_add(&(p_graph->abandoned_count), abandoned);
+	if (abandoned == atomic_fetch_sub(&(p_graph->remaining_count), abandoned))
+	{
+		(void)si_future_cancel(&(p_graph->done));
+	}
+	result = true;
+END:
+	si_array_free(&stack);
+	return result;
+}
+
+/** Doxygen
+ * @brief Abandons nodes whose task was dropped & finds one still pending.
+ *
+ * @param p_graph Pointer to the running task graph.
+ *
+ * @return Returns a pending node future. Returns NULL when there is none.
+ */
+static si_future_t* local_si_task_graph_reap(si_task_graph_t* const p_graph)
+{
+	si_future_t* p_pending = NULL;
+	for (size_t iii = 0u; iii < p_graph->node_count; iii++)
+	{
+		si_task_graph_node_t* const p_node = si_array_at(&(p_graph->nodes), iii);
+		si_future_t* const p_future = atomic_load(&(p_node->p_future));
+		if (NULL == p_future)
+		{
+			continue;
+		}
+		const si_future_state_t state = si_future_state(p_future);
+		if ((SI_FUTURE_CANCELLED == state) &&
+			(true != atomic_load(&(p_node->is_abandoned))))
+		{
+			(void)local_si_task_graph_abandon(p_graph, iii);
+		}
+		else if ((SI_FUTURE_PENDING == state) && (NULL == p_pending))
+		{
+			p_pending = p_future;
+		}
+	}
+	return p_pending;
+}
+
+bool si_task_graph_wait(si_task_graph_t* const p_graph)
+{
+	bool result = false;
+	if (NULL == p_graph)
+	{
+		goto END;
+	}
+	if (true != atomic_load(&(p_graph->is_running)))
+	{
+		goto END;
+	}
+	// Every unfinished node is queued behind a pending future or comes after
+	// one, so awaiting them one at a time ends with the run.
+	while (true != si_future_is_done(&(p_graph->done)))
+	{
+		si_future_t* const p_pending = local_si_task_graph_reap(p_graph);
+		if (NULL == p_pending)
+		{
+			// A node is between being enqueued & having its future stored.
+			si_thread_yield();
+			continue;
+		}
+		(void)si_threadpool_await_future(p_graph->p_pool, p_pending);
+		if (true != si_future_is_done(p_pending))
+		{
+			// A worker gave up waiting on a pool that's stopping.
+			goto END;
+		}
+	}
+	atomic_store(&(p_graph->is_running), false);
+	result = (0u == atomic_load(&(p_graph->abandoned_count)));
+END:
+	return result;
+}
+
+void* si_task_graph_result(si_task_graph_t* const p_graph, const size_t node)
+{
+	void* p_result = NULL;
+	if (NULL == p_graph)
+	{
+		goto END;
+	}
+	if ((node >= p_graph->node_count) ||
+		(true == atomic_load(&(p_graph->is_running))))
+	{
+		goto END;
+	}
+	const si_task_graph_node_t* const p_node = si_array_at(
+		&(p_graph->nodes), node
+	);
+	p_result = p_node->p_result;
+END:
+	return p_result;
+}
+
+void si_task_graph_free(si_task_graph_t* const p_graph)
+{
+	if (NULL == p_graph)
+	{
+		goto END;
+	}
+	(void)si_task_graph_wait(p_graph);
+	local_si_task_graph_clear(p_graph);
+	si_array_free(&(p_graph->nodes));
+	p_graph->node_count = 0u;
+	si_array_free(&(p_graph->edges));
+	p_graph->edge_count = 0u;
+	si_array_free(&(p_graph->successors));
+	si_future_free(&(p_graph->done));
+	p_graph->p_pool = NULL;
+END:
+	return;
+}
+
+void si_task_graph_destroy(si_task_graph_t** const pp_graph)
+{
+	if (NULL == pp_graph)
+	{
+		goto END;
+	}
+	if (NULL == *pp_graph)
+	{
+		goto END;
+	}
+	si_task_graph_free(*pp_graph);
+	free(*pp_graph);
+	*pp_graph = NULL;
+END:
+	return;
+}
@@ -1,6 +1,9 @@
 // si_thread.c
 #include "si_thread.h"
 
+#include <stdio.h> // fopen(), fgets(), snprintf()
+#include <stdlib.h> // strtoul()
+
 #if defined(__APPLE__)
 // Adds support for Mac OS pthreads timedjoin
 
@@ -112,6 +115,152 @@ END:
 	return count;
 }
 
+#if defined(__linux__)
+/** Doxygen
+ * @brief Parses a sysfs CPU list such as "0-3,8-11" from a file.
+ * 
+ * @param p_path Path of the sysfs file to read.
+ * @param p_cpus Pointer to array receiving up to capacity indexes. (NULL ok)
+ * @param capacity Number of size_t slots in p_cpus.
+ * @param p_highest Optional pointer receiving the highest index listed.
+ * 
+ * @return Returns number of indexes listed. Returns 0u on error.
+ */
+static size_t local_si_cpulist_read(const char* const p_path,
+	size_t* const p_cpus, const size_t capacity, size_t* const p_highest)
+{
+	size_t result = 0u;
+	FILE* const p_file = fopen(p_path, "r");
+	if (NULL == p_file)
+	{
+		goto END;
+	}
+	char buffer[SI_THREAD_CPULIST_MAX] = {0};
+	const char* const p_read = fgets(buffer, sizeof(buffer), p_file);
+	(void)fclose(p_file);
+	if (NULL == p_read)
+	{
+		goto END;
+	}
+	const char* p_next = buffer;
+	while (('0' <= *p_next) && ('9' >= *p_next))
+	{
+		char* p_end = NULL;
+		const size_t first = (size_t)strtoul(p_next, &p_end, 10);
+		size_t last = first;
+		if ('-' == *p_end)
+		{
+			last = (size_t)strtoul(p_end + 1, &p_end, 10);
+		}
+		for (size_t cpu = first; cpu <= last; cpu++)
+		{
+			if ((NULL != p_cpus) && (result < capacity))
+			{
+				p_cpus[result] = cpu;
+			}
+			result++;
+		}
+		if (NULL != p_highest)
+		{
+			*p_highest = last;
+		}
+		p_next = (',' == *p_end) ? (p_end + 1) : p_end;
+	}
+END:
+	return result;
+}
+#endif// __linux__
+
+size_t si_cpu_numa_node_count()
+{
+	size_t count = 1u;
+#if defined(__linux__)
+	size_t highest = 0u;
+	const size_t listed = local_si_cpulist_read(
+		"/sys/devices/system/node/online", NULL, 0u, &highest
+	);
+	if (0u >= listed)
+	{
+		goto END;
+	}
+	count = highest + 1u;
+END:
+#endif// __linux__
+	return count;
+}
+
+size_t si_cpu_numa_node_cpus(const size_t node, size_t* const p_cpus,
+	const size_t capacity)
+{
+	size_t result = 0u;
+	if ((NULL == p_cpus) || (0u >= capacity))
+	{
+		goto END;
+	}
+#if defined(__linux__)
+	char path[64] = {0};
+	(void)snprintf(path, sizeof(path),
+		"/sys/devices/system/node/node%zu/cpulist", node
+	);
+	const size_t listed = local_si_cpulist_read(path, p_cpus, capacity, NULL);
+	if (0u < listed)
+	{
+		result = (listed < capacity) ? listed : capacity;
+		goto END;
+	}
+#endif// __linux__
+	if (0u != node)
+	{
+		goto END;
+	}
+	// No NUMA information, every core belongs to node 0.
+	const size_t core_count = si_cpu_core_count();
+	for (; (result < core_count) && (result < capacity); result++)
+	{
+		p_cpus[result] = result;
+	}
+END:
+	return result;
+}
+
+bool si_thread_pin_cpus(const size_t* const p_cpus, const size_t count)
+{
+	bool result = false;
+	if ((NULL == p_cpus) || (0u >= count))
+	{
+		goto END;
+	}
+#ifdef _WIN32
+	DWORD_PTR mask = 0u;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		if ((sizeof(DWORD_PTR) * 8u) > p_cpus[iii])
+		{
+			mask |= ((DWORD_PTR)1u << p_cpus[iii]);
+		}
+	}
+	result = (0u != mask) &&
+		(0u != SetThreadAffinityMask(GetCurrentThread(), mask));
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		if (CPU_SETSIZE > p_cpus[iii])
+		{
+			CPU_SET(p_cpus[iii], &set);
+		}
+	}
+	result = (SI_PTHREAD_SUCCESS == pthread_setaffinity_np(
+		pthread_self(), sizeof(set), &set
+	));
+#else
+	// Mac OS only offers affinity hints through thread_policy_set().
+#endif// OS Specific implementation(s)
+END:
+	return result;
+}
+
 si_thread_func_return_t si_thread_join(si_thread_t* const p_thread)
 {
 	si_thread_func_return_t result = (si_thread_func_return_t)0;
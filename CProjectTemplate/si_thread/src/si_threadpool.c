@@ -1,5 +1,16 @@
 // si_threadpool.c
 #include "si_threadpool.h"
+#include "si_magazine.h" // si_magazine_calloc(), si_magazine_free()
+#include "si_threadpool_stats.h" // si_threadpool_worker_stats_t
+
+#include <stdint.h> // uint64_t, uintptr_t
+#include <string.h> // memset()
+
+#if SI_FIBER
+#include <fcntl.h> // fcntl(), O_NONBLOCK
+#include <poll.h> // poll(), pollfd
+#include <unistd.h> // close(), pipe(), read(), write()
+#endif//SI_FIBER
 
 // Local scope structure to hold task values in the queue.
 typedef struct local_task_t
@@ -9,30 +20,562 @@ typedef struct local_task_t
 	size_t task_id;
 	void* p_param;
 	p_task_f p_task;
+	// Result slot, the finished descriptor itself is kept in results.
 	void* p_result;
+	// Completed in place of a results entry when set. (Holds a reference)
+	si_future_t* p_future;
+	// Skips the run when cancelled before it starts. (Holds a reference)
+	si_cancel_token_t* p_token;
+	// Periodic firings run for their side effects, results are dropped.
+	bool drops_result;
+	// Monotonic time the task became visible. (Stats & elastic mode only)
+	uint64_t enqueue_ns;
+	// Link while the descriptor sits in a freelist.
+	struct local_task_t* p_next;
 } local_task_t;
 
+// Worker private stack of recycled descriptors. (One per worker thread)
+typedef struct local_task_cache_t
+{
+	local_task_t* p_head;
+	size_t count;
+} local_task_cache_t;
+
+// Life cycle of a worker slot in the pool array.
+typedef enum local_worker_state_t
+{
+	LOCAL_WORKER_FREE = 0,
+	LOCAL_WORKER_RUNNING = 1,
+	// The worker exited on its own & waits to be joined.
+	LOCAL_WORKER_RETIRED = 2,
+} local_worker_state_t;
+
+// Element of the pool array, handed to its worker thread as the parameter.
+typedef struct local_worker_slot_t
+{
+	si_thread_t thread;
+	si_threadpool_t* p_pool;
+	size_t index;
+	volatile _Atomic int state;
+} local_worker_slot_t;
+
+// Task run as a fiber, its resumes are queued as ordinary tasks.
+typedef struct local_fiber_task_t
+{
+	si_fiber_t fiber;
+	si_threadpool_t* p_pool;
+	size_t task_id;
+	size_t priority;
+	p_task_f p_task;
+	void* p_param;
+	void* p_result;
+	// Completed when the fiber returns. (Holds a reference)
+	si_future_t* p_future;
+	// Read by si_threadpool_is_cancelled() while resumed. (Holds a reference)
+	si_cancel_token_t* p_token;
+	// Set by si_task_wait_fd() before suspending, wait_result on wake up.
+	bool is_waiting_fd;
+	int wait_fd;
+	short wait_events;
+	int wait_result;
+	// Monotonic millisecs the wait times out at. (UINT64_MAX = never)
+	uint64_t wait_deadline;
+	// Link while waiting on the I/O thread.
+	struct local_fiber_task_t* p_io_next;
+} local_fiber_task_t;
+
+static void* local_fiber_resume(void* const p_param);
+static void local_fiber_task_abandon(local_fiber_task_t* const p_fiber);
+
+struct local_parallel_for_t;
+static void* local_parallel_for_task(void* const p_param);
+static void local_parallel_for_release(struct local_parallel_for_t* p_for);
+
+// Thread blocked in si_threadpool_await_results(), lives on its stack.
+typedef struct local_results_waiter_t
+{
+	size_t task_id;
+	// Notified once the awaited result is appended or the pool stops.
+	si_event_t ready_event;
+	struct local_results_waiter_t* p_next;
+} local_results_waiter_t;
+
+/** Doxygen
+ * @brief Frees a heap local_task_t, cancelling its future if never run.
+ * 
+ * @param p_param Pointer to local_task_t struct to be freed.
+ */
+static void local_task_free(void* const p_param)
+{
+	local_task_t* const p_local = p_param;
+	if (NULL == p_local)
+	{
+		goto END;
+	}
+	if (NULL != p_local->p_future)
+	{
+		(void)si_future_cancel(p_local->p_future);
+		si_future_destroy(&(p_local->p_future));
+	}
+	si_cancel_token_destroy(&(p_local->p_token));
+	if (local_fiber_resume == p_local->p_task)
+	{
+		// The fiber it would have resumed can never run again.
+		local_fiber_task_abandon(p_local->p_param);
+	}
+	else if (local_parallel_for_task == p_local->p_task)
+	{
+		// A dropped helper still holds a reference on the shared state.
+		local_parallel_for_release(p_local->p_param);
+	}
+	si_magazine_free(p_local);
+END:
+	return;
+}
+
+// Delayed or periodic task waiting in the pool's timer wheel.
+typedef struct local_timer_t
+{
+	p_task_f p_task;
+	void* p_param;
+	size_t priority;
+	// Reserved UID a delayed task's result is stored under.
+	size_t task_id;
+	// Millisecs between firings of a periodic task. (0u fires once)
+	uint32_t period;
+	// Stop handle of a periodic task. (Holds a reference)
+	si_future_t* p_handle;
+} local_timer_t;
+
+/** Doxygen
+ * @brief Frees a heap local_timer_t, cancelling its periodic handle.
+ * 
+ * @param p_param Pointer to local_timer_t struct to be freed.
+ */
+static void local_timer_free(void* const p_param)
+{
+	local_timer_t* const p_timer = p_param;
+	if (NULL == p_timer)
+	{
+		goto END;
+	}
+	if (NULL != p_timer->p_handle)
+	{
+		(void)si_future_cancel(p_timer->p_handle);
+		si_future_destroy(&(p_timer->p_handle));
+	}
+	free(p_timer);
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Gets the monotonic time used for task timestamps.
+ * 
+ * @return Returns nanosecs since an arbitrary fixed point.
+ */
+static uint64_t local_si_threadpool_now_ns(void)
+{
+	struct timespec now = {0};
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+/** Doxygen
+ * @brief Gets the monotonic time used as the timer wheel's tick.
+ * 
+ * @return Returns millisecs since an arbitrary fixed point.
+ */
+static inline uint64_t local_si_threadpool_now_ms(void)
+{
+	return local_si_threadpool_now_ns() / 1000000u;
+}
+
+
+/** Doxygen
+ * @brief Waits for work to be enqueued. Spins briefly, then parks the worker
+ *        on work_available_event until an enqueue or stop wakes it.
+ * @details The spin budget doubles when spinning found work and halves when
+ *          the worker had to park, within SI_THREADPOOL_SPIN_MIN/MAX. Elastic
+ *          workers stay parked for at most the pool's idle_timeout.
+ * 
+ * @param p_pool Pointer to si_threadpool_t the worker belongs to.
+ * @param p_spin_limit Pointer to the calling worker's current spin budget.
+ * @param p_timed_out Pointer set true when the idle timeout ran out.
+ * 
+ * @return Returns stdbool true if the worker parked. Returns false otherwise.
+ */
+static bool si_threadpool_park(si_threadpool_t* const p_pool,
+	size_t* const p_spin_limit, bool* const p_timed_out)
+{
+	bool result = false;
+	*p_timed_out = false;
+	for (size_t iii = 0u; iii < *p_spin_limit; iii++)
+	{
+		const size_t pending = atomic_load(&(p_pool->pending_count));
+		if (0u < pending)
+		{
+			if ((SI_THREADPOOL_SPIN_MAX / 2u) >= *p_spin_limit)
+			{
+				*p_spin_limit *= 2u;
+			}
+			goto END;
+		}
+		const bool is_running = atomic_load(&(p_pool->is_running));
+		if (true != is_running)
+		{
+			goto END;
+		}
+		si_cpu_relax();
+	}
+	if ((SI_THREADPOOL_SPIN_MIN * 2u) <= *p_spin_limit)
+	{
+		*p_spin_limit /= 2u;
+	}
+	// Publish parked before re-checking, enqueue reads it after pending.
+	atomic_fetch_add(&(p_pool->parked_count), 1u);
+	const uint64_t park_ms = local_si_threadpool_now_ms();
+	while (true)
+	{
+		// Keyed before the re-check, so no wake up in between is lost.
+		const uint32_t key = si_event_prepare_wait(
+			&(p_pool->work_available_event)
+		);
+		if ((0u < atomic_load(&(p_pool->pending_count))) ||
+			(true != atomic_load(&(p_pool->is_running))))
+		{
+			si_event_cancel_wait(&(p_pool->work_available_event));
+			break;
+		}
+		if (true != p_pool->is_elastic)
+		{
+			(void)si_event_wait(&(p_pool->work_available_event), key);
+			continue;
+		}
+		const uint64_t idle_ms = local_si_threadpool_now_ms() - park_ms;
+		if (idle_ms >= p_pool->idle_timeout)
+		{
+			si_event_cancel_wait(&(p_pool->work_available_event));
+			*p_timed_out = true;
+			break;
+		}
+		(void)si_event_wait_3(&(p_pool->work_available_event), key,
+			(uint32_t)(p_pool->idle_timeout - idle_ms)
+		);
+	}
+	atomic_fetch_sub(&(p_pool->parked_count), 1u);
+	result = true;
+END:
+	return result;
+}
+
+// Pool & deque index of the worker running on this thread. (NULL otherwise)
+static _Thread_local si_threadpool_t* gp_worker_pool = NULL;
+static _Thread_local size_t g_worker_index = 0u;
+static _Thread_local uint64_t g_steal_seed = 0u;
+static _Thread_local size_t g_worker_node = 0u;
+// Token of the task running on this thread. (NULL otherwise)
+static _Thread_local si_cancel_token_t* gp_task_token = NULL;
+// Fiber task running on this thread. (NULL otherwise)
+static _Thread_local local_fiber_task_t* gp_task_fiber = NULL;
+
+#if SI_THREADPOOL_STATS
+/** Doxygen
+ * @brief Gets the calling worker's own counters.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to find the counters in.
+ * 
+ * @return Returns pointer on success. Returns NULL when not a worker of it.
+ */
+static si_threadpool_worker_stats_t* si_threadpool_local_stats(
+	si_threadpool_t* const p_pool)
+{
+	si_threadpool_worker_stats_t* p_result = NULL;
+	if (p_pool != gp_worker_pool)
+	{
+		goto END;
+	}
+	p_result = si_array_at(&(p_pool->worker_stats), g_worker_index);
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Adds to a counter only the calling worker writes. (No atomic RMW)
+ * 
+ * @param p_counter Pointer to the counter to add to.
+ * @param value Amount to add.
+ */
+static inline void local_si_threadpool_stat_add(
+	volatile _Atomic uint64_t* const p_counter, const uint64_t value)
+{
+	atomic_store_explicit(p_counter,
+		atomic_load_explicit(p_counter, memory_order_relaxed) + value,
+		memory_order_relaxed
+	);
+}
+#endif//SI_THREADPOOL_STATS
+
+/** Doxygen
+ * @brief Works out the NUMA node & CPU set for a worker index.
+ * 
+ * @param affinity Placement policy of the pool.
+ * @param worker_index Index of the worker to place.
+ * @param p_cpus Pointer to array receiving the worker's CPU indexes.
+ * @param p_cpu_count Pointer receiving the number of CPUs. (0u = unpinned)
+ * 
+ * @return Returns the NUMA node index of the worker.
+ */
+static size_t local_si_threadpool_placement(
+	const si_threadpool_affinity_t affinity, const size_t worker_index,
+	size_t* const p_cpus, size_t* const p_cpu_count)
+{
+	size_t node = 0u;
+	*p_cpu_count = 0u;
+	const size_t node_count = si_cpu_numa_node_count();
+	if (SI_THREADPOOL_AFFINITY_NUMA == affinity)
+	{
+		node = worker_index % node_count;
+		*p_cpu_count = si_cpu_numa_node_cpus(
+			node, p_cpus, SI_THREADPOOL_PIN_CPUS_MAX
+		);
+	}
+	else if (SI_THREADPOOL_AFFINITY_CORE == affinity)
+	{
+		// Walk the nodes in order so neighbouring workers share a node.
+		size_t remaining = worker_index % si_cpu_core_count();
+		for (size_t iii = 0u; iii < node_count; iii++)
+		{
+			const size_t count = si_cpu_numa_node_cpus(
+				iii, p_cpus, SI_THREADPOOL_PIN_CPUS_MAX
+			);
+			if (remaining < count)
+			{
+				p_cpus[0] = p_cpus[remaining];
+				*p_cpu_count = 1u;
+				node = iii;
+				break;
+			}
+			remaining -= count;
+		}
+	}
+	return node;
+}
+
+/** Doxygen
+ * @brief Pins a starting worker & sets up the memory it owns from its node.
+ * 
+ * @param p_pool Pointer to si_threadpool_t the worker belongs to.
+ */
+static void si_threadpool_worker_place(si_threadpool_t* const p_pool)
+{
+	if (SI_THREADPOOL_AFFINITY_NONE != p_pool->affinity)
+	{
+		size_t cpus[SI_THREADPOOL_PIN_CPUS_MAX];
+		size_t cpu_count = 0u;
+		g_worker_node = local_si_threadpool_placement(
+			p_pool->affinity, g_worker_index, cpus, &cpu_count
+		);
+		if (0u < cpu_count)
+		{
+			(void)si_thread_pin_cpus(cpus, cpu_count);
+		}
+	}
+	// First touch of the deque buffer happens on the pinned worker. A slot
+	// reused after a retired worker keeps its deque, thieves may be reading it.
+	si_ws_deque_t* const p_deque = si_array_at(
+		&(p_pool->deques), g_worker_index
+	);
+	if ((NULL != p_deque) && (NULL == atomic_load(&(p_deque->p_buffer))))
+	{
+		if (true != si_ws_deque_init(p_deque))
+		{
+			// NOP, without a buffer the worker publishes to the shared queue.
+		}
+	}
+}
+
+/** Doxygen
+ * @brief Gets the calling worker's own descriptor cache.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to find the cache in.
+ * 
+ * @return Returns cache pointer on success. Returns NULL otherwise.
+ */
+static local_task_cache_t* si_threadpool_local_cache(
+	si_threadpool_t* const p_pool)
+{
+	local_task_cache_t* p_result = NULL;
+	if (p_pool != gp_worker_pool)
+	{
+		goto END;
+	}
+	p_result = si_array_at(&(p_pool->task_caches), g_worker_index);
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Gets a zeroed task descriptor, from the worker's cache or the pool's
+ *        shared freelist before falling back to the heap.
+ * @details A worker with an empty cache refills it with up to half of
+ *          SI_THREADPOOL_TASK_CACHE descriptors under a single lock. New
+ *          descriptors come from the calling thread's magazines.
+ * 
+ * @param p_pool Pointer to si_threadpool_t the descriptor is for.
+ * 
+ * @return Returns a descriptor on success. Returns NULL otherwise.
+ */
+static local_task_t* si_threadpool_task_alloc(si_threadpool_t* const p_pool)
+{
+	local_task_t* p_result = NULL;
+	local_task_cache_t* const p_cache = si_threadpool_local_cache(p_pool);
+	if ((NULL == p_cache) || (NULL == p_cache->p_head))
+	{
+		si_mutex_lock(&(p_pool->task_free_lock));
+		const size_t batch = (NULL == p_cache) ?
+			1u : (SI_THREADPOOL_TASK_CACHE / 2u);
+		for (size_t iii = 0u; iii < batch; iii++)
+		{
+			local_task_t* const p_free = p_pool->p_free_tasks;
+			if (NULL == p_free)
+			{
+				break;
+			}
+			p_pool->p_free_tasks = p_free->p_next;
+			p_pool->free_task_count--;
+			if (NULL == p_cache)
+			{
+				p_result = p_free;
+				break;
+			}
+			p_free->p_next = p_cache->p_head;
+			p_cache->p_head = p_free;
+			p_cache->count++;
+		}
+		si_mutex_unlock(&(p_pool->task_free_lock));
+	}
+	if ((NULL != p_cache) && (NULL != p_cache->p_head))
+	{
+		p_result = p_cache->p_head;
+		p_cache->p_head = p_result->p_next;
+		p_cache->count--;
+	}
+	if (NULL == p_result)
+	{
+		p_result = si_magazine_calloc(1u, sizeof(local_task_t));
+		if (NULL == p_result)
+		{
+			goto END;
+		}
+		atomic_fetch_add(&(p_pool->task_alloc_count), 1u);
+	}
+	memset(p_result, 0, sizeof(local_task_t));
+END:
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Recycles a task descriptor, cancelling its future if never run.
+ * @details A worker keeps up to SI_THREADPOOL_TASK_CACHE descriptors to
+ *          itself and hands half of them back to the shared freelist when
+ *          full. The shared freelist holds SI_THREADPOOL_FREE_TASKS_MAX.
+ * 
+ * @param p_pool Pointer to si_threadpool_t the descriptor came from.
+ * @param p_task Pointer to the descriptor to be recycled.
+ */
+static void si_threadpool_task_release(si_threadpool_t* const p_pool,
+	local_task_t* p_task)
+{
+	if (NULL == p_task)
+	{
+		goto END;
+	}
+	if (NULL != p_task->p_future)
+	{
+		(void)si_future_cancel(p_task->p_future);
+		si_future_destroy(&(p_task->p_future));
+	}
+	si_cancel_token_destroy(&(p_task->p_token));
+	local_task_cache_t* const p_cache = si_threadpool_local_cache(p_pool);
+	if ((NULL != p_cache) && (SI_THREADPOOL_TASK_CACHE > p_cache->count))
+	{
+		p_task->p_next = p_cache->p_head;
+		p_cache->p_head = p_task;
+		p_cache->count++;
+		goto END;
+	}
+	p_task->p_next = NULL;
+	si_mutex_lock(&(p_pool->task_free_lock));
+	if (NULL != p_cache)
+	{
+		// Spill half the full cache along with this descriptor.
+		for (size_t iii = 0u; iii < (SI_THREADPOOL_TASK_CACHE / 2u); iii++)
+		{
+			local_task_t* const p_spill = p_cache->p_head;
+			p_cache->p_head = p_spill->p_next;
+			p_cache->count--;
+			p_spill->p_next = p_task;
+			p_task = p_spill;
+		}
+	}
+	while (NULL != p_task)
+	{
+		local_task_t* const p_next = p_task->p_next;
+		if (SI_THREADPOOL_FREE_TASKS_MAX > p_pool->free_task_count)
+		{
+			p_task->p_next = p_pool->p_free_tasks;
+			p_pool->p_free_tasks = p_task;
+			p_pool->free_task_count++;
+		}
+		else
+		{
+			si_magazine_free(p_task);
+		}
+		p_task = p_next;
+	}
+	si_mutex_unlock(&(p_pool->task_free_lock));
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Frees every descriptor of a freelist.
+ * 
+ * @param p_head Pointer to the first descriptor of the list.
+ */
+static void local_task_list_free(local_task_t* p_head)
+{
+	while (NULL != p_head)
+	{
+		local_task_t* const p_next = p_head->p_next;
+		si_magazine_free(p_head);
+		p_head = p_next;
+	}
+}
+
 /** Doxygen
- * @brief Allocates and initializes a new heap local_task_t struct on the heap.
+ * @brief Fills a recycled task descriptor for a new task.
  * 
+ * @param p_pool Pointer to si_threadpool_t the task is for.
  * @param task_id auto-incremented task UID used to reference task results.
  * @param p_task Function reference of format: void* (*p_task_f)(void*);
  * @param p_param Optional parameter pointer passed to function on execution.
  * @param one_shot Optional stdbool flag to allow automatic looping of tasks.
  * @param priority Optional QoS priority level of the task. Used for looping.
  * 
- * @return Returns a heap pointer on success. Returns NULL otherwise.
+ * @return Returns a descriptor pointer on success. Returns NULL otherwise.
  */
-static local_task_t* local_task_new_5(const size_t task_id,
-	const p_task_f p_task, void* const p_param, const bool one_shot,
-	const size_t priority)
+static local_task_t* local_task_new_6(si_threadpool_t* const p_pool,
+	const size_t task_id, const p_task_f p_task, void* const p_param,
+	const bool one_shot, const size_t priority)
 {
 	local_task_t* p_result = NULL;
 	if ((NULL == p_task) || (SI_THREADPOOL_TASK_ID_INVALID == task_id))
 	{
 		goto END;
 	}
-	p_result = calloc(1u, sizeof(local_task_t));
+	p_result = si_threadpool_task_alloc(p_pool);
 	if (NULL == p_result)
 	{
 		goto END;
@@ -43,64 +586,1137 @@ static local_task_t* local_task_new_5(const size_t task_id,
 	p_result->p_param = p_param;
 	p_result->p_task = p_task;
 	p_result->p_result = NULL;
+	p_result->p_future = NULL;
+	p_result->p_token = NULL;
+	p_result->drops_result = false;
+	p_result->p_next = NULL;
 END:
 	return p_result;
 }
-static inline local_task_t* local_task_new_4(const size_t task_id,
-	const p_task_f p_task, void* const p_param, const bool one_shot)
+
+/** Doxygen
+ * @brief Gets the calling worker's own deque in work-stealing mode.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to find the deque in.
+ * 
+ * @return Returns deque pointer on success. Returns NULL otherwise.
+ */
+static si_ws_deque_t* si_threadpool_local_deque(si_threadpool_t* const p_pool)
 {
-	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN(0u)
-	return local_task_new_5(
-		task_id, p_task, p_param, one_shot, SI_THREADPOOL_PRIORITY_MIN
+	si_ws_deque_t* p_result = NULL;
+	if ((true != p_pool->is_work_stealing) || (p_pool != gp_worker_pool))
+	{
+		goto END;
+	}
+	si_ws_deque_t* const p_deque = si_array_at(
+		&(p_pool->deques), g_worker_index
 	);
+	// A deque whose buffer failed to allocate is left empty & unused.
+	if ((NULL == p_deque) || (NULL == atomic_load_explicit(
+		&(p_deque->p_buffer), memory_order_relaxed)))
+	{
+		goto END;
+	}
+	p_result = p_deque;
+END:
+	return p_result;
 }
-static inline local_task_t* local_task_new_3(const size_t task_id,
-	const p_task_f p_task, void* const p_param)
+
+/** Doxygen
+ * @brief Steals a task from the deque of a random peer, trying each once.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to steal within.
+ * 
+ * @return Returns a task on success. Returns NULL otherwise.
+ */
+static local_task_t* si_threadpool_steal(si_threadpool_t* const p_pool)
 {
-	// Default value of one_shot is true.
-	return local_task_new_4(task_id, p_task, p_param, true);
-}
-static inline local_task_t* local_task_new(const size_t task_id,
-	const p_task_f p_task)
+	local_task_t* p_result = NULL;
+	const size_t deque_count = p_pool->deques.capacity;
+	if (0u >= deque_count)
+	{
+		goto END;
+	}
+	// xorshift64, seeded per thread so thieves don't all pick the same peer.
+	if (0u == g_steal_seed)
+	{
+		g_steal_seed = (uint64_t)(uintptr_t)&g_steal_seed | 1u;
+	}
+	g_steal_seed ^= g_steal_seed << 13u;
+	g_steal_seed ^= g_steal_seed >> 7u;
+	g_steal_seed ^= g_steal_seed << 17u;
+	const size_t start = (size_t)(g_steal_seed % deque_count);
+	// Placed workers try peers on their own NUMA node first.
+	const bool is_placed = (p_pool == gp_worker_pool) &&
+		(SI_THREADPOOL_AFFINITY_NONE != p_pool->affinity) &&
+		(deque_count == p_pool->worker_nodes.capacity);
+	const size_t pass_count = (true == is_placed) ? 2u : 1u;
+	for (size_t pass = 0u; pass < pass_count; pass++)
+	{
+		for (size_t iii = 0u; iii < deque_count; iii++)
+		{
+			const size_t index = (start + iii) % deque_count;
+			if ((p_pool == gp_worker_pool) && (index == g_worker_index))
+			{
+				continue;
+			}
+			if (true == is_placed)
+			{
+				const size_t node = *(size_t*)si_array_at(
+					&(p_pool->worker_nodes), index
+				);
+				if ((node == g_worker_node) != (0u == pass))
+				{
+					continue;
+				}
+			}
+			p_result = si_ws_deque_steal(si_array_at(&(p_pool->deques), index));
+			if (NULL != p_result)
+			{
+				goto END;
+			}
+		}
+	}
+END:
+#if SI_THREADPOOL_STATS
+	if (NULL != p_result)
+	{
+		si_threadpool_worker_stats_t* const p_stats = si_threadpool_local_stats(
+			p_pool
+		);
+		if (NULL != p_stats)
+		{
+			local_si_threadpool_stat_add(&(p_stats->steals), 1u);
+		}
+	}
+#endif//SI_THREADPOOL_STATS
+	return p_result;
+}
+
+/** Doxygen
+ * @brief Finds the next task to run: own deque, then the shared priority
+ *        queue, then stealing from peers.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to take a task from.
+ * 
+ * @return Returns a heap task on success. Returns NULL otherwise.
+ */
+static local_task_t* si_threadpool_next_task(si_threadpool_t* const p_pool)
+{
+	local_task_t* p_task = si_ws_deque_take(si_threadpool_local_deque(p_pool));
+	if (NULL == p_task)
+	{
+		p_task = si_priority_queue_dequeue(&(p_pool->queue));
+	}
+	if ((NULL == p_task) && (true == p_pool->is_work_stealing))
+	{
+		p_task = si_threadpool_steal(p_pool);
+	}
+	if (NULL != p_task)
+	{
+		atomic_fetch_sub(&(p_pool->pending_count), 1u);
+	}
+	return p_task;
+}
+
+/** Doxygen
+ * @brief Wakes the threads awaiting a result. Costs a list walk & no system
+ *        call when nobody awaits the UID.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to wake waiters of. (results_lock)
+ * @param task_id UID of the appended result. SI_THREADPOOL_TASK_ID_INVALID
+ *                wakes every waiter.
+ */
+static void local_si_threadpool_wake_waiters(si_threadpool_t* const p_pool,
+	const size_t task_id)
+{
+	local_results_waiter_t* p_waiter = p_pool->p_results_waiters;
+	while (NULL != p_waiter)
+	{
+		if ((SI_THREADPOOL_TASK_ID_INVALID == task_id) ||
+		    (task_id == p_waiter->task_id))
+		{
+			si_event_notify_all(&(p_waiter->ready_event));
+		}
+		p_waiter = p_waiter->p_next;
+	}
+}
+
+/** Doxygen
+ * @brief Runs a task, re-enqueuing looping tasks & storing non-NULL results.
+ * @details Takes ownership of the descriptor. It's kept as the results entry
+ *          when there is one & recycled otherwise.
+ * 
+ * @param p_pool Pointer to si_threadpool_t the task was taken from.
+ * @param p_task Pointer to the task to be run.
+ */
+static void si_threadpool_run_task(si_threadpool_t* const p_pool,
+	local_task_t* p_task)
+{
+	if (NULL == p_task->p_task)
+	{
+		goto RELEASE;
+	}
+	if (true == si_cancel_token_is_cancelled(p_task->p_token))
+	{
+		// Abandoned before it started, the release cancels its future.
+		goto SIGNAL;
+	}
+#if SI_THREADPOOL_STATS
+	si_threadpool_worker_stats_t* const p_stats = si_threadpool_local_stats(
+		p_pool
+	);
+	const uint64_t start_ns = (NULL != p_stats) ?
+		local_si_threadpool_now_ns() : 0u;
+#endif//SI_THREADPOOL_STATS
+	// Saved for tasks run by a worker helping out inside another task.
+	si_cancel_token_t* const p_outer_token = gp_task_token;
+	gp_task_token = p_task->p_token;
+	p_task->p_result = p_task->p_task(p_task->p_param);
+	gp_task_token = p_outer_token;
+	si_cancel_token_destroy(&(p_task->p_token));
+#if SI_THREADPOOL_STATS
+	if (NULL != p_stats)
+	{
+		const uint64_t run_ns = local_si_threadpool_now_ns() - start_ns;
+		const uint64_t wait_ns = (start_ns > p_task->enqueue_ns) ?
+			(start_ns - p_task->enqueue_ns) : 0u;
+		local_si_threadpool_stat_add(&(p_stats->tasks_run), 1u);
+		local_si_threadpool_stat_add(&(p_stats->busy_ns), run_ns);
+		local_si_threadpool_stat_add(&(p_stats->wait_ns), wait_ns);
+		local_si_threadpool_stat_add(
+			&(p_stats->run_buckets[si_threadpool_stats_bucket(run_ns)]), 1u
+		);
+		local_si_threadpool_stat_add(
+			&(p_stats->wait_buckets[si_threadpool_stats_bucket(wait_ns)]), 1u
+		);
+	}
+#endif//SI_THREADPOOL_STATS
+	if (NULL != p_task->p_future)
+	{
+		// Futures skip the shared results list, waking only their waiters.
+		(void)si_future_complete(p_task->p_future, p_task->p_result);
+		si_future_destroy(&(p_task->p_future));
+		goto SIGNAL;
+	}
+	if (true != p_task->one_shot)
+	{
+		// Handles looping task(s)
+		const size_t new_id = si_threadpool_enqueue_5(
+			p_pool, p_task->p_task, p_task->p_param, 0, p_task->priority
+		);
+		if (SI_THREADPOOL_TASK_ID_INVALID == new_id)
+		{
+			// NOP ignore failed loop.
+		}
+	}
+	else
+	{
+		// Parameter free is a delegated responsibility of caller.
+		//free(p_task->p_param);
+	}
+	// Handle Results
+	if ((NULL != p_task->p_result) && (true != p_task->drops_result))
+	{
+		// NULL out function to prevent unintentional re-execution
+		p_task->p_task = NULL;
+		p_task->p_param = NULL;
+		const size_t task_id = p_task->task_id;
+		si_mutex_lock(&(p_pool->results_lock));
+		const size_t append_index = si_parray_append(
+			&(p_pool->results), p_task
+		);
+		if (SIZE_MAX != append_index)
+		{
+			// The descriptor now belongs to results.
+			p_task = NULL;
+			local_si_threadpool_wake_waiters(p_pool, task_id);
+		}
+		si_mutex_unlock(&(p_pool->results_lock));
+	}
+SIGNAL:
+	// Only an atomic add & load unless shutdown is draining the pool.
+	si_event_notify(&(p_pool->task_completed_event));
+RELEASE:
+	si_threadpool_task_release(p_pool, p_task);
+	return;
+}
+
+static si_thread_func_t si_threadpool_worker(void* const p_param);
+
+/** Doxygen
+ * @brief Starts a worker thread in a free or retired slot of the pool.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to add a worker to. (pool_lock held)
+ * @param index Index of the slot the worker takes.
+ * 
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_threadpool_spawn(si_threadpool_t* const p_pool,
+	const size_t index)
+{
+	bool result = false;
+	local_worker_slot_t* const p_slot = si_array_at(&(p_pool->pool), index);
+	if (NULL == p_slot)
+	{
+		goto END;
+	}
+	const int state = atomic_load(&(p_slot->state));
+	if (LOCAL_WORKER_RUNNING == state)
+	{
+		goto END;
+	}
+	if (LOCAL_WORKER_RETIRED == state)
+	{
+		// Reap the previous worker of this slot before reusing it.
+		(void)si_thread_join(&(p_slot->thread));
+	}
+	p_slot->p_pool = p_pool;
+	p_slot->index = index;
+	atomic_store(&(p_slot->state), LOCAL_WORKER_RUNNING);
+	atomic_fetch_add(&(p_pool->live_count), 1u);
+	si_thread_create(
+		&(p_slot->thread), (void* (*)(void*))si_threadpool_worker, (void*)p_slot
+	);
+	result = si_thread_is_valid(p_slot->thread);
+	if (true != result)
+	{
+		atomic_store(&(p_slot->state), LOCAL_WORKER_FREE);
+		atomic_fetch_sub(&(p_pool->live_count), 1u);
+	}
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Adds a worker to an elastic pool below its max_threads.
+ * @details Skipped when pool_lock is busy, as its holder may be stopping the
+ *          pool or growing it already.
+ * 
+ * @param p_pool Pointer to si_threadpool_t to add a worker to.
+ */
+static void si_threadpool_grow(si_threadpool_t* const p_pool)
+{
+	if ((true != p_pool->is_elastic) ||
+		(p_pool->max_threads <= atomic_load(&(p_pool->live_count))))
+	{
+		goto END;
+	}
+	if (true != si_mutex_try_lock(&(p_pool->pool_lock)))
+	{
+		goto END;
+	}
+	if (true == atomic_load(&(p_pool->is_running)))
+	{
+		for (size_t iii = 0u; iii < p_pool->pool.capacity; iii++)
+		{
+			const local_worker_slot_t* const p_slot = si_array_at(
+				&(p_pool->pool), iii
+			);
+			if (LOCAL_WORKER_RUNNING != atomic_load(&(p_slot->state)))
+			{
+				(void)si_threadpool_spawn(p_pool, iii);
+				break;
+			}
+		}
+	}
+	si_mutex_unlock(&(p_pool->pool_lock));
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Lets an idle elastic worker leave while the pool is above min_threads.
+ * @details Its deque is empty since it only parks once it found no work. The
+ *          deque, descriptor cache & counters stay with the slot for reuse.
+ * 
+ * @param p_pool Pointer to si_threadpool_t the calling worker belongs to.
+ * 
+ * @return Returns stdbool true when the worker must exit. False otherwise.
+ */
+static bool si_threadpool_retire(si_threadpool_t* const p_pool)
+{
+	bool result = false;
+	if (0u < atomic_load(&(p_pool->pending_count)))
+	{
+		goto END;
+	}
+	size_t live = atomic_load(&(p_pool->live_count));
+	while (live > p_pool->min_threads)
+	{
+		if (true == atomic_compare_exchange_weak(
+			&(p_pool->live_count), &live, live - 1u))
+		{
+			result = true;
+			break;
+		}
+	}
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Main thread task worker loop.
+ * 
+ * @param p_param Pointer to the local_worker_slot_t this worker runs in.
+ * 
+ * @return Returns the same pointer received.
+ */
+static si_thread_func_t si_threadpool_worker(void* const p_param)
+{
+	si_thread_func_return_t result = (si_thread_func_return_t)0;
+#ifdef SI_PTHREAD
+	result = p_param;
+#endif// SI_PTHREAD
+	if (NULL == p_param)
+	{
+		goto END;
+	}
+	local_worker_slot_t* const p_slot = p_param;
+	si_threadpool_t* const p_pool = p_slot->p_pool;
+	gp_worker_pool = p_pool;
+	g_worker_index = p_slot->index;
+	g_worker_node = 0u;
+	si_threadpool_worker_place(p_pool);
+	local_task_t* p_task = NULL;
+	size_t spin_limit = SI_THREADPOOL_SPIN_MIN;
+	const uint64_t spawn_wait_ns = (uint64_t)p_pool->spawn_wait * 1000000u;
+#if SI_THREADPOOL_STATS
+	si_threadpool_worker_stats_t* const p_stats = si_threadpool_local_stats(
+		p_pool
+	);
+#endif//SI_THREADPOOL_STATS
+	bool is_running = atomic_load(&(p_pool->is_running));
+	while (true == is_running)
+	{
+		p_task = si_threadpool_next_task(p_pool);
+		if (NULL == p_task)
+		{
+			bool is_timed_out = false;
+#if SI_THREADPOOL_STATS
+			const uint64_t idle_ns = local_si_threadpool_now_ns();
+			const bool did_park = si_threadpool_park(
+				p_pool, &spin_limit, &is_timed_out
+			);
+			if (NULL != p_stats)
+			{
+				local_si_threadpool_stat_add(&(p_stats->parks), did_park);
+				local_si_threadpool_stat_add(&(p_stats->idle_ns),
+					local_si_threadpool_now_ns() - idle_ns
+				);
+			}
+#else
+			(void)si_threadpool_park(p_pool, &spin_limit, &is_timed_out);
+#endif//SI_THREADPOOL_STATS
+			if ((true == is_timed_out) && (true == si_threadpool_retire(p_pool)))
+			{
+				// The slot may be reused as soon as it reads retired.
+				gp_worker_pool = NULL;
+				atomic_store(&(p_slot->state), LOCAL_WORKER_RETIRED);
+				goto END;
+			}
+			goto CONTINUE;
+		}
+		if ((true == p_pool->is_elastic) &&
+			(0u == atomic_load(&(p_pool->parked_count))))
+		{
+			// Waited too long with nobody idle, the pool is short of workers.
+			const uint64_t now_ns = local_si_threadpool_now_ns();
+			if ((now_ns > p_task->enqueue_ns) &&
+				(spawn_wait_ns < (now_ns - p_task->enqueue_ns)))
+			{
+				si_threadpool_grow(p_pool);
+			}
+		}
+		si_threadpool_run_task(p_pool, p_task);
+		p_task = NULL;
+CONTINUE:
+		// Stops are cooperative, running tasks poll the pool's cancel token.
+		is_running = atomic_load(&(p_pool->is_running));
+	}
+END:
+	return result;
+}
+
+
+void si_threadpool_init_3(si_threadpool_t* const p_pool,
+	const size_t priority_count, const bool is_work_stealing)
+{
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	atomic_store(&(p_pool->is_running), 0);
+	si_cancel_token_init(&(p_pool->cancel_token));
+	p_pool->is_work_stealing = is_work_stealing;
+	si_array_init_3(&(p_pool->deques), sizeof(si_ws_deque_t), 0u);
+	p_pool->affinity = SI_THREADPOOL_AFFINITY_NONE;
+	si_array_init_3(&(p_pool->worker_nodes), sizeof(size_t), 0u);
+	
+	const int pool_init_results = si_mutex_init(
+		&(p_pool->pool_lock)
+	);
+	if (SI_PTHREAD_SUCCESS != pool_init_results)
+	{
+		goto END;
+	}
+	const int results_init_results = si_mutex_init(
+		&(p_pool->results_lock)
+	);
+	if (SI_PTHREAD_SUCCESS != results_init_results)
+	{
+		goto END;
+	}
+	const int free_init_results = si_mutex_init(
+		&(p_pool->task_free_lock)
+	);
+	if (SI_PTHREAD_SUCCESS != free_init_results)
+	{
+		goto END;
+	}
+	const int timer_init_results = si_mutex_init(
+		&(p_pool->timer_lock)
+	);
+	if (SI_PTHREAD_SUCCESS != timer_init_results)
+	{
+		goto END;
+	}
+	si_cond_init(&(p_pool->timer_signal));
+	si_timer_wheel_init_2(&(p_pool->timers), local_si_threadpool_now_ms());
+	p_pool->timers.p_free_value = local_timer_free;
+	p_pool->has_timer_thread = false;
+	p_pool->is_elastic = false;
+	p_pool->min_threads = 0u;
+	p_pool->max_threads = 0u;
+	p_pool->spawn_wait = SI_THREADPOOL_DEFAULT_SPAWN_WAIT;
+	p_pool->idle_timeout = SI_THREADPOOL_DEFAULT_IDLE_TIMEOUT;
+	atomic_store(&(p_pool->live_count), 0u);
+	atomic_store(&(p_pool->blocked_count), 0u);
+	const int fiber_init_results = si_mutex_init(&(p_pool->fiber_lock));
+	if (SI_PTHREAD_SUCCESS != fiber_init_results)
+	{
+		goto END;
+	}
+	(void)si_fiber_stack_pool_init(&(p_pool->fiber_stacks));
+	p_pool->p_io_waiters = NULL;
+	p_pool->io_wake_fds[0] = -1;
+	p_pool->io_wake_fds[1] = -1;
+	p_pool->has_io_thread = false;
+#if SI_THREADPOOL_STATS
+	si_array_init_3(
+		&(p_pool->worker_stats), sizeof(si_threadpool_worker_stats_t), 0u
+	);
+#endif//SI_THREADPOOL_STATS
+	p_pool->p_free_tasks = NULL;
+	p_pool->free_task_count = 0u;
+	atomic_store(&(p_pool->task_alloc_count), 0u);
+	si_array_init_3(&(p_pool->task_caches), sizeof(local_task_cache_t), 0u);
+
+	atomic_store(&(p_pool->task_counter), 0u);
+	atomic_store(&(p_pool->pending_count), 0u);
+	atomic_store(&(p_pool->parked_count), 0u);
+	p_pool->p_results_waiters = NULL;
+	si_event_init(&(p_pool->task_completed_event));
+	si_event_init(&(p_pool->work_available_event));
+	si_array_init_3(&(p_pool->pool), sizeof(local_worker_slot_t), 0u);
+	si_parray_init_2(&(p_pool->results), 0u);
+	// Popped entries are recycled, so only si_threadpool_free() frees them.
+	p_pool->results.p_free_value = NULL;
+
+	si_priority_queue_init(&(p_pool->queue), priority_count);
+	p_pool->queue.p_free_value = local_task_free;
+END:
+	return;
+}
+inline void si_threadpool_init_2(si_threadpool_t* const p_pool,
+	const size_t priority_count)
+{
+	// Default value of is_work_stealing is false
+	si_threadpool_init_3(p_pool, priority_count, false);
+}
+inline void si_threadpool_init(si_threadpool_t* const p_pool)
+{
+	// Default value of priority_count(1u)
+	si_threadpool_init_2(p_pool, SI_THREADPOOL_DEFAULT_PRIORITY_COUNT);
+}
+
+si_threadpool_t* si_threadpool_new_2(const size_t priority_count,
+	const bool is_work_stealing)
+{
+	void* p_results = NULL;
+	if (0u >= priority_count)
+	{
+		goto END;
+	}
+	p_results = calloc(1u, sizeof(si_threadpool_t));
+	if (NULL == p_results)
+	{
+		goto END;
+	}
+	si_threadpool_init_3(p_results, priority_count, is_work_stealing);
+END:
+	return p_results;
+}
+inline si_threadpool_t* si_threadpool_new_1(const size_t priority_count)
+{
+	// Default value of is_work_stealing is false
+	return si_threadpool_new_2(priority_count, false);
+}
+inline si_threadpool_t* si_threadpool_new()
+{
+	// Default value of priority_count(1u)
+	return si_threadpool_new_1(SI_THREADPOOL_DEFAULT_PRIORITY_COUNT);
+}
+
+bool si_threadpool_has_result(si_threadpool_t* const p_pool,
+	const size_t task_id)
+{
+	bool result = false;
+	if ((NULL == p_pool) || (SI_THREADPOOL_TASK_ID_INVALID == task_id))
+	{
+		goto END;
+	}
+
+	si_mutex_lock(&(p_pool->results_lock));
+
+	const size_t results_capacity = p_pool->results.array.capacity;
+	for (size_t iii = 0u; iii < results_capacity; iii++)
+	{
+		local_task_t* p_task = si_parray_at(&(p_pool->results), iii);
+		if (NULL == p_task)
+		{
+			continue;
+		}
+		if (p_task->task_id == task_id)
+		{
+			result = true;
+			break;
+		}
+	}
+
+	si_mutex_unlock(&(p_pool->results_lock));
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Local function to generate(increment) next UID for a new task.
+ * 
+ * @param p_pool Pointer to the si_threadpool_t struct to generate for.
+ * 
+ * @return Returns size_t on success. SI_THREADPOOL_TASK_ID_INVALID otherwise.
+ */
+static size_t si_threadpool_next_task_id(si_threadpool_t* const p_pool)
+{
+	size_t result = SI_THREADPOOL_TASK_ID_INVALID;
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	result = atomic_fetch_add(&(p_pool->task_counter), 1u);
+	if (SI_THREADPOOL_TASK_ID_INVALID == result)
+	{
+		result = 0u;
+	}
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Wakes up to count parked workers. (No system call if none parked)
+ * 
+ * @param p_pool Pointer to the thread pool struct to wake workers of.
+ * @param count Number of tasks just made available.
+ */
+static void si_threadpool_wake(si_threadpool_t* const p_pool,
+	const size_t count)
+{
+	const size_t parked = atomic_load(&(p_pool->parked_count));
+	if (0u >= parked)
+	{
+		goto END;
+	}
+	if (count >= parked)
+	{
+		si_event_notify_all(&(p_pool->work_available_event));
+	}
+	else
+	{
+		// Fewer than parked, so it fits.
+		si_event_notify_2(&(p_pool->work_available_event), (uint32_t)count);
+	}
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Adds a worker to an elastic pool when every live worker is blocked,
+ *        as nobody would pick up newly published work otherwise.
+ * 
+ * @param p_pool Pointer to the thread pool struct work was published to.
+ */
+static void si_threadpool_compensate(si_threadpool_t* const p_pool)
+{
+	if ((true == p_pool->is_elastic) &&
+		(0u == atomic_load(&(p_pool->parked_count))) &&
+		(atomic_load(&(p_pool->live_count)) <=
+			atomic_load(&(p_pool->blocked_count))))
+	{
+		si_threadpool_grow(p_pool);
+	}
+}
+
+/** Doxygen
+ * @brief Makes a filled task descriptor visible to the workers.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_local Pointer to the descriptor. (Still the caller's on failure)
+ * 
+ * @return Returns stdbool true on success. Returns false otherwise.
+ */
+static bool si_threadpool_publish(si_threadpool_t* const p_pool,
+	local_task_t* const p_local)
+{
+	if ((SI_THREADPOOL_STATS) || (true == p_pool->is_elastic))
+	{
+		p_local->enqueue_ns = local_si_threadpool_now_ns();
+	}
+	// Count the task before it's visible so a worker never sees it uncounted.
+	atomic_fetch_add(&(p_pool->pending_count), 1u);
+	// Tasks spawned by a work-stealing worker stay on its own deque. Looping
+	// tasks don't, the LIFO end would run them ahead of every other task.
+	bool result = false;
+	if (true == p_local->one_shot)
+	{
+		result = si_ws_deque_push(si_threadpool_local_deque(p_pool), p_local);
+	}
+	if (true != result)
+	{
+		// Enqueue new local task struct by priority level.
+		result = si_priority_queue_enqueue(
+			&(p_pool->queue), p_local, p_local->priority
+		);
+	}
+	if (true != result)
+	{
+		atomic_fetch_sub(&(p_pool->pending_count), 1u);
+		goto END;
+	}
+	// Only pay for the lock & wake-up when a worker is actually parked.
+	si_threadpool_wake(p_pool, 1u);
+	si_threadpool_compensate(p_pool);
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Enqueues a new task, optionally completing a future with its result.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed.
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param one_shot Flag determines if automatically restarted.
+ * @param priority QoS size_t priority level of the task.
+ * @param p_future Optional future the task takes a reference to. (NULL ok)
+ * @param p_token Optional token the task takes a reference to. (NULL ok)
+ * 
+ * @return Returns task UID on success. Otherwise SI_THREADPOOL_TASK_ID_INVALID
+ */
+static size_t local_si_threadpool_enqueue(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const bool one_shot,
+	const size_t priority, si_future_t* const p_future,
+	si_cancel_token_t* const p_token)
+{
+	size_t result = SI_THREADPOOL_TASK_ID_INVALID;
+	if ((NULL == p_pool) || (NULL == p_task))
+	{
+		goto END;
+	}
+	const size_t priority_count = si_priority_queue_priority_count(
+		&(p_pool->queue)
+	);
+	if (priority >= priority_count)
+	{
+		goto END;
+	}
+	// Get next task from threadpool UID
+	const size_t task_id = si_threadpool_next_task_id(p_pool);
+	if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+	{
+		goto END;
+	}
+	// Generate new local task struct to hold the required task information.
+	local_task_t* p_local = local_task_new_6(
+		p_pool, task_id, p_task, p_parameter, one_shot, priority
+	);
+	if (NULL == p_local)
+	{
+		goto END;
+	}
+	p_local->p_future = si_future_retain(p_future);
+	p_local->p_token = si_cancel_token_retain(p_token);
+	const bool did_enqueue = si_threadpool_publish(p_pool, p_local);
+	if (true != did_enqueue)
+	{
+		// Drops the future's task reference without cancelling it.
+		si_future_destroy(&(p_local->p_future));
+		si_threadpool_task_release(p_pool, p_local);
+		p_local = NULL;
+		goto END;
+	}
+	result = task_id;
+END:
+	return result;
+}
+
+size_t si_threadpool_enqueue_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const bool one_shot,
+	const size_t priority)
+{
+	return local_si_threadpool_enqueue(
+		p_pool, p_task, p_parameter, one_shot, priority, NULL, NULL
+	);
+}
+inline size_t si_threadpool_enqueue_4(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const bool one_shot)
+{
+	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
+	return si_threadpool_enqueue_5(
+		p_pool, p_task, p_parameter, one_shot, SI_THREADPOOL_PRIORITY_MIN
+	);
+}
+inline size_t si_threadpool_enqueue_3(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter)
+{
+	// Default value of one_shot is true.
+	return si_threadpool_enqueue_4(
+		p_pool, p_task, p_parameter, true
+	);
+}
+inline size_t si_threadpool_enqueue(si_threadpool_t* const p_pool,
+	p_task_f const p_task)
+{
+	// Default value of p_parameter is NULL
+	return si_threadpool_enqueue_3(p_pool, p_task, NULL);
+}
+
+/** Doxygen
+ * @brief Enqueues one-shot tasks sharing a function, reserving their UIDs,
+ *        taking the queue lock & waking workers once per chunk.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add tasks to.
+ * @param p_task Function every task executes.
+ * @param pp_parameters Array of one parameter per task. (NULL to share one)
+ * @param p_parameter Parameter of every task when pp_parameters is NULL.
+ * @param count Number of tasks to enqueue.
+ * @param p_task_ids Optional array receiving count task UIDs. (NULL ok)
+ * @param priority QoS size_t priority level of the tasks.
+ * 
+ * @return Returns number of leading tasks enqueued.
+ */
+static size_t local_si_threadpool_enqueue_batch(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	void* const p_parameter, const size_t count, size_t* const p_task_ids,
+	const size_t priority)
+{
+	size_t result = 0u;
+	if ((NULL == p_pool) || (NULL == p_task) || (0u >= count))
+	{
+		goto END;
+	}
+	const size_t priority_count = si_priority_queue_priority_count(
+		&(p_pool->queue)
+	);
+	if (priority >= priority_count)
+	{
+		goto END;
+	}
+	const size_t first_id = atomic_fetch_add(&(p_pool->task_counter), count);
+	si_ws_deque_t* const p_deque = si_threadpool_local_deque(p_pool);
+	local_task_t* p_chunk[SI_THREADPOOL_BATCH_CHUNK] = {0};
+	while (result < count)
+	{
+		const size_t remaining = count - result;
+		const size_t chunk_count = (SI_THREADPOOL_BATCH_CHUNK < remaining) ?
+			SI_THREADPOOL_BATCH_CHUNK : remaining;
+		size_t built = 0u;
+		for (; built < chunk_count; built++)
+		{
+			size_t task_id = first_id + result + built;
+			if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+			{
+				task_id = 0u;
+			}
+			void* const p_param = (NULL == pp_parameters) ?
+				p_parameter : pp_parameters[result + built];
+			p_chunk[built] = local_task_new_6(
+				p_pool, task_id, p_task, p_param, true, priority
+			);
+			if (NULL == p_chunk[built])
+			{
+				break;
+			}
+			if (NULL != p_task_ids)
+			{
+				p_task_ids[result + built] = task_id;
+			}
+		}
+		if ((SI_THREADPOOL_STATS) || (true == p_pool->is_elastic))
+		{
+			const uint64_t enqueue_ns = local_si_threadpool_now_ns();
+			for (size_t iii = 0u; iii < built; iii++)
+			{
+				p_chunk[iii]->enqueue_ns = enqueue_ns;
+			}
+		}
+		atomic_fetch_add(&(p_pool->pending_count), built);
+		size_t published = 0u;
+		if (NULL != p_deque)
+		{
+			// Tasks spawned by a work-stealing worker stay on its own deque.
+			while ((published < built) &&
+				(true == si_ws_deque_push(p_deque, p_chunk[published])))
+			{
+				published++;
+			}
+		}
+		published += si_priority_queue_enqueue_batch(
+			&(p_pool->queue), (void* const*)&(p_chunk[published]),
+			built - published, priority
+		);
+		for (size_t iii = published; iii < built; iii++)
+		{
+			atomic_fetch_sub(&(p_pool->pending_count), 1u);
+			si_threadpool_task_release(p_pool, p_chunk[iii]);
+			p_chunk[iii] = NULL;
+		}
+		si_threadpool_wake(p_pool, published);
+		si_threadpool_compensate(p_pool);
+		result += published;
+		if (published < chunk_count)
+		{
+			break;
+		}
+	}
+END:
+	return result;
+}
+
+size_t si_threadpool_enqueue_batch_6(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	const size_t count, size_t* const p_task_ids, const size_t priority)
+{
+	size_t result = 0u;
+	if (NULL == pp_parameters)
+	{
+		goto END;
+	}
+	result = local_si_threadpool_enqueue_batch(
+		p_pool, p_task, pp_parameters, NULL, count, p_task_ids, priority
+	);
+END:
+	return result;
+}
+inline size_t si_threadpool_enqueue_batch_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	const size_t count, size_t* const p_task_ids)
+{
+	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
+	return si_threadpool_enqueue_batch_6(p_pool, p_task, pp_parameters,
+		count, p_task_ids, SI_THREADPOOL_PRIORITY_MIN
+	);
+}
+inline size_t si_threadpool_enqueue_batch(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const* const pp_parameters,
+	const size_t count)
+{
+	// Default value of p_task_ids is NULL
+	return si_threadpool_enqueue_batch_5(
+		p_pool, p_task, pp_parameters, count, NULL
+	);
+}
+
+si_future_t* si_threadpool_enqueue_future_4(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const size_t priority)
+{
+	si_future_t* p_result = NULL;
+	if ((NULL == p_pool) || (NULL == p_task))
+	{
+		goto END;
+	}
+	p_result = si_future_new();
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	const size_t task_id = local_si_threadpool_enqueue(
+		p_pool, p_task, p_parameter, true, priority, p_result, NULL
+	);
+	if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+	{
+		si_future_destroy(&p_result);
+	}
+END:
+	return p_result;
+}
+inline si_future_t* si_threadpool_enqueue_future_3(
+	si_threadpool_t* const p_pool, p_task_f const p_task,
+	void* const p_parameter)
+{
+	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
+	return si_threadpool_enqueue_future_4(
+		p_pool, p_task, p_parameter, SI_THREADPOOL_PRIORITY_MIN
+	);
+}
+inline si_future_t* si_threadpool_enqueue_future(si_threadpool_t* const p_pool,
+	p_task_f const p_task)
+{
+	// Default value of p_parameter is NULL
+	return si_threadpool_enqueue_future_3(p_pool, p_task, NULL);
+}
+
+si_future_t* si_threadpool_enqueue_cancellable_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter,
+	si_cancel_token_t* const p_token, const size_t priority)
+{
+	si_future_t* p_result = NULL;
+	if ((NULL == p_pool) || (NULL == p_task) || (NULL == p_token))
+	{
+		goto END;
+	}
+	p_result = si_future_new();
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	const size_t task_id = local_si_threadpool_enqueue(
+		p_pool, p_task, p_parameter, true, priority, p_result, p_token
+	);
+	if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+	{
+		si_future_destroy(&p_result);
+	}
+END:
+	return p_result;
+}
+inline si_future_t* si_threadpool_enqueue_cancellable(
+	si_threadpool_t* const p_pool, p_task_f const p_task,
+	void* const p_parameter, si_cancel_token_t* const p_token)
+{
+	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
+	return si_threadpool_enqueue_cancellable_5(
+		p_pool, p_task, p_parameter, p_token, SI_THREADPOOL_PRIORITY_MIN
+	);
+}
+
+bool si_threadpool_is_cancelled(si_threadpool_t* const p_pool)
+{
+	bool result = false;
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	result = si_cancel_token_is_cancelled(&(p_pool->cancel_token));
+	if ((true != result) && (p_pool == gp_worker_pool))
+	{
+		result = si_cancel_token_is_cancelled(gp_task_token);
+	}
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Drops a fiber task that will never be resumed, cancelling its
+ *        future. Its stack is recycled without being unwound.
+ * 
+ * @param p_fiber Pointer to the heap fiber task to be freed.
+ */
+static void local_fiber_task_abandon(local_fiber_task_t* const p_fiber)
 {
-	// Default value of p_param is NULL.
-	return local_task_new_3(task_id, p_task, NULL);
+	if (NULL == p_fiber)
+	{
+		goto END;
+	}
+	si_fiber_free(&(p_fiber->fiber));
+	if (NULL != p_fiber->p_future)
+	{
+		(void)si_future_cancel(p_fiber->p_future);
+		si_future_destroy(&(p_fiber->p_future));
+	}
+	si_cancel_token_destroy(&(p_fiber->p_token));
+	free(p_fiber);
+END:
+	return;
 }
 
 /** Doxygen
- * @brief Returns a heap clone of a local_task_t struct.
+ * @brief Queues the next resume of a fiber task at its priority.
+ * @details Always uses the shared queue, a worker's own deque is LIFO and
+ *          would resume a yielding fiber before anything else.
  * 
- * @param p_local Pointer to local_task_t struct to be cloned.
+ * @param p_fiber Pointer to the suspended or new fiber task.
  * 
- * @return Returns heap pointer on success. Returns NULL otherwise.
+ * @return Returns stdbool true on success. Returns false otherwise.
  */
-static local_task_t* local_task_clone(local_task_t* p_local)
+static bool local_fiber_task_queue(local_fiber_task_t* const p_fiber)
 {
-	local_task_t* p_result = NULL;
-	if (NULL == p_local)
+	si_threadpool_t* const p_pool = p_fiber->p_pool;
+	local_task_t* const p_local = local_task_new_6(p_pool, p_fiber->task_id,
+		local_fiber_resume, p_fiber, true, p_fiber->priority
+	);
+	bool result = (NULL != p_local);
+	if (true != result)
 	{
 		goto END;
 	}
-	if ((NULL == p_local->p_task) ||
-	    (SI_THREADPOOL_TASK_ID_INVALID == p_local->task_id))
+	if ((SI_THREADPOOL_STATS) || (true == p_pool->is_elastic))
+	{
+		p_local->enqueue_ns = local_si_threadpool_now_ns();
+	}
+	atomic_fetch_add(&(p_pool->pending_count), 1u);
+	result = si_priority_queue_enqueue(
+		&(p_pool->queue), p_local, p_local->priority
+	);
+	if (true != result)
 	{
+		atomic_fetch_sub(&(p_pool->pending_count), 1u);
+		si_threadpool_task_release(p_pool, p_local);
 		goto END;
 	}
-	p_result = calloc(1u, sizeof(local_task_t));
-	memcpy(p_result, p_local, sizeof(local_task_t));
+	si_threadpool_wake(p_pool, 1u);
+	si_threadpool_compensate(p_pool);
 END:
-	return p_result;
+	return result;
 }
 
+#if SI_FIBER
+/** Doxygen
+ * @brief Wakes the I/O thread so it picks up new waiters or a stop.
+ * 
+ * @param p_pool Pointer to the thread pool struct owning the I/O thread.
+ */
+static void si_threadpool_io_wake(si_threadpool_t* const p_pool)
+{
+	if (0 > p_pool->io_wake_fds[1])
+	{
+		goto END;
+	}
+	const char byte = 0;
+	// A full pipe already has a wake up pending.
+	(void)write(p_pool->io_wake_fds[1], &byte, 1u);
+END:
+	return;
+}
 
 /** Doxygen
- * @brief Main thread task worker loop.
+ * @brief I/O thread loop, polls the descriptors fibers wait on & queues the
+ *        fibers that are ready, timed out or cancelled.
  * 
- * @param p_param Pointer to si_threadpool_t that started this worker thread.
+ * @param p_param Pointer to si_threadpool_t that started this thread.
  * 
  * @return Returns the same pointer received.
  */
-static si_thread_func_t si_threadpool_worker(void* const p_param)
+static si_thread_func_t si_threadpool_io_worker(void* const p_param)
 {
 	si_thread_func_return_t result = (si_thread_func_return_t)0;
 #ifdef SI_PTHREAD
@@ -111,230 +1727,477 @@ static si_thread_func_t si_threadpool_worker(void* const p_param)
 		goto END;
 	}
 	si_threadpool_t* const p_pool = p_param;
-	local_task_t* p_task = NULL;
-	bool is_running = atomic_load(&(p_pool->is_running));
-	while (true == is_running)
+	// Waiters taken over from the pool, in the same order as p_fds[1..].
+	local_fiber_task_t* p_waiting = NULL;
+	struct pollfd* p_fds = NULL;
+	size_t fds_capacity = 0u;
+	while (true == atomic_load(&(p_pool->is_running)))
 	{
-		p_task = si_priority_queue_dequeue(&(p_pool->queue));
-		if (NULL == p_task)
+		si_mutex_lock(&(p_pool->fiber_lock));
+		while (NULL != p_pool->p_io_waiters)
 		{
-			sleep(1);
-			goto CONTINUE;
+			local_fiber_task_t* const p_new = p_pool->p_io_waiters;
+			p_pool->p_io_waiters = p_new->p_io_next;
+			p_new->p_io_next = p_waiting;
+			p_waiting = p_new;
 		}
-		if (NULL == p_task->p_task)
+		si_mutex_unlock(&(p_pool->fiber_lock));
+		size_t count = 1u;
+		for (local_fiber_task_t* p_node = p_waiting; NULL != p_node;
+			p_node = p_node->p_io_next)
 		{
-			goto CONTINUE;
+			count++;
 		}
-		p_task->p_result = p_task->p_task(p_task->p_param);
-		if (true != p_task->one_shot)
+		if (count > fds_capacity)
 		{
-			// Handles looping task(s)
-			const size_t new_id = si_threadpool_enqueue_5(
-				p_pool, p_task->p_task, p_task->p_param, 0, p_task->priority
+			struct pollfd* const p_grown = realloc(
+				p_fds, count * sizeof(struct pollfd)
 			);
-			if (SI_THREADPOOL_TASK_ID_INVALID == new_id)
+			if (NULL == p_grown)
 			{
-				// NOP ignore failed loop.
+				break;
 			}
+			p_fds = p_grown;
+			fds_capacity = count;
 		}
-		else
+		p_fds[0].fd = p_pool->io_wake_fds[0];
+		p_fds[0].events = POLLIN;
+		p_fds[0].revents = 0;
+		uint64_t wake_at = UINT64_MAX;
+		size_t index = 1u;
+		for (local_fiber_task_t* p_node = p_waiting; NULL != p_node;
+			p_node = p_node->p_io_next)
+		{
+			p_fds[index].fd = p_node->wait_fd;
+			p_fds[index].events = p_node->wait_events;
+			p_fds[index].revents = 0;
+			index++;
+			if (p_node->wait_deadline < wake_at)
+			{
+				wake_at = p_node->wait_deadline;
+			}
+			if (NULL != p_node->p_token)
+			{
+				// Nothing signals a token, so it's checked periodically.
+				const uint64_t check_at = local_si_threadpool_now_ms() +
+					SI_THREADPOOL_IO_CANCEL_POLL;
+				wake_at = (check_at < wake_at) ? check_at : wake_at;
+			}
+		}
+		int timeout = -1;
+		if (UINT64_MAX != wake_at)
 		{
-			// Parameter free is a delegated responsibility of caller.
-			//free(p_task->p_param);
+			const uint64_t now = local_si_threadpool_now_ms();
+			const uint64_t delay = (wake_at > now) ? (wake_at - now) : 0u;
+			timeout = (INT32_MAX > delay) ? (int)delay : INT32_MAX;
 		}
-		// Handle Results
-		if (NULL != p_task->p_result)
+		(void)poll(p_fds, (nfds_t)count, timeout);
+		if (0 != p_fds[0].revents)
 		{
-			local_task_t* p_results = local_task_clone(p_task);
-			if (NULL == p_results)
+			char drain[64];
+			while (0 < read(p_pool->io_wake_fds[0], drain, sizeof(drain)))
 			{
-				goto CONTINUE;
+				// Drains pending wake ups.
 			}
-			// NULL out function to prevent unintentional re-execution
-			p_results->p_task = NULL;
-			p_results->p_param = NULL;
-			si_mutex_lock(&(p_pool->results_lock));
-			const size_t append_index = si_parray_append(
-				&(p_pool->results), p_results
-			);
-			if (SIZE_MAX == append_index)
+		}
+		// Ready fibers are queued, the rest keep their order for next time.
+		const uint64_t now = local_si_threadpool_now_ms();
+		local_fiber_task_t** pp_link = &p_waiting;
+		index = 1u;
+		while (NULL != *pp_link)
+		{
+			local_fiber_task_t* const p_node = *pp_link;
+			const short revents = p_fds[index].revents;
+			index++;
+			if (0 != revents)
 			{
-				// Append failed.
-				free(p_results);
-				goto CONTINUE;
+				p_node->wait_result = (int)revents;
+			}
+			else if (p_node->wait_deadline <= now)
+			{
+				p_node->wait_result = 0;
+			}
+			else if ((true == si_cancel_token_is_cancelled(p_node->p_token)) ||
+				(true == si_cancel_token_is_cancelled(&(p_pool->cancel_token))))
+			{
+				p_node->wait_result = -1;
 			}
 			else
 			{
-				si_cond_signal(&(p_pool->results_appended_signal));
+				pp_link = &(p_node->p_io_next);
+				continue;
+			}
+			*pp_link = p_node->p_io_next;
+			p_node->p_io_next = NULL;
+			if (true != local_fiber_task_queue(p_node))
+			{
+				local_fiber_task_abandon(p_node);
 			}
-			si_mutex_unlock(&(p_pool->results_lock));
-		}
-		si_cond_signal(&(p_pool->task_completed_signal));
-CONTINUE:
-		// Free and test for cancel/running
-		if (NULL != p_task)
-		{
-			free(p_task);
-			p_task = NULL;
 		}
-		is_running = atomic_load(&(p_pool->is_running));
+	}
+	// Waiters left over resume polling when the pool is restarted.
+	si_mutex_lock(&(p_pool->fiber_lock));
+	while (NULL != p_waiting)
+	{
+		local_fiber_task_t* const p_node = p_waiting;
+		p_waiting = p_node->p_io_next;
+		p_node->p_io_next = p_pool->p_io_waiters;
+		p_pool->p_io_waiters = p_node;
+	}
+	si_mutex_unlock(&(p_pool->fiber_lock));
+	free(p_fds);
+END:
+	return result;
+}
 
-#ifdef SI_PTHREAD
-		int cancel_result = pthread_setcancelstate(
-			PTHREAD_CANCEL_ENABLE, NULL
-		);
-		if (0 != cancel_result)
+/** Doxygen
+ * @brief Starts the I/O thread of a running pool if not yet started.
+ * 
+ * @param p_pool Pointer to the thread pool struct. (fiber_lock held)
+ */
+static void si_threadpool_io_start(si_threadpool_t* const p_pool)
+{
+	if ((true == p_pool->has_io_thread) ||
+		(true != atomic_load(&(p_pool->is_running))))
+	{
+		goto END;
+	}
+	if (0 > p_pool->io_wake_fds[0])
+	{
+		if (SI_PTHREAD_SUCCESS != pipe(p_pool->io_wake_fds))
 		{
-			// Failed to enable the cancellation state(s).
+			p_pool->io_wake_fds[0] = -1;
+			p_pool->io_wake_fds[1] = -1;
 			goto END;
 		}
-		pthread_testcancel();
-		cancel_result = pthread_setcancelstate(
-			PTHREAD_CANCEL_DISABLE, NULL
-		);
-		if (0 != cancel_result)
+		for (size_t iii = 0u; iii < 2u; iii++)
 		{
-			// Failed to disable the cancellation state(s).
-			goto END;
+			const int flags = fcntl(p_pool->io_wake_fds[iii], F_GETFL);
+			(void)fcntl(p_pool->io_wake_fds[iii], F_SETFL, flags | O_NONBLOCK);
 		}
-#endif// SI_PTHREAD
 	}
+	si_thread_create(&(p_pool->io_thread),
+		(void* (*)(void*))si_threadpool_io_worker, (void*)p_pool
+	);
+	p_pool->has_io_thread = si_thread_is_valid(p_pool->io_thread);
 END:
-	return result;
+	return;
+}
+#endif//SI_FIBER
+
+/** Doxygen
+ * @brief Pool task resuming a fiber until it next suspends, then queueing
+ *        it again or handing it to the I/O thread.
+ * 
+ * @param p_param Pointer to the local_fiber_task_t to be resumed.
+ * 
+ * @return Returns NULL, the fiber's result goes to its future.
+ */
+static void* local_fiber_resume(void* const p_param)
+{
+	local_fiber_task_t* const p_fiber = p_param;
+	si_threadpool_t* const p_pool = p_fiber->p_pool;
+	if ((SI_FIBER_STATE_READY == p_fiber->fiber.state) &&
+		(true == si_cancel_token_is_cancelled(p_fiber->p_token)))
+	{
+		// Abandoned before it started.
+		local_fiber_task_abandon(p_fiber);
+		goto END;
+	}
+	local_fiber_task_t* const p_outer_fiber = gp_task_fiber;
+	si_cancel_token_t* const p_outer_token = gp_task_token;
+	gp_task_fiber = p_fiber;
+	gp_task_token = p_fiber->p_token;
+	const bool is_suspended = si_fiber_resume(&(p_fiber->fiber));
+	gp_task_fiber = p_outer_fiber;
+	gp_task_token = p_outer_token;
+	if (true != is_suspended)
+	{
+		(void)si_future_complete(p_fiber->p_future, p_fiber->p_result);
+		si_future_destroy(&(p_fiber->p_future));
+		local_fiber_task_abandon(p_fiber);
+		goto END;
+	}
+#if SI_FIBER
+	if (true == p_fiber->is_waiting_fd)
+	{
+		si_mutex_lock(&(p_pool->fiber_lock));
+		p_fiber->p_io_next = p_pool->p_io_waiters;
+		p_pool->p_io_waiters = p_fiber;
+		si_threadpool_io_start(p_pool);
+		si_mutex_unlock(&(p_pool->fiber_lock));
+		si_threadpool_io_wake(p_pool);
+		goto END;
+	}
+#endif//SI_FIBER
+	if (true != local_fiber_task_queue(p_fiber))
+	{
+		local_fiber_task_abandon(p_fiber);
+	}
+END:
+	return NULL;
 }
 
+/** Doxygen
+ * @brief Body of every fiber task's fiber, runs the task for its result.
+ * 
+ * @param p_arg Pointer to the local_fiber_task_t being run.
+ */
+static void local_fiber_entry(void* p_arg)
+{
+	local_fiber_task_t* const p_fiber = p_arg;
+	p_fiber->p_result = p_fiber->p_task(p_fiber->p_param);
+}
 
-void si_threadpool_init_2(si_threadpool_t* const p_pool,
-	const size_t priority_count)
+si_future_t* si_threadpool_enqueue_fiber_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter,
+	si_cancel_token_t* const p_token, const size_t priority)
 {
-	if (NULL == p_pool)
+	si_future_t* p_result = NULL;
+	if ((NULL == p_pool) || (NULL == p_task) || (0 == SI_FIBER))
 	{
 		goto END;
 	}
-	atomic_store(&(p_pool->is_running), 0);
-	
-	const int task_counter_results = si_mutex_init(
-		&(p_pool->task_counter_lock)
+	const size_t priority_count = si_priority_queue_priority_count(
+		&(p_pool->queue)
 	);
-	if (SI_PTHREAD_SUCCESS != task_counter_results)
+	if (priority >= priority_count)
 	{
 		goto END;
 	}
-	const int pool_init_results = si_mutex_init(
-		&(p_pool->pool_lock)
-	);
-	if (SI_PTHREAD_SUCCESS != pool_init_results)
+	local_fiber_task_t* p_fiber = calloc(1u, sizeof(local_fiber_task_t));
+	if (NULL == p_fiber)
 	{
 		goto END;
 	}
-	const int results_init_results = si_mutex_init(
-		&(p_pool->results_lock)
+	p_fiber->p_pool = p_pool;
+	p_fiber->task_id = si_threadpool_next_task_id(p_pool);
+	p_fiber->priority = priority;
+	p_fiber->p_task = p_task;
+	p_fiber->p_param = p_parameter;
+	p_fiber->wait_fd = -1;
+	const bool did_init = si_fiber_init(&(p_fiber->fiber),
+		&(p_pool->fiber_stacks), local_fiber_entry, p_fiber
 	);
-	if (SI_PTHREAD_SUCCESS != results_init_results)
+	p_result = si_future_new();
+	if ((true != did_init) || (NULL == p_result))
 	{
+		si_future_destroy(&p_result);
+		local_fiber_task_abandon(p_fiber);
 		goto END;
 	}
-
-	atomic_store(&(p_pool->task_counter), 0u);
-	si_cond_init(&(p_pool->results_appended_signal));
-	si_cond_init(&(p_pool->task_completed_signal));
-	si_array_init_3(&(p_pool->pool), sizeof(si_thread_t), 0u);
-	si_parray_init_2(&(p_pool->results), 0u);
-	p_pool->results.p_free_value = free;
-
-	si_priority_queue_init(&(p_pool->queue), priority_count);
-	p_pool->queue.p_free_value = free;
+	p_fiber->p_future = si_future_retain(p_result);
+	p_fiber->p_token = si_cancel_token_retain(p_token);
+	if (true != local_fiber_task_queue(p_fiber))
+	{
+		local_fiber_task_abandon(p_fiber);
+		si_future_destroy(&p_result);
+	}
 END:
-	return;
+	return p_result;
 }
-inline void si_threadpool_init(si_threadpool_t* const p_pool)
+inline si_future_t* si_threadpool_enqueue_fiber(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter)
 {
-	// Default value of priority_count(1u)
-	si_threadpool_init_2(p_pool, SI_THREADPOOL_DEFAULT_PRIORITY_COUNT);
+	// Default value of p_token is NULL
+	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
+	return si_threadpool_enqueue_fiber_5(
+		p_pool, p_task, p_parameter, NULL, SI_THREADPOOL_PRIORITY_MIN
+	);
 }
 
-si_threadpool_t* si_threadpool_new_1(const size_t priority_count)
+bool si_task_yield(void)
 {
-	void* p_results = NULL;
-	if (0u >= priority_count)
+	bool result = false;
+	local_fiber_task_t* const p_fiber = gp_task_fiber;
+	if (NULL == p_fiber)
 	{
+		// Plain tasks & threads can only hand their core over.
+		si_thread_yield();
 		goto END;
 	}
-	p_results = calloc(1u, sizeof(si_threadpool_t));
-	if (NULL == p_results)
+	p_fiber->is_waiting_fd = false;
+	si_fiber_yield(&(p_fiber->fiber));
+	// May resume on another worker, thread-locals are not read from here on.
+	result = true;
+END:
+	return result;
+}
+
+int si_task_wait_fd_3(const int fd, const short events, const int timeout)
+{
+	int result = -1;
+#if SI_FIBER
+	if (0 > fd)
+	{
+		goto END;
+	}
+	local_fiber_task_t* const p_fiber = gp_task_fiber;
+	if (NULL == p_fiber)
 	{
+		// Blocks the thread, elastic pools compensate for their workers.
+		si_threadpool_t* const p_pool = gp_worker_pool;
+		struct pollfd poll_fd = {0};
+		poll_fd.fd = fd;
+		poll_fd.events = events;
+		si_threadpool_blocking_begin(p_pool);
+		const int poll_result = poll(&poll_fd, 1u, timeout);
+		si_threadpool_blocking_end(p_pool);
+		result = (0 < poll_result) ? (int)poll_fd.revents : poll_result;
 		goto END;
 	}
-	si_threadpool_init_2(p_results, priority_count);
+	p_fiber->wait_fd = fd;
+	p_fiber->wait_events = events;
+	p_fiber->wait_result = -1;
+	p_fiber->wait_deadline = (0 > timeout) ? UINT64_MAX :
+		(local_si_threadpool_now_ms() + (uint64_t)timeout);
+	p_fiber->is_waiting_fd = true;
+	si_fiber_yield(&(p_fiber->fiber));
+	// May resume on another worker, thread-locals are not read from here on.
+	p_fiber->is_waiting_fd = false;
+	result = p_fiber->wait_result;
 END:
-	return p_results;
+#else
+	(void)fd;
+	(void)events;
+	(void)timeout;
+#endif//SI_FIBER
+	return result;
 }
-inline si_threadpool_t* si_threadpool_new()
+inline int si_task_wait_fd(const int fd, const short events)
 {
-	// Default value of priority_count(1u)
-	return si_threadpool_new_1(SI_THREADPOOL_DEFAULT_PRIORITY_COUNT);
+	// Default value of timeout is -1(no limit)
+	return si_task_wait_fd_3(fd, events, -1);
 }
 
-bool si_threadpool_has_result(si_threadpool_t* const p_pool,
-	const size_t task_id)
+/** Doxygen
+ * @brief Timer wheel expire function, enqueues a run of the timer's task.
+ * 
+ * @param p_data Pointer to the expired local_timer_t.
+ * @param p_deadline Pointer to the deadline, moved on for periodic timers.
+ * @param p_context Pointer to the si_threadpool_t owning the timer.
+ * 
+ * @return Returns stdbool true to re-arm a periodic timer. False otherwise.
+ */
+static bool local_si_threadpool_timer_fire(void* p_data,
+	uint64_t* p_deadline, void* p_context)
 {
 	bool result = false;
-	if ((NULL == p_pool) || (SI_THREADPOOL_TASK_ID_INVALID == task_id))
+	si_threadpool_t* const p_pool = p_context;
+	local_timer_t* const p_timer = p_data;
+	if ((NULL != p_timer->p_handle) &&
+		(true == si_future_is_done(p_timer->p_handle)))
 	{
-		goto END;
+		// Stopped by its owner.
+		goto DROP;
 	}
-
-	si_mutex_lock(&(p_pool->results_lock));
-
-	const size_t results_capacity = p_pool->results.array.capacity;
-	for (size_t iii = 0u; iii < results_capacity; iii++)
+	local_task_t* const p_local = local_task_new_6(p_pool, p_timer->task_id,
+		p_timer->p_task, p_timer->p_param, true, p_timer->priority
+	);
+	if (NULL != p_local)
 	{
-		local_task_t* p_task = si_parray_at(&(p_pool->results), iii);
-		if (NULL == p_task)
-		{
-			continue;
-		}
-		if (p_task->task_id == task_id)
+		p_local->drops_result = (0u < p_timer->period);
+		if (true != si_threadpool_publish(p_pool, p_local))
 		{
-			result = true;
-			break;
+			si_threadpool_task_release(p_pool, p_local);
 		}
 	}
-
-	si_mutex_unlock(&(p_pool->results_lock));
+	if (0u >= p_timer->period)
+	{
+		goto DROP;
+	}
+	*p_deadline += p_timer->period;
+	const uint64_t now = local_si_threadpool_now_ms();
+	if (*p_deadline <= now)
+	{
+		// Fell behind (stopped pool), skip the missed firings.
+		*p_deadline = now + p_timer->period;
+	}
+	result = true;
+	goto END;
+DROP:
+	local_timer_free(p_timer);
 END:
 	return result;
 }
 
 /** Doxygen
- * @brief Local function to generate(increment) next UID for a new task.
+ * @brief Timer thread loop, sleeps until the earliest deadline of the wheel.
  * 
- * @param p_pool Pointer to the si_threadpool_t struct to generate for.
+ * @param p_param Pointer to si_threadpool_t that started this thread.
  * 
- * @return Returns size_t on success. SI_THREADPOOL_TASK_ID_INVALID otherwise.
+ * @return Returns the same pointer received.
  */
-static size_t si_threadpool_next_task_id(si_threadpool_t* const p_pool)
+static si_thread_func_t si_threadpool_timer_worker(void* const p_param)
 {
-	size_t result = SI_THREADPOOL_TASK_ID_INVALID;
-	if (NULL == p_pool)
+	si_thread_func_return_t result = (si_thread_func_return_t)0;
+#ifdef SI_PTHREAD
+	result = p_param;
+#endif// SI_PTHREAD
+	if (NULL == p_param)
 	{
 		goto END;
 	}
-	si_mutex_t* const p_lock = &(p_pool->task_counter_lock);
-	si_mutex_lock(p_lock);
-	result = atomic_fetch_add(&(p_pool->task_counter), 1u);
-	si_mutex_unlock(p_lock);
-	if (SI_THREADPOOL_TASK_ID_INVALID == result)
+	si_threadpool_t* const p_pool = p_param;
+	si_mutex_lock(&(p_pool->timer_lock));
+	while (true == atomic_load(&(p_pool->is_running)))
 	{
-		result = 0u;
+		const uint64_t now = local_si_threadpool_now_ms();
+		(void)si_timer_wheel_advance(
+			&(p_pool->timers), now, local_si_threadpool_timer_fire, p_pool
+		);
+		const uint64_t next = si_timer_wheel_next(&(p_pool->timers));
+		if (SI_TIMER_WHEEL_NEVER == next)
+		{
+			si_cond_wait(&(p_pool->timer_signal), &(p_pool->timer_lock));
+			continue;
+		}
+		const uint64_t delay = (next > now) ? (next - now) : 0u;
+		(void)si_cond_timedwait(&(p_pool->timer_signal), &(p_pool->timer_lock),
+			(UINT32_MAX > delay) ? (uint32_t)delay : UINT32_MAX
+		);
 	}
+	si_mutex_unlock(&(p_pool->timer_lock));
 END:
 	return result;
 }
 
-size_t si_threadpool_enqueue_5(si_threadpool_t* const p_pool,
-	p_task_f const p_task, void* const p_parameter, const bool one_shot,
-	const size_t priority)
+/** Doxygen
+ * @brief Starts the timer thread of a running pool if not yet started.
+ * 
+ * @param p_pool Pointer to the thread pool struct. (timer_lock held)
+ */
+static void si_threadpool_timer_start(si_threadpool_t* const p_pool)
+{
+	if ((true == p_pool->has_timer_thread) ||
+		(true != atomic_load(&(p_pool->is_running))))
+	{
+		goto END;
+	}
+	si_thread_create(&(p_pool->timer_thread),
+		(void* (*)(void*))si_threadpool_timer_worker, (void*)p_pool
+	);
+	p_pool->has_timer_thread = si_thread_is_valid(p_pool->timer_thread);
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Files a delayed or periodic task into the pool's timer wheel.
+ * 
+ * @param p_pool Pointer to the thread pool struct to add task to.
+ * @param p_task Function of the task to be executed.
+ * @param p_parameter Pointer parameter to pass to the task function on run.
+ * @param delay Millisecs from now until the first firing.
+ * @param period Millisecs between firings. (0u fires once)
+ * @param priority QoS size_t priority level of the task.
+ * @param p_handle Stop handle of a periodic task, retained. (NULL ok)
+ * 
+ * @return Returns task UID on success. Otherwise SI_THREADPOOL_TASK_ID_INVALID
+ */
+static size_t local_si_threadpool_schedule(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t delay,
+	const uint32_t period, const size_t priority, si_future_t* const p_handle)
 {
 	size_t result = SI_THREADPOOL_TASK_ID_INVALID;
 	if ((NULL == p_pool) || (NULL == p_task))
@@ -348,52 +2211,94 @@ size_t si_threadpool_enqueue_5(si_threadpool_t* const p_pool,
 	{
 		goto END;
 	}
-	// Get next task from threadpool UID
-	const size_t task_id = si_threadpool_next_task_id(p_pool);
-	if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+	local_timer_t* p_timer = calloc(1u, sizeof(local_timer_t));
+	if (NULL == p_timer)
 	{
 		goto END;
 	}
-	// Generate new local task struct to hold the required task information.
-	local_task_t* p_local = local_task_new_4(
-		task_id, p_task, p_parameter, one_shot
+	p_timer->p_task = p_task;
+	p_timer->p_param = p_parameter;
+	p_timer->priority = priority;
+	p_timer->task_id = si_threadpool_next_task_id(p_pool);
+	p_timer->period = period;
+	p_timer->p_handle = si_future_retain(p_handle);
+	const uint64_t deadline = local_si_threadpool_now_ms() + delay;
+	si_mutex_lock(&(p_pool->timer_lock));
+	// Only an earlier deadline than the one slept towards needs a wake-up.
+	const uint64_t next = si_timer_wheel_next(&(p_pool->timers));
+	const bool did_add = si_timer_wheel_add(
+		&(p_pool->timers), deadline, p_timer
 	);
-	// Enqueue new local task struct by priority level.
-	const bool did_enqueue = si_priority_queue_enqueue(
-		&(p_pool->queue), p_local, priority
+	if (true == did_add)
+	{
+		result = p_timer->task_id;
+		if (deadline < next)
+		{
+			si_cond_signal(&(p_pool->timer_signal));
+		}
+		si_threadpool_timer_start(p_pool);
+	}
+	si_mutex_unlock(&(p_pool->timer_lock));
+	if (true != did_add)
+	{
+		// Drops the handle's reference without cancelling it.
+		si_future_destroy(&(p_timer->p_handle));
+		free(p_timer);
+		p_timer = NULL;
+	}
+END:
+	return result;
+}
+
+size_t si_threadpool_enqueue_after_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t delay,
+	const size_t priority)
+{
+	return local_si_threadpool_schedule(
+		p_pool, p_task, p_parameter, delay, 0u, priority, NULL
 	);
-	if (true != did_enqueue)
+}
+inline size_t si_threadpool_enqueue_after(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t delay)
+{
+	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
+	return si_threadpool_enqueue_after_5(
+		p_pool, p_task, p_parameter, delay, SI_THREADPOOL_PRIORITY_MIN
+	);
+}
+
+si_future_t* si_threadpool_enqueue_every_5(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t period,
+	const size_t priority)
+{
+	si_future_t* p_result = NULL;
+	if ((NULL == p_pool) || (NULL == p_task) || (0u >= period))
 	{
-		free(p_local);
-		p_local = NULL;
 		goto END;
 	}
-	result = task_id;
+	p_result = si_future_new();
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	const size_t task_id = local_si_threadpool_schedule(
+		p_pool, p_task, p_parameter, period, period, priority, p_result
+	);
+	if (SI_THREADPOOL_TASK_ID_INVALID == task_id)
+	{
+		si_future_destroy(&p_result);
+	}
 END:
-	return result;
+	return p_result;
 }
-inline size_t si_threadpool_enqueue_4(si_threadpool_t* const p_pool,
-	p_task_f const p_task, void* const p_parameter, const bool one_shot)
+inline si_future_t* si_threadpool_enqueue_every(si_threadpool_t* const p_pool,
+	p_task_f const p_task, void* const p_parameter, const uint32_t period)
 {
 	// Default value of priority is SI_THREADPOOL_PRIORITY_MIN (0u)
-	return si_threadpool_enqueue_5(
-		p_pool, p_task, p_parameter, one_shot, SI_THREADPOOL_PRIORITY_MIN
-	);
-}
-inline size_t si_threadpool_enqueue_3(si_threadpool_t* const p_pool,
-	p_task_f const p_task, void* const p_parameter)
-{
-	// Default value of one_shot is true.
-	return si_threadpool_enqueue_4(
-		p_pool, p_task, p_parameter, true
+	return si_threadpool_enqueue_every_5(
+		p_pool, p_task, p_parameter, period, SI_THREADPOOL_PRIORITY_MIN
 	);
 }
-inline size_t si_threadpool_enqueue(si_threadpool_t* const p_pool,
-	p_task_f const p_task)
-{
-	// Default value of p_parameter is NULL
-	return si_threadpool_enqueue_3(p_pool, p_task, NULL);
-}
 
 /** Doxygen
  * @brief Version of pop_results that doesn't lock for use of an await signal.
@@ -425,6 +2330,7 @@ static void* local_si_threadpool_pop_results(si_threadpool_t* const p_pool,
 		{
 			p_result = p_task->p_result;
 			si_parray_remove_at(&(p_pool->results), iii);
+			si_threadpool_task_release(p_pool, p_task);
 			break;
 		}
 	}
@@ -447,33 +2353,303 @@ END:
 	return p_result;
 }
 
+/** Doxygen
+ * @brief Runs one other task for a worker that is waiting on a result, or
+ *        backs off briefly when there is nothing to run.
+ * 
+ * @param p_pool Pointer to the thread pool struct the calling worker is in.
+ * @param p_idle_spins Pointer to the caller's count of idle rounds.
+ */
+static void si_threadpool_help_once(si_threadpool_t* const p_pool,
+	size_t* const p_idle_spins)
+{
+	local_task_t* p_task = si_threadpool_next_task(p_pool);
+	if (NULL != p_task)
+	{
+		si_threadpool_run_task(p_pool, p_task);
+		p_task = NULL;
+		*p_idle_spins = 0u;
+	}
+	else if (SI_THREADPOOL_SPIN_MIN > *p_idle_spins)
+	{
+		// The awaited task is running elsewhere.
+		si_cpu_relax();
+		(*p_idle_spins)++;
+	}
+	else
+	{
+		si_thread_yield();
+	}
+}
+
+/** Doxygen
+ * @brief Await used by the pool's own workers. Runs other tasks until the
+ *        result is ready instead of blocking a worker the result may need.
+ * 
+ * @param p_pool Pointer to the thread pool struct the calling worker is in.
+ * @param task_id UID of size_t to id the results to be waited on.
+ * 
+ * @return Returns result pointer on Success. Returns NULL otherwise.
+ */
+static void* si_threadpool_help_await(si_threadpool_t* const p_pool,
+	const size_t task_id)
+{
+	void* p_results = NULL;
+	size_t idle_spins = 0u;
+	while (NULL == p_results)
+	{
+		const bool is_running = atomic_load(&(p_pool->is_running));
+		if (true != is_running)
+		{
+			break;
+		}
+		si_mutex_lock(&(p_pool->results_lock));
+		p_results = local_si_threadpool_pop_results(p_pool, task_id);
+		si_mutex_unlock(&(p_pool->results_lock));
+		if (NULL != p_results)
+		{
+			break;
+		}
+		si_threadpool_help_once(p_pool, &idle_spins);
+	}
+	return p_results;
+}
+
 void* si_threadpool_await_results(si_threadpool_t* const p_pool,
 	const size_t task_id)
 {
+	void* p_results = NULL;
 	if((NULL == p_pool) || (SI_THREADPOOL_TASK_ID_INVALID == task_id))
 	{
 		goto END;
 	}
-	void* p_results = NULL;
+	if (p_pool == gp_worker_pool)
+	{
+		p_results = si_threadpool_help_await(p_pool, task_id);
+		goto END;
+	}
+	local_results_waiter_t waiter = {0};
+	waiter.task_id = task_id;
+	si_event_init(&(waiter.ready_event));
+	si_mutex_lock(&(p_pool->results_lock));
+	waiter.p_next = p_pool->p_results_waiters;
+	p_pool->p_results_waiters = &waiter;
 	while (NULL == p_results)
 	{
+		// Read under results_lock, stop wakes waiters after clearing it.
 		const bool is_running = atomic_load(&(p_pool->is_running));
 		if (true != is_running)
 		{
 			break;
 		}
-		si_mutex_lock(&(p_pool->results_lock));
 		p_results = local_si_threadpool_pop_results(p_pool, task_id);
 		if (NULL == p_results)
 		{
-			si_cond_wait(&(p_pool->results_appended_signal), &(p_pool->results_lock));
+			const uint32_t key = si_event_prepare_wait(&(waiter.ready_event));
+			si_mutex_unlock(&(p_pool->results_lock));
+			(void)si_event_wait(&(waiter.ready_event), key);
+			si_mutex_lock(&(p_pool->results_lock));
+		}
+	}
+	local_results_waiter_t** pp_link = &(p_pool->p_results_waiters);
+	while (&waiter != *pp_link)
+	{
+		pp_link = &((*pp_link)->p_next);
+	}
+	*pp_link = waiter.p_next;
+	si_mutex_unlock(&(p_pool->results_lock));
+END:
+	return p_results;
+}
+
+void* si_threadpool_await_future(si_threadpool_t* const p_pool,
+	si_future_t* const p_future)
+{
+	void* p_results = NULL;
+	if ((NULL == p_pool) || (NULL == p_future))
+	{
+		goto END;
+	}
+	if (p_pool == gp_worker_pool)
+	{
+		size_t idle_spins = 0u;
+		bool is_done = si_future_is_done(p_future);
+		while (true != is_done)
+		{
+			const bool is_running = atomic_load(&(p_pool->is_running));
+			if (true != is_running)
+			{
+				break;
+			}
+			si_threadpool_help_once(p_pool, &idle_spins);
+			is_done = si_future_is_done(p_future);
+		}
+		if (true != is_done)
+		{
+			goto END;
 		}
-		si_mutex_unlock(&(p_pool->results_lock));
 	}
+	p_results = si_future_wait(p_future);
 END:
 	return p_results;
 }
 
+// Shared by the caller & helper tasks of one parallel_for() call. Lives on
+// the heap so helpers a stopping pool runs late or drops never outlive it.
+typedef struct local_parallel_for_t
+{
+	volatile _Atomic size_t next_chunk;
+	volatile _Atomic size_t chunks_done;
+	// Held by the caller & every queued helper.
+	volatile _Atomic size_t ref_count;
+	size_t chunk_count;
+	size_t begin;
+	size_t end;
+	size_t grain;
+	p_range_f p_body;
+	void* p_context;
+	// Completed by whoever finishes the last chunk.
+	si_future_t done;
+} local_parallel_for_t;
+
+/** Doxygen
+ * @brief Drops a reference to parallel_for() state, freeing it on the last.
+ * 
+ * @param p_for Pointer to the shared parallel_for state.
+ */
+static void local_parallel_for_release(local_parallel_for_t* p_for)
+{
+	if (NULL == p_for)
+	{
+		goto END;
+	}
+	if (1u == atomic_fetch_sub(&(p_for->ref_count), 1u))
+	{
+		si_future_free(&(p_for->done));
+		free(p_for);
+	}
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Claims & runs chunks of a parallel_for() until none are left.
+ * 
+ * @param p_for Pointer to the shared parallel_for state.
+ */
+static void local_parallel_for_run(local_parallel_for_t* const p_for)
+{
+	size_t chunk = atomic_fetch_add(&(p_for->next_chunk), 1u);
+	while (chunk < p_for->chunk_count)
+	{
+		const size_t chunk_begin = p_for->begin + (chunk * p_for->grain);
+		const size_t chunk_end = ((p_for->end - chunk_begin) > p_for->grain) ?
+			(chunk_begin + p_for->grain) : p_for->end;
+		p_for->p_body(chunk_begin, chunk_end, p_for->p_context);
+		const size_t done = atomic_fetch_add(&(p_for->chunks_done), 1u) + 1u;
+		if (p_for->chunk_count == done)
+		{
+			(void)si_future_complete(&(p_for->done), p_for);
+		}
+		chunk = atomic_fetch_add(&(p_for->next_chunk), 1u);
+	}
+}
+
+/** Doxygen
+ * @brief Helper task of parallel_for(). Returns NULL so no result is stored.
+ * 
+ * @param p_param Pointer to the shared parallel_for state.
+ * 
+ * @return Returns NULL always.
+ */
+static void* local_parallel_for_task(void* const p_param)
+{
+	local_parallel_for_t* const p_for = p_param;
+	local_parallel_for_run(p_for);
+	local_parallel_for_release(p_for);
+	return NULL;
+}
+
+bool si_threadpool_parallel_for(si_threadpool_t* const p_pool,
+	const size_t begin, const size_t end, const size_t grain,
+	p_range_f const p_body, void* const p_context)
+{
+	bool result = false;
+	if ((NULL == p_body) || (begin > end))
+	{
+		goto END;
+	}
+	result = true;
+	const size_t range = end - begin;
+	if (0u >= range)
+	{
+		goto END;
+	}
+	size_t worker_count = 0u;
+	if (NULL != p_pool)
+	{
+		const bool is_running = atomic_load(&(p_pool->is_running));
+		worker_count = (true == is_running) ?
+			atomic_load(&(p_pool->live_count)) : 0u;
+	}
+	size_t chunk_grain = grain;
+	if (0u >= chunk_grain)
+	{
+		// Aim for a few chunks per thread so uneven chunks balance out.
+		const size_t target = (worker_count + 1u) *
+			SI_THREADPOOL_FOR_CHUNKS_PER_THREAD;
+		chunk_grain = (range + target - 1u) / target;
+	}
+	const size_t chunk_count = (range / chunk_grain) +
+		((0u == (range % chunk_grain)) ? 0u : 1u);
+	if ((0u >= worker_count) || (1u >= chunk_count))
+	{
+		p_body(begin, end, p_context);
+		goto END;
+	}
+	local_parallel_for_t* const p_for = calloc(1u, sizeof(*p_for));
+	if (NULL == p_for)
+	{
+		result = false;
+		goto END;
+	}
+	if (true != si_future_init(&(p_for->done)))
+	{
+		free(p_for);
+		result = false;
+		goto END;
+	}
+	atomic_init(&(p_for->next_chunk), 0u);
+	atomic_init(&(p_for->chunks_done), 0u);
+	p_for->chunk_count = chunk_count;
+	p_for->begin = begin;
+	p_for->end = end;
+	p_for->grain = chunk_grain;
+	p_for->p_body = p_body;
+	p_for->p_context = p_context;
+	// The caller takes a share itself so one fewer helper is needed.
+	const size_t helper_count = ((chunk_count - 1u) < worker_count) ?
+		(chunk_count - 1u) : worker_count;
+	atomic_init(&(p_for->ref_count), helper_count + 1u);
+	const size_t enqueued = local_si_threadpool_enqueue_batch(
+		p_pool, local_parallel_for_task, NULL, p_for, helper_count, NULL,
+		SI_THREADPOOL_PRIORITY_MIN
+	);
+	// Helpers that never made it into the queue hold no reference.
+	atomic_fetch_sub(&(p_for->ref_count), helper_count - enqueued);
+	local_parallel_for_run(p_for);
+	// Every chunk is claimed, the ones left are running on other threads so
+	// this returns even when the pool stops & drops the idle helpers.
+	(void)si_threadpool_await_future(p_pool, &(p_for->done));
+	if (true != si_future_is_done(&(p_for->done)))
+	{
+		(void)si_future_wait(&(p_for->done));
+	}
+	local_parallel_for_release(p_for);
+END:
+	return result;
+}
+
 void si_threadpool_await(si_threadpool_t** const pp_pool)
 {
 	if (NULL == pp_pool)
@@ -502,6 +2678,81 @@ END:
 	return;
 }
 
+void si_threadpool_set_affinity(si_threadpool_t* const p_pool,
+	const si_threadpool_affinity_t affinity)
+{
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	si_mutex_lock(&(p_pool->pool_lock));
+	p_pool->affinity = affinity;
+	si_mutex_unlock(&(p_pool->pool_lock));
+END:
+	return;
+}
+
+void si_threadpool_set_elastic_5(si_threadpool_t* const p_pool,
+	const size_t min_threads, const size_t max_threads,
+	const uint32_t spawn_wait, const uint32_t idle_timeout)
+{
+	if (NULL == p_pool)
+	{
+		goto END;
+	}
+	si_mutex_lock(&(p_pool->pool_lock));
+	if (0u >= p_pool->pool.capacity)
+	{
+		// At least one worker is kept to notice late tasks.
+		p_pool->min_threads = (0u < min_threads) ? min_threads : 1u;
+		p_pool->max_threads = (max_threads > p_pool->min_threads) ?
+			max_threads : p_pool->min_threads;
+		p_pool->is_elastic = (0u < max_threads);
+		p_pool->spawn_wait = spawn_wait;
+		p_pool->idle_timeout = idle_timeout;
+	}
+	si_mutex_unlock(&(p_pool->pool_lock));
+END:
+	return;
+}
+inline void si_threadpool_set_elastic(si_threadpool_t* const p_pool,
+	const size_t min_threads, const size_t max_threads)
+{
+	// Default value of spawn_wait is SI_THREADPOOL_DEFAULT_SPAWN_WAIT
+	// Default value of idle_timeout is SI_THREADPOOL_DEFAULT_IDLE_TIMEOUT
+	si_threadpool_set_elastic_5(p_pool, min_threads, max_threads,
+		SI_THREADPOOL_DEFAULT_SPAWN_WAIT, SI_THREADPOOL_DEFAULT_IDLE_TIMEOUT
+	);
+}
+
+void si_threadpool_blocking_begin(si_threadpool_t* const p_pool)
+{
+	if ((NULL == p_pool) || (p_pool != gp_worker_pool))
+	{
+		goto END;
+	}
+	atomic_fetch_add(&(p_pool->blocked_count), 1u);
+	if ((0u < atomic_load(&(p_pool->pending_count))) &&
+		(0u == atomic_load(&(p_pool->parked_count))))
+	{
+		// Queued work would otherwise wait out the blocking call.
+		si_threadpool_grow(p_pool);
+	}
+END:
+	return;
+}
+
+void si_threadpool_blocking_end(si_threadpool_t* const p_pool)
+{
+	if ((NULL == p_pool) || (p_pool != gp_worker_pool))
+	{
+		goto END;
+	}
+	atomic_fetch_sub(&(p_pool->blocked_count), 1u);
+END:
+	return;
+}
+
 void si_threadpool_start_2(si_threadpool_t* const p_pool,
 	const size_t thread_count)
 {
@@ -514,6 +2765,7 @@ void si_threadpool_start_2(si_threadpool_t* const p_pool,
 	{
 		goto END;
 	}
+	si_cancel_token_reset(&(p_pool->cancel_token));
 	atomic_store(&(p_pool->is_running), true);
 
 	si_mutex_lock(&(p_pool->pool_lock));
@@ -527,24 +2779,78 @@ void si_threadpool_start_2(si_threadpool_t* const p_pool,
 	{
 		si_array_free(&(p_pool->pool));
 	}
-	si_array_init_3(&(p_pool->pool), sizeof(si_thread_t), thread_count);
-
-	for (size_t iii = 0u; iii < thread_count; iii++)
+	// Elastic pools get every slot up front so workers never move.
+	size_t start_count = thread_count;
+	size_t slot_count = thread_count;
+	if (true == p_pool->is_elastic)
+	{
+		start_count = (p_pool->min_threads > start_count) ?
+			p_pool->min_threads : start_count;
+		start_count = (p_pool->max_threads < start_count) ?
+			p_pool->max_threads : start_count;
+		slot_count = p_pool->max_threads;
+	}
+	// Zeroed slots read as free.
+	si_array_init_3(&(p_pool->pool), sizeof(local_worker_slot_t), slot_count);
+	atomic_store(&(p_pool->live_count), 0u);
+	atomic_store(&(p_pool->blocked_count), 0u);
+	si_array_free(&(p_pool->task_caches));
+	si_array_init_3(
+		&(p_pool->task_caches), sizeof(local_task_cache_t), slot_count
+	);
+	if (true == p_pool->is_work_stealing)
+	{
+		// Zeroed deques read as empty, each worker sets up its own.
+		si_array_free(&(p_pool->deques));
+		si_array_init_3(&(p_pool->deques), sizeof(si_ws_deque_t), slot_count);
+	}
+#if SI_THREADPOOL_STATS
+	// Counters are kept across restarts, only grown for extra workers.
+	if (slot_count > p_pool->worker_stats.capacity)
+	{
+		(void)si_array_resize(&(p_pool->worker_stats), slot_count);
+	}
+#endif//SI_THREADPOOL_STATS
+	si_array_free(&(p_pool->worker_nodes));
+	if (SI_THREADPOOL_AFFINITY_NONE != p_pool->affinity)
 	{
-		si_thread_t* p_thread = si_array_at(&(p_pool->pool), iii);
-		if (NULL == p_thread)
+		// Known before any worker runs so thieves can read it freely.
+		si_array_init_3(&(p_pool->worker_nodes), sizeof(size_t), slot_count);
+		size_t cpus[SI_THREADPOOL_PIN_CPUS_MAX];
+		size_t cpu_count = 0u;
+		for (size_t iii = 0u; iii < p_pool->worker_nodes.capacity; iii++)
 		{
-			break;
+			const size_t node = local_si_threadpool_placement(
+				p_pool->affinity, iii, cpus, &cpu_count
+			);
+			si_array_set(&(p_pool->worker_nodes), iii, &node);
 		}
-		si_thread_create(
-			p_thread, (void* (*)(void*))si_threadpool_worker, (void*)p_pool
-		);
-		const bool is_valid = si_thread_is_valid(*p_thread);
+	}
+
+	for (size_t iii = 0u; iii < start_count; iii++)
+	{
+		const bool is_valid = si_threadpool_spawn(p_pool, iii);
 		if (true != is_valid)
 		{
 			break;
 		}
 	}
+	// Timers filed while stopped resume, overdue ones fire right away.
+	si_mutex_lock(&(p_pool->timer_lock));
+	if (0u < si_timer_wheel_count(&(p_pool->timers)))
+	{
+		si_threadpool_timer_start(p_pool);
+	}
+	si_mutex_unlock(&(p_pool->timer_lock));
+#if SI_FIBER
+	// Fibers left waiting on descriptors are polled again.
+	si_mutex_lock(&(p_pool->fiber_lock));
+	if (NULL != p_pool->p_io_waiters)
+	{
+		si_threadpool_io_start(p_pool);
+	}
+	si_mutex_unlock(&(p_pool->fiber_lock));
+#endif//SI_FIBER
 
 UNLOCK:
 	si_mutex_unlock(&(p_pool->pool_lock));
@@ -566,31 +2872,89 @@ void si_threadpool_stop_2(si_threadpool_t* const p_pool,
 		goto END;
 	}
 	atomic_store(&(p_pool->is_running), false);
+	// Running tasks see the pool cancelled once the grace period is over.
+	if (0u < timeout_offset)
+	{
+		si_cancel_token_cancel_after(&(p_pool->cancel_token), timeout_offset);
+	}
+	else
+	{
+		si_cancel_token_cancel(&(p_pool->cancel_token));
+	}
 
 	// Wake up anything waiting on these signals so they can check the
 	// current/new run state of the threadpool.
-	si_cond_broadcast(&(p_pool->results_appended_signal));
-	si_cond_broadcast(&(p_pool->task_completed_signal));
+	si_mutex_lock(&(p_pool->results_lock));
+	local_si_threadpool_wake_waiters(p_pool, SI_THREADPOOL_TASK_ID_INVALID);
+	si_mutex_unlock(&(p_pool->results_lock));
+	si_event_notify_all(&(p_pool->task_completed_event));
+	si_event_notify_all(&(p_pool->work_available_event));
+	// Timers stay filed in the wheel until the pool restarts or is freed.
+	si_mutex_lock(&(p_pool->timer_lock));
+	const bool has_timer_thread = p_pool->has_timer_thread;
+	p_pool->has_timer_thread = false;
+	si_cond_broadcast(&(p_pool->timer_signal));
+	si_mutex_unlock(&(p_pool->timer_lock));
+	if (true == has_timer_thread)
+	{
+		(void)si_thread_join(&(p_pool->timer_thread));
+	}
+#if SI_FIBER
+	// Fibers waiting on descriptors stay filed until restart or free.
+	si_mutex_lock(&(p_pool->fiber_lock));
+	const bool has_io_thread = p_pool->has_io_thread;
+	p_pool->has_io_thread = false;
+	si_mutex_unlock(&(p_pool->fiber_lock));
+	if (true == has_io_thread)
+	{
+		si_threadpool_io_wake(p_pool);
+		(void)si_thread_join(&(p_pool->io_thread));
+	}
+#endif//SI_FIBER
 
 	si_mutex_lock(&(p_pool->pool_lock));
 
-	const size_t thread_count = p_pool->pool.capacity;
-	for (size_t iii = 0u; iii < thread_count; iii++)
+	const size_t slot_count = p_pool->pool.capacity;
+	for (size_t iii = 0u; iii < slot_count; iii++)
 	{
-		si_thread_t* p_thread = si_array_at(&(p_pool->pool), iii);
-		if (NULL == p_thread)
+		local_worker_slot_t* const p_slot = si_array_at(&(p_pool->pool), iii);
+		if (LOCAL_WORKER_FREE == atomic_load(&(p_slot->state)))
 		{
+			// Never started or already reaped.
 			continue;
 		}
-#ifdef SI_PTHREAD
-		// We verify thread is cancelable when it was created.
-		(void)pthread_cancel(*p_thread);
-#endif// SI_PTHREAD
-		(void)si_thread_timedjoin_3(
-			p_thread, timeout_offset, true
-		);
+		// Workers exit after their current task, never asynchronously.
+		(void)si_thread_join(&(p_slot->thread));
+		atomic_store(&(p_slot->state), LOCAL_WORKER_FREE);
 	}
 	si_array_free(&(p_pool->pool));
+	atomic_store(&(p_pool->live_count), 0u);
+	atomic_store(&(p_pool->blocked_count), 0u);
+	// Workers are gone, drop any spawned tasks they left behind.
+	for (size_t iii = 0u; iii < p_pool->deques.capacity; iii++)
+	{
+		si_ws_deque_t* const p_deque = si_array_at(&(p_pool->deques), iii);
+		local_task_t* p_task = si_ws_deque_take(p_deque);
+		while (NULL != p_task)
+		{
+			atomic_fetch_sub(&(p_pool->pending_count), 1u);
+			local_task_free(p_task);
+			p_task = si_ws_deque_take(p_deque);
+		}
+		si_ws_deque_free(p_deque);
+	}
+	si_array_free(&(p_pool->deques));
+	for (size_t iii = 0u; iii < p_pool->task_caches.capacity; iii++)
+	{
+		local_task_cache_t* const p_cache = si_array_at(
+			&(p_pool->task_caches), iii
+		);
+		local_task_list_free(p_cache->p_head);
+		p_cache->p_head = NULL;
+		p_cache->count = 0u;
+	}
+	si_array_free(&(p_pool->task_caches));
+	si_array_free(&(p_pool->worker_nodes));
 
 	si_mutex_unlock(&(p_pool->pool_lock));
 END:
@@ -598,10 +2962,50 @@ END:
 }
 inline void si_threadpool_stop(si_threadpool_t* const p_pool)
 {
-	// Default value of timeout is 0(blocks forever)
+	// Default value of timeout is 0(cancels running tasks right away)
 	si_threadpool_stop_2(p_pool, 0);
 }
 
+void si_threadpool_shutdown_2(si_threadpool_t* const p_pool, const bool drain)
+{
+	if ((NULL == p_pool) || (p_pool == gp_worker_pool))
+	{
+		goto END;
+	}
+	while ((true == drain) && (true == atomic_load(&(p_pool->is_running))))
+	{
+		const uint32_t key = si_event_prepare_wait(
+			&(p_pool->task_completed_event)
+		);
+		// Parked first, a task running now keeps its worker from parking.
+		const size_t parked = atomic_load(&(p_pool->parked_count));
+		const size_t live = atomic_load(&(p_pool->live_count));
+		if ((parked >= live) && (0u == atomic_load(&(p_pool->pending_count))))
+		{
+			si_event_cancel_wait(&(p_pool->task_completed_event));
+			break;
+		}
+		// Workers park without notifying, so this also polls every 1ms.
+		(void)si_event_wait_3(&(p_pool->task_completed_event), key, 1u);
+	}
+	si_threadpool_stop_2(p_pool, 0u);
+	// Nothing runs anymore, what is left in the queue is abandoned.
+	local_task_t* p_task = si_priority_queue_dequeue(&(p_pool->queue));
+	while (NULL != p_task)
+	{
+		atomic_fetch_sub(&(p_pool->pending_count), 1u);
+		local_task_free(p_task);
+		p_task = si_priority_queue_dequeue(&(p_pool->queue));
+	}
+END:
+	return;
+}
+inline void si_threadpool_shutdown(si_threadpool_t* const p_pool)
+{
+	// Default value of drain is true
+	si_threadpool_shutdown_2(p_pool, true);
+}
+
 void si_threadpool_free(si_threadpool_t* const p_pool)
 {
 	if (NULL == p_pool)
@@ -610,17 +3014,50 @@ void si_threadpool_free(si_threadpool_t* const p_pool)
 	}
 	si_threadpool_stop_2(p_pool, SI_THREADPOOL_DEFAULT_JOIN_TIMEOUT);
 
-	si_mutex_lock(&(p_pool->task_counter_lock));
 	si_mutex_lock(&(p_pool->pool_lock));
 	si_mutex_lock(&(p_pool->results_lock));
 
+	p_pool->results.p_free_value = si_magazine_free;
 	si_parray_free(&(p_pool->results));
 	si_priority_queue_free(&(p_pool->queue));
-	si_cond_free(&(p_pool->results_appended_signal));
-	si_cond_free(&(p_pool->task_completed_signal));
+	si_array_free(&(p_pool->deques));
+	si_array_free(&(p_pool->task_caches));
+	si_array_free(&(p_pool->worker_nodes));
+#if SI_THREADPOOL_STATS
+	si_array_free(&(p_pool->worker_stats));
+#endif//SI_THREADPOOL_STATS
+	local_task_list_free(p_pool->p_free_tasks);
+	p_pool->p_free_tasks = NULL;
+	p_pool->free_task_count = 0u;
+	si_mutex_free(&(p_pool->task_free_lock));
+	si_mutex_lock(&(p_pool->timer_lock));
+	si_timer_wheel_free(&(p_pool->timers));
+	si_cond_free(&(p_pool->timer_signal));
+	si_mutex_unlock(&(p_pool->timer_lock));
+	si_mutex_free(&(p_pool->timer_lock));
+	// Queued fibers were abandoned with the queue, waiting ones go here.
+	si_mutex_lock(&(p_pool->fiber_lock));
+	while (NULL != p_pool->p_io_waiters)
+	{
+		local_fiber_task_t* const p_fiber = p_pool->p_io_waiters;
+		p_pool->p_io_waiters = p_fiber->p_io_next;
+		local_fiber_task_abandon(p_fiber);
+	}
+#if SI_FIBER
+	for (size_t iii = 0u; iii < 2u; iii++)
+	{
+		if (0 <= p_pool->io_wake_fds[iii])
+		{
+			(void)close(p_pool->io_wake_fds[iii]);
+			p_pool->io_wake_fds[iii] = -1;
+		}
+	}
+#endif//SI_FIBER
+	si_mutex_unlock(&(p_pool->fiber_lock));
+	si_mutex_free(&(p_pool->fiber_lock));
+	si_fiber_stack_pool_free(&(p_pool->fiber_stacks));
+	si_cancel_token_free(&(p_pool->cancel_token));
 
-	si_mutex_unlock(&(p_pool->task_counter_lock));
-	si_mutex_free(&(p_pool->task_counter_lock));
 	si_mutex_unlock(&(p_pool->pool_lock));
 	si_mutex_free(&(p_pool->pool_lock));
 	si_mutex_unlock(&(p_pool->results_lock));
@@ -0,0 +1,280 @@
+// si_threadpool_stats.c
+#include "si_threadpool_stats.h"
+
+#include <string.h> // memset()
+
+size_t si_threadpool_stats_bucket(const uint64_t duration_ns)
+{
+	size_t result = 0u;
+	if (2u > duration_ns)
+	{
+		goto END;
+	}
+#if defined(__GNUC__) || defined(__clang__)
+	result = (size_t)(63 - __builtin_clzll((unsigned long long)duration_ns));
+#else
+	for (uint64_t value = duration_ns >> 1u; 0u < value; value >>= 1u)
+	{
+		result++;
+	}
+#endif//__GNUC__
+	if (SI_THREADPOOL_STATS_BUCKETS <= result)
+	{
+		result = SI_THREADPOOL_STATS_BUCKETS - 1u;
+	}
+END:
+	return result;
+}
+
+uint64_t si_threadpool_histogram_percentile(
+	const si_threadpool_histogram_t* const p_histogram, const double percentile)
+{
+	uint64_t result = 0u;
+	if ((NULL == p_histogram) || (0u >= p_histogram->count) ||
+		(0.0 > percentile) || (1.0 < percentile))
+	{
+		goto END;
+	}
+	// Rank of the sample at the percentile, counting from 1.
+	uint64_t rank = (uint64_t)(percentile * (double)p_histogram->count);
+	if (0u >= rank)
+	{
+		rank = 1u;
+	}
+	uint64_t seen = 0u;
+	for (size_t iii = 0u; iii < SI_THREADPOOL_STATS_BUCKETS; iii++)
+	{
+		seen += p_histogram->buckets[iii];
+		if (seen >= rank)
+		{
+			result = (uint64_t)1u << (iii + 1u);
+			break;
+		}
+	}
+END:
+	return result;
+}
+
+void si_threadpool_stats_init(si_threadpool_stats_t* const p_stats)
+{
+	if (NULL == p_stats)
+	{
+		goto END;
+	}
+	memset(p_stats, 0x00, sizeof(si_threadpool_stats_t));
+	si_array_init_3(&(p_stats->queue_depths), sizeof(size_t), 0u);
+END:
+	return;
+}
+
+#if SI_THREADPOOL_STATS
+/** Doxygen
+ * @brief Adds a worker's live bucket counts into a snapshot histogram.
+ *
+ * @param p_histogram Pointer to the histogram to add to.
+ * @param p_buckets Array of SI_THREADPOOL_STATS_BUCKETS live counters.
+ * @param sum_ns Worker's total of the durations counted.
+ */
+static void local_si_threadpool_histogram_add(
+	si_threadpool_histogram_t* const p_histogram,
+	volatile _Atomic uint64_t* const p_buckets, const uint64_t sum_ns)
+{
+	for (size_t iii = 0u; iii < SI_THREADPOOL_STATS_BUCKETS; iii++)
+	{
+		const uint64_t count = atomic_load_explicit(
+			&(p_buckets[iii]), memory_order_relaxed
+		);
+		p_histogram->buckets[iii] += count;
+		p_histogram->count += count;
+	}
+	p_histogram->sum_ns += sum_ns;
+}
+#endif//SI_THREADPOOL_STATS
+
+bool si_threadpool_stats_snapshot(si_threadpool_t* const p_pool,
+	si_threadpool_stats_t* const p_stats)
+{
+	bool result = false;
+	if ((NULL == p_pool) || (NULL == p_stats))
+	{
+		goto END;
+	}
+	si_threadpool_stats_free(p_stats);
+	si_threadpool_stats_init(p_stats);
+#if SI_THREADPOOL_STATS
+	si_mutex_lock(&(p_pool->pool_lock));
+	p_stats->worker_count = atomic_load(&(p_pool->live_count));
+	for (size_t iii = 0u; iii < p_pool->worker_stats.capacity; iii++)
+	{
+		si_threadpool_worker_stats_t* const p_worker = si_array_at(
+			&(p_pool->worker_stats), iii
+		);
+		p_stats->tasks_run += atomic_load_explicit(
+			&(p_worker->tasks_run), memory_order_relaxed
+		);
+		p_stats->steals += atomic_load_explicit(
+			&(p_worker->steals), memory_order_relaxed
+		);
+		p_stats->parks += atomic_load_explicit(
+			&(p_worker->parks), memory_order_relaxed
+		);
+		p_stats->idle_ns += atomic_load_explicit(
+			&(p_worker->idle_ns), memory_order_relaxed
+		);
+		const uint64_t busy_ns = atomic_load_explicit(
+			&(p_worker->busy_ns), memory_order_relaxed
+		);
+		p_stats->busy_ns += busy_ns;
+		local_si_threadpool_histogram_add(
+			&(p_stats->run), p_worker->run_buckets, busy_ns
+		);
+		local_si_threadpool_histogram_add(&(p_stats->wait),
+			p_worker->wait_buckets,
+			atomic_load_explicit(&(p_worker->wait_ns), memory_order_relaxed)
+		);
+	}
+	si_mutex_unlock(&(p_pool->pool_lock));
+	p_stats->parked_count = atomic_load(&(p_pool->parked_count));
+	p_stats->pending_count = atomic_load(&(p_pool->pending_count));
+	si_mutex_lock(&(p_pool->timer_lock));
+	p_stats->timer_count = si_timer_wheel_count(&(p_pool->timers));
+	si_mutex_unlock(&(p_pool->timer_lock));
+	const size_t priority_count = si_priority_queue_priority_count(
+		&(p_pool->queue)
+	);
+	si_array_free(&(p_stats->queue_depths));
+	si_array_init_3(&(p_stats->queue_depths), sizeof(size_t), priority_count);
+	for (size_t iii = 0u; iii < p_stats->queue_depths.capacity; iii++)
+	{
+		const size_t depth = si_priority_queue_count_at(&(p_pool->queue), iii);
+		si_array_set(&(p_stats->queue_depths), iii, &depth);
+	}
+	result = true;
+#endif//SI_THREADPOOL_STATS
+END:
+	return result;
+}
+
+/** Doxygen
+ * @brief Prints one histogram line with its mean & rough percentiles.
+ *
+ * @param p_file Pointer to the FILE to print to.
+ * @param p_name Label of the histogram.
+ * @param p_histogram Pointer to the histogram to print.
+ */
+static void local_si_threadpool_histogram_fprint(FILE* const p_file,
+	const char* const p_name, const si_threadpool_histogram_t* const p_histogram)
+{
+	const uint64_t mean_ns = (0u < p_histogram->count) ?
+		(p_histogram->sum_ns / p_histogram->count) : 0u;
+	fprintf(p_file,
+		"%s: count=%llu mean=%lluns p50<%lluns p99<%lluns p100<%lluns\n",
+		p_name, (unsigned long long)p_histogram->count,
+		(unsigned long long)mean_ns,
+		(unsigned long long)si_threadpool_histogram_percentile(p_histogram, 0.5),
+		(unsigned long long)si_threadpool_histogram_percentile(p_histogram, 0.99),
+		(unsigned long long)si_threadpool_histogram_percentile(p_histogram, 1.0)
+	);
+}
+
+void si_threadpool_stats_fprint(FILE* const p_file,
+	const si_threadpool_stats_t* const p_stats)
+{
+	if ((NULL == p_file) || (NULL == p_stats))
+	{
+		goto END;
+	}
+	fprintf(p_file, "workers=%zu parked=%zu pending=%zu timers=%zu\n",
+		p_stats->worker_count, p_stats->parked_count, p_stats->pending_count,
+		p_stats->timer_count
+	);
+	fprintf(p_file, "queue depths:");
+	for (size_t iii = 0u; iii < p_stats->queue_depths.capacity; iii++)
+	{
+		fprintf(p_file, " %zu",
+			*(size_t*)si_array_at(&(p_stats->queue_depths), iii)
+		);
+	}
+	fprintf(p_file, "\n");
+	fprintf(p_file,
+		"tasks_run=%llu steals=%llu parks=%llu busy=%lluns idle=%lluns\n",
+		(unsigned long long)p_stats->tasks_run,
+		(unsigned long long)p_stats->steals,
+		(unsigned long long)p_stats->parks,
+		(unsigned long long)p_stats->busy_ns,
+		(unsigned long long)p_stats->idle_ns
+	);
+	local_si_threadpool_histogram_fprint(p_file, "wait", &(p_stats->wait));
+	local_si_threadpool_histogram_fprint(p_file, "run", &(p_stats->run));
+END:
+	return;
+}
+
+/** Doxygen
+ * @brief Prints a histogram as a JSON object.
+ *
+ * @param p_file Pointer to the FILE to print to.
+ * @param p_histogram Pointer to the histogram to print.
+ */
+static void local_si_threadpool_histogram_fprint_json(FILE* const p_file,
+	const si_threadpool_histogram_t* const p_histogram)
+{
+	fprintf(p_file, "{\"count\":%llu,\"sum_ns\":%llu,\"buckets\":[",
+		(unsigned long long)p_histogram->count,
+		(unsigned long long)p_histogram->sum_ns
+	);
+	for (size_t iii = 0u; iii < SI_THREADPOOL_STATS_BUCKETS; iii++)
+	{
+		fprintf(p_file, "%s%llu", (0u < iii) ? "," : "",
+			(unsigned long long)p_histogram->buckets[iii]
+		);
+	}
+	fprintf(p_file, "]}");
+}
+
+void si_threadpool_stats_fprint_json(FILE* const p_file,
+	const si_threadpool_stats_t* const p_stats)
+{
+	if ((NULL == p_file) || (NULL == p_stats))
+	{
+		goto END;
+	}
+	fprintf(p_file,
+		"{\"workers\":%zu,\"parked\":%zu,\"pending\":%zu,\"timers\":%zu,",
+		p_stats->worker_count, p_stats->parked_count, p_stats->pending_count,
+		p_stats->timer_count
+	);
+	fprintf(p_file, "\"queue_depths\":[");
+	for (size_t iii = 0u; iii < p_stats->queue_depths.capacity; iii++)
+	{
+		fprintf(p_file, "%s%zu", (0u < iii) ? "," : "",
+			*(size_t*)si_array_at(&(p_stats->queue_depths), iii)
+		);
+	}
+	fprintf(p_file,
+		"],\"tasks_run\":%llu,\"steals\":%llu,\"parks\":%llu,"
+		"\"busy_ns\":%llu,\"idle_ns\":%llu,\"wait\":",
+		(unsigned long long)p_stats->tasks_run,
+		(unsigned long long)p_stats->steals,
+		(unsigned long long)p_stats->parks,
+		(unsigned long long)p_stats->busy_ns,
+		(unsigned long long)p_stats->idle_ns
+	);
+	local_si_threadpool_histogram_fprint_json(p_file, &(p_stats->wait));
+	fprintf(p_file, ",\"run\":");
+	local_si_threadpool_histogram_fprint_json(p_file, &(p_stats->run));
+	fprintf(p_file, "}\n");
+END:
+	return;
+}
+
+void si_threadpool_stats_free(si_threadpool_stats_t* const p_stats)
+{
+	if (NULL == p_stats)
+	{
+		goto END;
+	}
+	si_array_free(&(p_stats->queue_depths));
+END:
+	return;
+}
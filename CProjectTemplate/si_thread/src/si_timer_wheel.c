@@ -0,0 +1,230 @@
+// si_timer_wheel.c
+#include "si_timer_wheel.h"
+
+#include <stdlib.h> // calloc(), free()
+
+#define SI_TIMER_WHEEL_MASK ((uint64_t)SI_TIMER_WHEEL_SLOTS - 1u)
+
+void si_timer_wheel_init_2(si_timer_wheel_t* const p_wheel,
+	const uint64_t now)
+{
+	if (NULL == p_wheel)
+	{
+		goto END;
+	}
+	p_wheel->current = now;
+	p_wheel->count = 0u;
+	for (size_t level = 0u; level < SI_TIMER_WHEEL_LEVELS; level++)
+	{
+		for (size_t iii = 0u; iii < SI_TIMER_WHEEL_SLOTS; iii++)
+		{
+			p_wheel->slots[level][iii] = NULL;
+		}
+	}
+	p_wheel->p_free_value = NULL;
+END:
+	return;
+}
+inline void si_timer_wheel_init(si_timer_wheel_t* const p_wheel)
+{
+	// Default value of now is 0u
+	si_timer_wheel_init_2(p_wheel, 0u);
+}
+
+/** Doxygen
+ * @brief Files an entry into the lowest level whose span covers its deadline
+ *        relative to the wheel's current tick.
+ *
+ * @param p_wheel Pointer to the timer wheel struct to file into.
+ * @param p_entry Pointer to the entry to be filed.
+ */
+static void local_si_timer_wheel_file(si_timer_wheel_t* const p_wheel,
+	si_timer_wheel_entry_t* const p_entry)
+{
+	uint64_t deadline = p_entry->deadline;
+	if (deadline < p_wheel->current)
+	{
+		deadline = p_wheel->current;
+	}
+	const uint64_t delta = deadline - p_wheel->current;
+	size_t level = 0u;
+	while ((level + 1u < SI_TIMER_WHEEL_LEVELS) &&
+		(delta >= ((uint64_t)1u << (SI_TIMER_WHEEL_SLOT_BITS * (level + 1u)))))
+	{
+		level++;
+	}
+	const uint64_t span = (uint64_t)1u <<
+		(SI_TIMER_WHEEL_SLOT_BITS * SI_TIMER_WHEEL_LEVELS);
+	if (delta >= span)
+	{
+		// Beyond the wheel, parked in the furthest top slot until it turns.
+		deadline = p_wheel->current + span - 1u;
+	}
+	const size_t slot = (size_t)(
+		(deadline >> (SI_TIMER_WHEEL_SLOT_BITS * level)) & SI_TIMER_WHEEL_MASK
+	);
+	p_entry->p_next = p_wheel->slots[level][slot];
+	p_wheel->slots[level][slot] = p_entry;
+}
+
+bool si_timer_wheel_add(si_timer_wheel_t* const p_wheel,
+	const uint64_t deadline, void* const p_data)
+{
+	bool result = false;
+	if (NULL == p_wheel)
+	{
+		goto END;
+	}
+	si_timer_wheel_entry_t* const p_entry = calloc(
+		1u, sizeof(si_timer_wheel_entry_t)
+	);
+	if (NULL == p_entry)
+	{
+		goto END;
+	}
+	p_entry->deadline = deadline;
+	p_entry->p_data = p_data;
+	local_si_timer_wheel_file(p_wheel, p_entry);
+	p_wheel->count++;
+	result = true;
+END:
+	return result;
+}
+
+uint64_t si_timer_wheel_next(const si_timer_wheel_t* const p_wheel)
+{
+	uint64_t result = SI_TIMER_WHEEL_NEVER;
+	if ((NULL == p_wheel) || (0u >= p_wheel->count))
+	{
+		goto END;
+	}
+	// A slot at level N is worked on when the tick reaches its block start.
+	for (size_t level = 0u; level < SI_TIMER_WHEEL_LEVELS; level++)
+	{
+		const size_t shift = SI_TIMER_WHEEL_SLOT_BITS * level;
+		const uint64_t first = (
+			p_wheel->current + (((uint64_t)1u << shift) - 1u)
+		) >> shift;
+		for (uint64_t iii = 0u; iii < SI_TIMER_WHEEL_SLOTS; iii++)
+		{
+			const uint64_t block = first + iii;
+			if (NULL != p_wheel->slots[level][block & SI_TIMER_WHEEL_MASK])
+			{
+				const uint64_t tick = block << shift;
+				if (tick < result)
+				{
+					result = tick;
+				}
+				break;
+			}
+		}
+	}
+END:
+	return result;
+}
+
+size_t si_timer_wheel_advance(si_timer_wheel_t* const p_wheel,
+	const uint64_t now, p_timer_expire_f const p_expire, void* const p_context)
+{
+	size_t result = 0u;
+	if ((NULL == p_wheel) || (NULL == p_expire))
+	{
+		goto END;
+	}
+	uint64_t tick = si_timer_wheel_next(p_wheel);
+	while ((SI_TIMER_WHEEL_NEVER != tick) && (tick <= now))
+	{
+		p_wheel->current = tick;
+		// Re-file the higher level slots turning over at this tick.
+		for (size_t level = 1u; level < SI_TIMER_WHEEL_LEVELS; level++)
+		{
+			const size_t shift = SI_TIMER_WHEEL_SLOT_BITS * level;
+			if (0u != (tick & (((uint64_t)1u << shift) - 1u)))
+			{
+				break;
+			}
+			const size_t slot = (size_t)((tick >> shift) & SI_TIMER_WHEEL_MASK);
+			si_timer_wheel_entry_t* p_entry = p_wheel->slots[level][slot];
+			p_wheel->slots[level][slot] = NULL;
+			while (NULL != p_entry)
+			{
+				si_timer_wheel_entry_t* const p_next = p_entry->p_next;
+				local_si_timer_wheel_file(p_wheel, p_entry);
+				p_entry = p_next;
+			}
+		}
+		const size_t slot = (size_t)(tick & SI_TIMER_WHEEL_MASK);
+		si_timer_wheel_entry_t* p_entry = p_wheel->slots[0][slot];
+		p_wheel->slots[0][slot] = NULL;
+		// Re-armed entries due again are filed from the next tick on.
+		p_wheel->current = tick + 1u;
+		while (NULL != p_entry)
+		{
+			si_timer_wheel_entry_t* const p_next = p_entry->p_next;
+			p_wheel->count--;
+			result++;
+			const bool is_rearmed = p_expire(
+				p_entry->p_data, &(p_entry->deadline), p_context
+			);
+			if (true == is_rearmed)
+			{
+				local_si_timer_wheel_file(p_wheel, p_entry);
+				p_wheel->count++;
+			}
+			else
+			{
+				free(p_entry);
+			}
+			p_entry = p_next;
+		}
+		tick = si_timer_wheel_next(p_wheel);
+	}
+	// Nothing is due before tick, so the idle ticks are skipped.
+	if ((SI_TIMER_WHEEL_NEVER != now) && (now >= p_wheel->current))
+	{
+		p_wheel->current = now + 1u;
+	}
+END:
+	return result;
+}
+
+size_t si_timer_wheel_count(const si_timer_wheel_t* const p_wheel)
+{
+	size_t result = 0u;
+	if (NULL == p_wheel)
+	{
+		goto END;
+	}
+	result = p_wheel->count;
+END:
+	return result;
+}
+
+void si_timer_wheel_free(si_timer_wheel_t* const p_wheel)
+{
+	if (NULL == p_wheel)
+	{
+		goto END;
+	}
+	for (size_t level = 0u; level < SI_TIMER_WHEEL_LEVELS; level++)
+	{
+		for (size_t iii = 0u; iii < SI_TIMER_WHEEL_SLOTS; iii++)
+		{
+			si_timer_wheel_entry_t* p_entry = p_wheel->slots[level][iii];
+			p_wheel->slots[level][iii] = NULL;
+			while (NULL != p_entry)
+			{
+				si_timer_wheel_entry_t* const p_next = p_entry->p_next;
+				if (NULL != p_wheel->p_free_value)
+				{
+					p_wheel->p_free_value(p_entry->p_data);
+				}
+				free(p_entry);
+				p_entry = p_next;
+			}
+		}
+	}
+	p_wheel->count = 0u;
+END:
+	return;
+}
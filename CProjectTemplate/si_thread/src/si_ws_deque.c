@@ -0,0 +1,243 @@
+// si_ws_deque.c
+#include "si_ws_deque.h"
+
+#include <stdlib.h> // calloc(), free()
+
+/** Doxygen
+ * @brief Allocates a zeroed buffer with capacity slots. (Power of 2)
+ *
+ * @param capacity Number of slots to allocate.
+ *
+ * @return Returns heap pointer on success. Returns NULL otherwise.
+ */
+static si_ws_deque_buffer_t* local_si_ws_deque_buffer_new(
+	const size_t capacity)
+{
+	si_ws_deque_buffer_t* p_result = calloc(
+		1u, sizeof(si_ws_deque_buffer_t) + (capacity * sizeof(_Atomic(void*)))
+	);
+	if (NULL == p_result)
+	{
+		goto END;
+	}
+	p_result->p_retired = NULL;
+	p_result->mask = capacity - 1u;
+END:
+	return p_result;
+}
+
+bool si_ws_deque_init_2(si_ws_deque_t* const p_deque,
+	const size_t initial_capacity)
+{
+	bool result = false;
+	if (NULL == p_deque)
+	{
+		goto END;
+	}
+	size_t capacity = 2u;
+	while (capacity < initial_capacity)
+	{
+		capacity <<= 1u;
+	}
+	// Stores rather than atomic_init() so a zeroed deque may be set up by
+	// its owner while thieves already poll it. (They see it as empty)
+	atomic_store_explicit(&(p_deque->top), 0, memory_order_relaxed);
+	atomic_store_explicit(&(p_deque->bottom), 0, memory_order_relaxed);
+	si_ws_deque_buffer_t* const p_buffer = local_si_ws_deque_buffer_new(capacity);
+	atomic_store_explicit(&(p_deque->p_buffer), p_buffer, memory_order_release);
+	result = (NULL != p_buffer);
+END:
+	return result;
+}
+inline bool si_ws_deque_init(si_ws_deque_t* const p_deque)
+{
+	// Default value of initial_capacity is SI_WS_DEQUE_DEFAULT_CAPACITY
+	return si_ws_deque_init_2(p_deque, SI_WS_DEQUE_DEFAULT_CAPACITY);
+}
+
+/** Doxygen
+ * @brief Doubles the owner's buffer, copying the live range [top, bottom).
+ *
+ * @return Returns the new buffer on success. Returns NULL otherwise.
+ */
+static si_ws_deque_buffer_t* local_si_ws_deque_grow(
+	si_ws_deque_t* const p_deque, si_ws_deque_buffer_t* const p_old,
+	const int64_t top, const int64_t bottom)
+{
+	si_ws_deque_buffer_t* const p_new = local_si_ws_deque_buffer_new(
+		(p_old->mask + 1u) * 2u
+	);
+	if (NULL == p_new)
+	{
+		goto END;
+	}
+	for (int64_t iii = top; iii < bottom; iii++)
+	{
+		void* const p_item = atomic_load_explicit(
+			&(p_old->slots[(size_t)iii & p_old->mask]), memory_order_relaxed
+		);
+		atomic_store_explicit(
+			&(p_new->slots[(size_t)iii & p_new->mask]), p_item,
+			memory_order_relaxed
+		);
+	}
+	p_new->p_retired = p_old;
+	atomic_store_explicit(&(p_deque->p_buffer), p_new, memory_order_release);
+END:
+	return p_new;
+}
+
+bool si_ws_deque_push(si_ws_deque_t* const p_deque, void* const p_item)
+{
+	bool result = false;
+	if ((NULL == p_deque) || (NULL == p_item))
+	{
+		goto END;
+	}
+	const int64_t bottom = atomic_load_explicit(
+		&(p_deque->bottom), memory_order_relaxed
+	);
+	const int64_t top = atomic_load_explicit(
+		&(p_deque->top), memory_order_acquire
+	);
+	si_ws_deque_buffer_t* p_buffer = atomic_load_explicit(
+		&(p_deque->p_buffer), memory_order_relaxed
+	);
+	if ((bottom - top) > (int64_t)p_buffer->mask)
+	{
+		p_buffer = local_si_ws_deque_grow(p_deque, p_buffer, top, bottom);
+		if (NULL == p_buffer)
+		{
+			goto END;
+		}
+	}
+	atomic_store_explicit(
+		&(p_buffer->slots[(size_t)bottom & p_buffer->mask]), p_item,
+		memory_order_relaxed
+	);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&(p_deque->bottom), bottom + 1, memory_order_relaxed);
+	result = true;
+END:
+	return result;
+}
+
+void* si_ws_deque_take(si_ws_deque_t* const p_deque)
+{
+	void* p_result = NULL;
+	if (NULL == p_deque)
+	{
+		goto END;
+	}
+	const int64_t bottom = atomic_load_explicit(
+		&(p_deque->bottom), memory_order_relaxed
+	) - 1;
+	si_ws_deque_buffer_t* const p_buffer = atomic_load_explicit(
+		&(p_deque->p_buffer), memory_order_relaxed
+	);
+	atomic_store_explicit(&(p_deque->bottom), bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	int64_t top = atomic_load_explicit(&(p_deque->top), memory_order_relaxed);
+	if (top > bottom)
+	{
+		// Empty, restore bottom.
+		atomic_store_explicit(
+			&(p_deque->bottom), bottom + 1, memory_order_relaxed
+		);
+		goto END;
+	}
+	p_result = atomic_load_explicit(
+		&(p_buffer->slots[(size_t)bottom & p_buffer->mask]),
+		memory_order_relaxed
+	);
+	if (top == bottom)
+	{
+		// Last item, race any thieves for it.
+		if (true != atomic_compare_exchange_strong_explicit(&(p_deque->top),
+			&top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+		{
+			p_result = NULL;
+		}
+		atomic_store_explicit(
+			&(p_deque->bottom), bottom + 1, memory_order_relaxed
+		);
+	}
+END:
+	return p_result;
+}
+
+void* si_ws_deque_steal(si_ws_deque_t* const p_deque)
+{
+	void* p_result = NULL;
+	if (NULL == p_deque)
+	{
+		goto END;
+	}
+	int64_t top = atomic_load_explicit(&(p_deque->top), memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	const int64_t bottom = atomic_load_explicit(
+		&(p_deque->bottom), memory_order_acquire
+	);
+	if (top >= bottom)
+	{
+		goto END;
+	}
+	si_ws_deque_buffer_t* const p_buffer = atomic_load_explicit(
+		&(p_deque->p_buffer), memory_order_acquire
+	);
+	void* const p_item = atomic_load_explicit(
+		&(p_buffer->slots[(size_t)top & p_buffer->mask]), memory_order_relaxed
+	);
+	if (true != atomic_compare_exchange_strong_explicit(&(p_deque->top),
+		&top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+	{
+		// Lost the race to the owner or another thief.
+		goto END;
+	}
+	p_result = p_item;
+END:
+	return p_result;
+}
+
+size_t si_ws_deque_count(si_ws_deque_t* const p_deque)
+{
+	size_t result = 0u;
+	if (NULL == p_deque)
+	{
+		goto END;
+	}
+	const int64_t bottom = atomic_load_explicit(
+		&(p_deque->bottom), memory_order_acquire
+	);
+	const int64_t top = atomic_load_explicit(
+		&(p_deque->top), memory_order_acquire
+	);
+	if (bottom > top)
+	{
+		result = (size_t)(bottom - top);
+	}
+END:
+	return result;
+}
+
+void si_ws_deque_free(si_ws_deque_t* const p_deque)
+{
+	if (NULL == p_deque)
+	{
+		goto END;
+	}
+	si_ws_deque_buffer_t* p_buffer = atomic_load_explicit(
+		&(p_deque->p_buffer), memory_order_relaxed
+	);
+	while (NULL != p_buffer)
+	{
+		si_ws_deque_buffer_t* const p_retired = p_buffer->p_retired;
+		free(p_buffer);
+		p_buffer = p_retired;
+	}
+	atomic_store_explicit(&(p_deque->p_buffer), NULL, memory_order_relaxed);
+	atomic_store_explicit(&(p_deque->top), 0, memory_order_relaxed);
+	atomic_store_explicit(&(p_deque->bottom), 0, memory_order_relaxed);
+END:
+	return;
+}
@@ -0,0 +1,81 @@
+// si_cancel_test.c
+
+#include "si_cancel.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdio.h> // printf()
+#include <time.h> // nanosleep()
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+static void si_cancel_test_tokens(void)
+{
+	si_cancel_token_t parent = {0};
+	si_cancel_token_init(&parent);
+	si_cancel_token_t* p_child = si_cancel_token_new_1(&parent);
+	TEST_ASSERT_NOT_NULL(p_child);
+	TEST_ASSERT_EQUAL_size_t(2u, atomic_load(&(parent.ref_count)));
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(&parent));
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(p_child));
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(NULL));
+	// Cancelling a child leaves its parent alone.
+	si_cancel_token_cancel(p_child);
+	TEST_ASSERT_TRUE(si_cancel_token_is_cancelled(p_child));
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(&parent));
+	si_cancel_token_reset(p_child);
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(p_child));
+	// Cancelling the parent reaches the child.
+	si_cancel_token_cancel(&parent);
+	TEST_ASSERT_TRUE(si_cancel_token_is_cancelled(p_child));
+	si_cancel_token_destroy(&p_child);
+	TEST_ASSERT_NULL(p_child);
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(parent.ref_count)));
+	si_cancel_token_free(&parent);
+}
+
+static void si_cancel_test_deadline(void)
+{
+	si_cancel_token_t token = {0};
+	si_cancel_token_init(&token);
+	si_cancel_token_cancel_after(&token, 20u);
+	// A later deadline never pushes back an earlier one.
+	si_cancel_token_cancel_after(&token, 60000u);
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(&token));
+	const struct timespec delay = {.tv_sec = 0, .tv_nsec = 25000000L};
+	(void)nanosleep(&delay, NULL);
+	TEST_ASSERT_TRUE(si_cancel_token_is_cancelled(&token));
+	// Expired deadlines latch the flag.
+	TEST_ASSERT_TRUE(atomic_load(&(token.is_cancelled)));
+	si_cancel_token_reset(&token);
+	TEST_ASSERT_FALSE(si_cancel_token_is_cancelled(&token));
+	si_cancel_token_cancel_after(&token, 0u);
+	TEST_ASSERT_TRUE(si_cancel_token_is_cancelled(&token));
+	si_cancel_token_free(&token);
+}
+
+/** Doxygen
+ * @brief Runs all local si_cancel_token_t unit tests.
+ */
+static void si_cancel_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_cancel_test_tokens);
+	RUN_TEST(si_cancel_test_deadline);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_cancel.\n");
+	si_cancel_test_all();
+	(void)printf("End of si_cancel testing.\n");
+	return 0;
+}
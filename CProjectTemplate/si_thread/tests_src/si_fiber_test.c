@@ -0,0 +1,116 @@
+// si_fiber_test.c
+
+#include "si_fiber.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdio.h> // printf()
+
+#define FIBER_TEST_YIELDS (5u)
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+static si_fiber_t fiber = {0};
+static size_t steps = 0u;
+
+/** Doxygen
+ * @brief Local fiber body counting a step between each yield.
+ *
+ * @param p_arg Pointer to the size_t number of yields to make.
+ */
+static void counting_fiber(void* p_arg)
+{
+	const size_t yields = *(size_t*)p_arg;
+	for (size_t iii = 0u; iii < yields; iii++)
+	{
+		steps++;
+		si_fiber_yield(&fiber);
+	}
+	steps++;
+}
+
+/** Doxygen
+ * @brief Tests si_fiber_stack_pool_t recycles up to max_free stacks.
+ */
+static void si_fiber_test_stack_pool(void)
+{
+	si_fiber_stack_pool_t pool = {0};
+	TEST_ASSERT_TRUE(si_fiber_stack_pool_init_3(&pool, 1000u, 1u));
+	// Rounded up to whole pages.
+	TEST_ASSERT_EQUAL_size_t(0u, pool.stack_size % pool.guard_size);
+	TEST_ASSERT_TRUE(1000u <= pool.stack_size);
+	void* const p_first = si_fiber_stack_pool_acquire(&pool);
+	void* const p_second = si_fiber_stack_pool_acquire(&pool);
+	TEST_ASSERT_NOT_NULL(p_first);
+	TEST_ASSERT_NOT_NULL(p_second);
+	TEST_ASSERT_EQUAL_size_t(2u, atomic_load(&(pool.map_count)));
+	si_fiber_stack_pool_release(&pool, p_first);
+	si_fiber_stack_pool_release(&pool, p_second);
+	// Only one is kept, the other was unmapped.
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(pool.map_count)));
+	TEST_ASSERT_EQUAL_PTR(p_first, si_fiber_stack_pool_acquire(&pool));
+	si_fiber_stack_pool_release(&pool, p_first);
+	si_fiber_stack_pool_free(&pool);
+	TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&(pool.map_count)));
+}
+
+/** Doxygen
+ * @brief Tests resuming a fiber runs it up to its next yield each time.
+ */
+static void si_fiber_test_resume(void)
+{
+	if (0 == SI_FIBER)
+	{
+		TEST_IGNORE_MESSAGE("Fibers are unavailable on this OS.");
+	}
+	si_fiber_stack_pool_t pool = {0};
+	TEST_ASSERT_TRUE(si_fiber_stack_pool_init(&pool));
+	size_t yields = FIBER_TEST_YIELDS;
+	steps = 0u;
+	TEST_ASSERT_TRUE(si_fiber_init(&fiber, &pool, counting_fiber, &yields));
+	for (size_t iii = 0u; iii < FIBER_TEST_YIELDS; iii++)
+	{
+		TEST_ASSERT_TRUE(si_fiber_resume(&fiber));
+		TEST_ASSERT_EQUAL_size_t(iii + 1u, steps);
+		TEST_ASSERT_EQUAL_INT(SI_FIBER_STATE_SUSPENDED, fiber.state);
+	}
+	TEST_ASSERT_FALSE(si_fiber_resume(&fiber));
+	TEST_ASSERT_EQUAL_size_t(FIBER_TEST_YIELDS + 1u, steps);
+	TEST_ASSERT_EQUAL_INT(SI_FIBER_STATE_DONE, fiber.state);
+	// Done fibers are not resumed again.
+	TEST_ASSERT_FALSE(si_fiber_resume(&fiber));
+	si_fiber_free(&fiber);
+
+	// A suspended fiber is dropped & its stack reused.
+	TEST_ASSERT_TRUE(si_fiber_init(&fiber, &pool, counting_fiber, &yields));
+	TEST_ASSERT_TRUE(si_fiber_resume(&fiber));
+	si_fiber_free(&fiber);
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(pool.map_count)));
+	si_fiber_stack_pool_free(&pool);
+}
+
+/** Doxygen
+ * @brief Runs all local si_fiber unit tests.
+ */
+static void si_fiber_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_fiber_test_stack_pool);
+	RUN_TEST(si_fiber_test_resume);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_fiber.\n");
+	si_fiber_test_all();
+	(void)printf("End of si_fiber testing.\n");
+	return 0;
+}
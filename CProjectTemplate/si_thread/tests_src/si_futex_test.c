@@ -0,0 +1,182 @@
+// si_futex_test.c
+
+#include "si_futex.h"
+#include "si_thread.h" // si_thread_create(), si_thread_join()
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdio.h> // printf()
+
+#define FUTEX_TEST_THREADS (4u)
+#define FUTEX_TEST_ITEMS (10000u)
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+static si_event_t event = {0};
+static volatile atomic_bool is_ready = false;
+static si_latch_t latch = {0};
+static si_semaphore_t semaphore = {0};
+static volatile _Atomic size_t consumed = 0u;
+
+/** Doxygen
+ * @brief Local thread function setting is_ready & notifying the event.
+ *
+ * @param p_void Unused.
+ */
+static void* event_notifier(void* p_void)
+{
+	(void)p_void;
+	si_thread_yield();
+	atomic_store(&is_ready, true);
+	si_event_notify_all(&event);
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Tests waiting on an si_event_t condition without a lock.
+ */
+static void si_futex_test_event(void)
+{
+	si_event_init(&event);
+	// Notified before the wait, so it returns straight away.
+	uint32_t key = si_event_prepare_wait(&event);
+	si_event_notify(&event);
+	TEST_ASSERT_TRUE(si_event_wait_3(&event, key, 1000u));
+	key = si_event_prepare_wait(&event);
+	TEST_ASSERT_FALSE(si_event_wait_3(&event, key, 10u));
+	TEST_ASSERT_EQUAL_UINT32(0u, atomic_load(&(event.waiters)));
+
+	atomic_store(&is_ready, false);
+	si_thread_t thread = {0};
+	si_thread_create(&thread, event_notifier, NULL);
+	while (true)
+	{
+		key = si_event_prepare_wait(&event);
+		if (true == atomic_load(&is_ready))
+		{
+			si_event_cancel_wait(&event);
+			break;
+		}
+		(void)si_event_wait(&event, key);
+	}
+	si_thread_join(&thread);
+	TEST_ASSERT_EQUAL_UINT32(0u, atomic_load(&(event.waiters)));
+}
+
+/** Doxygen
+ * @brief Local thread function counting the latch down once.
+ *
+ * @param p_void Unused.
+ */
+static void* latch_counter(void* p_void)
+{
+	(void)p_void;
+	si_latch_count_down(&latch);
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Tests si_latch_t opens only once counted down to zero.
+ */
+static void si_futex_test_latch(void)
+{
+	si_latch_init(&latch, FUTEX_TEST_THREADS);
+	TEST_ASSERT_FALSE(si_latch_try_wait(&latch));
+	TEST_ASSERT_FALSE(si_latch_wait_2(&latch, 10u));
+	si_thread_t threads[FUTEX_TEST_THREADS] = {0};
+	for (size_t iii = 0u; iii < FUTEX_TEST_THREADS; iii++)
+	{
+		si_thread_create(&(threads[iii]), latch_counter, NULL);
+	}
+	TEST_ASSERT_TRUE(si_latch_wait(&latch));
+	for (size_t iii = 0u; iii < FUTEX_TEST_THREADS; iii++)
+	{
+		si_thread_join(&(threads[iii]));
+	}
+	// Stays open.
+	si_latch_count_down_2(&latch, 100u);
+	TEST_ASSERT_TRUE(si_latch_try_wait(&latch));
+	TEST_ASSERT_EQUAL_UINT32(0u, atomic_load(&(latch.count)));
+}
+
+/** Doxygen
+ * @brief Local thread function consuming from the semaphore until told to
+ *        stop by a zero timeout.
+ *
+ * @param p_void Unused.
+ */
+static void* semaphore_consumer(void* p_void)
+{
+	(void)p_void;
+	while (true == si_semaphore_wait_2(&semaphore, 100u))
+	{
+		atomic_fetch_add(&consumed, 1u);
+	}
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Tests si_semaphore_t hands out exactly what was posted.
+ */
+static void si_futex_test_semaphore(void)
+{
+	si_semaphore_init(&semaphore, 2u);
+	TEST_ASSERT_TRUE(si_semaphore_try_wait(&semaphore));
+	TEST_ASSERT_TRUE(si_semaphore_wait(&semaphore));
+	TEST_ASSERT_FALSE(si_semaphore_try_wait(&semaphore));
+	TEST_ASSERT_FALSE(si_semaphore_wait_2(&semaphore, 10u));
+
+	atomic_store(&consumed, 0u);
+	si_thread_t threads[FUTEX_TEST_THREADS] = {0};
+	for (size_t iii = 0u; iii < FUTEX_TEST_THREADS; iii++)
+	{
+		si_thread_create(&(threads[iii]), semaphore_consumer, NULL);
+	}
+	for (size_t iii = 0u; iii < FUTEX_TEST_ITEMS; iii += 2u)
+	{
+		if (0u == (iii % 4u))
+		{
+			si_semaphore_post_2(&semaphore, 2u);
+		}
+		else
+		{
+			si_semaphore_post(&semaphore);
+			si_semaphore_post(&semaphore);
+		}
+	}
+	// Consumers quit once nothing was posted for 100ms.
+	for (size_t iii = 0u; iii < FUTEX_TEST_THREADS; iii++)
+	{
+		si_thread_join(&(threads[iii]));
+	}
+	TEST_ASSERT_EQUAL_size_t(FUTEX_TEST_ITEMS, atomic_load(&consumed));
+	TEST_ASSERT_EQUAL_UINT32(0u, atomic_load(&(semaphore.value)));
+	TEST_ASSERT_EQUAL_UINT32(0u, atomic_load(&(semaphore.waiters)));
+}
+
+/** Doxygen
+ * @brief Runs all local si_futex unit tests.
+ */
+static void si_futex_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_futex_test_event);
+	RUN_TEST(si_futex_test_latch);
+	RUN_TEST(si_futex_test_semaphore);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_futex.\n");
+	si_futex_test_all();
+	(void)printf("End of si_futex testing.\n");
+	return 0;
+}
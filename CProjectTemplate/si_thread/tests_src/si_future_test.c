@@ -0,0 +1,143 @@
+// si_future_test.c
+
+#include "si_future.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <pthread.h> // pthread_create(), pthread_join()
+#include <stdint.h> // SIZE_MAX
+#include <stdio.h> // printf()
+#include <time.h> // nanosleep()
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+static int g_value = 42;
+
+static void sleep_20ms(void)
+{
+	const struct timespec delay = {.tv_sec = 0, .tv_nsec = 20000000L};
+	(void)nanosleep(&delay, NULL);
+}
+
+static void* complete_later(si_future_t* p_future)
+{
+	sleep_20ms();
+	(void)si_future_complete(p_future, &g_value);
+	return NULL;
+}
+
+static void* cancel_later(si_future_t* p_future)
+{
+	sleep_20ms();
+	(void)si_future_cancel(p_future);
+	return NULL;
+}
+
+static void si_future_test_single(void)
+{
+	si_future_t* p_future = si_future_new();
+	TEST_ASSERT_NOT_NULL(p_future);
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_PENDING, si_future_state(p_future));
+	TEST_ASSERT_FALSE(si_future_is_done(p_future));
+
+	printf("Testing si_future_wait() on another thread's completion.\n");
+	pthread_t thread = {0};
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL,
+		(void* (*)(void*))complete_later, p_future
+	));
+	TEST_ASSERT_EQUAL_PTR(&g_value, si_future_wait(p_future));
+	TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_READY, si_future_state(p_future));
+	// Completion is one-shot.
+	TEST_ASSERT_FALSE(si_future_complete(p_future, NULL));
+	TEST_ASSERT_FALSE(si_future_cancel(p_future));
+	TEST_ASSERT_EQUAL_PTR(&g_value, si_future_wait(p_future));
+
+	printf("Testing reference counting.\n");
+	si_future_t* p_copy = si_future_retain(p_future);
+	si_future_destroy(&p_copy);
+	TEST_ASSERT_NULL(p_copy);
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(p_future->ref_count)));
+	si_future_destroy(&p_future);
+	TEST_ASSERT_NULL(p_future);
+
+	printf("Testing si_future_wait() on cancellation.\n");
+	p_future = si_future_new();
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL,
+		(void* (*)(void*))cancel_later, p_future
+	));
+	TEST_ASSERT_NULL(si_future_wait(p_future));
+	TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_CANCELLED, si_future_state(p_future));
+	si_future_destroy(&p_future);
+}
+
+static void si_future_test_many(void)
+{
+	si_future_t* futures[4] = {0};
+	for (size_t iii = 0u; iii < 4u; iii++)
+	{
+		futures[iii] = si_future_new();
+		TEST_ASSERT_NOT_NULL(futures[iii]);
+	}
+	TEST_ASSERT_EQUAL_size_t(SIZE_MAX, si_future_wait_any(NULL, 4u));
+
+	printf("Testing si_future_wait_any().\n");
+	pthread_t thread = {0};
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL,
+		(void* (*)(void*))complete_later, futures[2]
+	));
+	TEST_ASSERT_EQUAL_size_t(2u, si_future_wait_any(futures, 4u));
+	TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+	// Links were removed again so completing the others is safe.
+	TEST_ASSERT_NULL(futures[2]->p_links);
+	TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&(futures[0]->waiter_count)));
+
+	printf("Testing si_future_wait_all().\n");
+	(void)si_future_complete(futures[0], NULL);
+	(void)si_future_complete(futures[3], &g_value);
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL,
+		(void* (*)(void*))complete_later, futures[1]
+	));
+	TEST_ASSERT_TRUE(si_future_wait_all(futures, 4u));
+	TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+	for (size_t iii = 0u; iii < 4u; iii++)
+	{
+		si_future_destroy(&(futures[iii]));
+	}
+
+	printf("Testing si_future_wait_all() reports a cancel.\n");
+	futures[0] = si_future_new();
+	futures[1] = si_future_new();
+	(void)si_future_complete(futures[0], &g_value);
+	(void)si_future_cancel(futures[1]);
+	TEST_ASSERT_FALSE(si_future_wait_all(futures, 2u));
+	si_future_destroy(&(futures[0]));
+	si_future_destroy(&(futures[1]));
+}
+
+/** Doxygen
+ * @brief Runs all local si_future unit tests.
+ */
+static void si_future_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_future_test_single);
+	RUN_TEST(si_future_test_many);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_future.\n");
+	si_future_test_all();
+	(void)printf("End of si_future testing.\n");
+	return 0;
+}
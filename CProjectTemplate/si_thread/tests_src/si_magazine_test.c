@@ -0,0 +1,166 @@
+// si_magazine_test.c
+
+#include "si_magazine.h"
+#include "si_thread.h" // si_thread_create(), si_thread_join()
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdint.h> // uintptr_t
+#include <stdio.h> // printf()
+#include <string.h> // memset()
+
+#define MAGAZINE_TEST_THREADS (4u)
+#define MAGAZINE_TEST_BLOCKS (1000u)
+#define MAGAZINE_TEST_ROUNDS (50u)
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+static void* blocks[MAGAZINE_TEST_BLOCKS] = {0};
+
+/** Doxygen
+ * @brief Tests blocks are aligned, zeroed by calloc() & reused once freed.
+ */
+static void si_magazine_test_reuse(void)
+{
+	si_magazine_trim();
+	TEST_ASSERT_NULL(si_magazine_calloc(SIZE_MAX, 2u));
+	for (size_t iii = 1u; iii <= (2u * SI_MAGAZINE_MAX_SIZE); iii += 7u)
+	{
+		unsigned char* const p_block = si_magazine_calloc(1u, iii);
+		TEST_ASSERT_NOT_NULL(p_block);
+		TEST_ASSERT_EQUAL_size_t(0u, (uintptr_t)p_block % 16u);
+		for (size_t jjj = 0u; jjj < iii; jjj++)
+		{
+			TEST_ASSERT_EQUAL_UINT8(0u, p_block[jjj]);
+		}
+		memset(p_block, 0xFF, iii);
+		si_magazine_free(p_block);
+	}
+	// A warm class is served without malloc().
+	void* const p_first = si_magazine_alloc(40u);
+	si_magazine_free(p_first);
+	const size_t before = si_magazine_malloc_count();
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_ROUNDS; iii++)
+	{
+		void* const p_block = si_magazine_alloc(33u);
+		TEST_ASSERT_EQUAL_PTR(p_first, p_block);
+		si_magazine_free(p_block);
+	}
+	TEST_ASSERT_EQUAL_size_t(before, si_magazine_malloc_count());
+	si_magazine_free(NULL);
+	si_magazine_thread_flush();
+	si_magazine_trim();
+}
+
+/** Doxygen
+ * @brief Local thread function freeing every block allocated by main.
+ *
+ * @param p_void Unused.
+ */
+static void* block_freer(void* p_void)
+{
+	(void)p_void;
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_BLOCKS; iii++)
+	{
+		si_magazine_free(blocks[iii]);
+		blocks[iii] = NULL;
+	}
+	si_magazine_thread_flush();
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Local thread function allocating & freeing in a loop.
+ *
+ * @param p_void Unused.
+ */
+static void* block_churner(void* p_void)
+{
+	(void)p_void;
+	void* p_local[64] = {0};
+	for (size_t round = 0u; round < MAGAZINE_TEST_ROUNDS; round++)
+	{
+		for (size_t iii = 0u; iii < 64u; iii++)
+		{
+			p_local[iii] = si_magazine_alloc(16u + (iii * 8u));
+			TEST_ASSERT_NOT_NULL(p_local[iii]);
+			memset(p_local[iii], (int)iii, 16u + (iii * 8u));
+		}
+		for (size_t iii = 0u; iii < 64u; iii++)
+		{
+			si_magazine_free(p_local[iii]);
+		}
+	}
+	si_magazine_thread_flush();
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Tests blocks freed by another thread come back through the depot.
+ */
+static void si_magazine_test_depot(void)
+{
+	si_magazine_trim();
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_BLOCKS; iii++)
+	{
+		blocks[iii] = si_magazine_alloc(64u);
+		TEST_ASSERT_NOT_NULL(blocks[iii]);
+	}
+	si_thread_t thread = {0};
+	si_thread_create(&thread, block_freer, NULL);
+	si_thread_join(&thread);
+	// Producer consumer handoff, the freed blocks are allocated again.
+	const size_t before = si_magazine_malloc_count();
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_BLOCKS; iii++)
+	{
+		blocks[iii] = si_magazine_alloc(64u);
+	}
+	const size_t fresh = si_magazine_malloc_count() - before;
+	printf("Reallocating %u handed off blocks took %zu from malloc().\n",
+		MAGAZINE_TEST_BLOCKS, fresh
+	);
+	TEST_ASSERT_TRUE(SI_MAGAZINE_SIZE * 2u >= fresh);
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_BLOCKS; iii++)
+	{
+		si_magazine_free(blocks[iii]);
+		blocks[iii] = NULL;
+	}
+
+	si_thread_t threads[MAGAZINE_TEST_THREADS] = {0};
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_THREADS; iii++)
+	{
+		si_thread_create(&(threads[iii]), block_churner, NULL);
+	}
+	for (size_t iii = 0u; iii < MAGAZINE_TEST_THREADS; iii++)
+	{
+		si_thread_join(&(threads[iii]));
+	}
+	si_magazine_thread_flush();
+	si_magazine_trim();
+}
+
+/** Doxygen
+ * @brief Runs all local si_magazine unit tests.
+ */
+static void si_magazine_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_magazine_test_reuse);
+	RUN_TEST(si_magazine_test_depot);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_magazine.\n");
+	si_magazine_test_all();
+	(void)printf("End of si_magazine testing.\n");
+	return 0;
+}
@@ -1,9 +1,21 @@
 // si_mutex_test.c
 
 #include "si_mutex.h"
+#include "si_thread.h" // si_thread_create(), si_thread_join()
 #include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
 
 #include <stdio.h> // printf()
+#include <time.h> // nanosleep()
+
+#define SEQLOCK_TEST_WRITES (20000u)
+
+static si_mutex_t held_mutex = {0};
+static volatile atomic_bool is_holding = false;
+
+static si_seqlock_t seqlock = {0};
+// Writer keeps seq_b == 2 * seq_a, so a torn read shows up as a mismatch.
+static volatile _Atomic size_t seq_a = 0u;
+static volatile _Atomic size_t seq_b = 0u;
 
 /* Is run before every test, put unit init calls here. */
 void setUp (void)
@@ -35,6 +47,131 @@ static void si_mutex_test_main(void)
 	si_mutex_free(&mutex);
 }
 
+/** Doxygen
+ * @brief Local thread function holding held_mutex for a while.
+ *
+ * @param p_void Unused.
+ */
+static void* holding_runner(void* p_void)
+{
+	(void)p_void;
+	si_mutex_lock(&held_mutex);
+	atomic_store(&is_holding, true);
+	const struct timespec hold = {0, 20000000L}; // 20ms
+	(void)nanosleep(&hold, NULL);
+	si_mutex_unlock(&held_mutex);
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Tests the lock contention counters of si_mutex_lock_2().
+ */
+static void si_mutex_test_stats(void)
+{
+	si_lock_stats_t stats = {0};
+	si_lock_stats_init(&stats);
+	TEST_ASSERT_EQUAL_INT(0, si_mutex_init(&held_mutex));
+	si_mutex_lock_2(&held_mutex, &stats);
+	si_mutex_unlock(&held_mutex);
+	TEST_ASSERT_EQUAL_UINT64(1u, atomic_load(&(stats.acquisitions)));
+	TEST_ASSERT_EQUAL_UINT64(0u, atomic_load(&(stats.contended)));
+
+	atomic_store(&is_holding, false);
+	si_thread_t thread = {0};
+	si_thread_create(&thread, holding_runner, NULL);
+	while (false == atomic_load(&is_holding))
+	{
+		si_thread_yield();
+	}
+	si_mutex_lock_2(&held_mutex, &stats);
+	si_mutex_unlock(&held_mutex);
+	si_thread_join(&thread);
+	TEST_ASSERT_EQUAL_UINT64(2u, atomic_load(&(stats.acquisitions)));
+	TEST_ASSERT_EQUAL_UINT64(1u, atomic_load(&(stats.contended)));
+	TEST_ASSERT_GREATER_THAN_UINT64(0u, atomic_load(&(stats.wait_ns)));
+	si_mutex_free(&held_mutex);
+}
+
+/** Doxygen
+ * @brief Tests shared & exclusive locking of si_rwlock_t.
+ */
+static void si_mutex_test_rwlock(void)
+{
+	si_lock_stats_t stats = {0};
+	si_lock_stats_init(&stats);
+	si_rwlock_t rwlock = {0};
+	TEST_ASSERT_EQUAL_INT(0, si_rwlock_init_2(&rwlock, &stats));
+	si_rwlock_read_lock(&rwlock);
+	TEST_ASSERT_TRUE(si_rwlock_try_read_lock(&rwlock));
+	TEST_ASSERT_FALSE(si_rwlock_try_write_lock(&rwlock));
+	si_rwlock_read_unlock(&rwlock);
+	si_rwlock_read_unlock(&rwlock);
+
+	si_rwlock_write_lock(&rwlock);
+	TEST_ASSERT_FALSE(si_rwlock_try_read_lock(&rwlock));
+	TEST_ASSERT_FALSE(si_rwlock_try_write_lock(&rwlock));
+	si_rwlock_write_unlock(&rwlock);
+	TEST_ASSERT_TRUE(si_rwlock_try_write_lock(&rwlock));
+	si_rwlock_write_unlock(&rwlock);
+	// Only the blocking locks are counted.
+	TEST_ASSERT_EQUAL_UINT64(2u, atomic_load(&(stats.acquisitions)));
+	TEST_ASSERT_EQUAL_UINT64(0u, atomic_load(&(stats.contended)));
+	si_rwlock_free(&rwlock);
+}
+
+/** Doxygen
+ * @brief Local thread function updating the seqlock protected pair.
+ *
+ * @param p_void Unused.
+ */
+static void* seqlock_writer(void* p_void)
+{
+	(void)p_void;
+	for (size_t iii = 1u; iii <= SEQLOCK_TEST_WRITES; iii++)
+	{
+		si_seqlock_write_lock(&seqlock);
+		atomic_store_explicit(&seq_a, iii, memory_order_relaxed);
+		atomic_store_explicit(&seq_b, iii * 2u, memory_order_relaxed);
+		si_seqlock_write_unlock(&seqlock);
+		if (0u == (iii % 64u))
+		{
+			si_thread_yield();
+		}
+	}
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Tests readers never see a torn update under si_seqlock_t.
+ */
+static void si_mutex_test_seqlock(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, si_seqlock_init(&seqlock));
+	atomic_store(&seq_a, 0u);
+	atomic_store(&seq_b, 0u);
+	si_thread_t thread = {0};
+	si_thread_create(&thread, seqlock_writer, NULL);
+	size_t a = 0u;
+	while (SEQLOCK_TEST_WRITES > a)
+	{
+		size_t b = 0u;
+		size_t sequence = 0u;
+		do
+		{
+			sequence = si_seqlock_read_begin(&seqlock);
+			a = atomic_load_explicit(&seq_a, memory_order_relaxed);
+			b = atomic_load_explicit(&seq_b, memory_order_relaxed);
+		} while (true == si_seqlock_read_retry(&seqlock, sequence));
+		TEST_ASSERT_EQUAL_size_t(a * 2u, b);
+		TEST_ASSERT_EQUAL_size_t(0u, sequence & 1u);
+	}
+	si_thread_join(&thread);
+	TEST_ASSERT_EQUAL_size_t(SEQLOCK_TEST_WRITES * 2u,
+		atomic_load(&(seqlock.sequence))
+	);
+	si_seqlock_free(&seqlock);
+}
+
 /** Doxygen
  * @brief Runs all local si_mutex_t unit tests.
  */
@@ -42,6 +179,9 @@ static void si_mutex_test_all(void)
 {
 	UNITY_BEGIN();
 	RUN_TEST(si_mutex_test_main);
+	RUN_TEST(si_mutex_test_stats);
+	RUN_TEST(si_mutex_test_rwlock);
+	RUN_TEST(si_mutex_test_seqlock);
 	UNITY_END();
 }
 
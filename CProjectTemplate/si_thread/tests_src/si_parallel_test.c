@@ -0,0 +1,242 @@
+// si_parallel_test.c
+
+#include "si_parallel.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdint.h> // uint64_t
+#include <stdio.h> // printf()
+#include <stdlib.h> // qsort()
+#include <string.h> // memcpy()
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+static int si_parallel_test_cmp_u64(const void* const p_left,
+	const void* const p_right)
+{
+	const uint64_t left = *(const uint64_t*)p_left;
+	const uint64_t right = *(const uint64_t*)p_right;
+	return (left > right) - (left < right);
+}
+
+static void si_parallel_test_fill(si_array_t* const p_array)
+{
+	uint64_t state = 0x9E3779B97F4A7C15ull;
+	for (size_t iii = 0u; iii < p_array->capacity; iii++)
+	{
+		state ^= state << 13u;
+		state ^= state >> 7u;
+		state ^= state << 17u;
+		// Keep the range small enough to produce duplicates.
+		const uint64_t value = state % 50000u;
+		si_array_set(p_array, iii, &value);
+	}
+}
+
+/** Doxygen
+ * @brief Runs parallel sort & batched search against a live threadpool.
+ */
+static void si_parallel_test_main(void)
+{
+	const size_t count = 200000u;
+	si_array_t array = {0};
+	si_array_t expected = {0};
+	si_array_init_3(&array, sizeof(uint64_t), count);
+	si_array_init_3(&expected, sizeof(uint64_t), count);
+	si_parallel_test_fill(&array);
+	memcpy(expected.p_data, array.p_data, count * sizeof(uint64_t));
+	qsort(expected.p_data, count, sizeof(uint64_t), si_parallel_test_cmp_u64);
+
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+
+	printf("Testing si_parallel_sort().\n");
+	TEST_ASSERT_TRUE(si_parallel_sort(&pool, &array, si_parallel_test_cmp_u64));
+	TEST_ASSERT_EQUAL_MEMORY(
+		expected.p_data, array.p_data, count * sizeof(uint64_t)
+	);
+
+	printf("Testing si_parallel_bsearch_many().\n");
+	si_array_t keys = {0};
+	si_array_init_3(&keys, sizeof(uint64_t), 10000u);
+	for (size_t iii = 0u; iii < keys.capacity; iii++)
+	{
+		// Even keys probe stored values, odd keys probe past the range.
+		const uint64_t key = (0u == (iii % 2u)) ?
+			*(const uint64_t*)si_array_at(&expected, iii * 7u) :
+			(uint64_t)(100000u + iii);
+		si_array_set(&keys, iii, &key);
+	}
+	si_array_t indexes = {0};
+	TEST_ASSERT_TRUE(si_parallel_bsearch_many(
+		&pool, &array, &keys, &indexes, si_parallel_test_cmp_u64
+	));
+	TEST_ASSERT_EQUAL_size_t(keys.capacity, indexes.capacity);
+	for (size_t iii = 0u; iii < keys.capacity; iii++)
+	{
+		const size_t index = *(const size_t*)si_array_at(&indexes, iii);
+		if (0u == (iii % 2u))
+		{
+			TEST_ASSERT_NOT_EQUAL(SIZE_MAX, index);
+			TEST_ASSERT_EQUAL_UINT64(
+				*(const uint64_t*)si_array_at(&keys, iii),
+				*(const uint64_t*)si_array_at(&array, index)
+			);
+		}
+		else
+		{
+			TEST_ASSERT_EQUAL_size_t(SIZE_MAX, index);
+		}
+	}
+	si_array_free(&indexes);
+	si_array_free(&keys);
+	// Jobs run as parallel_for() chunks, nothing goes through the results.
+	TEST_ASSERT_EQUAL_size_t(0u, si_parray_count(&(pool.results)));
+
+	si_threadpool_free(&pool);
+
+	printf("Testing si_parallel_sort() without a running pool.\n");
+	si_parallel_test_fill(&array);
+	TEST_ASSERT_TRUE(si_parallel_sort(NULL, &array, si_parallel_test_cmp_u64));
+	TEST_ASSERT_EQUAL_MEMORY(
+		expected.p_data, array.p_data, count * sizeof(uint64_t)
+	);
+	si_array_free(&expected);
+	si_array_free(&array);
+}
+
+static void si_parallel_test_halve(void* const p_out, const void* const p_in,
+	void* const p_context)
+{
+	(void)p_context;
+	*(double*)p_out = (double)*(const uint64_t*)p_in * 0.5;
+}
+
+static void si_parallel_test_add_u64(void* const p_accumulator,
+	const void* const p_element)
+{
+	*(uint64_t*)p_accumulator += *(const uint64_t*)p_element;
+}
+
+static void si_parallel_test_add_double(void* const p_accumulator,
+	const void* const p_element)
+{
+	*(double*)p_accumulator += *(const double*)p_element;
+}
+
+/** Doxygen
+ * @brief Runs parallel map, reduce & inclusive_scan, checking floating point
+ *        results match bit for bit with & without a running pool.
+ */
+static void si_parallel_test_map_reduce_scan(void)
+{
+	const size_t count = 100003u;
+	si_array_t array = {0};
+	si_array_init_3(&array, sizeof(uint64_t), count);
+	si_parallel_test_fill(&array);
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+
+	printf("Testing si_parallel_map().\n");
+	si_array_t halves = {0};
+	TEST_ASSERT_TRUE(si_parallel_map(&pool, &array, &halves, sizeof(double),
+		si_parallel_test_halve, NULL
+	));
+	TEST_ASSERT_EQUAL_size_t(count, halves.capacity);
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		const uint64_t value = *(const uint64_t*)si_array_at(&array, iii);
+		const double half = (double)value * 0.5;
+		TEST_ASSERT_EQUAL_MEMORY(
+			&half, si_array_at(&halves, iii), sizeof(double)
+		);
+	}
+
+	printf("Testing si_parallel_reduce().\n");
+	uint64_t expected = 7u;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		expected += *(const uint64_t*)si_array_at(&array, iii);
+	}
+	uint64_t total = 7u;
+	TEST_ASSERT_TRUE(si_parallel_reduce(
+		&pool, &array, &total, si_parallel_test_add_u64
+	));
+	TEST_ASSERT_EQUAL_UINT64(expected, total);
+	double sum = 0.0;
+	double inline_sum = 0.0;
+	TEST_ASSERT_TRUE(si_parallel_reduce(
+		&pool, &halves, &sum, si_parallel_test_add_double
+	));
+	TEST_ASSERT_TRUE(si_parallel_reduce(
+		NULL, &halves, &inline_sum, si_parallel_test_add_double
+	));
+	TEST_ASSERT_EQUAL_MEMORY(&inline_sum, &sum, sizeof(double));
+
+	printf("Testing si_parallel_inclusive_scan().\n");
+	si_array_t prefixes = {0};
+	si_array_init_3(&prefixes, sizeof(uint64_t), count);
+	memcpy(prefixes.p_data, array.p_data, count * sizeof(uint64_t));
+	TEST_ASSERT_TRUE(si_parallel_inclusive_scan(
+		&pool, &prefixes, si_parallel_test_add_u64
+	));
+	uint64_t running = 0u;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		running += *(const uint64_t*)si_array_at(&array, iii);
+		TEST_ASSERT_EQUAL_UINT64(
+			running, *(const uint64_t*)si_array_at(&prefixes, iii)
+		);
+	}
+	si_array_t inline_halves = {0};
+	si_array_init_3(&inline_halves, sizeof(double), count);
+	memcpy(inline_halves.p_data, halves.p_data, count * sizeof(double));
+	TEST_ASSERT_TRUE(si_parallel_inclusive_scan(
+		&pool, &halves, si_parallel_test_add_double
+	));
+	TEST_ASSERT_TRUE(si_parallel_inclusive_scan(
+		NULL, &inline_halves, si_parallel_test_add_double
+	));
+	TEST_ASSERT_EQUAL_MEMORY(
+		inline_halves.p_data, halves.p_data, count * sizeof(double)
+	);
+	// The last prefix is the same fold as reduce().
+	TEST_ASSERT_EQUAL_MEMORY(
+		&sum, si_array_at(&halves, count - 1u), sizeof(double)
+	);
+	TEST_ASSERT_EQUAL_size_t(0u, si_parray_count(&(pool.results)));
+
+	si_threadpool_free(&pool);
+	si_array_free(&inline_halves);
+	si_array_free(&prefixes);
+	si_array_free(&halves);
+	si_array_free(&array);
+}
+
+/** Doxygen
+ * @brief Runs all local si_parallel unit tests.
+ */
+static void si_parallel_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_parallel_test_main);
+	RUN_TEST(si_parallel_test_map_reduce_scan);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_parallel.\n");
+	si_parallel_test_all();
+	(void)printf("End of si_parallel testing.\n");
+	return 0;
+}
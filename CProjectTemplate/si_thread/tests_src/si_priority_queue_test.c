@@ -68,11 +68,139 @@ void si_priority_queue_test_modify(void)
 	TEST_ASSERT_NULL(p_queue);
 }
 
+void si_priority_queue_test_batch(void)
+{
+	int p_data[100] = {0};
+	void* pp_data[100] = {0};
+	for (size_t iii = 0u; iii < 100u; iii++)
+	{
+		p_data[iii] = (int)iii;
+		pp_data[iii] = &(p_data[iii]);
+	}
+	si_priority_queue_t* p_queue = si_priority_queue_new(4u);
+	TEST_ASSERT_NOT_NULL(p_queue);
+	TEST_ASSERT_EQUAL_size_t(0u, si_priority_queue_enqueue_batch(
+		p_queue, (void* const*)pp_data, 100u, 4u
+	));
+	TEST_ASSERT_EQUAL_size_t(40u, si_priority_queue_enqueue_batch(
+		p_queue, (void* const*)pp_data, 40u, 1u
+	));
+	TEST_ASSERT_EQUAL_size_t(60u, si_priority_queue_enqueue_batch(
+		p_queue, (void* const*)&(pp_data[40]), 60u, 1u
+	));
+	// A NULL entry ends the batch early.
+	pp_data[3] = NULL;
+	TEST_ASSERT_EQUAL_size_t(3u, si_priority_queue_enqueue_batch(
+		p_queue, (void* const*)pp_data, 10u, 3u
+	));
+	TEST_ASSERT_EQUAL_size_t(103u, si_priority_queue_count(p_queue));
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		int* p_next = si_priority_queue_dequeue(p_queue);
+		TEST_ASSERT_EQUAL_INT((int)iii, *p_next);
+	}
+	// Batches keep their FIFO order within a priority.
+	for (size_t iii = 0u; iii < 100u; iii++)
+	{
+		int* p_next = si_priority_queue_dequeue(p_queue);
+		TEST_ASSERT_NOT_NULL(p_next);
+		TEST_ASSERT_EQUAL_INT((int)iii, *p_next);
+	}
+	si_priority_queue_destroy(&p_queue);
+}
+
+void si_priority_queue_test_weighted(void)
+{
+	int low[100] = {0};
+	int high[100] = {0};
+	si_priority_queue_t* p_queue = si_priority_queue_new(2u);
+	TEST_ASSERT_NOT_NULL(p_queue);
+	const size_t too_heavy[] = { SI_PRIORITY_QUEUE_MAX_SCHEDULE, 1u };
+	TEST_ASSERT_FALSE(si_priority_queue_set_weights(p_queue, too_heavy));
+	const size_t weights[] = { 1u, 3u };
+	TEST_ASSERT_TRUE(si_priority_queue_set_weights(p_queue, weights));
+	for (size_t iii = 0u; iii < 100u; iii++)
+	{
+		TEST_ASSERT_TRUE(si_priority_queue_enqueue(p_queue, &(low[iii]), 0u));
+		TEST_ASSERT_TRUE(si_priority_queue_enqueue(p_queue, &(high[iii]), 1u));
+	}
+	// Background work keeps a quarter of the turns while both levels wait.
+	for (size_t iii = 0u; iii < 40u; iii++)
+	{
+		TEST_ASSERT_NOT_NULL(si_priority_queue_dequeue(p_queue));
+	}
+	TEST_ASSERT_EQUAL_size_t(90u, si_priority_queue_count_at(p_queue, 0u));
+	TEST_ASSERT_EQUAL_size_t(70u, si_priority_queue_count_at(p_queue, 1u));
+	// Turns of an empty level are not wasted.
+	for (size_t iii = 0u; iii < 160u; iii++)
+	{
+		TEST_ASSERT_NOT_NULL(si_priority_queue_dequeue(p_queue));
+	}
+	TEST_ASSERT_TRUE(si_priority_queue_is_empty(p_queue));
+	TEST_ASSERT_TRUE(si_priority_queue_set_weights(p_queue, NULL));
+	TEST_ASSERT_NULL(p_queue->p_schedule);
+	si_priority_queue_destroy(&p_queue);
+}
+
+void si_priority_queue_test_aging(void)
+{
+	int p_data[8] = {0};
+	si_priority_queue_t* p_queue = si_priority_queue_new(3u);
+	TEST_ASSERT_NOT_NULL(p_queue);
+	for (size_t iii = 0u; iii < 4u; iii++)
+	{
+		TEST_ASSERT_TRUE(
+			si_priority_queue_enqueue(p_queue, &(p_data[iii]), 0u)
+		);
+	}
+	// Feeding moves every level up once, clamped to the top.
+	TEST_ASSERT_EQUAL_size_t(4u, si_priority_queue_feed(p_queue, 1u));
+	TEST_ASSERT_EQUAL_size_t(0u, si_priority_queue_count_at(p_queue, 0u));
+	TEST_ASSERT_EQUAL_size_t(4u, si_priority_queue_count_at(p_queue, 1u));
+	TEST_ASSERT_EQUAL_size_t(4u, si_priority_queue_feed(p_queue, 5u));
+	TEST_ASSERT_EQUAL_size_t(4u, si_priority_queue_count_at(p_queue, 2u));
+	TEST_ASSERT_EQUAL_size_t(0u, si_priority_queue_feed(p_queue, 1u));
+	for (size_t iii = 0u; iii < 4u; iii++)
+	{
+		TEST_ASSERT_EQUAL_PTR(
+			&(p_data[iii]), si_priority_queue_dequeue(p_queue)
+		);
+	}
+
+	// Every second turn promotes the oldest entry of level 0 then level 1.
+	si_priority_queue_set_aging(p_queue, 2u);
+	TEST_ASSERT_TRUE(si_priority_queue_enqueue(p_queue, &(p_data[0]), 0u));
+	for (size_t iii = 1u; iii < 8u; iii++)
+	{
+		TEST_ASSERT_TRUE(
+			si_priority_queue_enqueue(p_queue, &(p_data[iii]), 2u)
+		);
+	}
+	TEST_ASSERT_EQUAL_PTR(&(p_data[1]), si_priority_queue_dequeue(p_queue));
+	TEST_ASSERT_EQUAL_PTR(&(p_data[2]), si_priority_queue_dequeue(p_queue));
+	TEST_ASSERT_EQUAL_size_t(1u, si_priority_queue_count_at(p_queue, 1u));
+	TEST_ASSERT_EQUAL_PTR(&(p_data[3]), si_priority_queue_dequeue(p_queue));
+	TEST_ASSERT_EQUAL_PTR(&(p_data[4]), si_priority_queue_dequeue(p_queue));
+	// Reached the top level behind the entries already waiting there.
+	TEST_ASSERT_EQUAL_size_t(4u, si_priority_queue_count_at(p_queue, 2u));
+	for (size_t iii = 5u; iii < 8u; iii++)
+	{
+		TEST_ASSERT_EQUAL_PTR(
+			&(p_data[iii]), si_priority_queue_dequeue(p_queue)
+		);
+	}
+	TEST_ASSERT_EQUAL_PTR(&(p_data[0]), si_priority_queue_dequeue(p_queue));
+	si_priority_queue_destroy(&p_queue);
+}
+
 void si_priority_queue_test_all(void)
 {
 	UNITY_BEGIN();
 	//RUN_TEST(si_priority_queue_test_init);
 	RUN_TEST(si_priority_queue_test_modify);
+	RUN_TEST(si_priority_queue_test_batch);
+	RUN_TEST(si_priority_queue_test_weighted);
+	RUN_TEST(si_priority_queue_test_aging);
 	UNITY_END();
 }
 
@@ -0,0 +1,240 @@
+// si_task_graph_test.c
+
+#include "si_task_graph.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdatomic.h> // atomic_fetch_add()
+#include <stdio.h> // printf()
+#include <unistd.h> // usleep()
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+// Global step counter, each node records the step it ran at.
+static volatile _Atomic size_t g_step = 0u;
+
+typedef struct stage_t
+{
+	size_t step;
+	size_t runs;
+} stage_t;
+
+static void* stage_task(void* p_param)
+{
+	stage_t* const p_stage = p_param;
+	p_stage->step = atomic_fetch_add(&g_step, 1u);
+	p_stage->runs++;
+	return p_stage;
+}
+
+/** Doxygen
+ * @brief Runs a diamond, a long chain & a wide fan-out/fan-in on p_pool.
+ */
+static void si_task_graph_test_shapes(si_threadpool_t* const p_pool)
+{
+	si_task_graph_t graph = {0};
+	TEST_ASSERT_TRUE(si_task_graph_init(&graph));
+
+	printf("Testing diamond a -> (b, c) -> d.\n");
+	stage_t stages[4] = {0};
+	size_t nodes[4] = {0};
+	for (size_t iii = 0u; iii < 4u; iii++)
+	{
+		nodes[iii] = si_task_graph_add_3(&graph, stage_task, &(stages[iii]));
+		TEST_ASSERT_EQUAL_size_t(iii, nodes[iii]);
+	}
+	TEST_ASSERT_TRUE(si_task_graph_precede(&graph, nodes[0], nodes[1]));
+	TEST_ASSERT_TRUE(si_task_graph_precede(&graph, nodes[0], nodes[2]));
+	TEST_ASSERT_TRUE(si_task_graph_precede(&graph, nodes[1], nodes[3]));
+	TEST_ASSERT_TRUE(si_task_graph_precede(&graph, nodes[2], nodes[3]));
+	TEST_ASSERT_FALSE(si_task_graph_precede(&graph, nodes[3], nodes[3]));
+	TEST_ASSERT_FALSE(si_task_graph_precede(&graph, nodes[3], 4u));
+	// Run twice to check the graph resets between runs.
+	for (size_t run = 1u; run <= 2u; run++)
+	{
+		TEST_ASSERT_TRUE(si_task_graph_run(&graph, p_pool));
+		TEST_ASSERT_TRUE(si_task_graph_wait(&graph));
+		TEST_ASSERT_LESS_THAN_size_t(stages[1].step, stages[0].step);
+		TEST_ASSERT_LESS_THAN_size_t(stages[2].step, stages[0].step);
+		TEST_ASSERT_LESS_THAN_size_t(stages[3].step, stages[1].step);
+		TEST_ASSERT_LESS_THAN_size_t(stages[3].step, stages[2].step);
+		for (size_t iii = 0u; iii < 4u; iii++)
+		{
+			TEST_ASSERT_EQUAL_size_t(run, stages[iii].runs);
+			TEST_ASSERT_EQUAL_PTR(
+				&(stages[iii]), si_task_graph_result(&graph, nodes[iii])
+			);
+		}
+	}
+	si_task_graph_free(&graph);
+
+	printf("Testing a 1000 stage chain.\n");
+	stage_t chain[1000] = {0};
+	TEST_ASSERT_TRUE(si_task_graph_init(&graph));
+	for (size_t iii = 0u; iii < 1000u; iii++)
+	{
+		(void)si_task_graph_add_3(&graph, stage_task, &(chain[iii]));
+		if (0u < iii)
+		{
+			TEST_ASSERT_TRUE(si_task_graph_precede(&graph, iii - 1u, iii));
+		}
+	}
+	TEST_ASSERT_TRUE(si_task_graph_run(&graph, p_pool));
+	TEST_ASSERT_TRUE(si_task_graph_wait(&graph));
+	for (size_t iii = 1u; iii < 1000u; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(chain[iii - 1u].step + 1u, chain[iii].step);
+	}
+	si_task_graph_free(&graph);
+
+	printf("Testing fan-out to 500 nodes & back in.\n");
+	stage_t wide[502] = {0};
+	TEST_ASSERT_TRUE(si_task_graph_init(&graph));
+	for (size_t iii = 0u; iii < 502u; iii++)
+	{
+		(void)si_task_graph_add_3(&graph, stage_task, &(wide[iii]));
+	}
+	for (size_t iii = 1u; iii <= 500u; iii++)
+	{
+		TEST_ASSERT_TRUE(si_task_graph_precede(&graph, 0u, iii));
+		TEST_ASSERT_TRUE(si_task_graph_precede(&graph, iii, 501u));
+	}
+	TEST_ASSERT_TRUE(si_task_graph_run(&graph, p_pool));
+	TEST_ASSERT_TRUE(si_task_graph_wait(&graph));
+	for (size_t iii = 1u; iii <= 500u; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(1u, wide[iii].runs);
+		TEST_ASSERT_LESS_THAN_size_t(wide[iii].step, wide[0].step);
+		TEST_ASSERT_LESS_THAN_size_t(wide[501].step, wide[iii].step);
+	}
+	si_task_graph_free(&graph);
+}
+
+static void si_task_graph_test_pool(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+	si_task_graph_test_shapes(&pool);
+	// Nothing in a graph run stores a threadpool result.
+	TEST_ASSERT_EQUAL_size_t(0u, si_parray_count(&(pool.results)));
+	si_threadpool_free(&pool);
+
+	si_threadpool_t* p_pool = si_threadpool_new_2(1u, true);
+	si_threadpool_start_2(p_pool, 4u);
+	si_task_graph_test_shapes(p_pool);
+	si_threadpool_destroy(&p_pool);
+}
+
+static void si_task_graph_test_inline(void)
+{
+	si_task_graph_test_shapes(NULL);
+
+	printf("Testing cycle detection.\n");
+	si_task_graph_t* p_graph = si_task_graph_new();
+	TEST_ASSERT_NOT_NULL(p_graph);
+	stage_t stages[3] = {0};
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		(void)si_task_graph_add_3(p_graph, stage_task, &(stages[iii]));
+	}
+	TEST_ASSERT_TRUE(si_task_graph_precede(p_graph, 0u, 1u));
+	TEST_ASSERT_TRUE(si_task_graph_precede(p_graph, 1u, 2u));
+	TEST_ASSERT_TRUE(si_task_graph_precede(p_graph, 2u, 1u));
+	TEST_ASSERT_FALSE(si_task_graph_run(p_graph, NULL));
+	TEST_ASSERT_FALSE(si_task_graph_wait(p_graph));
+	TEST_ASSERT_EQUAL_size_t(0u, stages[0].runs);
+	si_task_graph_destroy(&p_graph);
+	TEST_ASSERT_NULL(p_graph);
+
+	printf("Testing an empty graph.\n");
+	p_graph = si_task_graph_new();
+	TEST_ASSERT_TRUE(si_task_graph_run(p_graph, NULL));
+	TEST_ASSERT_TRUE(si_task_graph_wait(p_graph));
+	si_task_graph_destroy(&p_graph);
+}
+
+static si_threadpool_t* p_stop_pool = NULL;
+static volatile atomic_bool is_blocker_running = false;
+
+static void* blocker_task(void* p_param)
+{
+	(void)p_param;
+	atomic_store(&is_blocker_running, true);
+	while (true != si_threadpool_is_cancelled(p_stop_pool))
+	{
+		usleep(1000);
+	}
+	return NULL;
+}
+
+static void si_task_graph_test_stop(void)
+{
+	p_stop_pool = si_threadpool_new_1(1u);
+	TEST_ASSERT_NOT_NULL(p_stop_pool);
+	si_threadpool_start_2(p_stop_pool, 1u);
+	// Keeps the only worker busy so the root is still queued at shutdown.
+	TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID,
+		si_threadpool_enqueue_3(p_stop_pool, blocker_task, NULL)
+	);
+	while (true != atomic_load(&is_blocker_running))
+	{
+		usleep(1000);
+	}
+	si_task_graph_t graph = {0};
+	TEST_ASSERT_TRUE(si_task_graph_init(&graph));
+	stage_t stages[3] = {0};
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		(void)si_task_graph_add_3(&graph, stage_task, &(stages[iii]));
+	}
+	TEST_ASSERT_TRUE(si_task_graph_precede(&graph, 0u, 1u));
+	TEST_ASSERT_TRUE(si_task_graph_precede(&graph, 0u, 2u));
+	TEST_ASSERT_TRUE(si_task_graph_run(&graph, p_stop_pool));
+
+	printf("Testing a run whose root the pool drops.\n");
+	si_threadpool_shutdown_2(p_stop_pool, false);
+	TEST_ASSERT_FALSE(si_task_graph_wait(&graph));
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(0u, stages[iii].runs);
+	}
+	TEST_ASSERT_FALSE(atomic_load(&(graph.is_running)));
+
+	// The next run goes inline on the stopped pool.
+	TEST_ASSERT_TRUE(si_task_graph_run(&graph, p_stop_pool));
+	TEST_ASSERT_TRUE(si_task_graph_wait(&graph));
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(1u, stages[iii].runs);
+	}
+	si_task_graph_free(&graph);
+	si_threadpool_destroy(&p_stop_pool);
+}
+
+/** Doxygen
+ * @brief Runs all local si_task_graph unit tests.
+ */
+static void si_task_graph_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_task_graph_test_pool);
+	RUN_TEST(si_task_graph_test_inline);
+	RUN_TEST(si_task_graph_test_stop);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_task_graph.\n");
+	si_task_graph_test_all();
+	(void)printf("End of si_task_graph testing.\n");
+	return 0;
+}
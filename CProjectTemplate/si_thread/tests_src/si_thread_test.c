@@ -43,6 +43,32 @@ static void si_thread_test_main(void)
 	printf("Core count: %lu.\n", core_count);
 	TEST_ASSERT_GREATER_THAN_size_t(0u, core_count);
 
+	const size_t node_count = si_cpu_numa_node_count();
+	printf("NUMA node count: %lu.\n", node_count);
+	TEST_ASSERT_GREATER_THAN_size_t(0u, node_count);
+	size_t cpus[SI_THREAD_CPULIST_MAX] = {0};
+	const size_t cpu_count = si_cpu_numa_node_cpus(0u, cpus, SI_THREAD_CPULIST_MAX);
+	TEST_ASSERT_GREATER_THAN_size_t(0u, cpu_count);
+	TEST_ASSERT_EQUAL_size_t(0u, si_cpu_numa_node_cpus(node_count, cpus, 1u));
+#ifdef __linux__
+	// Pinning is undone afterwards so later tests run on every CPU again.
+	cpu_set_t saved;
+	CPU_ZERO(&saved);
+	TEST_ASSERT_EQUAL_INT(0, pthread_getaffinity_np(
+		pthread_self(), sizeof(saved), &saved
+	));
+	TEST_ASSERT_TRUE(si_thread_pin_cpus(cpus, cpu_count));
+	cpu_set_t pinned;
+	CPU_ZERO(&pinned);
+	TEST_ASSERT_EQUAL_INT(0, pthread_getaffinity_np(
+		pthread_self(), sizeof(pinned), &pinned
+	));
+	TEST_ASSERT_TRUE(CPU_ISSET(cpus[0], &pinned));
+	TEST_ASSERT_EQUAL_INT(0, pthread_setaffinity_np(
+		pthread_self(), sizeof(saved), &saved
+	));
+#endif//__linux__
+
 	int value = 0;
 	si_thread_t thread = {0};
 	si_thread_create(&thread, test_runner, &value);
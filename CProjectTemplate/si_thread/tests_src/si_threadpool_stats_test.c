@@ -0,0 +1,175 @@
+// si_threadpool_stats_test.c
+
+#include "si_threadpool_stats.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdio.h> // printf(), tmpfile()
+#include <string.h> // strstr()
+
+// Freed by tearDown() so a failed assertion doesn't leak them.
+static si_threadpool_t* p_pool = NULL;
+static si_threadpool_stats_t stats = {0};
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+	si_threadpool_stats_init(&stats);
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+	si_threadpool_destroy(&p_pool);
+	si_threadpool_stats_free(&stats);
+}
+
+static void si_threadpool_stats_test_histogram(void)
+{
+	TEST_ASSERT_EQUAL_size_t(0u, si_threadpool_stats_bucket(0u));
+	TEST_ASSERT_EQUAL_size_t(0u, si_threadpool_stats_bucket(1u));
+	TEST_ASSERT_EQUAL_size_t(1u, si_threadpool_stats_bucket(2u));
+	TEST_ASSERT_EQUAL_size_t(1u, si_threadpool_stats_bucket(3u));
+	TEST_ASSERT_EQUAL_size_t(10u, si_threadpool_stats_bucket(1024u));
+	TEST_ASSERT_EQUAL_size_t(10u, si_threadpool_stats_bucket(2047u));
+	TEST_ASSERT_EQUAL_size_t(
+		SI_THREADPOOL_STATS_BUCKETS - 1u, si_threadpool_stats_bucket(UINT64_MAX)
+	);
+
+	si_threadpool_histogram_t histogram = {0};
+	TEST_ASSERT_EQUAL_UINT64(
+		0u, si_threadpool_histogram_percentile(&histogram, 0.5)
+	);
+	// 90 samples around 1us, 10 around 1ms.
+	histogram.buckets[si_threadpool_stats_bucket(1000u)] = 90u;
+	histogram.buckets[si_threadpool_stats_bucket(1000000u)] = 10u;
+	histogram.count = 100u;
+	TEST_ASSERT_EQUAL_UINT64(
+		1024u, si_threadpool_histogram_percentile(&histogram, 0.5)
+	);
+	TEST_ASSERT_EQUAL_UINT64(
+		1024u, si_threadpool_histogram_percentile(&histogram, 0.9)
+	);
+	TEST_ASSERT_EQUAL_UINT64(
+		1048576u, si_threadpool_histogram_percentile(&histogram, 0.99)
+	);
+	TEST_ASSERT_EQUAL_UINT64(
+		0u, si_threadpool_histogram_percentile(&histogram, 1.5)
+	);
+}
+
+static void* count_task(volatile _Atomic size_t* p_count)
+{
+	atomic_fetch_add(p_count, 1u);
+	return NULL;
+}
+
+/** Doxygen
+ * @brief Writes p_stats with p_print_f into buffer through a tmpfile().
+ *
+ * @return Returns the number of bytes written.
+ */
+static size_t si_threadpool_stats_test_print(
+	void (*p_print_f)(FILE* const, const si_threadpool_stats_t* const),
+	const si_threadpool_stats_t* const p_stats, char* const buffer,
+	const size_t buffer_size)
+{
+	FILE* const p_file = tmpfile();
+	TEST_ASSERT_NOT_NULL(p_file);
+	p_print_f(p_file, p_stats);
+	rewind(p_file);
+	const size_t length = fread(buffer, 1u, buffer_size - 1u, p_file);
+	fclose(p_file);
+	buffer[length] = '\0';
+	return length;
+}
+
+static void si_threadpool_stats_test_snapshot(void)
+{
+	p_pool = si_threadpool_new_1(3u);
+	TEST_ASSERT_NOT_NULL(p_pool);
+	TEST_ASSERT_FALSE(si_threadpool_stats_snapshot(NULL, &stats));
+#if SI_THREADPOOL_STATS
+	// Queued tasks show up per priority before any worker runs. Static so
+	// tasks still running after a failed assertion have it to write to.
+	static volatile _Atomic size_t count = 0u;
+	for (size_t iii = 0u; iii < 30u; iii++)
+	{
+		TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID,
+			si_threadpool_enqueue_5(
+				p_pool, (p_task_f)count_task, (void*)&count, true, iii % 3u
+			)
+		);
+	}
+	TEST_ASSERT_TRUE(si_threadpool_stats_snapshot(p_pool, &stats));
+	TEST_ASSERT_EQUAL_size_t(3u, stats.queue_depths.capacity);
+	for (size_t iii = 0u; iii < 3u; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(
+			10u, *(size_t*)si_array_at(&(stats.queue_depths), iii)
+		);
+	}
+	TEST_ASSERT_EQUAL_size_t(30u, stats.pending_count);
+	TEST_ASSERT_EQUAL_UINT64(0u, stats.tasks_run);
+
+	si_threadpool_start_2(p_pool, 2u);
+	while (30u > atomic_load(&count))
+	{
+		si_thread_yield();
+	}
+	// Counters are written right after each task returns.
+	do
+	{
+		TEST_ASSERT_TRUE(si_threadpool_stats_snapshot(p_pool, &stats));
+	} while (30u > stats.tasks_run);
+	TEST_ASSERT_EQUAL_size_t(2u, stats.worker_count);
+	TEST_ASSERT_EQUAL_UINT64(30u, stats.tasks_run);
+	TEST_ASSERT_EQUAL_UINT64(30u, stats.wait.count);
+	TEST_ASSERT_EQUAL_UINT64(30u, stats.run.count);
+	TEST_ASSERT_EQUAL_UINT64(stats.busy_ns, stats.run.sum_ns);
+	TEST_ASSERT_TRUE(0u < stats.wait.sum_ns);
+	TEST_ASSERT_EQUAL_size_t(0u, stats.pending_count);
+
+	char buffer[2048] = {0};
+	TEST_ASSERT_TRUE(0u < si_threadpool_stats_test_print(
+		si_threadpool_stats_fprint, &stats, buffer, sizeof(buffer)
+	));
+	TEST_ASSERT_NOT_NULL(strstr(buffer, "workers=2 "));
+	TEST_ASSERT_NOT_NULL(strstr(buffer, "queue depths: 0 0 0\n"));
+	TEST_ASSERT_NOT_NULL(strstr(buffer, "tasks_run=30 "));
+
+	TEST_ASSERT_TRUE(0u < si_threadpool_stats_test_print(
+		si_threadpool_stats_fprint_json, &stats, buffer, sizeof(buffer)
+	));
+	TEST_ASSERT_EQUAL_CHAR('{', buffer[0]);
+	TEST_ASSERT_NOT_NULL(strstr(buffer, "\"tasks_run\":30,"));
+	TEST_ASSERT_NOT_NULL(strstr(buffer, "\"queue_depths\":[0,0,0]"));
+
+	// Counters survive a restart.
+	si_threadpool_stop(p_pool);
+	si_threadpool_start_2(p_pool, 1u);
+	TEST_ASSERT_TRUE(si_threadpool_stats_snapshot(p_pool, &stats));
+	TEST_ASSERT_EQUAL_UINT64(30u, stats.tasks_run);
+#else
+	// Compiled out, there is nothing to snapshot.
+	TEST_ASSERT_FALSE(si_threadpool_stats_snapshot(p_pool, &stats));
+#endif//SI_THREADPOOL_STATS
+}
+
+/** Doxygen
+ * @brief Runs all local si_threadpool_stats_t unit tests.
+ */
+static void si_threadpool_stats_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_threadpool_stats_test_histogram);
+	RUN_TEST(si_threadpool_stats_test_snapshot);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_threadpool_stats.\n");
+	si_threadpool_stats_test_all();
+	(void)printf("End of si_threadpool_stats testing.\n");
+	return 0;
+}
@@ -1,5 +1,7 @@
 // si_threadpool_test.c
 
+#include <poll.h> // POLLIN
+#include <stdint.h> // intptr_t
 #include <stdio.h> // printf()
 
 #include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
@@ -41,7 +43,15 @@ static void* example_task(si_logger_t* p_param)
 static void* looping_task(si_logger_t* p_param)
 {
 	si_logger_warning(p_param, "Drink Water!");
-	sleep(12);
+	// Sleeps for 12s in steps, leaving early once the pool is stopping.
+	for (size_t iii = 0u; iii < 120u; iii++)
+	{
+		if (true == si_threadpool_is_cancelled(p_threadpool))
+		{
+			break;
+		}
+		usleep(100000);
+	}
 	return NULL;
 }
 
@@ -60,6 +70,770 @@ END:
 	return p_num;
 }
 
+static void* wake_task(size_t* p_count)
+{
+	(*p_count)++;
+	return p_count;
+}
+
+static double now_ms(void)
+{
+	struct timespec now = {0};
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((double)now.tv_sec * 1000.0) + ((double)now.tv_nsec / 1000000.0);
+}
+
+static void si_threadpool_test_wake_latency(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 2u);
+	size_t count = 0u;
+	double slowest = 0.0;
+	for (size_t iii = 0u; iii < 5u; iii++)
+	{
+		// Give the workers time to finish spinning and park.
+		usleep(20000);
+		TEST_ASSERT_EQUAL_size_t(2u, atomic_load(&(pool.parked_count)));
+		const double start = now_ms();
+		const size_t task_id = si_threadpool_enqueue_3(
+			&pool, (p_task_f)wake_task, &count
+		);
+		TEST_ASSERT_NOT_NULL(si_threadpool_await_results(&pool, task_id));
+		const double elapsed = now_ms() - start;
+		slowest = (elapsed > slowest) ? elapsed : slowest;
+	}
+	printf("Slowest idle wake-up: %.3fms\n", slowest);
+	TEST_ASSERT_EQUAL_size_t(5u, count);
+	// Polling used to take up to a second here.
+	TEST_ASSERT_TRUE(100.0 > slowest);
+	si_threadpool_free(&pool);
+}
+
+typedef struct fib_param_t
+{
+	size_t n;
+	size_t result;
+} fib_param_t;
+
+static si_threadpool_t* p_fib_pool = NULL;
+
+static void* fib_task(fib_param_t* p_param)
+{
+	if (2u > p_param->n)
+	{
+		p_param->result = p_param->n;
+		goto END;
+	}
+	// Spawn one half and recurse on the other, joining from inside the pool.
+	fib_param_t left = {.n = p_param->n - 1u, .result = 0u};
+	fib_param_t right = {.n = p_param->n - 2u, .result = 0u};
+	const size_t task_id = si_threadpool_enqueue_3(
+		p_fib_pool, (p_task_f)fib_task, &left
+	);
+	TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID, task_id);
+	(void)fib_task(&right);
+	TEST_ASSERT_EQUAL_PTR(&left, si_threadpool_await_results(p_fib_pool, task_id));
+	p_param->result = left.result + right.result;
+END:
+	return p_param;
+}
+
+static void si_threadpool_test_work_stealing(void)
+{
+	// Same results unpinned, pinned per core & spread across NUMA nodes.
+	const si_threadpool_affinity_t affinities[] = {
+		SI_THREADPOOL_AFFINITY_NONE,
+		SI_THREADPOOL_AFFINITY_CORE,
+		SI_THREADPOOL_AFFINITY_NUMA,
+	};
+	for (size_t iii = 0u; iii < sizeof(affinities) / sizeof(affinities[0]); iii++)
+	{
+		p_fib_pool = si_threadpool_new_2(1u, true);
+		TEST_ASSERT_NOT_NULL(p_fib_pool);
+		si_threadpool_set_affinity(p_fib_pool, affinities[iii]);
+		si_threadpool_start_2(p_fib_pool, 4u);
+		fib_param_t root = {.n = 18u, .result = 0u};
+		const size_t task_id = si_threadpool_enqueue_3(
+			p_fib_pool, (p_task_f)fib_task, &root
+		);
+		TEST_ASSERT_EQUAL_PTR(
+			&root, si_threadpool_await_results(p_fib_pool, task_id)
+		);
+		TEST_ASSERT_EQUAL_size_t(2584u, root.result);
+		TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&(p_fib_pool->pending_count)));
+		si_threadpool_destroy(&p_fib_pool);
+		TEST_ASSERT_NULL(p_fib_pool);
+	}
+}
+
+static void* count_task(volatile _Atomic size_t* p_count)
+{
+	atomic_fetch_add(p_count, 1u);
+	return NULL;
+}
+
+static void si_threadpool_test_work_stealing_loop(void)
+{
+	// A looping task re-enqueued by the only worker must not starve others.
+	si_threadpool_t* p_pool = si_threadpool_new_2(1u, true);
+	TEST_ASSERT_NOT_NULL(p_pool);
+	si_threadpool_start_2(p_pool, 1u);
+	volatile _Atomic size_t loop_count = 0u;
+	volatile _Atomic size_t once_count = 0u;
+	TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID, si_threadpool_enqueue_4(
+		p_pool, (p_task_f)count_task, (void*)&loop_count, false
+	));
+	while (100u > atomic_load(&loop_count))
+	{
+		usleep(1000);
+	}
+	TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID, si_threadpool_enqueue_3(
+		p_pool, (p_task_f)count_task, (void*)&once_count
+	));
+	const double deadline = now_ms() + 5000.0;
+	while ((0u == atomic_load(&once_count)) && (now_ms() < deadline))
+	{
+		usleep(1000);
+	}
+	printf("Loop iterations: %zu\n", atomic_load(&loop_count));
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&once_count));
+	si_threadpool_destroy(&p_pool);
+	TEST_ASSERT_NULL(p_pool);
+}
+
+static void* null_task(size_t* p_count)
+{
+	(*p_count)++;
+	return NULL;
+}
+
+static void si_threadpool_test_futures(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+	size_t counts[64] = {0};
+	si_future_t* futures[64] = {0};
+	for (size_t iii = 0u; iii < 64u; iii++)
+	{
+		futures[iii] = si_threadpool_enqueue_future_3(
+			&pool, (p_task_f)wake_task, &(counts[iii])
+		);
+		TEST_ASSERT_NOT_NULL(futures[iii]);
+	}
+	TEST_ASSERT_LESS_THAN_size_t(64u, si_future_wait_any(futures, 64u));
+	TEST_ASSERT_TRUE(si_future_wait_all(futures, 64u));
+	for (size_t iii = 0u; iii < 64u; iii++)
+	{
+		TEST_ASSERT_EQUAL_PTR(
+			&(counts[iii]), si_threadpool_await_future(&pool, futures[iii])
+		);
+		TEST_ASSERT_EQUAL_size_t(1u, counts[iii]);
+		si_future_destroy(&(futures[iii]));
+	}
+	// Futures bypass the results list entirely.
+	TEST_ASSERT_EQUAL_size_t(0u, pool.results.array.capacity);
+
+	// A NULL result still completes the future.
+	size_t count = 0u;
+	si_future_t* p_future = si_threadpool_enqueue_future_3(
+		&pool, (p_task_f)null_task, &count
+	);
+	TEST_ASSERT_NULL(si_threadpool_await_future(&pool, p_future));
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_READY, si_future_state(p_future));
+	TEST_ASSERT_EQUAL_size_t(1u, count);
+	si_future_destroy(&p_future);
+
+	// Tasks never run are cancelled when the pool is freed.
+	si_threadpool_stop(&pool);
+	p_future = si_threadpool_enqueue_future_3(
+		&pool, (p_task_f)null_task, &count
+	);
+	TEST_ASSERT_NOT_NULL(p_future);
+	si_threadpool_free(&pool);
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_CANCELLED, si_future_state(p_future));
+	si_future_destroy(&p_future);
+}
+
+static void si_threadpool_test_task_recycling(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+	size_t counts[256] = {0};
+	size_t task_ids[256] = {0};
+	size_t warm_allocs = 0u;
+	for (size_t round = 0u; round < 20u; round++)
+	{
+		for (size_t iii = 0u; iii < 256u; iii++)
+		{
+			task_ids[iii] = si_threadpool_enqueue_3(
+				&pool, (p_task_f)wake_task, &(counts[iii])
+			);
+			TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID, task_ids[iii]);
+		}
+		for (size_t iii = 0u; iii < 256u; iii++)
+		{
+			TEST_ASSERT_EQUAL_PTR(
+				&(counts[iii]), si_threadpool_await_results(&pool, task_ids[iii])
+			);
+		}
+		if (0u == round)
+		{
+			warm_allocs = atomic_load(&(pool.task_alloc_count));
+		}
+	}
+	printf("Task descriptors allocated: %zu for %u tasks\n",
+		atomic_load(&(pool.task_alloc_count)), 20u * 256u
+	);
+	// Once warm every descriptor is recycled.
+	TEST_ASSERT_EQUAL_size_t(warm_allocs, atomic_load(&(pool.task_alloc_count)));
+	TEST_ASSERT_EQUAL_size_t(20u, counts[0]);
+	TEST_ASSERT_EQUAL_size_t(20u, counts[255]);
+	si_threadpool_free(&pool);
+}
+
+static void* batch_task(size_t* p_count)
+{
+	(*p_count)++;
+	return p_count;
+}
+
+static void si_threadpool_test_batch(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+	size_t counts[200] = {0};
+	void* params[200] = {0};
+	size_t task_ids[200] = {0};
+	for (size_t iii = 0u; iii < 200u; iii++)
+	{
+		params[iii] = &(counts[iii]);
+	}
+	TEST_ASSERT_EQUAL_size_t(0u, si_threadpool_enqueue_batch(
+		&pool, (p_task_f)batch_task, NULL, 200u
+	));
+	// Spans several SI_THREADPOOL_BATCH_CHUNK sized chunks.
+	TEST_ASSERT_EQUAL_size_t(200u, si_threadpool_enqueue_batch_5(
+		&pool, (p_task_f)batch_task, params, 200u, task_ids
+	));
+	for (size_t iii = 0u; iii < 200u; iii++)
+	{
+		if (0u < iii)
+		{
+			TEST_ASSERT_EQUAL_size_t(task_ids[iii - 1u] + 1u, task_ids[iii]);
+		}
+		TEST_ASSERT_EQUAL_PTR(
+			&(counts[iii]), si_threadpool_await_results(&pool, task_ids[iii])
+		);
+		TEST_ASSERT_EQUAL_size_t(1u, counts[iii]);
+	}
+	si_threadpool_free(&pool);
+}
+
+static void sum_range(size_t begin, size_t end, void* p_context)
+{
+	uint64_t* const p_values = p_context;
+	for (size_t iii = begin; iii < end; iii++)
+	{
+		p_values[iii] += (uint64_t)iii;
+	}
+}
+
+static void si_threadpool_test_parallel_for(void)
+{
+	const size_t count = 100003u;
+	uint64_t* const p_values = calloc(count, sizeof(uint64_t));
+	TEST_ASSERT_NOT_NULL(p_values);
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 4u);
+	// Automatic grain, explicit grain, a grain larger than the range.
+	TEST_ASSERT_TRUE(si_threadpool_parallel_for(
+		&pool, 0u, count, 0u, sum_range, p_values
+	));
+	TEST_ASSERT_TRUE(si_threadpool_parallel_for(
+		&pool, 0u, count, 7u, sum_range, p_values
+	));
+	TEST_ASSERT_TRUE(si_threadpool_parallel_for(
+		&pool, 0u, count, count * 2u, sum_range, p_values
+	));
+	// Without a running pool the body runs on the caller.
+	TEST_ASSERT_TRUE(si_threadpool_parallel_for(
+		NULL, 0u, count, 0u, sum_range, p_values
+	));
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		TEST_ASSERT_EQUAL_UINT64((uint64_t)iii * 4u, p_values[iii]);
+	}
+	TEST_ASSERT_TRUE(si_threadpool_parallel_for(
+		&pool, 5u, 5u, 0u, sum_range, p_values
+	));
+	TEST_ASSERT_FALSE(si_threadpool_parallel_for(
+		&pool, 6u, 5u, 0u, sum_range, p_values
+	));
+	// No parallel_for helper leaves a result behind.
+	TEST_ASSERT_EQUAL_size_t(0u, si_parray_count(&(pool.results)));
+	si_threadpool_free(&pool);
+	free(p_values);
+}
+
+static void* tick_task(volatile _Atomic size_t* p_count)
+{
+	atomic_fetch_add(p_count, 1u);
+	return (void*)p_count;
+}
+
+static si_threadpool_t* p_stop_pool = NULL;
+static volatile _Atomic bool is_blocker_running = false;
+
+static void* blocker_task(void* p_param)
+{
+	(void)p_param;
+	atomic_store(&is_blocker_running, true);
+	while (true != si_threadpool_is_cancelled(p_stop_pool))
+	{
+		usleep(1000);
+	}
+	return NULL;
+}
+
+static void shutdown_range(size_t begin, size_t end, void* p_context)
+{
+	// The caller's first chunk shuts down the pool under its parallel_for().
+	if (0u == begin)
+	{
+		si_threadpool_shutdown_2(p_stop_pool, false);
+	}
+	sum_range(begin, end, p_context);
+}
+
+static void si_threadpool_test_parallel_for_stop(void)
+{
+	uint64_t values[8] = {0};
+	p_stop_pool = si_threadpool_new_1(1u);
+	TEST_ASSERT_NOT_NULL(p_stop_pool);
+	si_threadpool_start_2(p_stop_pool, 1u);
+	// Keeps the only worker busy so the helper is still queued at shutdown.
+	TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID,
+		si_threadpool_enqueue_3(p_stop_pool, blocker_task, NULL)
+	);
+	while (true != atomic_load(&is_blocker_running))
+	{
+		usleep(1000);
+	}
+	// Returns once the caller ran every chunk the dropped helper left.
+	TEST_ASSERT_TRUE(si_threadpool_parallel_for(
+		p_stop_pool, 0u, 8u, 1u, shutdown_range, values
+	));
+	for (size_t iii = 0u; iii < 8u; iii++)
+	{
+		TEST_ASSERT_EQUAL_UINT64((uint64_t)iii, values[iii]);
+	}
+	si_threadpool_destroy(&p_stop_pool);
+}
+
+static void si_threadpool_test_timers(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 2u);
+	volatile _Atomic size_t delayed = 0u;
+	double start = now_ms();
+	const size_t task_id = si_threadpool_enqueue_after(
+		&pool, (p_task_f)tick_task, (void*)&delayed, 50u
+	);
+	TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID, task_id);
+	TEST_ASSERT_EQUAL_PTR(&delayed, si_threadpool_await_results(&pool, task_id));
+	const double elapsed = now_ms() - start;
+	printf("Delayed task ran after %.3fms\n", elapsed);
+	TEST_ASSERT_TRUE(49.0 <= elapsed);
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&delayed));
+
+	// Periodic task fires until its handle is cancelled.
+	volatile _Atomic size_t ticks = 0u;
+	si_future_t* p_every = si_threadpool_enqueue_every(
+		&pool, (p_task_f)tick_task, (void*)&ticks, 10u
+	);
+	TEST_ASSERT_NOT_NULL(p_every);
+	usleep(105000);
+	TEST_ASSERT_TRUE(si_future_cancel(p_every));
+	si_future_destroy(&p_every);
+	const size_t fired = atomic_load(&ticks);
+	printf("Periodic task fired %zu times in 105ms\n", fired);
+	TEST_ASSERT_TRUE(3u <= fired);
+	TEST_ASSERT_TRUE(11u >= fired);
+	usleep(50000);
+	TEST_ASSERT_TRUE(fired + 1u >= atomic_load(&ticks));
+	// Periodic results are dropped instead of piling up.
+	TEST_ASSERT_EQUAL_size_t(0u, si_parray_count(&(pool.results)));
+
+	// Idle periodic jobs cost no CPU between firings.
+	si_future_t* handles[2000] = {0};
+	for (size_t iii = 0u; iii < 2000u; iii++)
+	{
+		handles[iii] = si_threadpool_enqueue_every(
+			&pool, (p_task_f)tick_task, (void*)&ticks, 60000u + (uint32_t)iii
+		);
+		TEST_ASSERT_NOT_NULL(handles[iii]);
+	}
+	struct timespec cpu_before = {0};
+	struct timespec cpu_after = {0};
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_before);
+	usleep(200000);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_after);
+	const double cpu_ms = (
+		((double)(cpu_after.tv_sec - cpu_before.tv_sec) * 1000.0) +
+		((double)(cpu_after.tv_nsec - cpu_before.tv_nsec) / 1000000.0)
+	);
+	printf("CPU used by 2000 idle periodic tasks in 200ms: %.3fms\n", cpu_ms);
+	TEST_ASSERT_TRUE(20.0 > cpu_ms);
+	// Freeing the pool cancels the timers left in the wheel.
+	si_threadpool_free(&pool);
+	for (size_t iii = 0u; iii < 2000u; iii++)
+	{
+		TEST_ASSERT_EQUAL_INT(SI_FUTURE_CANCELLED, si_future_state(handles[iii]));
+		si_future_destroy(&(handles[iii]));
+	}
+}
+
+typedef struct elastic_param_t
+{
+	si_threadpool_t* p_pool;
+	volatile _Atomic size_t done;
+	volatile _Atomic size_t blocked;
+	volatile _Atomic size_t most_blocked;
+	volatile _Atomic size_t most_live;
+} elastic_param_t;
+
+static void elastic_note_most(volatile _Atomic size_t* p_most, size_t value)
+{
+	size_t most = atomic_load(p_most);
+	while ((value > most) && !atomic_compare_exchange_weak(p_most, &most, value))
+	{
+	}
+}
+
+static void* blocking_task(elastic_param_t* p_param)
+{
+	si_threadpool_blocking_begin(p_param->p_pool);
+	elastic_note_most(&(p_param->most_blocked),
+		atomic_fetch_add(&(p_param->blocked), 1u) + 1u
+	);
+	usleep(50000);
+	atomic_fetch_sub(&(p_param->blocked), 1u);
+	si_threadpool_blocking_end(p_param->p_pool);
+	atomic_fetch_add(&(p_param->done), 1u);
+	return NULL;
+}
+
+static void* busy_task(elastic_param_t* p_param)
+{
+	elastic_note_most(&(p_param->most_live),
+		atomic_load(&(p_param->p_pool->live_count))
+	);
+	const double start = now_ms();
+	while (5.0 > (now_ms() - start))
+	{
+	}
+	atomic_fetch_add(&(p_param->done), 1u);
+	return NULL;
+}
+
+static void elastic_await_done(elastic_param_t* p_param, size_t count)
+{
+	for (size_t iii = 0u; iii < 5000u; iii++)
+	{
+		if (count <= atomic_load(&(p_param->done)))
+		{
+			break;
+		}
+		usleep(1000);
+	}
+	TEST_ASSERT_EQUAL_size_t(count, atomic_load(&(p_param->done)));
+}
+
+static void si_threadpool_test_elastic(void)
+{
+	for (size_t mode = 0u; mode < 2u; mode++)
+	{
+		si_threadpool_t pool = {0};
+		si_threadpool_init_3(&pool, 1u, (1u == mode));
+		si_threadpool_set_elastic_5(&pool, 1u, 4u, 1u, 50u);
+		si_threadpool_start_2(&pool, 1u);
+		TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(pool.live_count)));
+		elastic_param_t param = {.p_pool = &pool};
+		// Each blocked worker is made up for, so all four tasks block at once.
+		for (size_t iii = 0u; iii < 4u; iii++)
+		{
+			TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID,
+				si_threadpool_enqueue_3(&pool, (p_task_f)blocking_task, &param)
+			);
+		}
+		elastic_await_done(&param, 4u);
+		printf("Most tasks blocked at once: %zu\n",
+			atomic_load(&(param.most_blocked))
+		);
+		TEST_ASSERT_EQUAL_size_t(4u, atomic_load(&(param.most_blocked)));
+		// Workers above min_threads leave after the idle timeout.
+		usleep(300000);
+		TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(pool.live_count)));
+		TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&(pool.blocked_count)));
+		// Tasks waiting past spawn_wait add workers without any hints.
+		for (size_t iii = 0u; iii < 8u; iii++)
+		{
+			TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID,
+				si_threadpool_enqueue_3(&pool, (p_task_f)busy_task, &param)
+			);
+		}
+		elastic_await_done(&param, 12u);
+		printf("Most workers while busy: %zu\n", atomic_load(&(param.most_live)));
+		TEST_ASSERT_TRUE(2u <= atomic_load(&(param.most_live)));
+		TEST_ASSERT_TRUE(4u >= atomic_load(&(param.most_live)));
+		// Restarting reuses the slots of retired workers.
+		si_threadpool_stop(&pool);
+		TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&(pool.live_count)));
+		si_threadpool_start_2(&pool, 2u);
+		TEST_ASSERT_EQUAL_size_t(2u, atomic_load(&(pool.live_count)));
+		TEST_ASSERT_NOT_EQUAL(SI_THREADPOOL_TASK_ID_INVALID,
+			si_threadpool_enqueue_3(&pool, (p_task_f)busy_task, &param)
+		);
+		elastic_await_done(&param, 13u);
+		si_threadpool_free(&pool);
+	}
+}
+
+static si_threadpool_t* p_cancel_pool = NULL;
+
+// Polls its pool until cancelled.
+static void* polling_task(volatile _Atomic size_t* p_started)
+{
+	atomic_fetch_add(p_started, 1u);
+	while (true != si_threadpool_is_cancelled(p_cancel_pool))
+	{
+		usleep(1000);
+	}
+	return (void*)p_started;
+}
+
+static void si_threadpool_test_cancellation(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	p_cancel_pool = &pool;
+	si_threadpool_start_2(&pool, 1u);
+	volatile _Atomic size_t started = 0u;
+	// A token cancelled while queued skips the task & cancels its future.
+	si_cancel_token_t* p_token = si_cancel_token_new();
+	si_cancel_token_cancel(p_token);
+	si_future_t* p_future = si_threadpool_enqueue_cancellable(
+		&pool, (p_task_f)polling_task, (void*)&started, p_token
+	);
+	TEST_ASSERT_NOT_NULL(p_future);
+	TEST_ASSERT_NULL(si_threadpool_await_future(&pool, p_future));
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_CANCELLED, si_future_state(p_future));
+	TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&started));
+	si_future_destroy(&p_future);
+	si_cancel_token_destroy(&p_token);
+
+	// A deadline ends a running task that polls.
+	p_token = si_cancel_token_new();
+	si_cancel_token_cancel_after(p_token, 30u);
+	double start = now_ms();
+	p_future = si_threadpool_enqueue_cancellable(
+		&pool, (p_task_f)polling_task, (void*)&started, p_token
+	);
+	TEST_ASSERT_EQUAL_PTR(&started, si_threadpool_await_future(&pool, p_future));
+	double elapsed = now_ms() - start;
+	printf("Task with a 30ms deadline returned after %.3fms\n", elapsed);
+	TEST_ASSERT_TRUE(29.0 <= elapsed);
+	TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&started));
+	si_future_destroy(&p_future);
+	si_cancel_token_destroy(&p_token);
+
+	// Stopping cancels a running task after the grace period, no kill.
+	p_future = si_threadpool_enqueue_future_3(
+		&pool, (p_task_f)polling_task, (void*)&started
+	);
+	while (2u > atomic_load(&started))
+	{
+		usleep(1000);
+	}
+	start = now_ms();
+	si_threadpool_stop_2(&pool, 20u);
+	elapsed = now_ms() - start;
+	printf("Stop with a 20ms grace period took %.3fms\n", elapsed);
+	TEST_ASSERT_TRUE(19.0 <= elapsed);
+	TEST_ASSERT_TRUE(1000.0 > elapsed);
+	TEST_ASSERT_EQUAL_PTR(&started, si_future_wait(p_future));
+	si_future_destroy(&p_future);
+
+	// Shutting down without draining abandons what is still queued.
+	si_threadpool_start_2(&pool, 1u);
+	TEST_ASSERT_FALSE(si_threadpool_is_cancelled(&pool));
+	si_future_t* p_blocker = si_threadpool_enqueue_future_3(
+		&pool, (p_task_f)polling_task, (void*)&started
+	);
+	while (3u > atomic_load(&started))
+	{
+		usleep(1000);
+	}
+	size_t count = 0u;
+	si_future_t* futures[10] = {0};
+	for (size_t iii = 0u; iii < 10u; iii++)
+	{
+		futures[iii] = si_threadpool_enqueue_future_3(
+			&pool, (p_task_f)wake_task, &count
+		);
+		TEST_ASSERT_NOT_NULL(futures[iii]);
+	}
+	si_threadpool_shutdown_2(&pool, false);
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_READY, si_future_state(p_blocker));
+	si_future_destroy(&p_blocker);
+	for (size_t iii = 0u; iii < 10u; iii++)
+	{
+		TEST_ASSERT_EQUAL_INT(SI_FUTURE_CANCELLED, si_future_state(futures[iii]));
+		si_future_destroy(&(futures[iii]));
+	}
+	TEST_ASSERT_EQUAL_size_t(0u, count);
+	TEST_ASSERT_EQUAL_size_t(0u, atomic_load(&(pool.pending_count)));
+
+	// Draining runs everything queued first.
+	si_threadpool_start_2(&pool, 1u);
+	for (size_t iii = 0u; iii < 10u; iii++)
+	{
+		futures[iii] = si_threadpool_enqueue_future_3(
+			&pool, (p_task_f)wake_task, &count
+		);
+	}
+	si_threadpool_shutdown(&pool);
+	for (size_t iii = 0u; iii < 10u; iii++)
+	{
+		TEST_ASSERT_EQUAL_INT(SI_FUTURE_READY, si_future_state(futures[iii]));
+		si_future_destroy(&(futures[iii]));
+	}
+	TEST_ASSERT_EQUAL_size_t(10u, count);
+	si_threadpool_free(&pool);
+	p_cancel_pool = NULL;
+}
+
+#define FIBER_TEST_TASKS (100u)
+#define FIBER_TEST_YIELDS (10u)
+
+typedef struct fiber_param_t
+{
+	volatile _Atomic size_t* p_turns;
+	size_t yields;
+} fiber_param_t;
+
+// Yields between turns, all fibers interleave on a single worker.
+static void* yielding_task(fiber_param_t* p_param)
+{
+	for (size_t iii = 0u; iii < p_param->yields; iii++)
+	{
+		atomic_fetch_add(p_param->p_turns, 1u);
+		TEST_ASSERT_TRUE(si_task_yield());
+	}
+	return (void*)p_param;
+}
+
+// Waits on the read end of a pipe, returns the read byte.
+static void* reading_task(int* p_fd)
+{
+	const int revents = si_task_wait_fd_3(*p_fd, POLLIN, 1000);
+	char byte = 0;
+	if ((0 < revents) && (1 == read(*p_fd, &byte, 1u)))
+	{
+		return (void*)(intptr_t)byte;
+	}
+	return NULL;
+}
+
+// Waits on a pipe nobody writes to.
+static void* timing_out_task(int* p_fd)
+{
+	return (void*)(intptr_t)(1 + si_task_wait_fd_3(*p_fd, POLLIN, 20));
+}
+
+static void si_threadpool_test_fibers(void)
+{
+	si_threadpool_t pool = {0};
+	si_threadpool_init(&pool);
+	si_threadpool_start_2(&pool, 1u);
+	TEST_ASSERT_FALSE(si_task_yield());
+
+	// Every fiber suspends, so the single worker takes turns between them.
+	volatile _Atomic size_t turns = 0u;
+	fiber_param_t params[FIBER_TEST_TASKS] = {0};
+	si_future_t* futures[FIBER_TEST_TASKS] = {0};
+	for (size_t iii = 0u; iii < FIBER_TEST_TASKS; iii++)
+	{
+		params[iii].p_turns = &turns;
+		params[iii].yields = FIBER_TEST_YIELDS;
+		futures[iii] = si_threadpool_enqueue_fiber(
+			&pool, (p_task_f)yielding_task, &(params[iii])
+		);
+		TEST_ASSERT_NOT_NULL(futures[iii]);
+	}
+	for (size_t iii = 0u; iii < FIBER_TEST_TASKS; iii++)
+	{
+		TEST_ASSERT_EQUAL_PTR(&(params[iii]),
+			si_threadpool_await_future(&pool, futures[iii])
+		);
+		si_future_destroy(&(futures[iii]));
+	}
+	TEST_ASSERT_EQUAL_size_t(FIBER_TEST_TASKS * FIBER_TEST_YIELDS,
+		atomic_load(&turns)
+	);
+	// Stacks are recycled, far fewer are mapped than fibers were run.
+	TEST_ASSERT_TRUE(
+		FIBER_TEST_TASKS >= atomic_load(&(pool.fiber_stacks.map_count))
+	);
+
+	// A waiting fiber frees its worker for the fiber that wakes it.
+	int fds[2] = {-1, -1};
+	TEST_ASSERT_EQUAL_INT(0, pipe(fds));
+	si_future_t* p_reader = si_threadpool_enqueue_fiber(
+		&pool, (p_task_f)reading_task, &(fds[0])
+	);
+	TEST_ASSERT_NOT_NULL(p_reader);
+	usleep(10000);
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_PENDING, si_future_state(p_reader));
+	TEST_ASSERT_EQUAL_INT(1, (int)write(fds[1], "x", 1u));
+	TEST_ASSERT_EQUAL_PTR((void*)(intptr_t)'x',
+		si_threadpool_await_future(&pool, p_reader)
+	);
+	si_future_destroy(&p_reader);
+
+	// Timeouts resume the fiber with 0.
+	double start = now_ms();
+	si_future_t* p_timeout = si_threadpool_enqueue_fiber(
+		&pool, (p_task_f)timing_out_task, &(fds[0])
+	);
+	TEST_ASSERT_EQUAL_PTR((void*)(intptr_t)1,
+		si_threadpool_await_future(&pool, p_timeout)
+	);
+	const double elapsed = now_ms() - start;
+	printf("Fiber fd wait with a 20ms timeout returned after %.3fms\n",
+		elapsed
+	);
+	TEST_ASSERT_TRUE(19.0 <= elapsed);
+	si_future_destroy(&p_timeout);
+
+	// Fibers still waiting when the pool is freed are cancelled.
+	p_timeout = si_threadpool_enqueue_fiber(
+		&pool, (p_task_f)reading_task, &(fds[0])
+	);
+	usleep(10000);
+	si_threadpool_free(&pool);
+	TEST_ASSERT_EQUAL_INT(SI_FUTURE_CANCELLED, si_future_state(p_timeout));
+	si_future_destroy(&p_timeout);
+	(void)close(fds[0]);
+	(void)close(fds[1]);
+}
+
 static void handle_signal(int signal)
 {
 	// NOP to make -Wpedantic happy.
@@ -126,6 +900,18 @@ static void si_threadpool_test_all(void)
 {
 	UNITY_BEGIN();
 	RUN_TEST(si_threadpool_test_init);
+	RUN_TEST(si_threadpool_test_wake_latency);
+	RUN_TEST(si_threadpool_test_work_stealing);
+	RUN_TEST(si_threadpool_test_work_stealing_loop);
+	RUN_TEST(si_threadpool_test_futures);
+	RUN_TEST(si_threadpool_test_task_recycling);
+	RUN_TEST(si_threadpool_test_batch);
+	RUN_TEST(si_threadpool_test_parallel_for);
+	RUN_TEST(si_threadpool_test_parallel_for_stop);
+	RUN_TEST(si_threadpool_test_timers);
+	RUN_TEST(si_threadpool_test_elastic);
+	RUN_TEST(si_threadpool_test_cancellation);
+	RUN_TEST(si_threadpool_test_fibers);
 	RUN_TEST(si_threadpool_test_run);
 	UNITY_END();
 }
@@ -0,0 +1,169 @@
+// si_timer_wheel_test.c
+
+#include "si_timer_wheel.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <stdio.h> // printf()
+#include <stdlib.h> // rand(), srand()
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+#define SI_TIMER_WHEEL_TEST_ENTRIES (10000u)
+
+typedef struct test_timer_t
+{
+	uint64_t deadline;
+	size_t fired;
+	// Re-arms this many more times, period ticks apart.
+	size_t repeats;
+	uint64_t period;
+} test_timer_t;
+
+// Bounds of the deadlines the running advance may expire.
+static uint64_t g_floor = 0u;
+static uint64_t g_now = 0u;
+
+static bool expire_timer(void* p_data, uint64_t* p_deadline, void* p_context)
+{
+	test_timer_t* const p_timer = p_data;
+	size_t* const p_fired = p_context;
+	TEST_ASSERT_EQUAL_UINT64(p_timer->deadline, *p_deadline);
+	TEST_ASSERT_TRUE(*p_deadline <= g_now);
+	TEST_ASSERT_TRUE(*p_deadline >= g_floor);
+	p_timer->fired++;
+	(*p_fired)++;
+	bool result = false;
+	if (0u < p_timer->repeats)
+	{
+		p_timer->repeats--;
+		p_timer->deadline += p_timer->period;
+		*p_deadline = p_timer->deadline;
+		result = true;
+	}
+	return result;
+}
+
+static void si_timer_wheel_test_levels(void)
+{
+	si_timer_wheel_t wheel = {0};
+	si_timer_wheel_init_2(&wheel, 1000u);
+	g_floor = 0u;
+	TEST_ASSERT_EQUAL_UINT64(SI_TIMER_WHEEL_NEVER, si_timer_wheel_next(&wheel));
+	// Deadlines on both sides of every level boundary & past the wheel's span.
+	const uint64_t offsets[] = {
+		0u, 1u, 63u, 64u, 65u, 4095u, 4096u, 4097u, 262143u, 262144u,
+		300000u, 16777215u, 16777216u, 20000000u, 1000000000u,
+	};
+	const size_t count = sizeof(offsets) / sizeof(offsets[0]);
+	test_timer_t timers[sizeof(offsets) / sizeof(offsets[0])] = {0};
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		timers[iii].deadline = 1000u + offsets[iii];
+		TEST_ASSERT_TRUE(si_timer_wheel_add(
+			&wheel, timers[iii].deadline, &(timers[iii])
+		));
+	}
+	TEST_ASSERT_EQUAL_size_t(count, si_timer_wheel_count(&wheel));
+	size_t fired = 0u;
+	for (size_t iii = 0u; iii < count; iii++)
+	{
+		// Nothing fires a tick early.
+		const uint64_t next = si_timer_wheel_next(&wheel);
+		TEST_ASSERT_TRUE(next <= timers[iii].deadline);
+		g_now = timers[iii].deadline - 1u;
+		if (g_now >= wheel.current)
+		{
+			(void)si_timer_wheel_advance(&wheel, g_now, expire_timer, &fired);
+		}
+		TEST_ASSERT_EQUAL_size_t(iii, fired);
+		g_now = timers[iii].deadline;
+		TEST_ASSERT_EQUAL_size_t(
+			1u, si_timer_wheel_advance(&wheel, g_now, expire_timer, &fired)
+		);
+		TEST_ASSERT_EQUAL_size_t(1u, timers[iii].fired);
+	}
+	TEST_ASSERT_EQUAL_size_t(0u, si_timer_wheel_count(&wheel));
+	// Passed deadlines fire on the next advance.
+	timers[0].deadline = 5u;
+	TEST_ASSERT_TRUE(si_timer_wheel_add(&wheel, 5u, &(timers[0])));
+	g_now++;
+	TEST_ASSERT_EQUAL_size_t(
+		1u, si_timer_wheel_advance(&wheel, g_now, expire_timer, &fired)
+	);
+	si_timer_wheel_free(&wheel);
+}
+
+static void si_timer_wheel_test_random(void)
+{
+	static test_timer_t timers[SI_TIMER_WHEEL_TEST_ENTRIES];
+	si_timer_wheel_t wheel = {0};
+	si_timer_wheel_init(&wheel);
+	srand(38u);
+	size_t expected = 0u;
+	for (size_t iii = 0u; iii < SI_TIMER_WHEEL_TEST_ENTRIES; iii++)
+	{
+		timers[iii].deadline = ((uint64_t)rand() * 7919u) % 50000000u;
+		timers[iii].fired = 0u;
+		// Every tenth entry is periodic.
+		timers[iii].repeats = (0u == (iii % 10u)) ? 5u : 0u;
+		timers[iii].period = 1u + (iii % 5000u);
+		expected += 1u + timers[iii].repeats;
+		TEST_ASSERT_TRUE(si_timer_wheel_add(
+			&wheel, timers[iii].deadline, &(timers[iii])
+		));
+	}
+	size_t fired = 0u;
+	size_t advances = 0u;
+	g_now = 0u;
+	while (0u < si_timer_wheel_count(&wheel))
+	{
+		// Nothing due in an earlier advance may be left for this one.
+		g_floor = g_now + 1u;
+		g_now += 1u + ((uint64_t)rand() % 100000u);
+		(void)si_timer_wheel_advance(&wheel, g_now, expire_timer, &fired);
+		advances++;
+	}
+	printf("Fired %zu entries over %zu advances.\n", fired, advances);
+	TEST_ASSERT_EQUAL_size_t(expected, fired);
+	for (size_t iii = 0u; iii < SI_TIMER_WHEEL_TEST_ENTRIES; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(0u, timers[iii].repeats);
+	}
+	// Pending entries are handed to p_free_value.
+	wheel.p_free_value = free;
+	for (size_t iii = 0u; iii < 100u; iii++)
+	{
+		TEST_ASSERT_TRUE(si_timer_wheel_add(
+			&wheel, g_now + (iii * 1000u), calloc(1u, sizeof(test_timer_t))
+		));
+	}
+	si_timer_wheel_free(&wheel);
+	TEST_ASSERT_EQUAL_size_t(0u, si_timer_wheel_count(&wheel));
+}
+
+/** Doxygen
+ * @brief Runs all local si_timer_wheel_t unit tests.
+ */
+static void si_timer_wheel_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_timer_wheel_test_levels);
+	RUN_TEST(si_timer_wheel_test_random);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_timer_wheel.\n");
+	si_timer_wheel_test_all();
+	(void)printf("End of si_timer_wheel testing.\n");
+	return 0;
+}
@@ -0,0 +1,133 @@
+// si_ws_deque_test.c
+
+#include "si_thread.h" // si_thread_yield()
+#include "si_ws_deque.h"
+#include "unity.h" // RUN_TEST(), UNITY_BEGIN(), UNITY_END()
+
+#include <pthread.h> // pthread_create(), pthread_join()
+#include <stdio.h> // printf()
+
+/* Is run before every test, put unit init calls here. */
+void setUp (void)
+{
+}
+
+/* Is run after every test, put unit clean-up calls here. */
+void tearDown (void)
+{
+}
+
+#define SI_WS_DEQUE_TEST_ITEMS (100000u)
+#define SI_WS_DEQUE_TEST_THIEVES (3u)
+
+// Items are offsets into this so each one is a distinct non-NULL pointer.
+static char g_items[SI_WS_DEQUE_TEST_ITEMS + 1u];
+static volatile _Atomic size_t g_seen[SI_WS_DEQUE_TEST_ITEMS + 1u];
+static volatile _Atomic bool g_owner_done = false;
+
+static void si_ws_deque_test_single(void)
+{
+	si_ws_deque_t deque = {0};
+	TEST_ASSERT_TRUE(si_ws_deque_init_2(&deque, 2u));
+	TEST_ASSERT_NULL(si_ws_deque_take(&deque));
+	TEST_ASSERT_NULL(si_ws_deque_steal(&deque));
+	TEST_ASSERT_FALSE(si_ws_deque_push(&deque, NULL));
+
+	printf("Testing push past the initial capacity.\n");
+	for (size_t iii = 1u; iii <= 10u; iii++)
+	{
+		TEST_ASSERT_TRUE(si_ws_deque_push(&deque, &(g_items[iii])));
+	}
+	TEST_ASSERT_EQUAL_size_t(10u, si_ws_deque_count(&deque));
+
+	printf("Testing steal from the top & take from the bottom.\n");
+	TEST_ASSERT_EQUAL_PTR(&(g_items[1u]), si_ws_deque_steal(&deque));
+	TEST_ASSERT_EQUAL_PTR(&(g_items[2u]), si_ws_deque_steal(&deque));
+	TEST_ASSERT_EQUAL_PTR(&(g_items[10u]), si_ws_deque_take(&deque));
+	TEST_ASSERT_EQUAL_PTR(&(g_items[9u]), si_ws_deque_take(&deque));
+	TEST_ASSERT_EQUAL_size_t(6u, si_ws_deque_count(&deque));
+	for (size_t iii = 8u; iii >= 3u; iii--)
+	{
+		TEST_ASSERT_EQUAL_PTR(&(g_items[iii]), si_ws_deque_take(&deque));
+	}
+	TEST_ASSERT_NULL(si_ws_deque_take(&deque));
+	TEST_ASSERT_EQUAL_size_t(0u, si_ws_deque_count(&deque));
+	si_ws_deque_free(&deque);
+}
+
+static void* si_ws_deque_test_thief(si_ws_deque_t* p_deque)
+{
+	while (true)
+	{
+		const bool owner_done = atomic_load(&g_owner_done);
+		char* const p_item = si_ws_deque_steal(p_deque);
+		if (NULL != p_item)
+		{
+			atomic_fetch_add(&(g_seen[p_item - g_items]), 1u);
+			continue;
+		}
+		if ((true == owner_done) && (0u == si_ws_deque_count(p_deque)))
+		{
+			break;
+		}
+		si_thread_yield();
+	}
+	return NULL;
+}
+
+static void si_ws_deque_test_concurrent(void)
+{
+	printf("Testing concurrent owner & thieves.\n");
+	si_ws_deque_t deque = {0};
+	TEST_ASSERT_TRUE(si_ws_deque_init(&deque));
+	pthread_t thieves[SI_WS_DEQUE_TEST_THIEVES] = {0};
+	for (size_t iii = 0u; iii < SI_WS_DEQUE_TEST_THIEVES; iii++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&(thieves[iii]), NULL,
+			(void* (*)(void*))si_ws_deque_test_thief, &deque
+		));
+	}
+	for (size_t iii = 1u; iii <= SI_WS_DEQUE_TEST_ITEMS; iii++)
+	{
+		TEST_ASSERT_TRUE(si_ws_deque_push(&deque, &(g_items[iii])));
+		// Take back every third item to race the thieves at the bottom.
+		if (0u == (iii % 3u))
+		{
+			char* const p_item = si_ws_deque_take(&deque);
+			if (NULL != p_item)
+			{
+				atomic_fetch_add(&(g_seen[p_item - g_items]), 1u);
+			}
+		}
+	}
+	atomic_store(&g_owner_done, true);
+	for (size_t iii = 0u; iii < SI_WS_DEQUE_TEST_THIEVES; iii++)
+	{
+		TEST_ASSERT_EQUAL_INT(0, pthread_join(thieves[iii], NULL));
+	}
+	// Every item was handed out exactly once.
+	for (size_t iii = 1u; iii <= SI_WS_DEQUE_TEST_ITEMS; iii++)
+	{
+		TEST_ASSERT_EQUAL_size_t(1u, atomic_load(&(g_seen[iii])));
+	}
+	si_ws_deque_free(&deque);
+}
+
+/** Doxygen
+ * @brief Runs all local si_ws_deque unit tests.
+ */
+static void si_ws_deque_test_all(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(si_ws_deque_test_single);
+	RUN_TEST(si_ws_deque_test_concurrent);
+	UNITY_END();
+}
+
+int main(void)
+{
+	(void)printf("Begin testing of si_ws_deque.\n");
+	si_ws_deque_test_all();
+	(void)printf("End of si_ws_deque testing.\n");
+	return 0;
+}